@@ -286,6 +286,15 @@ int uwsgi_buffer_num64(struct uwsgi_buffer *ub, int64_t num) {
 	return uwsgi_buffer_append(ub, buf, ret);
 }
 
+// unsigned LEB128
+int uwsgi_buffer_varint(struct uwsgi_buffer *ub, uint64_t num) {
+	while (num > 127) {
+		if (uwsgi_buffer_u8(ub, (uint8_t) (0x80 | (num & 0x7f)))) return -1;
+		num >>= 7;
+	}
+	return uwsgi_buffer_u8(ub, (uint8_t) num);
+}
+
 int uwsgi_buffer_append_keyval(struct uwsgi_buffer *ub, char *key, uint16_t keylen, char *val, uint16_t vallen) {
 	if (uwsgi_buffer_u16le(ub, keylen)) return -1;
 	if (uwsgi_buffer_append(ub, key, keylen)) return -1;
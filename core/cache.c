@@ -24,21 +24,159 @@ extern struct uwsgi_server uwsgi;
 
 */
 
-static void cache_full(struct uwsgi_cache *uc) {
+/*
+	eviction policies
+
+	purge_lru moves the item to the tail of a list on every get (so gets need the write lock).
+	The clock and sampled policies only store a reference bit (clock) or the
+	insertion tick (sampled) of the item on gets (a relaxed store, allowed under the read lock
+	and in optimistic reads):
+
+	clock: the hand scans the items clearing the reference bits, the first item without it is evicted
+	sampled: purge_samples random items are checked, the least recently used one is evicted
+
+	The optional TinyLFU admission filter (admission=tinylfu) tracks the frequency of every key
+	(hits and misses) in a count-min sketch of 4 rows of 8bit counters, halved every 10*width
+	additions. When the cache is full the new item is stored only if its key is more frequent than
+	the victim, so one-time keys (e.g. from scans) do not wipe the working set.
+*/
+
+static void cache_sketch_add(struct uwsgi_cache *uc, uint32_t hash);
+static uint8_t cache_sketch_estimate(struct uwsgi_cache *uc, uint32_t hash);
+
+static uint64_t cache_policy_victim(struct uwsgi_cache *uc) {
+	uint64_t i;
+	if (uc->purge_policy == UWSGI_CACHE_POLICY_CLOCK) {
+		// two rounds are enough to clear all of the reference bits
+		for (i = 0; i < (uc->max_items * 2); i++) {
+			uc->clock_hand++;
+			if (uc->clock_hand >= uc->max_items) uc->clock_hand = 1;
+			struct uwsgi_cache_item *uci = cache_item(uc->clock_hand);
+			if (!uci->keysize) continue;
+			if (uc->clock_refs[uc->clock_hand]) {
+				uc->clock_refs[uc->clock_hand] = 0;
+				continue;
+			}
+			return uc->clock_hand;
+		}
+		return 0;
+	}
+
+	uint64_t victim = 0;
+	uint32_t victim_age = 0;
+	uint64_t samples = 0;
+	// give up after too many empty slots
+	for (i = 0; i < (uc->purge_samples * 4) && samples < uc->purge_samples; i++) {
+		// xorshift64
+		uc->random_state ^= uc->random_state << 13;
+		uc->random_state ^= uc->random_state >> 7;
+		uc->random_state ^= uc->random_state << 17;
+		uint64_t slot = 1 + (uc->random_state % (uc->max_items - 1));
+		struct uwsgi_cache_item *uci = cache_item(slot);
+		if (!uci->keysize) continue;
+		samples++;
+		uint32_t age = uc->policy_tick - uc->access_ticks[slot];
+		if (!victim || age > victim_age) {
+			victim = slot;
+			victim_age = age;
+		}
+	}
+	return victim;
+}
+
+// mark the item as recently used (it can be called without the write lock)
+static void cache_policy_touch(struct uwsgi_cache *uc, uint64_t slot) {
+	if (uc->clock_refs) {
+		if (!__atomic_load_n(&uc->clock_refs[slot], __ATOMIC_RELAXED))
+			__atomic_store_n(&uc->clock_refs[slot], 1, __ATOMIC_RELAXED);
+	}
+	else if (uc->access_ticks) {
+		uint32_t tick = __atomic_load_n(&uc->policy_tick, __ATOMIC_RELAXED);
+		if (__atomic_load_n(&uc->access_ticks[slot], __ATOMIC_RELAXED) != tick)
+			__atomic_store_n(&uc->access_ticks[slot], tick, __ATOMIC_RELAXED);
+	}
+}
+
+// a new item has been stored (write lock held)
+static void cache_policy_insert(struct uwsgi_cache *uc, uint64_t slot) {
+	if (uc->clock_refs) {
+		// new items do not survive the next round of the hand unless they are used
+		uc->clock_refs[slot] = 0;
+	}
+	else if (uc->access_ticks) {
+		// items accessed after this one will be more recent
+		uc->access_ticks[slot] = uc->policy_tick++;
+	}
+}
+
+static uint64_t cache_sketch_index(struct uwsgi_cache *uc, uint32_t hash, int row) {
+	static const uint64_t seeds[] = { 0x9E3779B97F4A7C15LLU, 0xC2B2AE3D27D4EB4FLLU, 0x165667B19E3779F9LLU, 0xD6E8FEB86659FD93LLU };
+	uint64_t h = ((uint64_t) hash + seeds[row]) * seeds[row];
+	h ^= h >> 32;
+	return (row * uc->sketch_width) + (h & (uc->sketch_width - 1));
+}
+
+// counters are approximated, so lost updates from concurrent readers are not a problem
+static void cache_sketch_add(struct uwsgi_cache *uc, uint32_t hash) {
+	int i;
+	if (!uc->sketch) return;
+	for (i = 0; i < 4; i++) {
+		uint8_t *counter = &uc->sketch[cache_sketch_index(uc, hash, i)];
+		uint8_t value = __atomic_load_n(counter, __ATOMIC_RELAXED);
+		if (value < 15) __atomic_store_n(counter, value + 1, __ATOMIC_RELAXED);
+	}
+	uint64_t additions = __atomic_add_fetch(&uc->sketch_additions, 1, __ATOMIC_RELAXED);
+	// aging, only the process reaching the limit does it
+	if (additions == uc->sketch_width * 10) {
+		uint64_t j;
+		for (j = 0; j < uc->sketch_width * 4; j++) {
+			__atomic_store_n(&uc->sketch[j], __atomic_load_n(&uc->sketch[j], __ATOMIC_RELAXED) >> 1, __ATOMIC_RELAXED);
+		}
+		__atomic_store_n(&uc->sketch_additions, 0, __ATOMIC_RELAXED);
+	}
+}
+
+static uint8_t cache_sketch_estimate(struct uwsgi_cache *uc, uint32_t hash) {
+	int i;
+	uint8_t estimate = 15;
+	for (i = 0; i < 4; i++) {
+		uint8_t value = __atomic_load_n(&uc->sketch[cache_sketch_index(uc, hash, i)], __ATOMIC_RELAXED);
+		if (value < estimate) estimate = value;
+	}
+	return estimate;
+}
+
+// hash is the one of the key that needs room
+static void cache_full(struct uwsgi_cache *uc, uint32_t hash) {
 	uint64_t i;
 	int clear_cache = uc->clear_on_full;
 
 	if (!uc->ignore_full) {
         	if (uc->purge_lru)
                 	uwsgi_log("LRU item will be purged from cache \"%s\"\n", uc->name);
+		else if (uc->purge_policy)
+                	uwsgi_log("an item will be purged from cache \"%s\"\n", uc->name);
                 else
                 	uwsgi_log("*** DANGER cache \"%s\" is FULL !!! ***\n", uc->name);
 	}
 
         uc->full++;
 
-        if (uc->purge_lru && uc->lru_head)
-        	uwsgi_cache_del2(uc, NULL, 0, uc->lru_head, UWSGI_CACHE_FLAG_LOCAL);
+	uint64_t victim = 0;
+        if (uc->purge_lru)
+		victim = uc->lru_head;
+	else if (uc->purge_policy)
+		victim = cache_policy_victim(uc);
+
+	if (victim) {
+		struct uwsgi_cache_item *uci = cache_item(victim);
+		if (uc->sketch && cache_sketch_estimate(uc, hash) <= cache_sketch_estimate(uc, uci->hash)) {
+			uc->admission_rejected++;
+		}
+		else if (!uwsgi_cache_del2(uc, NULL, 0, victim, UWSGI_CACHE_FLAG_LOCAL)) {
+			uc->evictions++;
+		}
+	}
 
 	// we do not need locking here !
 	if (uc->sweep_on_full) {
@@ -217,7 +355,221 @@ static void cache_unmark_blocks(struct uwsgi_cache *uc, uint64_t index, uint64_t
         }
 }
 
+/*
+	slab allocator
+
+	the data area is split in pages (by default 1MB, or 1/256 of the data area for small caches),
+	each page is assigned on demand to a size class and split in chunks of the class size
+	(classes grow by slab_factor, chunks are always a multiple of blocksize so first_block
+	keeps pointing to the value).
+
+	Every class has a list of pages with free chunks, and every page a list of its free chunks,
+	so allocating and freeing is O(1) regardless of how much the cache is filled. When a page
+	is completely empty it is released and can be assigned to another class.
+*/
+
+static uint64_t cache_slab_round(struct uwsgi_cache *uc, uint64_t size) {
+	return ((size + uc->blocksize - 1) / uc->blocksize) * uc->blocksize;
+}
+
+static uint64_t cache_slab_classes(struct uwsgi_cache *uc, uint64_t *sizes) {
+	uint64_t n = 0;
+	// a free chunk holds the index of the next one
+	uint64_t size = cache_slab_round(uc, 8);
+	while (size < uc->slab_page_size && n < UWSGI_CACHE_SLAB_CLASSES - 1) {
+		sizes[n++] = size;
+		uint64_t next = cache_slab_round(uc, (uint64_t) (size * uc->slab_factor));
+		if (next <= size) next = size + uc->blocksize;
+		size = next;
+	}
+	sizes[n++] = uc->slab_page_size;
+	return n;
+}
+
+static void cache_slabs_configure(struct uwsgi_cache *uc) {
+	uint64_t data_size = uc->blocksize * uc->blocks;
+	uint64_t min_chunk = cache_slab_round(uc, 8);
+
+	if (!uc->slab_page_size) {
+		uc->slab_page_size = 1024 * 1024;
+		// small caches need enough pages to be shared by all the classes
+		if (uc->slab_page_size > data_size / (UWSGI_CACHE_SLAB_CLASSES * 4)) uc->slab_page_size = data_size / (UWSGI_CACHE_SLAB_CLASSES * 4);
+	}
+	uc->slab_page_size = (uc->slab_page_size / uc->blocksize) * uc->blocksize;
+	if (uc->slab_page_size < min_chunk) uc->slab_page_size = min_chunk;
+
+	uc->slab_npages = data_size / uc->slab_page_size;
+	if (!uc->slab_npages || uc->slab_npages >= 0xffffffff || uc->slab_page_size / min_chunk >= 0xffffffff) {
+		uwsgi_log("invalid slab page size (%llu) for cache \"%s\"\n", (unsigned long long) uc->slab_page_size, uc->name);
+		exit(1);
+	}
+	uc->max_item_size = uc->slab_page_size;
+}
+
+// the slab metadata are placed (aligned) after the data area
+static uint64_t cache_slabs_offset(struct uwsgi_cache *uc) {
+	uint64_t offset = ((sizeof(struct uwsgi_cache_item)+uc->keysize) * uc->max_items) + (uc->blocksize * uc->blocks);
+	return (offset + 7) & ~((uint64_t) 7);
+}
+
+static uint64_t cache_slabs_size(struct uwsgi_cache *uc) {
+	return sizeof(struct uwsgi_cache_slabs) + (sizeof(struct uwsgi_cache_slab_page) * uc->slab_npages);
+}
+
+static void cache_slabs_init(struct uwsgi_cache *uc) {
+	uint64_t sizes[UWSGI_CACHE_SLAB_CLASSES];
+	uint64_t i;
+
+	uc->slabs = (struct uwsgi_cache_slabs *) (((char *) uc->items) + cache_slabs_offset(uc));
+	uc->slab_pages = (struct uwsgi_cache_slab_page *) (uc->slabs + 1);
+
+	uint64_t n = cache_slab_classes(uc, sizes);
+
+	// recovered from the store, ensure the classes have not changed
+	if (uc->slabs->nclasses) {
+		int valid = uc->slabs->nclasses == n;
+		for (i = 0; valid && i < n; i++) {
+			if (uc->slabs->classes[i].chunk_size != sizes[i]) valid = 0;
+		}
+		if (!valid) {
+			uwsgi_log("invalid cache store file: slab classes of cache \"%s\" do not match, please remove it or fix the slab configuration\n", uc->name);
+			exit(1);
+		}
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		uc->slabs->classes[i].chunk_size = sizes[i];
+		uc->slabs->classes[i].chunks_per_page = uc->slab_page_size / sizes[i];
+	}
+	uc->slabs->nclasses = n;
+}
+
+static uint64_t cache_slab_class(struct uwsgi_cache *uc, uint64_t len) {
+	uint64_t low = 0, high = uc->slabs->nclasses - 1;
+	while (low < high) {
+		uint64_t mid = (low + high) / 2;
+		if (uc->slabs->classes[mid].chunk_size < len) low = mid + 1;
+		else high = mid;
+	}
+	return low;
+}
+
+static void cache_slab_partial_add(struct uwsgi_cache *uc, struct uwsgi_cache_slab_class *ucsc, uint64_t pidx) {
+	struct uwsgi_cache_slab_page *page = &uc->slab_pages[pidx];
+	page->prev = 0;
+	page->next = ucsc->partial;
+	if (ucsc->partial) uc->slab_pages[ucsc->partial - 1].prev = pidx + 1;
+	ucsc->partial = pidx + 1;
+}
+
+static void cache_slab_partial_remove(struct uwsgi_cache *uc, struct uwsgi_cache_slab_class *ucsc, uint64_t pidx) {
+	struct uwsgi_cache_slab_page *page = &uc->slab_pages[pidx];
+	if (page->prev) uc->slab_pages[page->prev - 1].next = page->next;
+	else ucsc->partial = page->next;
+	if (page->next) uc->slab_pages[page->next - 1].prev = page->prev;
+	page->prev = 0;
+	page->next = 0;
+}
+
+static int cache_slab_new_page(struct uwsgi_cache *uc, uint64_t cls) {
+	uint64_t pidx;
+	if (uc->slabs->free_pages) {
+		pidx = uc->slabs->free_pages - 1;
+		uc->slabs->free_pages = uc->slab_pages[pidx].next;
+	}
+	else if (uc->slabs->next_page < uc->slab_npages) {
+		pidx = uc->slabs->next_page++;
+	}
+	else {
+		return -1;
+	}
+	struct uwsgi_cache_slab_page *page = &uc->slab_pages[pidx];
+	page->class = cls + 1;
+	page->used = 0;
+	page->carved = 0;
+	page->free = 0;
+	uc->slabs->classes[cls].pages++;
+	cache_slab_partial_add(uc, &uc->slabs->classes[cls], pidx);
+	return 0;
+}
+
+static uint64_t cache_slab_take(struct uwsgi_cache *uc, uint64_t cls) {
+	struct uwsgi_cache_slab_class *ucsc = &uc->slabs->classes[cls];
+	uint64_t pidx = ucsc->partial - 1;
+	struct uwsgi_cache_slab_page *page = &uc->slab_pages[pidx];
+	char *base = ((char *) uc->data) + (pidx * uc->slab_page_size);
+	uint64_t chunk;
+	if (page->free) {
+		chunk = page->free - 1;
+		memcpy(&page->free, base + (chunk * ucsc->chunk_size), sizeof(uint32_t));
+	}
+	else {
+		chunk = page->carved++;
+	}
+	page->used++;
+	ucsc->chunks++;
+	if (page->used >= ucsc->chunks_per_page) {
+		cache_slab_partial_remove(uc, ucsc, pidx);
+	}
+	return ((pidx * uc->slab_page_size) + (chunk * ucsc->chunk_size)) / uc->blocksize;
+}
+
+// returns the first block of the chunk or 0xffffffffffffffff when no memory is available
+static uint64_t cache_slab_alloc(struct uwsgi_cache *uc, uint64_t len) {
+	uint64_t cls = cache_slab_class(uc, len);
+	uint64_t i;
+	if (uc->slabs->classes[cls].partial || !cache_slab_new_page(uc, cls)) {
+		return cache_slab_take(uc, cls);
+	}
+	// no more pages, instead of failing use a chunk of a bigger class
+	for (i = cls + 1; i < uc->slabs->nclasses; i++) {
+		if (uc->slabs->classes[i].partial) {
+			return cache_slab_take(uc, i);
+		}
+	}
+	return 0xffffffffffffffffLLU;
+}
+
+static void cache_slab_free(struct uwsgi_cache *uc, uint64_t first_block) {
+	uint64_t offset = first_block * uc->blocksize;
+	uint64_t pidx = offset / uc->slab_page_size;
+	struct uwsgi_cache_slab_page *page = &uc->slab_pages[pidx];
+	if (pidx >= uc->slab_npages || !page->class || !page->used) {
+		uwsgi_log("[uwsgi-cache] BUG: invalid slab chunk %llu in cache \"%s\"\n", (unsigned long long) first_block, uc->name);
+		return;
+	}
+	uint64_t cls = page->class - 1;
+	struct uwsgi_cache_slab_class *ucsc = &uc->slabs->classes[cls];
+	uint64_t chunk = (offset - (pidx * uc->slab_page_size)) / ucsc->chunk_size;
+
+	if (page->used >= ucsc->chunks_per_page) {
+		cache_slab_partial_add(uc, ucsc, pidx);
+	}
+	memcpy(((char *) uc->data) + offset, &page->free, sizeof(uint32_t));
+	page->free = chunk + 1;
+	page->used--;
+	ucsc->chunks--;
+
+	// release the page
+	if (!page->used) {
+		cache_slab_partial_remove(uc, ucsc, pidx);
+		page->class = 0;
+		page->next = uc->slabs->free_pages;
+		uc->slabs->free_pages = pidx + 1;
+		ucsc->pages--;
+	}
+}
+
+// can the chunk hold the new value (without wasting a bigger class) ?
+static int cache_slab_fits(struct uwsgi_cache *uc, uint64_t first_block, uint64_t len) {
+	uint64_t pidx = (first_block * uc->blocksize) / uc->slab_page_size;
+	return uc->slab_pages[pidx].class == cache_slab_class(uc, len) + 1;
+}
+
 static void cache_send_udp_command(struct uwsgi_cache *, char *, uint16_t, char *, uint16_t, uint64_t, uint8_t);
+static void cache_replog_add(struct uwsgi_cache *, char *, uint16_t);
+static void cache_replog_init(struct uwsgi_cache *);
 
 static void cache_sync_hook(char *k, uint16_t kl, char *v, uint16_t vl, void *data) {
 	struct uwsgi_cache *uc = (struct uwsgi_cache *) data;
@@ -258,14 +610,15 @@ static void uwsgi_cache_add_items(struct uwsgi_cache *uc) {
 		key_len = value - key;
 		value++;
 		uint64_t len = (usl->value + usl->len) - value;
-		uwsgi_wlock(uc->lock);
-		if (!uwsgi_cache_set2(uc, key, key_len, value, len, 0, 0)) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, key_len);
+		uwsgi_wlock(ucs->lock);
+		if (!uwsgi_cache_set2(ucs, key, key_len, value, len, 0, 0)) {
 			uwsgi_log("[cache] stored \"%.*s\" in \"%s\"\n", key_len, key, uc->name);
 		}
 		else {
 			uwsgi_log("[cache-error] unable to store \"%.*s\" in \"%s\"\n", key_len, key, uc->name);
 		}
-		uwsgi_rwunlock(uc->lock);
+		uwsgi_rwunlock(ucs->lock);
 next:
 		usl = usl->next;
 	}
@@ -290,14 +643,15 @@ static void uwsgi_cache_load_files(struct uwsgi_cache *uc) {
 		}
 		value = uwsgi_open_and_read(key, &len, 0, NULL);
 		if (value) {
-			uwsgi_wlock(uc->lock);
-			if (!uwsgi_cache_set2(uc, key, key_len, value, len, 0, 0)) {
+			struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, key_len);
+			uwsgi_wlock(ucs->lock);
+			if (!uwsgi_cache_set2(ucs, key, key_len, value, len, 0, 0)) {
 				uwsgi_log("[cache] stored \"%.*s\" in \"%s\"\n", key_len, key, uc->name);
 			}		
 			else {
 				uwsgi_log("[cache-error] unable to store \"%.*s\" in \"%s\"\n", key_len, key, uc->name);
 			}
-			uwsgi_rwunlock(uc->lock);
+			uwsgi_rwunlock(ucs->lock);
 			free(value);
 		}
 		else {
@@ -327,11 +681,12 @@ next:
                 if (value) {
 			struct uwsgi_buffer *gzipped = uwsgi_gzip(value, len);
 			if (gzipped) {
-                        	uwsgi_wlock(uc->lock);
-                        	if (!uwsgi_cache_set2(uc, key, key_len, gzipped->buf, gzipped->len, 0, 0)) {
+				struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, key_len);
+                        	uwsgi_wlock(ucs->lock);
+                        	if (!uwsgi_cache_set2(ucs, key, key_len, gzipped->buf, gzipped->len, 0, 0)) {
                                 	uwsgi_log("[cache-gzip] stored \"%.*s\" in \"%s\"\n", key_len, key, uc->name);
                         	}
-                        	uwsgi_rwunlock(uc->lock);
+                        	uwsgi_rwunlock(ucs->lock);
 				uwsgi_buffer_destroy(gzipped);
 			}
                         free(value);
@@ -344,12 +699,136 @@ next2:
 
 
 
-void uwsgi_cache_init(struct uwsgi_cache *uc) {
+/*
+	store consistency
+
+	the pages of the store modified by set/del operations are tracked, so the periodic sync (run by a master
+	thread, without holding the cache lock) only flushes them. The header (the last page of the store) is
+	flushed as dirty at startup and marked clean again only by the flush on shutdown/reload, so the writers
+	never wait for the disk. A store found dirty (or with an invalid header) at startup is repaired (invalid
+	items are dropped and the index rebuilt).
+*/
+
+static uint32_t cache_store_checksum(struct uwsgi_cache_store_header *ucsh) {
+	struct uwsgi_hash_algo *uha = uwsgi_hash_algo_get("crc32c");
+	return uha->func((char *) ucsh, offsetof(struct uwsgi_cache_store_header, checksum));
+}
+
+static uint64_t cache_store_layout(struct uwsgi_cache *uc) {
+	uint64_t geometry[] = {
+		uc->max_items, uc->blocks, uc->blocksize, uc->keysize, sizeof(struct uwsgi_cache_item),
+		uc->use_blocks_bitmap, uc->use_slabs, uc->slab_page_size, uc->slab_npages, uc->compact,
+	};
+	struct uwsgi_hash_algo *uha = uwsgi_hash_algo_get("crc32c");
+	return uha->func((char *) geometry, sizeof(geometry));
+}
+
+// only writes after the shutdown flush get here with a clean header
+static void cache_store_begin(struct uwsgi_cache *uc) {
+	struct uwsgi_cache_store_header *ucsh = uc->store_header;
+	if (!ucsh || ucsh->dirty) return;
+	ucsh->dirty = 1;
+	ucsh->checksum = cache_store_checksum(ucsh);
+	if (msync(ucsh, uwsgi.page_size, MS_SYNC)) {
+		uwsgi_error("cache_store_begin()/msync()");
+	}
+}
+
+// mark the pages after the changes (the sync clears the marks before flushing)
+static void cache_store_dirty(struct uwsgi_cache *uc, void *ptr, uint64_t len) {
+	if (!uc->dirty_pages || !len) return;
+	uint64_t offset = (char *) ptr - (char *) uc->items;
+	uint64_t page = offset / uwsgi.page_size;
+	uint64_t last = (offset + len - 1) / uwsgi.page_size;
+	for (; page <= last && page < uc->dirty_npages; page++) {
+		uc->dirty_pages[page] = 1;
+	}
+	uc->store_writes++;
+}
+
+static void cache_store_dirty_item(struct uwsgi_cache *uc, uint64_t index) {
+	if (!index) return;
+	cache_store_dirty(uc, cache_item(index), sizeof(struct uwsgi_cache_item) + uc->keysize);
+}
 
-	uc->hashtable = uwsgi_calloc_shared(sizeof(uint64_t) * uc->hashsize);
+static void cache_store_dirty_value(struct uwsgi_cache *uc, struct uwsgi_cache_item *uci) {
+	cache_store_dirty(uc, ((char *) uc->data) + (uci->first_block * uc->blocksize), uci->valsize);
+	if (uc->slabs) {
+		cache_store_dirty(uc, uc->slabs, cache_slabs_size(uc));
+	}
+}
+
+static void cache_store_sync(struct uwsgi_cache *uc, int mark_clean) {
+	if (!uc->store_header || !uc->store_header->dirty) return;
+
+	uint64_t writes = uc->store_writes;
+	uint64_t page = 0;
+	while (page < uc->dirty_npages) {
+		if (!uc->dirty_pages[page] || !__sync_lock_test_and_set(&uc->dirty_pages[page], 0)) {
+			page++;
+			continue;
+		}
+		// flush contiguous ranges with a single call
+		uint64_t first = page++;
+		while (page < uc->dirty_npages && uc->dirty_pages[page] && __sync_lock_test_and_set(&uc->dirty_pages[page], 0)) page++;
+		if (msync(((char *) uc->items) + (first * uwsgi.page_size), (page - first) * uwsgi.page_size, MS_SYNC)) {
+			uwsgi_error("cache_store_sync()/msync()");
+			return;
+		}
+	}
+
+	if (!mark_clean) return;
+
+	// writers hold the lock while changing the store, no change is in progress here
+	int clean = 0;
+	uwsgi_wlock(uc->lock);
+	if (uc->store_writes == writes) {
+		uc->store_header->dirty = 0;
+		uc->store_header->generation++;
+		uc->store_header->checksum = cache_store_checksum(uc->store_header);
+		clean = 1;
+	}
+	uwsgi_rwunlock(uc->lock);
+
+	if (clean && msync(uc->store_header, uwsgi.page_size, MS_SYNC)) {
+		uwsgi_error("cache_store_sync()/msync()");
+	}
+}
+
+static void cache_fix(struct uwsgi_cache *, int);
+
+static void cache_init_storage(struct uwsgi_cache *uc) {
+
+	if (uc->compact) {
+		// keep the index load factor around 0.7
+		uc->nbuckets = (uc->max_items / 5) + 1;
+		uc->buckets = uwsgi_calloc_shared(sizeof(struct uwsgi_cache_bucket) * uc->nbuckets);
+	}
+	else {
+		uc->hashtable = uwsgi_calloc_shared(sizeof(uint64_t) * uc->hashsize);
+	}
+	if (uc->optimistic) {
+		uc->seqs = uwsgi_calloc_shared(sizeof(uint32_t) * uc->hashsize);
+	}
+	if (uc->purge_policy == UWSGI_CACHE_POLICY_CLOCK) {
+		uc->clock_refs = uwsgi_calloc_shared(sizeof(uint8_t) * uc->max_items);
+	}
+	else if (uc->purge_policy == UWSGI_CACHE_POLICY_SAMPLED) {
+		uc->access_ticks = uwsgi_calloc_shared(sizeof(uint32_t) * uc->max_items);
+		uc->random_state = (uint64_t) uwsgi_micros() | 1;
+	}
+	if (uc->tinylfu) {
+		uc->sketch_width = 64;
+		while (uc->sketch_width < uc->max_items) uc->sketch_width <<= 1;
+		uc->sketch = uwsgi_calloc_shared(uc->sketch_width * 4);
+	}
 	uc->unused_blocks_stack = uwsgi_calloc_shared(sizeof(uint64_t) * uc->max_items);
 	uc->unused_blocks_stack_ptr = 0;
 	uc->filesize = ( (sizeof(struct uwsgi_cache_item)+uc->keysize) * uc->max_items) + (uc->blocksize * uc->blocks);
+	if (uc->use_slabs) {
+		cache_slabs_configure(uc);
+		uc->filesize = cache_slabs_offset(uc) + cache_slabs_size(uc);
+	}
 
 	uint64_t i;
 	for (i = 1; i < uc->max_items; i++) {
@@ -371,8 +850,14 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 	if (uc->store) {
 		int cache_fd;
 		struct stat cst;
+		int fresh = 0;
+		int repair = 0;
 
-        if (uc->store_delete && !stat(uc->store, &cst) && ((size_t) cst.st_size != uc->filesize || !S_ISREG(cst.st_mode))) {
+		// the header has its own page after the data
+		uint64_t header_offset = ((uc->filesize + uwsgi.page_size - 1) / uwsgi.page_size) * uwsgi.page_size;
+		size_t store_size = header_offset + uwsgi.page_size;
+
+        if (uc->store_delete && !stat(uc->store, &cst) && (((size_t) cst.st_size != store_size && (size_t) cst.st_size != uc->filesize) || !S_ISREG(cst.st_mode))) {
             uwsgi_log("Removing invalid cache store file: %s\n", uc->store);
             if (unlink(uc->store) != 0) {
                 uwsgi_log("Cannot remove invalid cache store file: %s\n", uc->store);
@@ -385,18 +870,28 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 			cache_fd = open(uc->store, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
 			if (cache_fd >= 0) {
 				// fill the caching store
-				if (ftruncate(cache_fd, uc->filesize)) {
+				if (ftruncate(cache_fd, store_size)) {
 					uwsgi_log("ftruncate()");
 					exit(1);
 				}
 			}
+			fresh = 1;
 		}
 		else {
-			if ((size_t) cst.st_size != uc->filesize || !S_ISREG(cst.st_mode)) {
+			if (((size_t) cst.st_size != store_size && (size_t) cst.st_size != uc->filesize) || !S_ISREG(cst.st_mode)) {
 				uwsgi_log("invalid cache store file. Please remove it or fix cache blocksize/items to match its size\n");
 				exit(1);
 			}
 			cache_fd = open(uc->store, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+			// a store created by an older version, add the header
+			if (cache_fd >= 0 && (size_t) cst.st_size == uc->filesize) {
+				uwsgi_log("adding the consistency header to cache store file %s\n", uc->store);
+				if (ftruncate(cache_fd, store_size)) {
+					uwsgi_log("ftruncate()");
+					exit(1);
+				}
+				repair = 1;
+			}
 			uwsgi_log("recovered cache from backing store file: %s\n", uc->store);
 		}
 
@@ -404,14 +899,45 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 			uwsgi_error_open(uc->store);
 			exit(1);
 		}
-		uc->items = (struct uwsgi_cache_item *) mmap(NULL, uc->filesize, PROT_READ | PROT_WRITE, MAP_SHARED, cache_fd, 0);
+		uc->items = (struct uwsgi_cache_item *) mmap(NULL, store_size, PROT_READ | PROT_WRITE, MAP_SHARED, cache_fd, 0);
 		if (uc->items == MAP_FAILED) {
 			uwsgi_error("uwsgi_cache_init()/mmap() [with store]");
 			exit(1);
 		}
-
-		uwsgi_cache_fix(uc);
 		close(cache_fd);
+
+		uc->store_header = (struct uwsgi_cache_store_header *) (((char *) uc->items) + header_offset);
+		uc->dirty_npages = header_offset / uwsgi.page_size;
+		uc->dirty_pages = uwsgi_calloc_shared(uc->dirty_npages);
+
+		struct uwsgi_cache_store_header *ucsh = uc->store_header;
+		if (!fresh && !repair) {
+			if (ucsh->magic != UWSGI_CACHE_STORE_MAGIC || ucsh->checksum != cache_store_checksum(ucsh)) {
+				uwsgi_log("invalid header in cache store file %s\n", uc->store);
+				repair = 1;
+			}
+			else if (ucsh->layout != cache_store_layout(uc)) {
+				uwsgi_log("cache store file %s has been created with a different configuration\n", uc->store);
+				repair = 1;
+			}
+			else if (ucsh->dirty) {
+				uwsgi_log("cache store file %s has not been cleanly synced (generation %llu)\n", uc->store, (unsigned long long) ucsh->generation);
+				repair = 1;
+			}
+		}
+
+		if (repair && uc->use_slabs) {
+			// the slab metadata cannot be trusted, start from scratch
+			uwsgi_log("dropping the content of cache store file %s\n", uc->store);
+			memset(uc->items, 0, header_offset);
+		}
+
+		if (fresh || repair) {
+			memset(ucsh, 0, sizeof(struct uwsgi_cache_store_header));
+			ucsh->magic = UWSGI_CACHE_STORE_MAGIC;
+			ucsh->layout = cache_store_layout(uc);
+			ucsh->dirty = 1;
+		}
 	}
 	else {
 		uc->items = (struct uwsgi_cache_item *) mmap(NULL, uc->filesize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0);
@@ -428,6 +954,26 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 
 	uc->data = ((char *)uc->items) + ((sizeof(struct uwsgi_cache_item)+uc->keysize) * uc->max_items);
 
+	if (uc->use_slabs) {
+		cache_slabs_init(uc);
+	}
+
+	if (uc->store) {
+		cache_fix(uc, uc->store_header->dirty);
+		// the repaired (or new) store is flushed as a whole
+		if (uc->store_header->dirty) {
+			if (msync(uc->items, uc->dirty_npages * uwsgi.page_size, MS_SYNC)) {
+				uwsgi_error("uwsgi_cache_init()/msync()");
+			}
+		}
+		// dirty until the shutdown flush
+		uc->store_header->dirty = 1;
+		uc->store_header->checksum = cache_store_checksum(uc->store_header);
+		if (msync(uc->store_header, uwsgi.page_size, MS_SYNC)) {
+			uwsgi_error("uwsgi_cache_init()/msync()");
+		}
+	}
+
 	if (uc->name) {
 		// can't free that until shutdown
 		char *lock_name = uwsgi_concat2("cache_", uc->name);
@@ -443,6 +989,70 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 			(unsigned long long) sizeof(struct uwsgi_cache_item)+uc->keysize,
 			(unsigned long long) ((sizeof(struct uwsgi_cache_item)+uc->keysize) * uc->max_items), (unsigned long long) (uc->blocksize * uc->blocks),
 			(unsigned long long) uc->blocks_bitmap_size);
+	if (uc->slabs) {
+		uwsgi_log("*** Cache \"%s\" slabs: %llu pages of %llu bytes, %llu classes (from %llu to %llu bytes) ***\n",
+			uc->name, (unsigned long long) uc->slab_npages, (unsigned long long) uc->slab_page_size,
+			(unsigned long long) uc->slabs->nclasses, (unsigned long long) uc->slabs->classes[0].chunk_size,
+			(unsigned long long) uc->slabs->classes[uc->slabs->nclasses-1].chunk_size);
+	}
+}
+
+static void cache_init_shards(struct uwsgi_cache *uc) {
+	uint64_t i;
+	uc->shard_caches = uwsgi_calloc_shared(sizeof(struct uwsgi_cache) * uc->shards);
+	for (i = 0; i < uc->shards; i++) {
+		struct uwsgi_cache *ucs = &uc->shard_caches[i];
+		memcpy(ucs, uc, sizeof(struct uwsgi_cache));
+		ucs->shards = 0;
+		ucs->shard_caches = NULL;
+		ucs->next = NULL;
+		ucs->sync_nodes = NULL;
+		ucs->udp_servers = NULL;
+		char *num = uwsgi_num2str(i);
+		// the shard name is used for the lock name too
+		ucs->name = uwsgi_concat3(uc->name, "#", num);
+		ucs->name_len = strlen(ucs->name);
+		if (uc->store) {
+			ucs->store = uwsgi_concat3(uc->store, ".", num);
+		}
+		free(num);
+		// slot 0 is reserved in each shard
+		ucs->max_items = (uc->max_items / uc->shards) + 1;
+		if (uc->use_blocks_bitmap) {
+			ucs->blocks = (uc->blocks / uc->shards) + 1;
+			ucs->max_item_size = ucs->blocksize * ucs->blocks;
+		}
+		else if (uc->use_slabs) {
+			ucs->blocks = (uc->blocks / uc->shards) + 1;
+			// the page size is computed by each shard (unless explicitly set)
+		}
+		else {
+			ucs->blocks = ucs->max_items;
+		}
+		ucs->hashsize = uc->hashsize / uc->shards;
+		if (!ucs->hashsize) ucs->hashsize = 1;
+		cache_init_storage(ucs);
+		if (ucs->use_slabs) uc->max_item_size = ucs->max_item_size;
+	}
+}
+
+void uwsgi_cache_init(struct uwsgi_cache *uc) {
+
+	// before the shards creation, so they share it
+	if (uc->replog_size) {
+		cache_replog_init(uc);
+	}
+
+	if (uc->shards) {
+		cache_init_shards(uc);
+		// the parent lock is only used for (rare) cache-wide operations
+		char *lock_name = uwsgi_concat2("cache_", uc->name);
+		uc->lock = uwsgi_rwlock_init(lock_name);
+		uwsgi_log("*** Cache \"%s\" split in %llu shards ***\n", uc->name, (unsigned long long) uc->shards);
+	}
+	else {
+		cache_init_storage(uc);
+	}
 
 	uwsgi_cache_setup_nodes(uc);
 
@@ -453,6 +1063,13 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 	}
 	uwsgi_socket_nb(uc->udp_node_socket);
 
+	if (uc->shards) {
+		uint64_t i;
+		for (i = 0; i < uc->shards; i++) {
+			uc->shard_caches[i].udp_node_socket = uc->udp_node_socket;
+		}
+	}
+
 	uwsgi_cache_sync_from_nodes(uc);
 
 	uwsgi_cache_load_files(uc);
@@ -461,7 +1078,121 @@ void uwsgi_cache_init(struct uwsgi_cache *uc) {
 
 }
 
+/*
+	optimistic reads
+
+	each hashtable slot has a sequence counter, writers (always holding the write lock)
+	make it odd before touching the chain (or the value of one of its items) and even again
+	when they have finished. Readers do not take the lock: they snapshot the counter,
+	copy the value and check the counter is still the same (otherwise they retry).
+
+	As del2() can be called by set2() (e.g. when the cache is full) the writer opening
+	the sequence is the one closing it.
+*/
+static int cache_seq_open(struct uwsgi_cache *uc, uint32_t hash) {
+	if (!uc->seqs) return 0;
+	uint32_t *seq = &uc->seqs[hash % uc->hashsize];
+	// already opened by the caller
+	if (*seq & 1) return 0;
+	__atomic_store_n(seq, *seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	return 1;
+}
+
+static void cache_seq_close(struct uwsgi_cache *uc, uint32_t hash, int opened) {
+	if (!opened) return;
+	uint32_t *seq = &uc->seqs[hash % uc->hashsize];
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(seq, *seq + 1, __ATOMIC_RELAXED);
+}
+
+/*
+	compact layout
+
+	instead of chaining items with the same hash (requiring a cacheline miss for every item in
+	the chain) we use an open-addressing index of 64 bytes buckets. Each bucket holds 7 entries
+	(an 8 bit tag, the 32 bit hash and the item slot), so most of the misses and hits are resolved
+	by a single cacheline, the item is accessed only for the final key comparison.
+
+	Full buckets overflow to the next one (linear probing), the overflow counter of the home
+	bucket (and of the ones traversed) tells lookups they need to continue probing.
+	A saturated (255) overflow counter is never decremented.
+*/
+static uint8_t cache_compact_tag(uint32_t hash) {
+	uint8_t tag = hash >> 24;
+	return tag ? tag : 1;
+}
+
+// this is safe for optimistic readers too, every value from the index is validated
+static uint64_t cache_compact_find(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint32_t hash) {
+	uint8_t tag = cache_compact_tag(hash);
+	uint64_t pos = hash % uc->nbuckets;
+	uint64_t probes;
+	for (probes = 0; probes < uc->nbuckets; probes++) {
+		struct uwsgi_cache_bucket *ucb = &uc->buckets[pos];
+		int i;
+		for (i = 0; i < UWSGI_CACHE_BUCKET_ENTRIES; i++) {
+			if (ucb->tags[i] != tag || ucb->hashes[i] != hash) continue;
+			uint64_t slot = ucb->slots[i];
+			if (!slot || slot >= uc->max_items) continue;
+			struct uwsgi_cache_item *uci = cache_item(slot);
+			if (uci->keysize == keylen && !memcmp(uci->key, key, keylen)) {
+				return slot;
+			}
+		}
+		if (!ucb->overflow) break;
+		pos = (pos + 1) % uc->nbuckets;
+	}
+	return 0;
+}
+
+static void cache_compact_add(struct uwsgi_cache *uc, uint32_t hash, uint64_t slot) {
+	uint64_t pos = hash % uc->nbuckets;
+	uint64_t probes;
+	for (probes = 0; probes < uc->nbuckets; probes++) {
+		struct uwsgi_cache_bucket *ucb = &uc->buckets[pos];
+		int i;
+		for (i = 0; i < UWSGI_CACHE_BUCKET_ENTRIES; i++) {
+			if (ucb->tags[i]) continue;
+			ucb->hashes[i] = hash;
+			ucb->slots[i] = slot;
+			// the tag is the last one to be set (optimistic readers check it first)
+			ucb->tags[i] = cache_compact_tag(hash);
+			return;
+		}
+		if (ucb->overflow < 0xff) ucb->overflow++;
+		pos = (pos + 1) % uc->nbuckets;
+	}
+	// this should never happen, the index is always bigger than max_items
+	uwsgi_log("[uwsgi-cache] BUG: no free entry in the compact index of cache \"%s\"\n", uc->name);
+}
+
+static void cache_compact_remove(struct uwsgi_cache *uc, uint32_t hash, uint64_t slot) {
+	uint64_t pos = hash % uc->nbuckets;
+	uint64_t probes;
+	for (probes = 0; probes < uc->nbuckets; probes++) {
+		struct uwsgi_cache_bucket *ucb = &uc->buckets[pos];
+		int i;
+		for (i = 0; i < UWSGI_CACHE_BUCKET_ENTRIES; i++) {
+			if (ucb->tags[i] && ucb->slots[i] == slot) {
+				ucb->tags[i] = 0;
+				ucb->hashes[i] = 0;
+				ucb->slots[i] = 0;
+				// fix the overflow counters of the traversed buckets
+				uint64_t home = hash % uc->nbuckets;
+				while (home != pos) {
+					if (uc->buckets[home].overflow < 0xff) uc->buckets[home].overflow--;
+					home = (home + 1) % uc->nbuckets;
+				}
+				return;
+			}
+		}
+		pos = (pos + 1) % uc->nbuckets;
+	}
+}
+
 static uint64_t check_lazy(struct uwsgi_cache *uc, struct uwsgi_cache_item *uci, uint64_t slot) {
+	if (uc->purge_policy) cache_policy_touch(uc, slot);
 	if (!uci->expires || !uc->lazy_expire) return slot;
 	uint64_t now = (uint64_t) uwsgi_now();
 	// expired ?
@@ -475,6 +1206,15 @@ static uint64_t check_lazy(struct uwsgi_cache *uc, struct uwsgi_cache_item *uci,
 static uint64_t uwsgi_cache_get_index(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
 
 	uint32_t hash = uc->hash->func(key, keylen);
+
+	cache_sketch_add(uc, hash);
+
+	if (uc->buckets) {
+		uint64_t slot = cache_compact_find(uc, key, keylen, hash);
+		if (!slot) return 0;
+		return check_lazy(uc, cache_item(slot), slot);
+	}
+
 	uint32_t hash_key = hash % uc->hashsize;
 
 	uint64_t slot = uc->hashtable[hash_key];
@@ -548,6 +1288,9 @@ static void lru_remove_item(struct uwsgi_cache *uc, uint64_t index)
 		prev->lru_next = curr->lru_next;
 	} else
 		uc->lru_head = curr->lru_next;
+
+	cache_store_dirty_item(uc, curr->lru_prev);
+	cache_store_dirty_item(uc, curr->lru_next);
 }
 
 static void lru_add_item(struct uwsgi_cache *uc, uint64_t index)
@@ -563,15 +1306,22 @@ static void lru_add_item(struct uwsgi_cache *uc, uint64_t index)
 	curr->lru_next = 0;
 	curr->lru_prev = uc->lru_tail;
 	uc->lru_tail = index;
+
+	cache_store_dirty_item(uc, curr->lru_prev);
+	cache_store_dirty_item(uc, index);
 }
 
+/*
+	get2() and get4() return the stored bytes, compressed items cannot be used by their callers
+	(paths and addresses) so they are not returned (uwsgi_cache_get_copy() decompresses them)
+*/
 char *uwsgi_cache_get2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t * valsize) {
 
 	uint64_t index = uwsgi_cache_get_index(uc, key, keylen);
 
 	if (index) {
 		struct uwsgi_cache_item *uci = cache_item(index);
-		if (uci->flags & UWSGI_CACHE_FLAG_UNGETTABLE)
+		if (uci->flags & (UWSGI_CACHE_FLAG_UNGETTABLE|UWSGI_CACHE_FLAG_COMPRESSED))
 			return NULL;
 		*valsize = uci->valsize;
 		if (uc->purge_lru) {
@@ -588,14 +1338,163 @@ char *uwsgi_cache_get2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint6
 	return NULL;
 }
 
-int64_t uwsgi_cache_num2(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
+// lookup without locks, every value read from the shared memory must be validated
+static uint64_t cache_get_index_optimistic(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint32_t hash) {
+	uint64_t slot = __atomic_load_n(&uc->hashtable[hash % uc->hashsize], __ATOMIC_RELAXED);
+	uint64_t rounds = 0;
+	while (slot > 0 && slot < uc->max_items && rounds < uc->max_items) {
+		struct uwsgi_cache_item *uci = cache_item(slot);
+		if (uci->hash == hash && uci->keysize == keylen && !memcmp(uci->key, key, keylen)) {
+			return slot;
+		}
+		slot = uci->next;
+		rounds++;
+	}
+	return 0;
+}
 
-        uint64_t index = uwsgi_cache_get_index(uc, key, keylen);
+/*
+	compression
 
-        if (index) {
-                struct uwsgi_cache_item *uci = cache_item(index);
-		if (uci->flags & UWSGI_CACHE_FLAG_UNGETTABLE)
-                        return 0;
+	with compress=gzip the values bigger than compress_threshold are stored as gzip members (when smaller
+	than the original) and flagged with UWSGI_CACHE_FLAG_COMPRESSED. The copies returned by the api are
+	transparently decompressed, while the routers can send them as-is to the clients accepting gzip.
+*/
+#ifdef UWSGI_ZLIB
+static struct uwsgi_buffer *cache_compress(struct uwsgi_cache *uc, char *val, uint64_t vallen, uint64_t flags) {
+	if (!uc->compress || vallen < uc->compress_threshold || (flags & (UWSGI_CACHE_FLAG_MATH|UWSGI_CACHE_FLAG_COMPRESSED))) return NULL;
+	struct uwsgi_buffer *ub = uwsgi_gzip(val, vallen);
+	if (ub && ub->pos >= vallen) {
+		uwsgi_buffer_destroy(ub);
+		return NULL;
+	}
+	return ub;
+}
+
+#endif
+
+// compress before locking the cache (pass UWSGI_CACHE_FLAG_COMPRESSED to uwsgi_cache_set2() when a buffer is returned),
+// the udp nodes (without a replication log) need the plain value
+struct uwsgi_buffer *uwsgi_cache_precompress(struct uwsgi_cache *uc, char *val, uint64_t vallen, uint64_t flags) {
+#ifdef UWSGI_ZLIB
+	if (uc->nodes && !uc->replog) return NULL;
+	return cache_compress(uc, val, vallen, flags);
+#else
+	return NULL;
+#endif
+}
+
+// replace a compressed copy of a value with the plain one
+static void cache_decompress(char **value, uint64_t *vallen) {
+#ifdef UWSGI_ZLIB
+	struct uwsgi_buffer *ub = uwsgi_gunzip(*value, *vallen);
+	if (ub) {
+		free(*value);
+		*value = ub->buf;
+		*vallen = ub->pos;
+		ub->buf = NULL;
+		uwsgi_buffer_destroy(ub);
+		return;
+	}
+#endif
+	uwsgi_log("[uwsgi-cache] unable to decompress value\n");
+	free(*value);
+	*value = NULL;
+	*vallen = 0;
+}
+
+/*
+	get a copy of a value without locking the cache.
+
+	returns 0 on success (*value is NULL if the item does not exist, otherwise you have to free it)
+	and -1 when the locked path must be used (optimistic reads not enabled, value too big
+	or too much contention)
+*/
+static int cache_get_optimistic(struct uwsgi_cache *uc, char *key, uint16_t keylen, char **value, uint64_t *vallen, uint64_t *expires, uint64_t *flags) {
+	int retries;
+	char *buf = NULL;
+	uint64_t buf_size = 0;
+
+	// lru caches update the list on every get
+	if (!uc->seqs || uc->purge_lru) return -1;
+
+	uint32_t hash = uc->hash->func(key, keylen);
+	uint32_t *seq = &uc->seqs[hash % uc->hashsize];
+
+	cache_sketch_add(uc, hash);
+
+	for (retries = 0; retries < 8; retries++) {
+		uint32_t seq_start = __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+		// a writer is modifying the chain
+		if (seq_start & 1) continue;
+		uint64_t index = uc->buckets ? cache_compact_find(uc, key, keylen, hash) : cache_get_index_optimistic(uc, key, keylen, hash);
+		if (!index) {
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if (__atomic_load_n(seq, __ATOMIC_RELAXED) != seq_start) continue;
+			free(buf);
+			__atomic_fetch_add(&uc->miss, 1, __ATOMIC_RELAXED);
+			*value = NULL;
+			return 0;
+		}
+		struct uwsgi_cache_item *uci = cache_item(index);
+		uint64_t item_flags = uci->flags;
+		uint64_t item_size = uci->valsize;
+		uint64_t item_expires = uci->expires;
+		uint64_t first_block = uci->first_block;
+		if (item_size > uc->optimistic_max_size) {
+			free(buf);
+			return -1;
+		}
+		// inconsistent values, we are racing with a writer
+		if (first_block >= uc->blocks || (first_block * uc->blocksize) + item_size > uc->blocks * uc->blocksize) continue;
+		if (item_size > buf_size) {
+			free(buf);
+			buf = uwsgi_malloc(item_size);
+			buf_size = item_size;
+		}
+		memcpy(buf, uc->data + (first_block * uc->blocksize), item_size);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(seq, __ATOMIC_RELAXED) != seq_start) continue;
+
+		if ((item_flags & UWSGI_CACHE_FLAG_UNGETTABLE) || (uc->lazy_expire && item_expires && item_expires <= (uint64_t) uwsgi_now())) {
+			free(buf);
+			__atomic_fetch_add(&uc->miss, 1, __ATOMIC_RELAXED);
+			*value = NULL;
+			return 0;
+		}
+
+		if (uc->purge_policy) cache_policy_touch(uc, index);
+		__atomic_fetch_add(&uci->hits, 1, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&uc->hits, 1, __ATOMIC_RELAXED);
+		*value = buf;
+		*vallen = item_size;
+		if (expires) *expires = item_expires;
+		*flags = item_flags;
+		return 0;
+	}
+
+	free(buf);
+	__atomic_fetch_add(&uc->optimistic_retries, 1, __ATOMIC_RELAXED);
+	return -1;
+}
+
+int uwsgi_cache_get_optimistic(struct uwsgi_cache *uc, char *key, uint16_t keylen, char **value, uint64_t *vallen, uint64_t *expires) {
+	uint64_t flags = 0;
+	if (cache_get_optimistic(uc, key, keylen, value, vallen, expires, &flags)) return -1;
+	if (*value && (flags & UWSGI_CACHE_FLAG_COMPRESSED)) {
+		cache_decompress(value, vallen);
+	}
+	return 0;
+}
+
+int64_t uwsgi_cache_num2(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
+
+        uint64_t index = uwsgi_cache_get_index(uc, key, keylen);
+
+        if (index) {
+                struct uwsgi_cache_item *uci = cache_item(index);
+		if (uci->flags & UWSGI_CACHE_FLAG_UNGETTABLE)
+                        return 0;
                 uci->hits++;
                 uc->hits++;
 		int64_t *num = (int64_t *) (uc->data + (uci->first_block * uc->blocksize));
@@ -606,7 +1505,7 @@ int64_t uwsgi_cache_num2(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
 	return 0;
 }
 
-char *uwsgi_cache_get3(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t * valsize, uint64_t *expires) {
+static char *cache_get_value(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t * valsize, uint64_t *expires, uint64_t *flags) {
 
         uint64_t index = uwsgi_cache_get_index(uc, key, keylen);
 
@@ -617,6 +1516,8 @@ char *uwsgi_cache_get3(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint6
                 *valsize = uci->valsize;
 		if (expires)
 			*expires = uci->expires;
+		if (flags)
+			*flags = uci->flags;
 		if (uc->purge_lru) {
 			lru_remove_item(uc, index);
 			lru_add_item(uc, index);
@@ -631,13 +1532,48 @@ char *uwsgi_cache_get3(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint6
         return NULL;
 }
 
+// the value as stored (compressed values are not decompressed)
+char *uwsgi_cache_get3(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t * valsize, uint64_t *expires) {
+	return cache_get_value(uc, key, keylen, valsize, expires, NULL);
+}
+
+/*
+	get a copy of a value (to be freed) from the right shard of a cache, taking the lock only when needed.
+
+	compressed values are decompressed, unless the caller is able to manage them (compressed is not NULL
+	and set to 1), on return *compressed reports if the copy is compressed
+*/
+char *uwsgi_cache_get_copy(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t *vallen, uint64_t *expires, int *compressed) {
+	struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+	char *buf = NULL;
+	uint64_t flags = 0;
+	if (cache_get_optimistic(ucs, key, keylen, &buf, vallen, expires, &flags)) {
+		if (ucs->purge_lru)
+			uwsgi_wlock(ucs->lock);
+		else
+			uwsgi_rlock(ucs->lock);
+		char *value = cache_get_value(ucs, key, keylen, vallen, expires, &flags);
+		if (value) {
+			buf = uwsgi_malloc(*vallen);
+			memcpy(buf, value, *vallen);
+		}
+		uwsgi_rwunlock(ucs->lock);
+	}
+	if (buf && (flags & UWSGI_CACHE_FLAG_COMPRESSED) && !(compressed && *compressed)) {
+		cache_decompress(&buf, vallen);
+		flags ^= UWSGI_CACHE_FLAG_COMPRESSED;
+	}
+	if (compressed) *compressed = buf && (flags & UWSGI_CACHE_FLAG_COMPRESSED);
+	return buf;
+}
+
 char *uwsgi_cache_get4(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_t * valsize, uint64_t *hits) {
 
         uint64_t index = uwsgi_cache_get_index(uc, key, keylen);
 
         if (index) {
                 struct uwsgi_cache_item *uci = cache_item(index);
-                if (uci->flags & UWSGI_CACHE_FLAG_UNGETTABLE)
+                if (uci->flags & (UWSGI_CACHE_FLAG_UNGETTABLE|UWSGI_CACHE_FLAG_COMPRESSED))
                         return NULL;
                 *valsize = uci->valsize;
                 if (hits)
@@ -663,15 +1599,24 @@ int uwsgi_cache_del2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_
 
 	if (index) {
 		uci = cache_item(index);
+		uint32_t hash = uci->hash;
+		// keep the links to mark the changed pages of the store
+		struct uwsgi_cache_item removed = *uci;
+		cache_store_begin(uc);
+		int seq_opened = cache_seq_open(uc, hash);
 		if (uci->keysize > 0) {
 			// unmark blocks
 			if (uc->blocks_bitmap) cache_unmark_blocks(uc, uci->first_block, uci->valsize);
+			else if (uc->slabs) cache_slab_free(uc, uci->first_block);
 			// put back the block in unused stack
 			uc->unused_blocks_stack_ptr++;
 			uc->unused_blocks_stack[uc->unused_blocks_stack_ptr] = index;
 
+			if (uc->buckets) {
+				cache_compact_remove(uc, uci->hash, index);
+			}
 			// unlink prev and next (if any)
-			if (uci->prev) {
+			else if (uci->prev) {
                         	struct uwsgi_cache_item *ucii = cache_item(uci->prev);
                         	ucii->next = uci->next;
                 	}
@@ -680,12 +1625,12 @@ int uwsgi_cache_del2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_
                         	uc->hashtable[uci->hash % uc->hashsize] = uci->next;
                 	}
 
-                	if (uci->next) {
+                	if (!uc->buckets && uci->next) {
                         	struct uwsgi_cache_item *ucii = cache_item(uci->next);
                         	ucii->prev = uci->prev;
                 	}
 
-                	if (!uci->prev && !uci->next) {
+                	if (!uc->buckets && !uci->prev && !uci->next) {
                         	// reset hashtable entry
                         	uc->hashtable[uci->hash % uc->hashsize] = 0;
                 	}
@@ -693,6 +1638,7 @@ int uwsgi_cache_del2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_
 			if (uc->purge_lru)
 				lru_remove_item(uc, index);
 
+			if (uci->flags & UWSGI_CACHE_FLAG_COMPRESSED) uc->compressed_items--;
 			uc->n_items--;
 		}
 
@@ -705,43 +1651,109 @@ int uwsgi_cache_del2(struct uwsgi_cache *uc, char *key, uint16_t keylen, uint64_
 		uci->next = 0;
 		uci->expires = 0;
 
+		cache_store_dirty_item(uc, index);
+		cache_store_dirty_item(uc, removed.prev);
+		cache_store_dirty_item(uc, removed.next);
+		if (uc->slabs && removed.keysize) {
+			cache_store_dirty_value(uc, &removed);
+		}
+
+		cache_seq_close(uc, hash, seq_opened);
+
 		if (uc->use_last_modified) {
 			uc->last_modified_at = uwsgi_now();
 		}
 	}
 
-	if (uc->nodes && ret == 0 && !(flags & UWSGI_CACHE_FLAG_LOCAL)) {
-                cache_send_udp_command(uc, key, keylen, NULL, 0, 0, 11);
+	if (ret == 0 && !(flags & UWSGI_CACHE_FLAG_LOCAL)) {
+		if (uc->replog) {
+			cache_replog_add(uc, key, keylen);
+		}
+		else if (uc->nodes) {
+                	cache_send_udp_command(uc, key, keylen, NULL, 0, 0, 11);
+		}
         }
 
 	return ret;
 }
 
-void uwsgi_cache_fix(struct uwsgi_cache *uc) {
+// check an item recovered from a torn store
+static int cache_item_is_valid(struct uwsgi_cache *uc, uint64_t index) {
+	struct uwsgi_cache_item *uci = cache_item(index);
+	if (uci->keysize > uc->keysize) return 0;
+	if (!uci->valsize || uci->valsize > uc->max_item_size) return 0;
+	if (uci->hash != uc->hash->func(uci->key, uci->keysize)) return 0;
+	if (uc->use_blocks_bitmap || uc->slabs) {
+		if (uci->first_block >= uc->blocks) return 0;
+		if ((uci->first_block * uc->blocksize) + uci->valsize > uc->blocks * uc->blocksize) return 0;
+	}
+	else if (uci->first_block != index) return 0;
+	// the index already contains the key
+	if (uwsgi_cache_get_index(uc, uci->key, uci->keysize)) return 0;
+	return 1;
+}
+
+static void cache_fix(struct uwsgi_cache *uc, int repair) {
 
 	uint64_t i;
 	unsigned long long restored = 0;
+	unsigned long long dropped = 0;
+	uint64_t compressed = 0;
 	uint64_t next_scan = 0;
 
 	// reset unused blocks
 	uc->unused_blocks_stack_ptr = 0;
 
+	if (repair) {
+		uc->lru_head = 0;
+		uc->lru_tail = 0;
+	}
+
 	for (i = 1; i < uc->max_items; i++) {
 		// valid record ?
 		struct uwsgi_cache_item *uci = cache_item(i);
+		if (uci->keysize && repair && !cache_item_is_valid(uc, i)) {
+			memset(uci, 0, sizeof(struct uwsgi_cache_item));
+			dropped++;
+		}
 		if (uci->keysize) {
-			if (!uci->prev) {
+			if (uc->buckets) {
+				cache_compact_add(uc, uci->hash, i);
+			}
+			else if (repair) {
+				// rebuild the collision chain
+				uint64_t *slot = &uc->hashtable[uci->hash % uc->hashsize];
+				uci->prev = 0;
+				uci->next = *slot;
+				if (*slot) {
+					struct uwsgi_cache_item *head = cache_item(*slot);
+					head->prev = i;
+				}
+				*slot = i;
+			}
+			else if (!uci->prev) {
 				// put value in hash_table
 				uc->hashtable[uci->hash % uc->hashsize] = i;
 			}
+			if (uc->use_blocks_bitmap) {
+				cache_mark_blocks(uc, uci->first_block, uci->valsize);
+			}
+			if (uci->flags & UWSGI_CACHE_FLAG_COMPRESSED) {
+				compressed++;
+			}
 			if (uci->expires && (!next_scan || next_scan > uci->expires)) {
 				next_scan = uci->expires;
 			}
-			if (!uc->lru_head && !uci->lru_prev) {
-				uc->lru_head = i;
+			if (repair) {
+				if (uc->purge_lru) lru_add_item(uc, i);
 			}
-			if (!uc->lru_tail && !uci->lru_next) {
-				uc->lru_tail = i;
+			else {
+				if (!uc->lru_head && !uci->lru_prev) {
+					uc->lru_head = i;
+				}
+				if (!uc->lru_tail && !uci->lru_next) {
+					uc->lru_tail = i;
+				}
 			}
 			restored++;
 		}
@@ -754,9 +1766,17 @@ void uwsgi_cache_fix(struct uwsgi_cache *uc) {
 
 	uc->next_scan = next_scan;
 	uc->n_items = restored;
+	uc->compressed_items = compressed;
+	if (dropped) {
+		uwsgi_log("[uwsgi-cache] dropped %llu invalid items\n", dropped);
+	}
 	uwsgi_log("[uwsgi-cache] restored %llu items\n", uc->n_items);
 }
 
+void uwsgi_cache_fix(struct uwsgi_cache *uc) {
+	cache_fix(uc, 0);
+}
+
 int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *val, uint64_t vallen, uint64_t expires, uint64_t flags) {
 
 	uint64_t index = 0, last_index = 0;
@@ -767,6 +1787,11 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 
 	int ret = -1;
 	time_t now = 0;
+	int seq_opened = 0;
+	uint32_t hash;
+	// the udp nodes receive the plain value
+	char *plain = val;
+	uint64_t plain_len = vallen;
 
 	if (!keylen || !vallen)
 		return -1;
@@ -774,15 +1799,28 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 	if (keylen > uc->keysize)
 		return -1;
 
-	if (vallen > uc->max_item_size) return -1;
-
 	if ((flags & UWSGI_CACHE_FLAG_MATH) && vallen != 8) return -1;
 
+#ifdef UWSGI_ZLIB
+	// fallback for the callers not using uwsgi_cache_precompress() (the value is compressed under the lock)
+	struct uwsgi_buffer *gzipped = cache_compress(uc, val, vallen, flags);
+	if (gzipped) {
+		val = gzipped->buf;
+		vallen = gzipped->pos;
+		flags |= UWSGI_CACHE_FLAG_COMPRESSED;
+	}
+#endif
+
+	if (vallen > uc->max_item_size) goto done;
+
 	//uwsgi_log("putting cache data in key %.*s %d\n", keylen, key, vallen);
 	index = uwsgi_cache_get_index(uc, key, keylen);
+	hash = uc->hash->func(key, keylen);
+	cache_store_begin(uc);
+	seq_opened = cache_seq_open(uc, hash);
 	if (!index) {
 		if (!uc->unused_blocks_stack_ptr) {
-			cache_full(uc);
+			cache_full(uc, hash);
 			if (!uc->unused_blocks_stack_ptr)
 				goto end;
 		}
@@ -791,14 +1829,29 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 		uc->unused_blocks_stack_ptr--;
 
 		uci = cache_item(index);
-		if (!uc->blocks_bitmap) {
+		if (uc->slabs) {
+			uint64_t first_block = cache_slab_alloc(uc, vallen);
+			if (first_block == 0xffffffffffffffffLLU) {
+				uc->unused_blocks_stack_ptr++;
+				cache_full(uc, hash);
+				// the purged items could have released a chunk
+				first_block = cache_slab_alloc(uc, vallen);
+				if (first_block == 0xffffffffffffffffLLU)
+					goto end;
+				index = uc->unused_blocks_stack[uc->unused_blocks_stack_ptr];
+				uc->unused_blocks_stack_ptr--;
+				uci = cache_item(index);
+			}
+			uci->first_block = first_block;
+		}
+		else if (!uc->blocks_bitmap) {
 			uci->first_block = index;
 		}
 		else {
 			uci->first_block = uwsgi_cache_find_free_blocks(uc, vallen);
 			if (uci->first_block == 0xffffffffffffffffLLU) {
 				uc->unused_blocks_stack_ptr++;
-				cache_full(uc);
+				cache_full(uc, hash);
                                 goto end;
 			}
 			// mark used blocks;
@@ -819,10 +1872,13 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 			if (!uc->next_scan || uc->next_scan > expires)
 				uc->next_scan = expires;
 		}
+		if (uc->purge_policy)
+			cache_policy_insert(uc, index);
 		uci->expires = expires;
-		uci->hash = uc->hash->func(key, keylen);
+		uci->hash = hash;
 		uci->hits = 0;
 		uci->flags = flags;
+		if (flags & UWSGI_CACHE_FLAG_COMPRESSED) uc->compressed_items++;
 		memcpy(uci->key, key, keylen);
 
 		if ( !(flags & UWSGI_CACHE_FLAG_MATH)) {
@@ -857,12 +1913,17 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 		uci->valsize = vallen;
 		uci->keysize = keylen;
 		ret = 0;
-		// now put the value in the hashtable
-		uint32_t slot = uci->hash % uc->hashsize;
 		// reset values
 		uci->prev = 0;
 		uci->next = 0;
 
+		// now put the value in the index
+		if (uc->buckets) {
+			cache_compact_add(uc, hash, index);
+			goto added;
+		}
+
+		uint32_t slot = uci->hash % uc->hashsize;
 		last_index = uc->hashtable[slot];
 		if (last_index == 0) {
 			uc->hashtable[slot] = index;
@@ -878,10 +1939,13 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 			uci->prev = last_index;
 		}
 
+added:
 		uc->n_items++ ;
 	}
 	else if (flags & UWSGI_CACHE_FLAG_UPDATE) {
 		uci = cache_item(index);
+		// math operations cannot be applied to compressed values
+		if ((flags & UWSGI_CACHE_FLAG_MATH) && (uci->flags & UWSGI_CACHE_FLAG_COMPRESSED)) goto end;
 		if (!(flags & UWSGI_CACHE_FLAG_FIXEXPIRE)) {
 			if (uc->purge_lru) {
 				lru_remove_item(uc, index);
@@ -894,13 +1958,28 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
 			}
 			uci->expires = expires;
 		}
-		if (uc->blocks_bitmap) {
+		if (uc->slabs && !cache_slab_fits(uc, uci->first_block, vallen)) {
+			uint64_t first_block = cache_slab_alloc(uc, vallen);
+			if (first_block == 0xffffffffffffffffLLU) {
+				cache_full(uc, hash);
+				// the purge could have chosen the item itself
+				if (uwsgi_cache_get_index(uc, key, keylen) != index)
+					goto end;
+				// the purged items could have released a chunk
+				first_block = cache_slab_alloc(uc, vallen);
+				if (first_block == 0xffffffffffffffffLLU)
+					goto end;
+			}
+			cache_slab_free(uc, uci->first_block);
+			uci->first_block = first_block;
+		}
+		else if (uc->blocks_bitmap) {
 			// we have a special case here, as we need to find a new series of free blocks
 			uint64_t old_first_block = uci->first_block;
 			uci->first_block = uwsgi_cache_find_free_blocks(uc, vallen);
                         if (uci->first_block == 0xffffffffffffffffLLU) {
 				uci->first_block = old_first_block;
-				cache_full(uc);
+				cache_full(uc, hash);
                                 goto end;
                         }
                         // mark used blocks;
@@ -940,24 +2019,247 @@ int uwsgi_cache_set2(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *v
                         }
 		}
 		uci->valsize = vallen;
+		if ((uci->flags ^ flags) & UWSGI_CACHE_FLAG_COMPRESSED) {
+			uci->flags ^= UWSGI_CACHE_FLAG_COMPRESSED;
+			if (flags & UWSGI_CACHE_FLAG_COMPRESSED) uc->compressed_items++;
+			else uc->compressed_items--;
+		}
 		ret = 0;
 	}
 
+	if (ret == 0) {
+		cache_store_dirty_item(uc, index);
+		cache_store_dirty_item(uc, uci->prev);
+		cache_store_dirty_value(uc, uci);
+	}
+
 	if (uc->use_last_modified) {
 		uc->last_modified_at = (now ? now : uwsgi_now());
 	}
 
-	if (uc->nodes && ret == 0 && !(flags & UWSGI_CACHE_FLAG_LOCAL)) {
-		cache_send_udp_command(uc, key, keylen, val, vallen, expires, 10);
+	if (ret == 0 && !(flags & UWSGI_CACHE_FLAG_LOCAL)) {
+		if (uc->replog) {
+			cache_replog_add(uc, key, keylen);
+		}
+		else if (uc->nodes) {
+			cache_send_udp_command(uc, key, keylen, plain, plain_len, expires, 10);
+		}
 	}
 
 
 end:
+	cache_seq_close(uc, hash, seq_opened);
+done:
+#ifdef UWSGI_ZLIB
+	if (gzipped) uwsgi_buffer_destroy(gzipped);
+#endif
 	return ret;
 
 }
 
 
+/*
+	batched operations
+
+	every partition holding at least one of the keys is locked only once.
+	Returned values (mget) are copies (you have to free them), the status of every item
+	is 0 on success, -1 on error (or item not found). The number of successful items is returned.
+*/
+
+static struct uwsgi_cache **cache_mitems_owners(struct uwsgi_cache *uc, struct uwsgi_cache_mitem *items, uint64_t n) {
+	uint64_t i;
+	struct uwsgi_cache **owners = uwsgi_malloc(sizeof(struct uwsgi_cache *) * (n ? n : 1));
+	for (i = 0; i < n; i++) {
+		items[i].status = -1;
+		owners[i] = uwsgi_cache_shard(uc, items[i].key, items[i].keylen);
+	}
+	return owners;
+}
+
+int uwsgi_cache_mget(struct uwsgi_cache *uc, struct uwsgi_cache_mitem *items, uint64_t n) {
+	uint64_t i, j;
+	int found = 0;
+	int need_decompression = 0;
+	struct uwsgi_cache **owners = cache_mitems_owners(uc, items, n);
+
+	for (i = 0; i < n; i++) {
+		items[i].value = NULL;
+		items[i].vallen = 0;
+		items[i].expires = 0;
+		// try without locking first
+		if (!uwsgi_cache_get_optimistic(owners[i], items[i].key, items[i].keylen, &items[i].value, &items[i].vallen, &items[i].expires)) {
+			if (items[i].value) {
+				items[i].status = 0;
+				found++;
+			}
+			owners[i] = NULL;
+		}
+	}
+
+	for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, j);
+		int locked = 0;
+		for (i = 0; i < n; i++) {
+			if (owners[i] != ucs) continue;
+			if (!locked) {
+				if (ucs->purge_lru)
+					uwsgi_wlock(ucs->lock);
+				else
+					uwsgi_rlock(ucs->lock);
+				locked = 1;
+			}
+			uint64_t vallen = 0, expires = 0, flags = 0;
+			char *value = cache_get_value(ucs, items[i].key, items[i].keylen, &vallen, &expires, &flags);
+			if (!value) continue;
+			items[i].value = uwsgi_malloc(vallen);
+			memcpy(items[i].value, value, vallen);
+			items[i].vallen = vallen;
+			items[i].expires = expires;
+			items[i].status = 0;
+			found++;
+			// decompressed after unlocking
+			if (flags & UWSGI_CACHE_FLAG_COMPRESSED) {
+				items[i].status = 1;
+				need_decompression = 1;
+			}
+		}
+		if (locked) uwsgi_rwunlock(ucs->lock);
+	}
+
+	for (i = 0; need_decompression && i < n; i++) {
+		if (items[i].status != 1) continue;
+		cache_decompress(&items[i].value, &items[i].vallen);
+		items[i].status = 0;
+		if (!items[i].value) {
+			items[i].status = -1;
+			found--;
+		}
+	}
+
+	free(owners);
+	return found;
+}
+
+int uwsgi_cache_mset(struct uwsgi_cache *uc, struct uwsgi_cache_mitem *items, uint64_t n, uint64_t flags) {
+	uint64_t i, j;
+	int stored = 0;
+	struct uwsgi_cache **owners = cache_mitems_owners(uc, items, n);
+#ifdef UWSGI_ZLIB
+	struct uwsgi_buffer **gzipped = NULL;
+	if (uc->compress) {
+		gzipped = uwsgi_calloc(sizeof(struct uwsgi_buffer *) * (n ? n : 1));
+		for (i = 0; i < n; i++) {
+			gzipped[i] = uwsgi_cache_precompress(owners[i], items[i].value, items[i].vallen, flags);
+		}
+	}
+#endif
+
+	for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, j);
+		int locked = 0;
+		for (i = 0; i < n; i++) {
+			if (owners[i] != ucs) continue;
+			if (!locked) {
+				uwsgi_wlock(ucs->lock);
+				locked = 1;
+			}
+#ifdef UWSGI_ZLIB
+			if (gzipped && gzipped[i]) {
+				items[i].status = uwsgi_cache_set2(ucs, items[i].key, items[i].keylen, gzipped[i]->buf, gzipped[i]->pos, items[i].expires, flags|UWSGI_CACHE_FLAG_COMPRESSED);
+				if (!items[i].status) stored++;
+				continue;
+			}
+#endif
+			items[i].status = uwsgi_cache_set2(ucs, items[i].key, items[i].keylen, items[i].value, items[i].vallen, items[i].expires, flags);
+			if (!items[i].status) stored++;
+		}
+		if (locked) uwsgi_rwunlock(ucs->lock);
+	}
+
+#ifdef UWSGI_ZLIB
+	if (gzipped) {
+		for (i = 0; i < n; i++) {
+			if (gzipped[i]) uwsgi_buffer_destroy(gzipped[i]);
+		}
+		free(gzipped);
+	}
+#endif
+	free(owners);
+	return stored;
+}
+
+int uwsgi_cache_mdel(struct uwsgi_cache *uc, struct uwsgi_cache_mitem *items, uint64_t n) {
+	uint64_t i, j;
+	int removed = 0;
+	struct uwsgi_cache **owners = cache_mitems_owners(uc, items, n);
+
+	for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, j);
+		int locked = 0;
+		for (i = 0; i < n; i++) {
+			if (owners[i] != ucs) continue;
+			if (!locked) {
+				uwsgi_wlock(ucs->lock);
+				locked = 1;
+			}
+			items[i].status = uwsgi_cache_del2(ucs, items[i].key, items[i].keylen, 0, 0);
+			if (!items[i].status) removed++;
+		}
+		if (locked) uwsgi_rwunlock(ucs->lock);
+	}
+
+	free(owners);
+	return removed;
+}
+
+/*
+	batched items are encoded (big endian) as:
+
+	keys only (mget/mdel requests): [keylen (16bit)][key]
+	with values (mset requests): [keylen (16bit)][key][vallen (64bit)][expires (64bit)][value]
+	mget responses: [status (8bit)][vallen (64bit)][expires (64bit)][value]
+	mset/mdel responses: [status (8bit)]
+*/
+
+int uwsgi_cache_mitems_pack(struct uwsgi_buffer *ub, struct uwsgi_cache_mitem *items, uint64_t n, int with_values) {
+	uint64_t i;
+	for (i = 0; i < n; i++) {
+		if (uwsgi_buffer_u16be(ub, items[i].keylen)) return -1;
+		if (uwsgi_buffer_append(ub, items[i].key, items[i].keylen)) return -1;
+		if (!with_values) continue;
+		if (uwsgi_buffer_u64be(ub, items[i].vallen)) return -1;
+		if (uwsgi_buffer_u64be(ub, items[i].expires)) return -1;
+		if (uwsgi_buffer_append(ub, items[i].value, items[i].vallen)) return -1;
+	}
+	return 0;
+}
+
+// items will point to the memory of buf
+int uwsgi_cache_mitems_unpack(char *buf, uint64_t len, struct uwsgi_cache_mitem *items, uint64_t n, int with_values) {
+	uint64_t i;
+	char *ptr = buf;
+	char *watermark = buf + len;
+	for (i = 0; i < n; i++) {
+		memset(&items[i], 0, sizeof(struct uwsgi_cache_mitem));
+		if (ptr + 2 > watermark) return -1;
+		items[i].keylen = uwsgi_be16(ptr);
+		ptr += 2;
+		if (ptr + items[i].keylen > watermark) return -1;
+		items[i].key = ptr;
+		ptr += items[i].keylen;
+		if (!with_values) continue;
+		if (ptr + 16 > watermark) return -1;
+		items[i].vallen = uwsgi_be64(ptr);
+		items[i].expires = uwsgi_be64(ptr + 8);
+		ptr += 16;
+		if (items[i].vallen > (uint64_t) (watermark - ptr)) return -1;
+		items[i].value = ptr;
+		ptr += items[i].vallen;
+	}
+	return 0;
+}
+
+
 static void cache_send_udp_command(struct uwsgi_cache *uc, char *key, uint16_t keylen, char *val, uint16_t vallen, uint64_t expires, uint8_t cmd) {
 
 		struct uwsgi_header uh;
@@ -1000,34 +2302,399 @@ static void cache_send_udp_command(struct uwsgi_cache *uc, char *key, uint16_t k
 			iov[4].iov_base = val;
 			iov[4].iov_len = vallen16;
 
-			char es[sizeof(UMAX64_STR) + 1];
-        		uint16_t es_size = uwsgi_long2str2n(expires, es, sizeof(UMAX64_STR));
+			char es[sizeof(UMAX64_STR) + 1];
+        		uint16_t es_size = uwsgi_long2str2n(expires, es, sizeof(UMAX64_STR));
+
+			u_e[0] = (uint8_t) (es_size & 0xff);
+        		u_e[1] = (uint8_t) ((es_size >> 8) & 0xff);
+
+			iov[5].iov_base = u_e;
+                	iov[5].iov_len = 2;
+
+                	iov[6].iov_base = es;
+                	iov[6].iov_len = es_size;
+
+			uh._pktsize += 2 + vallen16 + 2 + es_size;
+		}
+
+		uh.modifier1 = 111;
+		uh.modifier2 = cmd;
+
+		struct uwsgi_string_list *usl = uc->nodes;
+		while(usl) {
+			mh.msg_name = usl->custom_ptr;
+			mh.msg_namelen = usl->custom;
+			if (sendmsg(uc->udp_node_socket, &mh, 0) <= 0) {
+				uwsgi_error("[cache-udp-node] sendmsg()");
+			}
+			usl = usl->next;
+		}
+
+}
+
+/*
+	delta replication
+
+	every local change appends the key to a ring (the replication log) with a sequence number.
+	A master thread periodically collects the keys changed since its last run (repeated writes
+	to the same key are coalesced) and sends their current state to the nodes in batches (modifier2 12).
+
+	Restarting nodes ask the sync nodes (modifier2 8) for the changes after the last sequence they applied,
+	falling back to the full dump when the log does not cover it anymore (or the epoch changed).
+*/
+
+static struct uwsgi_cache_replog_entry *cache_replog_entry(struct uwsgi_cache *uc, uint64_t seq) {
+	char *ring = ((char *) uc->replog) + sizeof(struct uwsgi_cache_replog);
+	return (struct uwsgi_cache_replog_entry *) (ring + ((seq % uc->replog->size) * uc->replog->entry_size));
+}
+
+static void cache_replog_add(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
+	uwsgi_lock(uc->replog_lock);
+	uint64_t seq = ++uc->replog->seq;
+	struct uwsgi_cache_replog_entry *e = cache_replog_entry(uc, seq);
+	e->seq = seq;
+	e->keylen = keylen;
+	memcpy(e->key, key, keylen);
+	uwsgi_unlock(uc->replog_lock);
+}
+
+static void cache_replog_init(struct uwsgi_cache *uc) {
+	uint64_t entry_size = sizeof(struct uwsgi_cache_replog_entry) + uc->keysize;
+	entry_size = (entry_size + 7) & ~((uint64_t) 7);
+	size_t len = sizeof(struct uwsgi_cache_replog) + (entry_size * uc->replog_size);
+	int reset_origins = 0;
+
+	if (uc->store) {
+		// the log lives near the store, so a restarted node can still serve (and request) deltas
+		char *path = uwsgi_concat2(uc->store, ".replog");
+		char *store = uc->shards ? uwsgi_concat2(uc->store, ".0") : uc->store;
+		struct stat st;
+		// a new store means the positions of the other nodes are meaningless
+		if (stat(store, &st)) reset_origins = 1;
+		if (store != uc->store) free(store);
+
+		int fd = open(path, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+		if (fd < 0) {
+			uwsgi_error_open(path);
+			exit(1);
+		}
+		if (fstat(fd, &st)) {
+			uwsgi_error("cache_replog_init()/fstat()");
+			exit(1);
+		}
+		if ((size_t) st.st_size != len) {
+			if (ftruncate(fd, 0) || ftruncate(fd, len)) {
+				uwsgi_error("cache_replog_init()/ftruncate()");
+				exit(1);
+			}
+		}
+		uc->replog = (struct uwsgi_cache_replog *) mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (uc->replog == MAP_FAILED) {
+			uwsgi_error("cache_replog_init()/mmap()");
+			exit(1);
+		}
+		close(fd);
+		free(path);
+	}
+	else {
+		uc->replog = uwsgi_calloc_shared(len);
+	}
+
+	if (!uc->replog->epoch || uc->replog->size != uc->replog_size || uc->replog->entry_size != entry_size) {
+		memset(uc->replog, 0, len);
+		uc->replog->epoch = ((uint64_t) uwsgi_micros() << 16) ^ (uint64_t) getpid();
+		if (!uc->replog->epoch) uc->replog->epoch = 1;
+		uc->replog->size = uc->replog_size;
+		uc->replog->entry_size = entry_size;
+	}
+	else if (reset_origins) {
+		memset(uc->replog->origins, 0, sizeof(uc->replog->origins));
+	}
+
+	char *lock_name = uwsgi_concat2("cache_replog_", uc->name ? uc->name : "default");
+	uc->replog_lock = uwsgi_lock_init(lock_name);
+
+	uwsgi_log("*** Cache \"%s\" replication log: %llu entries (epoch %llu, sequence %llu) ***\n", uc->name,
+		(unsigned long long) uc->replog->size, (unsigned long long) uc->replog->epoch, (unsigned long long) uc->replog->seq);
+}
+
+// remember the last sequence applied from another node
+static void cache_replog_track(struct uwsgi_cache *uc, uint64_t epoch, uint64_t seq) {
+	int i, slot = -1;
+	if (!uc->replog) return;
+	uwsgi_lock(uc->replog_lock);
+	for (i = 0; i < UWSGI_CACHE_REPLOG_ORIGINS; i++) {
+		if (uc->replog->origins[i].epoch == epoch) { slot = i; break; }
+	}
+	if (slot < 0) {
+		for (i = 0; i < UWSGI_CACHE_REPLOG_ORIGINS; i++) {
+			if (!uc->replog->origins[i].epoch) { slot = i; break; }
+		}
+	}
+	if (slot < 0) slot = epoch % UWSGI_CACHE_REPLOG_ORIGINS;
+	uc->replog->origins[slot].epoch = epoch;
+	uc->replog->origins[slot].seq = seq;
+	uwsgi_unlock(uc->replog_lock);
+}
+
+static int cache_replog_position(struct uwsgi_cache *uc, uint64_t epoch, uint64_t *seq) {
+	int i, ret = -1;
+	uwsgi_lock(uc->replog_lock);
+	for (i = 0; i < UWSGI_CACHE_REPLOG_ORIGINS; i++) {
+		if (uc->replog->origins[i].epoch == epoch) {
+			*seq = uc->replog->origins[i].seq;
+			ret = 0;
+			break;
+		}
+	}
+	uwsgi_unlock(uc->replog_lock);
+	return ret;
+}
+
+/*
+	collect the keys changed after 'since' (only the most recent change of each key is kept).
+	items point to the 'entries' memory area (free both of them). Returns -1 if the log does not cover 'since'
+*/
+static int cache_replog_collect(struct uwsgi_cache *uc, uint64_t since, uint64_t *seq, struct uwsgi_cache_mitem **items, uint64_t *n, char **entries) {
+	uint64_t i;
+	uwsgi_lock(uc->replog_lock);
+	*seq = uc->replog->seq;
+	if (since > *seq || *seq - since > uc->replog->size) {
+		uwsgi_unlock(uc->replog_lock);
+		return -1;
+	}
+	uint64_t count = *seq - since;
+	*entries = uwsgi_malloc((count ? count : 1) * uc->replog->entry_size);
+	for (i = 0; i < count; i++) {
+		memcpy(*entries + (i * uc->replog->entry_size), cache_replog_entry(uc, since + 1 + i), uc->replog->entry_size);
+	}
+	uwsgi_unlock(uc->replog_lock);
+
+	*items = uwsgi_malloc(sizeof(struct uwsgi_cache_mitem) * (count ? count : 1));
+	*n = 0;
+	if (!count) return 0;
+
+	// open addressing set of the already collected keys (index + 1)
+	uint64_t set_size = 2;
+	while (set_size < count * 2) set_size <<= 1;
+	uint64_t *set = uwsgi_calloc(sizeof(uint64_t) * set_size);
+	// walk from the newest change
+	for (i = count; i > 0; i--) {
+		struct uwsgi_cache_replog_entry *e = (struct uwsgi_cache_replog_entry *) (*entries + ((i - 1) * uc->replog->entry_size));
+		uint64_t slot = uc->hash->func(e->key, e->keylen) & (set_size - 1);
+		int found = 0;
+		while (set[slot]) {
+			struct uwsgi_cache_mitem *item = &(*items)[set[slot] - 1];
+			if (!uwsgi_strncmp(item->key, item->keylen, e->key, e->keylen)) {
+				found = 1;
+				break;
+			}
+			slot = (slot + 1) & (set_size - 1);
+		}
+		if (found) continue;
+		memset(&(*items)[*n], 0, sizeof(struct uwsgi_cache_mitem));
+		(*items)[*n].key = e->key;
+		(*items)[*n].keylen = e->keylen;
+		(*n)++;
+		set[slot] = *n;
+	}
+	free(set);
+	return 0;
+}
+
+// the current state of a key: [keylen (16bit)][key][found (8bit)][vallen (64bit)][expires (64bit)][value]
+static int cache_replog_pack(struct uwsgi_buffer *ub, struct uwsgi_cache_mitem *item) {
+	if (uwsgi_buffer_u16be(ub, item->keylen)) return -1;
+	if (uwsgi_buffer_append(ub, item->key, item->keylen)) return -1;
+	if (uwsgi_buffer_u8(ub, item->status ? 0 : 1)) return -1;
+	if (uwsgi_buffer_u64be(ub, item->status ? 0 : item->vallen)) return -1;
+	if (uwsgi_buffer_u64be(ub, item->status ? 0 : item->expires)) return -1;
+	if (!item->status && uwsgi_buffer_append(ub, item->value, item->vallen)) return -1;
+	return 0;
+}
+
+static uint64_t cache_replog_packed_size(struct uwsgi_cache_mitem *item) {
+	return 2 + item->keylen + 17 + (item->status ? 0 : item->vallen);
+}
+
+static int cache_replog_apply(struct uwsgi_cache *uc, char *buf, uint64_t len, uint64_t n) {
+	uint64_t i;
+	char *ptr = buf;
+	char *watermark = buf + len;
+	for (i = 0; i < n; i++) {
+		if (ptr + 2 > watermark) return -1;
+		uint16_t keylen = uwsgi_be16(ptr);
+		ptr += 2;
+		if (ptr + keylen + 17 > watermark) return -1;
+		char *key = ptr;
+		ptr += keylen;
+		uint8_t found = *ptr++;
+		uint64_t vallen = uwsgi_be64(ptr);
+		uint64_t expires = uwsgi_be64(ptr + 8);
+		ptr += 16;
+		if (vallen > (uint64_t) (watermark - ptr)) return -1;
+		struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+		uwsgi_wlock(ucs->lock);
+		if (found) {
+			if (uwsgi_cache_set2(ucs, key, keylen, ptr, vallen, expires, UWSGI_CACHE_FLAG_UPDATE|UWSGI_CACHE_FLAG_LOCAL|UWSGI_CACHE_FLAG_ABSEXPIRE)) {
+				uwsgi_log("[cache-replication] unable to update cache\n");
+			}
+		}
+		else {
+			uwsgi_cache_del2(ucs, key, keylen, 0, UWSGI_CACHE_FLAG_LOCAL);
+		}
+		uwsgi_rwunlock(ucs->lock);
+		ptr += vallen;
+	}
+	return 0;
+}
+
+// the changes after 'since' packed for the catch-up of another node (NULL if a full sync is needed)
+struct uwsgi_buffer *uwsgi_cache_replog_delta(struct uwsgi_cache *uc, uint64_t epoch, uint64_t since, uint64_t *seq, uint64_t *n) {
+	struct uwsgi_cache_mitem *items = NULL;
+	char *entries = NULL;
+	uint64_t i;
 
-			u_e[0] = (uint8_t) (es_size & 0xff);
-        		u_e[1] = (uint8_t) ((es_size >> 8) & 0xff);
+	*n = 0;
+	*seq = 0;
+	if (!uc->replog) return NULL;
+	if (epoch != uc->replog->epoch || cache_replog_collect(uc, since, seq, &items, n, &entries)) {
+		*seq = uc->replog->seq;
+		return NULL;
+	}
 
-			iov[5].iov_base = u_e;
-                	iov[5].iov_len = 2;
+	uwsgi_cache_mget(uc, items, *n);
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(uwsgi.page_size);
+	for (i = 0; i < *n; i++) {
+		if (cache_replog_pack(ub, &items[i])) {
+			uwsgi_buffer_destroy(ub);
+			ub = NULL;
+			break;
+		}
+	}
+	for (i = 0; i < *n; i++) {
+		free(items[i].value);
+	}
+	free(items);
+	free(entries);
+	return ub;
+}
 
-                	iov[6].iov_base = es;
-                	iov[6].iov_len = es_size;
+/*
+	a batch is split in datagrams of at most 64k, each one is:
+	[epoch (64bit)][from (64bit)][to (64bit)][chunk (16bit)][chunks (16bit)][items (16bit)] + items
 
-			uh._pktsize += 2 + vallen16 + 2 + es_size;
+	items bigger than a datagram cannot be sent, the batch containing them announces one more chunk
+	so it is never complete for the nodes: their position stops before it and they get the missing
+	items with the (tcp) catch-up when restarted.
+*/
+#define CACHE_REPLOG_DGRAM_HEADER 30
+#define CACHE_REPLOG_DGRAM_SIZE 65507
+#define CACHE_REPLOG_DGRAM_MAX (CACHE_REPLOG_DGRAM_SIZE - 4 - CACHE_REPLOG_DGRAM_HEADER)
+
+static void cache_replog_send(struct uwsgi_cache *uc, int fd, struct uwsgi_cache_mitem *items, uint64_t n, uint64_t from, uint64_t to) {
+	uint64_t i, chunks = 0, chunk_size = 0, skipped = 0;
+	for (i = 0; i < n; i++) {
+		uint64_t size = cache_replog_packed_size(&items[i]);
+		if (size > CACHE_REPLOG_DGRAM_MAX) {
+			uwsgi_log("[cache-replication] item \"%.*s\" of cache \"%s\" too big for a datagram (%llu bytes), skipped\n",
+				items[i].keylen, items[i].key, uc->name, (unsigned long long) size);
+			skipped++;
+			continue;
 		}
+		if (!chunks || chunk_size + size > CACHE_REPLOG_DGRAM_MAX) {
+			chunks++;
+			chunk_size = 0;
+		}
+		chunk_size += size;
+	}
+	uc->replication_skipped += skipped;
+	uint64_t announced = chunks + (skipped ? 1 : 0);
+	if (!chunks || announced > 0xffff) {
+		if (chunks) uwsgi_log("[cache-replication] too many changes for cache \"%s\", the nodes need a full sync\n", uc->name);
+		return;
+	}
 
-		uh.modifier1 = 111;
-		uh.modifier2 = cmd;
-
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(UMAX16);
+	uint16_t chunk = 0;
+	i = 0;
+	while (i < n) {
+		ub->pos = 4 + CACHE_REPLOG_DGRAM_HEADER;
+		uint16_t nitems = 0;
+		for (; i < n; i++) {
+			uint64_t size = cache_replog_packed_size(&items[i]);
+			if (size > CACHE_REPLOG_DGRAM_MAX) continue;
+			if (ub->pos + size > CACHE_REPLOG_DGRAM_SIZE) break;
+			if (cache_replog_pack(ub, &items[i])) goto end;
+			nitems++;
+		}
+		if (!nitems) continue;
+		size_t pos = ub->pos;
+		ub->pos = 4;
+		if (uwsgi_buffer_u64be(ub, uc->replog->epoch)) goto end;
+		if (uwsgi_buffer_u64be(ub, from)) goto end;
+		if (uwsgi_buffer_u64be(ub, to)) goto end;
+		if (uwsgi_buffer_u16be(ub, chunk)) goto end;
+		if (uwsgi_buffer_u16be(ub, announced)) goto end;
+		if (uwsgi_buffer_u16be(ub, nitems)) goto end;
+		ub->pos = pos;
+		if (uwsgi_buffer_set_uh(ub, 111, 12)) goto end;
 		struct uwsgi_string_list *usl = uc->nodes;
 		while(usl) {
-			mh.msg_name = usl->custom_ptr;
-			mh.msg_namelen = usl->custom;
-			if (sendmsg(uc->udp_node_socket, &mh, 0) <= 0) {
-				uwsgi_error("[cache-udp-node] sendmsg()");
+			if (sendto(fd, ub->buf, ub->pos, 0, (struct sockaddr *) usl->custom_ptr, usl->custom) < 0) {
+				uwsgi_error("[cache-replication] sendto()");
 			}
 			usl = usl->next;
 		}
+		chunk++;
+	}
+end:
+	uwsgi_buffer_destroy(ub);
+}
+
+static void *cache_replication_loop(void *ucache) {
+	// block all signals
+	sigset_t smask;
+	sigfillset(&smask);
+	pthread_sigmask(SIG_BLOCK, &smask, NULL);
+
+	struct uwsgi_cache *uc = (struct uwsgi_cache *) ucache;
+
+	// the socket is created here as the ones created before the sockets setup do not survive reloads
+	int fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0) {
+		uwsgi_error("[cache-replication] socket()");
+		return NULL;
+	}
+
+	// older changes reach the nodes via the catch-up
+	uwsgi_lock(uc->replog_lock);
+	uint64_t sent = uc->replog->seq;
+	uwsgi_unlock(uc->replog_lock);
+
+	for(;;) {
+		usleep(uc->replication_freq * 1000);
+		struct uwsgi_cache_mitem *items = NULL;
+		char *entries = NULL;
+		uint64_t i, n = 0, seq = 0;
+		if (cache_replog_collect(uc, sent, &seq, &items, &n, &entries)) {
+			uwsgi_log("[cache-replication] replication log of cache \"%s\" overrun, the nodes need a full sync\n", uc->name);
+			sent = seq;
+			continue;
+		}
+		if (n > 0) {
+			uwsgi_cache_mget(uc, items, n);
+			cache_replog_send(uc, fd, items, n, sent, seq);
+			for (i = 0; i < n; i++) {
+				free(items[i].value);
+			}
+		}
+		free(items);
+		free(entries);
+		sent = seq;
+	}
 
+	return NULL;
 }
 
 void *cache_udp_server_loop(void *ucache) {
@@ -1056,6 +2723,14 @@ void *cache_udp_server_loop(void *ucache) {
 
         // allocate 64k chunk to receive messages
         char *buf = uwsgi_malloc(UMAX16);
+
+	// replication batches being received (a position is tracked only when all of the chunks arrived)
+	struct {
+		uint64_t epoch;
+		uint64_t to;
+		uint16_t received;
+	} batches[UWSGI_CACHE_REPLOG_ORIGINS];
+	memset(batches, 0, sizeof(batches));
 	
 	for(;;) {
                 uint16_t pktsize = 0, ss = 0;
@@ -1071,6 +2746,34 @@ void *cache_udp_server_loop(void *ucache) {
                 memcpy(&pktsize, buf+1, 2);
                 if (pktsize != len-4) continue;
 
+		// replication batch
+		if (buf[3] == 12) {
+			if (pktsize < CACHE_REPLOG_DGRAM_HEADER) continue;
+			uint64_t epoch = uwsgi_be64(buf + 4);
+			uint64_t from = uwsgi_be64(buf + 12);
+			uint64_t to = uwsgi_be64(buf + 20);
+			uint16_t chunks = uwsgi_be16(buf + 30);
+			uint16_t nitems = uwsgi_be16(buf + 32);
+			if (cache_replog_apply(uc, buf + 4 + CACHE_REPLOG_DGRAM_HEADER, pktsize - CACHE_REPLOG_DGRAM_HEADER, nitems)) {
+				uwsgi_log("[cache-replication] invalid batch received\n");
+				continue;
+			}
+			if (!uc->replog) continue;
+			int slot = epoch % UWSGI_CACHE_REPLOG_ORIGINS;
+			if (batches[slot].epoch != epoch || batches[slot].to != to) {
+				batches[slot].epoch = epoch;
+				batches[slot].to = to;
+				batches[slot].received = 0;
+			}
+			if (++batches[slot].received != chunks) continue;
+			// advance only if no previous batch has been lost
+			uint64_t applied = 0;
+			if (!cache_replog_position(uc, epoch, &applied) && applied >= from && to > applied) {
+				cache_replog_track(uc, epoch, to);
+			}
+			continue;
+		}
+
                 memcpy(&ss, buf + 4, 2);
                 if (4+ss > pktsize) continue;
                 uint16_t keylen = ss;
@@ -1089,19 +2792,21 @@ void *cache_udp_server_loop(void *ucache) {
                                 if (6+keylen+vallen+ss > pktsize) continue;
                                 expires = uwsgi_str_num(buf + 10 + keylen+vallen, ss);
                         }
-                        uwsgi_wlock(uc->lock);
-                        if (uwsgi_cache_set2(uc, key, keylen, val, vallen, expires, UWSGI_CACHE_FLAG_UPDATE|UWSGI_CACHE_FLAG_LOCAL|UWSGI_CACHE_FLAG_ABSEXPIRE)) {
+                        struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+                        uwsgi_wlock(ucs->lock);
+                        if (uwsgi_cache_set2(ucs, key, keylen, val, vallen, expires, UWSGI_CACHE_FLAG_UPDATE|UWSGI_CACHE_FLAG_LOCAL|UWSGI_CACHE_FLAG_ABSEXPIRE)) {
                                 uwsgi_log("[cache-udp-server] unable to update cache\n");
                         }
-                        uwsgi_rwunlock(uc->lock);
+                        uwsgi_rwunlock(ucs->lock);
                 }
                 // cache del
                 else if (buf[3] == 11) {
-                        uwsgi_wlock(uc->lock);
-                        if (uwsgi_cache_del2(uc, key, keylen, 0, UWSGI_CACHE_FLAG_LOCAL)) {
+                        struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+                        uwsgi_wlock(ucs->lock);
+                        if (uwsgi_cache_del2(ucs, key, keylen, 0, UWSGI_CACHE_FLAG_LOCAL)) {
                                 uwsgi_log("[cache-udp-server] unable to update cache\n");
                         }
-                        uwsgi_rwunlock(uc->lock);
+                        uwsgi_rwunlock(ucs->lock);
                 }
         }
 
@@ -1161,7 +2866,10 @@ static void *cache_sweeper_loop(void *ucache) {
 		struct uwsgi_cache *uc;
 
 		for (uc = (struct uwsgi_cache *)ucache; uc; uc = uc->next) {
-			uint64_t freed_items = cache_sweeper_free_items(uc);
+			uint64_t i, freed_items = 0;
+			for (i = 0; i < uwsgi_cache_nshards(uc); i++) {
+				freed_items += cache_sweeper_free_items(uwsgi_cache_shard_n(uc, i));
+			}
 			if (uwsgi.cache_report_freed_items && freed_items)
 				uwsgi_log("freed %llu items for cache \"%s\"\n", (unsigned long long)freed_items, uc->name);
 		}
@@ -1172,14 +2880,56 @@ static void *cache_sweeper_loop(void *ucache) {
         return NULL;
 }
 
-void uwsgi_cache_sync_all() {
+static void *cache_store_sync_loop(void *arg) {
+	// block all signals
+	sigset_t smask;
+	sigfillset(&smask);
+	pthread_sigmask(SIG_BLOCK, &smask, NULL);
 
+	uint64_t cycles = 0;
+	for(;;) {
+		struct uwsgi_cache *uc = uwsgi.caches;
+		while(uc) {
+			if (uc->store && (cycles == 0 || (uc->store_sync > 0 && (cycles % uc->store_sync) == 0))) {
+				uint64_t i;
+				for (i = 0; i < uwsgi_cache_nshards(uc); i++) {
+					cache_store_sync(uwsgi_cache_shard_n(uc, i), 0);
+				}
+			}
+			uc = uc->next;
+		}
+		cycles++;
+		sleep(1);
+	}
+
+	return NULL;
+}
+
+// the periodic sync of the stores runs in a thread, so the disk latency does not block the master
+void uwsgi_cache_start_store_sync() {
 	struct uwsgi_cache *uc = uwsgi.caches;
 	while(uc) {
-		if (uc->store && (uwsgi.master_cycles == 0 || (uc->store_sync > 0 && (uwsgi.master_cycles % uc->store_sync) == 0))) {
-                	if (msync(uc->items, uc->filesize, MS_ASYNC)) {
-                        	uwsgi_error("uwsgi_cache_sync_all()/msync()");
-                        }
+		if (uc->store) break;
+		uc = uc->next;
+	}
+	if (!uc) return;
+
+	pthread_t cache_store_sync;
+	if (pthread_create(&cache_store_sync, NULL, cache_store_sync_loop, NULL)) {
+		uwsgi_error("uwsgi_cache_start_store_sync()/pthread_create()");
+		uwsgi_log("unable to run the cache store sync thread !!!\n");
+	}
+}
+
+// called on shutdown, flush everything regardless of store_sync
+void uwsgi_cache_flush_stores() {
+	struct uwsgi_cache *uc = uwsgi.caches;
+	while(uc) {
+		if (uc->store) {
+			uint64_t i;
+			for (i = 0; i < uwsgi_cache_nshards(uc); i++) {
+				cache_store_sync(uwsgi_cache_shard_n(uc, i), 1);
+			}
 		}
 		uc = uc->next;
 	}
@@ -1215,6 +2965,16 @@ void uwsgi_cache_start_sync_servers() {
 
 	struct uwsgi_cache *uc = uwsgi.caches;
 	while(uc) {
+		if (uc->replog && uc->nodes) {
+			pthread_t cache_replication;
+			if (pthread_create(&cache_replication, NULL, cache_replication_loop, (void *) uc)) {
+				uwsgi_error("pthread_create()");
+				uwsgi_log("unable to run the cache replication thread !!!\n");
+			}
+			else {
+				uwsgi_log("replication thread enabled for cache \"%s\"\n", uc->name);
+			}
+		}
 		if (!uc->udp_servers) goto next;		
 		pthread_t cache_udp_server;
                 if (pthread_create(&cache_udp_server, NULL, cache_udp_server_loop, (void *) uc)) {
@@ -1289,6 +3049,20 @@ struct uwsgi_cache *uwsgi_cache_create(char *arg) {
 		char *c_sweep_on_full = NULL;
 		char *c_clear_on_full = NULL;
 		char *c_no_expire = NULL;
+		char *c_shards = NULL;
+		char *c_optimistic = NULL;
+		char *c_layout = NULL;
+		char *c_optimistic_max_size = NULL;
+		char *c_replog = NULL;
+		char *c_replication_freq = NULL;
+		char *c_slabs = NULL;
+		char *c_purge_policy = NULL;
+		char *c_purge_samples = NULL;
+		char *c_admission = NULL;
+		char *c_slab_factor = NULL;
+		char *c_slab_page_size = NULL;
+		char *c_compress = NULL;
+		char *c_compress_threshold = NULL;
 
 		if (uwsgi_kvlist_parse(arg, strlen(arg), ',', '=',
                         "name", &c_name,
@@ -1326,6 +3100,22 @@ struct uwsgi_cache *uwsgi_cache_create(char *arg) {
 			"sweep_on_full", &c_sweep_on_full,
 			"clear_on_full", &c_clear_on_full,
 			"no_expire", &c_no_expire,
+			"shards", &c_shards,
+			"optimistic", &c_optimistic,
+			"layout", &c_layout,
+			"optimistic_max_size", &c_optimistic_max_size,
+			"slabs", &c_slabs,
+			"purge_policy", &c_purge_policy,
+			"policy", &c_purge_policy,
+			"purge_samples", &c_purge_samples,
+			"admission", &c_admission,
+			"slab_factor", &c_slab_factor,
+			"slab_page_size", &c_slab_page_size,
+			"replication_log", &c_replog,
+			"replog", &c_replog,
+			"replication_freq", &c_replication_freq,
+			"compress", &c_compress,
+			"compress_threshold", &c_compress_threshold,
                 	NULL)) {
 			uwsgi_log("unable to parse cache definition\n");
 			exit(1);
@@ -1372,6 +3162,19 @@ struct uwsgi_cache *uwsgi_cache_create(char *arg) {
 			uc->use_blocks_bitmap = 1; 
 			uc->max_item_size = uc->blocksize * uc->blocks;
 		}
+		if (c_slabs) {
+			if (uc->use_blocks_bitmap) {
+				uwsgi_log("bitmap and slabs modes cannot be combined for cache \"%s\"\n", uc->name);
+				exit(1);
+			}
+			uc->use_slabs = 1;
+			uc->slab_factor = 1.25;
+			if (c_slab_factor) uc->slab_factor = strtod(c_slab_factor, NULL);
+			if (uc->slab_factor <= 1.0) { uwsgi_log("invalid slab factor for cache \"%s\", must be higher than 1.0\n", uc->name); exit(1); }
+			if (c_slab_page_size) uc->slab_page_size = uwsgi_n64(c_slab_page_size);
+			// the real value is computed when the memory is allocated
+			uc->max_item_size = uc->blocksize * uc->blocks;
+		}
 		if (c_use_last_modified) uc->use_last_modified = 1;
 		if (c_ignore_full) uc->ignore_full = 1;
 
@@ -1389,7 +3192,8 @@ struct uwsgi_cache *uwsgi_cache_create(char *arg) {
 		uc->store_sync = uwsgi.cache_store_sync;
 		if (c_store_sync) { uc->store_sync = uwsgi_n64(c_store_sync); }
 
-		if (uc->blocks < uc->max_items) {
+		// slabs can hold more than one item per block
+		if (!uc->use_slabs && uc->blocks < uc->max_items) {
 			uwsgi_log("invalid number of cache blocks for \"%s\", must be higher than max_items (%llu)\n", uc->name, uc->max_items);
 			exit(1);
 		}
@@ -1419,6 +3223,110 @@ struct uwsgi_cache *uwsgi_cache_create(char *arg) {
 		
 		if (c_purge_lru)
 			uc->purge_lru = 1;
+
+		if (c_purge_policy) {
+			if (!strcmp(c_purge_policy, "lru")) {
+				uc->purge_lru = 1;
+			}
+			else if (!strcmp(c_purge_policy, "clock")) {
+				uc->purge_policy = UWSGI_CACHE_POLICY_CLOCK;
+			}
+			else if (!strcmp(c_purge_policy, "sampled")) {
+				uc->purge_policy = UWSGI_CACHE_POLICY_SAMPLED;
+			}
+			else {
+				uwsgi_log("invalid purge policy for cache \"%s\": %s\n", uc->name, c_purge_policy);
+				exit(1);
+			}
+			if (uc->purge_lru && uc->purge_policy) {
+				uwsgi_log("purge_lru and purge_policy cannot be combined for cache \"%s\"\n", uc->name);
+				exit(1);
+			}
+		}
+
+		uc->purge_samples = 5;
+		if (c_purge_samples) uc->purge_samples = uwsgi_n64(c_purge_samples);
+		if (!uc->purge_samples) { uwsgi_log("invalid purge samples for cache \"%s\"\n", uc->name); exit(1); }
+
+		if (c_admission) {
+			if (strcmp(c_admission, "tinylfu")) {
+				uwsgi_log("invalid admission filter for cache \"%s\": %s\n", uc->name, c_admission);
+				exit(1);
+			}
+			if (!uc->purge_lru && !uc->purge_policy) {
+				uwsgi_log("the admission filter of cache \"%s\" requires a purge policy\n", uc->name);
+				exit(1);
+			}
+			uc->tinylfu = 1;
+		}
+
+		if (c_layout) {
+			if (!strcmp(c_layout, "compact")) {
+				if (uc->max_items >= 0xffffffff) {
+					uwsgi_log("compact layout for cache \"%s\" supports at most %llu items\n", uc->name, 0xffffffffLLU);
+					exit(1);
+				}
+				uc->compact = 1;
+			}
+			else if (strcmp(c_layout, "chained")) {
+				uwsgi_log("invalid cache layout for \"%s\": %s\n", uc->name, c_layout);
+				exit(1);
+			}
+		}
+
+		if (c_optimistic) {
+			if (uc->purge_lru) {
+				uwsgi_log("optimistic reads are not available for lru cache \"%s\" (use purge_policy=clock or purge_policy=sampled)\n", uc->name);
+				exit(1);
+			}
+			uc->optimistic = 1;
+			uc->optimistic_max_size = 4096;
+			if (c_optimistic_max_size) uc->optimistic_max_size = uwsgi_n64(c_optimistic_max_size);
+		}
+
+		if (c_replog) {
+			uc->replog_size = uwsgi_n64(c_replog);
+			if (uc->keysize > 0xffff) {
+				uwsgi_log("the replication log of cache \"%s\" supports keys up to 65535 bytes\n", uc->name);
+				exit(1);
+			}
+			uc->replication_freq = 100;
+			if (c_replication_freq) uc->replication_freq = uwsgi_n64(c_replication_freq);
+			if (!uc->replication_freq) { uwsgi_log("invalid replication frequency for cache \"%s\"\n", uc->name); exit(1); }
+			if (uc->nodes && !uwsgi.master_process) {
+				uwsgi_log("*** WARNING: replication of cache \"%s\" requires the master process ***\n", uc->name);
+			}
+		}
+
+		if (c_compress) {
+#ifdef UWSGI_ZLIB
+			if (strcmp(c_compress, "gzip")) {
+				uwsgi_log("invalid compression for cache \"%s\": %s\n", uc->name, c_compress);
+				exit(1);
+			}
+			uc->compress = 1;
+			uc->compress_threshold = 256;
+			if (c_compress_threshold) uc->compress_threshold = uwsgi_n64(c_compress_threshold);
+#else
+			uwsgi_log("compression of cache \"%s\" requires zlib support\n", uc->name);
+			exit(1);
+#endif
+		}
+
+		if (c_shards) {
+			uc->shards = uwsgi_n64(c_shards);
+			if (uc->shards < 2) {
+				uc->shards = 0;
+			}
+			else if (uc->shards >= uc->max_items) {
+				uwsgi_log("invalid number of shards for cache \"%s\", must be lower than max_items (%llu)\n", uc->name, uc->max_items);
+				exit(1);
+			}
+			else if (uc->sync_nodes && !uc->replog_size) {
+				uwsgi_log("sharded cache \"%s\" can be synchronized from other nodes only with a replication log\n", uc->name);
+				exit(1);
+			}
+		}
 	}
 
 	uwsgi_cache_init(uc);
@@ -1520,6 +3428,11 @@ void uwsgi_cache_magic_context_hook(char *key, uint16_t key_len, char *value, ui
                 ucmc->status_len = vallen;
                 return;
         }
+
+	if (!uwsgi_strncmp(key, key_len, "items", 5)) {
+                ucmc->items = uwsgi_str_num(value, vallen);
+                return;
+        }
 }
 
 static struct uwsgi_buffer *uwsgi_cache_prepare_magic_get(char *cache_name, uint16_t cache_name_len, char *key, uint16_t key_len) {
@@ -1674,19 +3587,7 @@ char *uwsgi_cache_magic_get(char *key, uint16_t keylen, uint64_t *vallen, uint64
 
 	// we have a local cache !!!
 	if (uc) {
-		if (uc->purge_lru)
-			uwsgi_wlock(uc->lock);
-		else
-			uwsgi_rlock(uc->lock);
-		char *value = uwsgi_cache_get3(uc, key, keylen, vallen, expires);
-		if (!value) {
-			uwsgi_rwunlock(uc->lock);
-			return NULL;
-		}
-		char *buf = uwsgi_malloc(*vallen);
-		memcpy(buf, value, *vallen);
-		uwsgi_rwunlock(uc->lock);
-		return buf;
+		return uwsgi_cache_get_copy(uc, key, keylen, vallen, expires, NULL);
 	}
 
 	// we have a remote one
@@ -1783,12 +3684,13 @@ int uwsgi_cache_magic_exists(char *key, uint16_t keylen, char *cache) {
 
         // we have a local cache !!!
         if (uc) {
-                uwsgi_rlock(uc->lock);
-                if (!uwsgi_cache_exists2(uc, key, keylen)) {
-                        uwsgi_rwunlock(uc->lock);
+		struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+                uwsgi_rlock(ucs->lock);
+                if (!uwsgi_cache_exists2(ucs, key, keylen)) {
+                        uwsgi_rwunlock(ucs->lock);
                         return 0;
                 }
-		uwsgi_rwunlock(uc->lock);
+		uwsgi_rwunlock(ucs->lock);
 		return 1;
         }
 
@@ -1855,9 +3757,21 @@ int uwsgi_cache_magic_set(char *key, uint16_t keylen, char *value, uint64_t vall
 
 	// we have a local cache !!!
 	if (uc) {
-                uwsgi_wlock(uc->lock);
-                int ret = uwsgi_cache_set2(uc, key, keylen, value, vallen, expires, flags);
-                uwsgi_rwunlock(uc->lock);
+		struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+#ifdef UWSGI_ZLIB
+		struct uwsgi_buffer *gzipped = uwsgi_cache_precompress(ucs, value, vallen, flags);
+		if (gzipped) {
+			value = gzipped->buf;
+			vallen = gzipped->pos;
+			flags |= UWSGI_CACHE_FLAG_COMPRESSED;
+		}
+#endif
+                uwsgi_wlock(ucs->lock);
+                int ret = uwsgi_cache_set2(ucs, key, keylen, value, vallen, expires, flags);
+                uwsgi_rwunlock(ucs->lock);
+#ifdef UWSGI_ZLIB
+		if (gzipped) uwsgi_buffer_destroy(gzipped);
+#endif
 		return ret;
         }
 
@@ -1931,12 +3845,13 @@ int uwsgi_cache_magic_del(char *key, uint16_t keylen, char *cache) {
 
         // we have a local cache !!!
         if (uc) {
-                uwsgi_wlock(uc->lock);
-                if (uwsgi_cache_del2(uc, key, keylen, 0, 0)) {
-                        uwsgi_rwunlock(uc->lock);
+		struct uwsgi_cache *ucs = uwsgi_cache_shard(uc, key, keylen);
+                uwsgi_wlock(ucs->lock);
+                if (uwsgi_cache_del2(ucs, key, keylen, 0, 0)) {
+                        uwsgi_rwunlock(ucs->lock);
                         return -1;
                 }
-                uwsgi_rwunlock(uc->lock);
+                uwsgi_rwunlock(ucs->lock);
                 return 0;
         }
 
@@ -2003,15 +3918,18 @@ int uwsgi_cache_magic_clear(char *cache) {
 
         // we have a local cache !!!
         if (uc) {
-		uint64_t i;
-                uwsgi_wlock(uc->lock);
-		for (i = 1; i < uc->max_items; i++) {
-                	if (uwsgi_cache_del2(uc, NULL, 0, i, 0)) {
-                        	uwsgi_rwunlock(uc->lock);
-                        	return -1;
-                	}
+		uint64_t i, j;
+		for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+			struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, j);
+                	uwsgi_wlock(ucs->lock);
+			for (i = 1; i < ucs->max_items; i++) {
+                		if (uwsgi_cache_del2(ucs, NULL, 0, i, 0)) {
+                        		uwsgi_rwunlock(ucs->lock);
+                        		return -1;
+                		}
+			}
+                	uwsgi_rwunlock(ucs->lock);
 		}
-                uwsgi_rwunlock(uc->lock);
                 return 0;
         }
 
@@ -2054,9 +3972,265 @@ int uwsgi_cache_magic_clear(char *cache) {
 }
 
 
+// resolve the cache string of the magic functions (local cache or name@server)
+static struct uwsgi_cache *cache_magic_resolve(char *cache, char **cache_server, char **cache_name, uint16_t *cache_name_len) {
+	*cache_server = NULL;
+	*cache_name = NULL;
+	*cache_name_len = 0;
+	if (!cache) return uwsgi.caches;
+	char *at = strchr(cache, '@');
+	if (!at) return uwsgi_cache_by_name(cache);
+	*cache_server = at + 1;
+	*cache_name = cache;
+	*cache_name_len = at - cache;
+	return NULL;
+}
+
+// a single request for the whole batch
+static int cache_magic_mitems_remote(char *cmd, char *cache_server, char *cache_name, uint16_t cache_name_len, struct uwsgi_cache_mitem *items, uint64_t n) {
+	struct uwsgi_cache_magic_context ucmc;
+	struct uwsgi_buffer *ub = NULL, *body = NULL;
+	char *response = NULL;
+	int ret = -1;
+	int is_get = !strcmp(cmd, "mget");
+	uint64_t i;
+
+	if (!n) return 0;
+
+	int fd = uwsgi_connect(cache_server, 0, 1);
+	if (fd < 0) return -1;
+
+	if (uwsgi.wait_write_hook(fd, uwsgi.socket_timeout) <= 0) goto end;
+
+	body = uwsgi_buffer_new(uwsgi.page_size);
+	if (uwsgi_cache_mitems_pack(body, items, n, !is_get && strcmp(cmd, "mdel"))) goto end;
+
+	ub = uwsgi_buffer_new(uwsgi.page_size);
+	ub->pos = 4;
+	if (uwsgi_buffer_append_keyval(ub, "cmd", 3, cmd, strlen(cmd))) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "items", 5, n)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "size", 4, body->pos)) goto end;
+	if (cache_name) {
+		if (uwsgi_buffer_append_keyval(ub, "cache", 5, cache_name, cache_name_len)) goto end;
+	}
+
+	if (cache_magic_send_and_manage(fd, ub, body->buf, body->pos, uwsgi.socket_timeout, &ucmc)) goto end;
+	if (uwsgi_strncmp(ucmc.status, ucmc.status_len, "ok", 2)) goto end;
+	if (ucmc.items != n || ucmc.size < n) goto end;
+
+	response = uwsgi_malloc(ucmc.size);
+	if (uwsgi_read_whole_true_nb(fd, response, ucmc.size, uwsgi.socket_timeout)) goto end;
+
+	char *ptr = response;
+	char *watermark = response + ucmc.size;
+	ret = 0;
+	for (i = 0; i < n; i++) {
+		if (ptr + 1 > watermark) goto invalid;
+		uint8_t status = *ptr++;
+		if (!is_get) {
+			items[i].status = status ? 0 : -1;
+			if (status) ret++;
+			continue;
+		}
+		if (ptr + 16 > watermark) goto invalid;
+		uint64_t vallen = uwsgi_be64(ptr);
+		uint64_t expires = uwsgi_be64(ptr + 8);
+		ptr += 16;
+		if (!status) continue;
+		if (vallen > (uint64_t) (watermark - ptr)) goto invalid;
+		items[i].value = uwsgi_malloc(vallen);
+		memcpy(items[i].value, ptr, vallen);
+		items[i].vallen = vallen;
+		items[i].expires = expires;
+		items[i].status = 0;
+		ptr += vallen;
+		ret++;
+	}
+	goto end;
+
+invalid:
+	uwsgi_log("[uwsgi-cache] invalid %s response from %s\n", cmd, cache_server);
+	ret = -1;
+end:
+	close(fd);
+	if (ub) uwsgi_buffer_destroy(ub);
+	if (body) uwsgi_buffer_destroy(body);
+	free(response);
+	return ret;
+}
+
+// like uwsgi_cache_magic_get() but compressed values are not decompressed if *compressed is set
+char *uwsgi_cache_magic_get_encoded(char *key, uint16_t keylen, uint64_t *vallen, uint64_t *expires, int *compressed, char *cache) {
+	char *cache_server, *cache_name;
+	uint16_t cache_name_len;
+
+	struct uwsgi_cache *uc = cache_magic_resolve(cache, &cache_server, &cache_name, &cache_name_len);
+	if (uc) return uwsgi_cache_get_copy(uc, key, keylen, vallen, expires, compressed);
+	// remote servers always send plain values
+	*compressed = 0;
+	return uwsgi_cache_magic_get(key, keylen, vallen, expires, cache);
+}
+
+int uwsgi_cache_magic_mget(struct uwsgi_cache_mitem *items, uint64_t n, char *cache) {
+	char *cache_server, *cache_name;
+	uint16_t cache_name_len;
+	uint64_t i;
+
+	for (i = 0; i < n; i++) {
+		items[i].value = NULL;
+		items[i].vallen = 0;
+		items[i].expires = 0;
+		items[i].status = -1;
+	}
+
+	struct uwsgi_cache *uc = cache_magic_resolve(cache, &cache_server, &cache_name, &cache_name_len);
+	if (uc) return uwsgi_cache_mget(uc, items, n);
+	if (cache_server) return cache_magic_mitems_remote("mget", cache_server, cache_name, cache_name_len, items, n);
+	return -1;
+}
+
+int uwsgi_cache_magic_mset(struct uwsgi_cache_mitem *items, uint64_t n, uint64_t flags, char *cache) {
+	char *cache_server, *cache_name;
+	uint16_t cache_name_len;
+	uint64_t i;
+
+	for (i = 0; i < n; i++) {
+		items[i].status = -1;
+	}
+
+	struct uwsgi_cache *uc = cache_magic_resolve(cache, &cache_server, &cache_name, &cache_name_len);
+	if (uc) return uwsgi_cache_mset(uc, items, n, flags);
+	if (cache_server) return cache_magic_mitems_remote(flags & UWSGI_CACHE_FLAG_UPDATE ? "mupdate" : "mset", cache_server, cache_name, cache_name_len, items, n);
+	return -1;
+}
+
+int uwsgi_cache_magic_mdel(struct uwsgi_cache_mitem *items, uint64_t n, char *cache) {
+	char *cache_server, *cache_name;
+	uint16_t cache_name_len;
+	uint64_t i;
+
+	for (i = 0; i < n; i++) {
+		items[i].status = -1;
+	}
+
+	struct uwsgi_cache *uc = cache_magic_resolve(cache, &cache_server, &cache_name, &cache_name_len);
+	if (uc) return uwsgi_cache_mdel(uc, items, n);
+	if (cache_server) return cache_magic_mitems_remote("mdel", cache_server, cache_name, cache_name_len, items, n);
+	return -1;
+}
+
+
+struct cache_catchup_context {
+	char *status;
+	uint16_t status_len;
+	uint64_t epoch;
+	uint64_t seq;
+	uint64_t items;
+	uint64_t size;
+};
+
+static void cache_catchup_hook(char *k, uint16_t kl, char *v, uint16_t vl, void *data) {
+	struct cache_catchup_context *ccc = (struct cache_catchup_context *) data;
+	if (!uwsgi_strncmp(k, kl, "status", 6)) {
+		ccc->status = v;
+		ccc->status_len = vl;
+	}
+	else if (!uwsgi_strncmp(k, kl, "epoch", 5)) {
+		ccc->epoch = uwsgi_str_num(v, vl);
+	}
+	else if (!uwsgi_strncmp(k, kl, "seq", 3)) {
+		ccc->seq = uwsgi_str_num(v, vl);
+	}
+	else if (!uwsgi_strncmp(k, kl, "items", 5)) {
+		ccc->items = uwsgi_str_num(v, vl);
+	}
+	else if (!uwsgi_strncmp(k, kl, "size", 4)) {
+		ccc->size = uwsgi_str_num(v, vl);
+	}
+}
+
+// ask for the changes after the last applied sequence: 0 on success, 1 if a full sync is needed, -1 on error
+static int cache_replog_catchup(struct uwsgi_cache *uc, char *node, uint64_t *epoch, uint64_t *seq) {
+	struct cache_catchup_context ccc;
+	char *body = NULL;
+	int i, ret = -1;
+
+	int fd = uwsgi_connect(node, 0, 0);
+	if (fd < 0) {
+		uwsgi_log("[cache-sync] unable to connect to the cache server\n");
+		return -1;
+	}
+
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(uwsgi.page_size);
+	ub->pos = 4;
+	if (uc->name && uwsgi_buffer_append_keyval(ub, "cache", 5, uc->name, uc->name_len)) goto end;
+	for (i = 0; i < UWSGI_CACHE_REPLOG_ORIGINS; i++) {
+		if (!uc->replog->origins[i].epoch) continue;
+		char since[(sizeof(UMAX64_STR) * 2) + 2];
+		int since_len = snprintf(since, sizeof(since), "%llu:%llu", (unsigned long long) uc->replog->origins[i].epoch, (unsigned long long) uc->replog->origins[i].seq);
+		if (uwsgi_buffer_append_keyval(ub, "since", 5, since, since_len)) goto end;
+	}
+	if (uwsgi_buffer_set_uh(ub, 111, 8)) goto end;
+
+	if (uwsgi_write_nb(fd, ub->buf, ub->pos, uwsgi.socket_timeout)) {
+		uwsgi_log("[cache-sync] unable to write to the cache server\n");
+		goto end;
+	}
+
+	size_t rlen = ub->pos;
+	if (uwsgi_read_with_realloc(fd, &ub->buf, &rlen, uwsgi.socket_timeout, NULL, NULL)) {
+		uwsgi_log("[cache-sync] unable to read from the cache server\n");
+		goto end;
+	}
+
+	memset(&ccc, 0, sizeof(struct cache_catchup_context));
+	if (uwsgi_hooked_parse(ub->buf, rlen, cache_catchup_hook, &ccc)) goto end;
+	*epoch = ccc.epoch;
+	*seq = ccc.seq;
+
+	if (!uwsgi_strncmp(ccc.status, ccc.status_len, "full", 4)) {
+		ret = 1;
+		goto end;
+	}
+	if (uwsgi_strncmp(ccc.status, ccc.status_len, "delta", 5)) goto end;
+
+	body = uwsgi_malloc(ccc.size ? ccc.size : 1);
+	if (ccc.size && uwsgi_read_nb(fd, body, ccc.size, uwsgi.socket_timeout)) {
+		uwsgi_log("[cache-sync] unable to read from the cache server\n");
+		goto end;
+	}
+	if (cache_replog_apply(uc, body, ccc.size, ccc.items)) {
+		uwsgi_log("[cache-sync] invalid delta received\n");
+		goto end;
+	}
+	cache_replog_track(uc, ccc.epoch, ccc.seq);
+	uwsgi_log("[cache-sync] applied %llu changes (sequence %llu of epoch %llu)\n", (unsigned long long) ccc.items,
+		(unsigned long long) ccc.seq, (unsigned long long) ccc.epoch);
+	ret = 0;
+end:
+	free(body);
+	uwsgi_buffer_destroy(ub);
+	close(fd);
+	return ret;
+}
+
 void uwsgi_cache_sync_from_nodes(struct uwsgi_cache *uc) {
 	struct uwsgi_string_list *usl = uc->sync_nodes;
 	while(usl) {
+		uint64_t epoch = 0, seq = 0;
+		if (uc->replog) {
+			uwsgi_log("[cache-sync] getting changes from %s ...\n", usl->value);
+			int ret = cache_replog_catchup(uc, usl->value, &epoch, &seq);
+			if (ret == 0) break;
+			if (ret < 0) goto next;
+		}
+
+		// a sharded cache has no single memory area to dump
+		if (uc->shards) {
+			uwsgi_log("[cache-sync] sharded cache \"%s\" cannot be fully synchronized\n", uc->name);
+			break;
+		}
+
 		uwsgi_log("[cache-sync] getting cache dump from %s ...\n", usl->value);
 		int fd = uwsgi_connect(usl->value, 0, 0);
 		if (fd < 0) {
@@ -2095,18 +4269,30 @@ void uwsgi_cache_sync_from_nodes(struct uwsgi_cache *uc) {
 
 		uwsgi_hooked_parse(ub->buf, rlen, cache_sync_hook, uc);
 
+		cache_store_begin(uc);
 		if (uwsgi_read_nb(fd, (char *) uc->items, uc->filesize, uwsgi.socket_timeout)) {
 			uwsgi_buffer_destroy(ub);
 			close(fd);
                         uwsgi_log("[cache-sync] unable to read from the cache server\n");
 			goto next;
                 }
+		cache_store_dirty(uc, uc->items, uc->filesize);
 
-		// reset the hashtable
-		memset(uc->hashtable, 0, sizeof(uint64_t) * UMAX16);
+		// reset the index
+		if (uc->buckets) {
+			memset(uc->buckets, 0, sizeof(struct uwsgi_cache_bucket) * uc->nbuckets);
+		}
+		else {
+			memset(uc->hashtable, 0, sizeof(uint64_t) * uc->hashsize);
+		}
 		// re-fill the hashtable
                 uwsgi_cache_fix(uc);
 
+		// the following changes will be requested as deltas
+		if (uc->replog && epoch) {
+			cache_replog_track(uc, epoch, seq);
+		}
+
 		uwsgi_buffer_destroy(ub);
 		close(fd);
 		break;
@@ -2139,6 +4325,19 @@ void uwsgi_cache_setup_nodes(struct uwsgi_cache *uc) {
 
 struct uwsgi_cache_item *uwsgi_cache_keys(struct uwsgi_cache *uc, uint64_t *pos, struct uwsgi_cache_item **uci) {
 
+	// in compact layout pos is the index entry
+	if (uc->buckets) {
+		for(;*pos < uc->nbuckets * UWSGI_CACHE_BUCKET_ENTRIES; (*pos)++) {
+			struct uwsgi_cache_bucket *ucb = &uc->buckets[*pos / UWSGI_CACHE_BUCKET_ENTRIES];
+			uint64_t entry = *pos % UWSGI_CACHE_BUCKET_ENTRIES;
+			if (!ucb->tags[entry]) continue;
+			*uci = cache_item(ucb->slots[entry]);
+			(*pos)++;
+			return *uci;
+		}
+		return NULL;
+	}
+
 	// security check
 	if (*pos >= uc->hashsize) return NULL;
 	// iterate hashtable
@@ -2170,3 +4369,31 @@ void uwsgi_cache_rwunlock(struct uwsgi_cache *uc) {
 char *uwsgi_cache_item_key(struct uwsgi_cache_item *uci) {
 	return uci->key;
 }
+
+/*
+	sharded caches
+
+	when a cache is created with shards=N, its items, hashtable, blocks and lru list are
+	partitioned in N independent caches, each one protected by its own lock.
+
+	Whenever you need to access a key, get the right partition with uwsgi_cache_shard()
+	and use it (lock included) in place of the main cache. For non-sharded caches the
+	main cache itself is returned.
+*/
+struct uwsgi_cache *uwsgi_cache_shard(struct uwsgi_cache *uc, char *key, uint16_t keylen) {
+	if (!uc->shards) return uc;
+	uint32_t hash = uc->hash->func(key, keylen);
+	// mix the hash to not correlate the shard with the hashtable slot of the shard
+	uint64_t mixed = ((uint64_t) hash * 0x9E3779B97F4A7C15ULL) >> 32;
+	return &uc->shard_caches[mixed % uc->shards];
+}
+
+struct uwsgi_cache *uwsgi_cache_shard_n(struct uwsgi_cache *uc, uint64_t n) {
+	if (!uc->shards) return uc;
+	return &uc->shard_caches[n];
+}
+
+uint64_t uwsgi_cache_nshards(struct uwsgi_cache *uc) {
+	if (!uc->shards) return 1;
+	return uc->shards;
+}
@@ -0,0 +1 @@
+char *uwsgi_config_py = "78daed7d6b73e336b2e8e7a35fc1556a2ec54492c733c9de5d6f942a8fad9968d7637b6d4f1ed771b1288a92195322c3871f49e5bfdfee0640022048519ec99ebd7b4f6a37b18846a3d1e86e341a0de033abf8fef2ddcc9a1761b4b0b2a72c0fd6bd5ef190ad42f73e48b330de5813cb7e35de1f2d827bbbd70bd7499ce6569c89bfd240fc9587eb80578d33a81567e360731fa6f166bc0af281fd015b72df9e5d1c4dddb34b7b8800c5c65b0703e7fae58d535675efa0721a8cb3240aa1daf5e80bf746857e758335aa0af7ac3551fc5a14f949a1967c7953f600fa5afe59cc9334f6832c930afd78b30c57bd651aafadfc360dbc45b85959bcfc8a3e0cad93d8bf63207192275e9a0502e22cc98177e7f829edf5f2f4e9a067c13f04fb4b111425e03ff1472f78f48324b766f46d9aa6712ac1ffb30e5f61e49f8f885cde5e13360ecbba46e4a69697a975355ab3db287814157f29e27c0bad499804990adf3bfff1350c03f074cc45ca0d37cb1846d09a4cacd730224bab121b90b6632f7d083736c3faeee8c8204b47472011b61f799b95edf482280bb64297638adf5cf6a77befa554ec388c414b6b13e78885a1ab50da2bdf07f15f044b0bab2769c045264e07ce81a8cc29b2c28d8a230df222ddf0626bf4e8c318a4c11efd7497de5d3006e40a6092406b47e7e7a6de9c9f4377ea5438d2d81d9d7f383afb707a05d5c34d3ea8a360c58067b40f15f9907ee74545208da88465b44fe3547ef9dada673065939280ad8b280f3965a03565b1844f031983aac29814402b1b094ed14092b2a1751ae7f03b0ad6c1260f16f4d1a91a5728d19a0306f0f11fd89747eee9f9c5d9d1f4f2f2ece2d23d3b3d39b59db2e267d6619ea7e1bcc81927ac75e06d328600eb5bcb62e3a36e5b6146c2e2dd7b61e4cda3c0f2360b094dc54c8e22bf0d2cb44356e26559b0b0f2d80a7381252b12ec685061101c50c9194a789dc6eec260f53eb39671ea0716b21788435b0862e93fad40b7ac75bc0864bd1b67b997e6d94398df8274fcf8eefb19f0a4260480761e6ebcf4c98dc22c870fd7604fa966b0703dfc8073c018ff05c30814e4b7d03df85f81fd057240beb197684907008f1c09360b2b5ed29f340939540dc80e52b016dc5615a9872cefb1ead0ce6f449a7d17a49b20b20facb71e988021fb183c063e1a18ed73b8f4168b34d3be4660c1811c1dc53d4898f60d7b956adf96210863bc09f3582f49fc34d03ea57191d79bf2bdc49b8730d385814edb93b7d6fbf673166fb44f59a6033dd6aa2d8279a1379c44c52adcb88b5027fdd7289c6b9f0a18863c789458f27baf07c3338fb3c065bec38495f4988d4c52303ba0d0eb04740387ce85ce27453e80420f54dfcd72106581017e543654415b4938611cc835989d88a08a8454e8d369bc09f4ca12184827232e70d96c3ca11a3d46370a85f8c2e67ede1598beb8d4532fb5b2c1a658f37e3cdcc207eb2a2d242206f1fc671498a1e5af1751b8091cc0a55041c6b93245d0335e4555f48ac8b1e7ff5284692055aa000cdcef5f3392ad178b9beb17d98df522eb5b2f2c247c8833d65034e80c2d19568113d43b4d44a5411478994e144c6de80594bed6d8f7a268c091c1f47c1b44d10439a656032660cd3f4dac972a17f01f305c6ef0085ee27e55892482a37d0edf04493b74aff23fd4099f8b09d9ccf0d76080d69f0b089fe8f10b204c22cf0f06f61e3a35aeed545fc6b52f23fe85e306590e13740496e1e380fd67481f37ab4aa5d86fd9c63348a7e6a130c8eb28d8942037bd5ab9683b1143c81125ea009fc709e08162797491ba0588e344069c9d4fe97b90a613aa64d3c44426601cc52becf3033a69a247c9f8c1836177d05f94e402fb6a7033bfb15e998607b0305ac628e70360327113fe58043e4c90d2086fa9d0ab4b01af413604a742d0469874c3fca97220c0014861fab80facd1f79f5b8b02d63bbe97071931b7d884bfb80f5eba017e678380393d1967f4267870c5276690c8018709967fc5a95e0028ece11f95f97ef4bdadb912152019534026b758d743b974ec2530820b41729b96b45653d4440294d60b7c9cc1b75d88aee02ad5414f0c6d43e2e5b763b00f599e0dec17d9de7815e636d8315104731f2d0cc56f6f9ee17f07ae8b36d0751dc73138b9eaeaf80b581b7cf12243b45c1f6c680508bf1fb105e16894dda2d3f2edf4f0d8569cdb29fd0790481315b8868a76bd7a8e7aa11a69eaf587a80eb4b39bea182a6c551d9a68830ca6ed4d0822920ff87f87d6d1db93c3779793eb1b58881f4b7fcfdee01f9c69fd7eff88cdb196671d59bc32ea5e1604d8eb65e04173b068f5d24076e6731e14d9b36036b8639e2d2023a4fe32f256a8797dab3ffe390e3703460beb4db4a81573fa787938570b81e072fd691c0458265ba0dc838635f42b12f85ae13e0edf578e32c6a4ceb02400fddfc07452f272fe043cae5b0158bad7b55df070c26a554890027061b89f156c4012c07a0d344fa16e075a90565541d09169bfbdfcddfa6dff775a448facdf5ec1afd7f02bb6f640f5f7364514f5c76008d75e3e2087860dd5500cca90b86f923a8e5f0ccab552bb4fcdf53534f85d6ef8c6d94d4fc34de32c68fa6e98357983639c5d60c6c0e943e55ca97dec0fd44d527cae58b75ee616190abc2b7c7c299c514665600218d867d08d3797c738177feb8577855d771fd81240abddb2b6dc56550e07918c57314205eb5fba218435f0f5cb83d7a433b697aeed964a3063df06b00cc04955b0667c5b4ede192e3a4258f9e1df436b5d641132d38a37d11314f991c796ac993c0a8a19035bf259b8f1a30246e4ebaa856f7ae0685a6b0f44d0e9fdd6fb2f51e2e640c6df7aff05fa2506ea7f15be035f38f2977febfd0e381d65fa78fd9ce903c4923961a564dbcef304730025430baae1524795527942d264f3d993124d2fdb262219a8d3e4e32d166e3c78acd4e291e487444a92a0478c12e2b8d9d5c2f451724dc61e3826204ccab7587c53fc3183343ff6441b8fd6171656ec29a57cd95d64b72e5bc5ac33690180565f5969ea4b638436d94465758a2bc8013206e41de01db9511c5a50d0fa1ab7330de6f5aab448d5d6a7b565da3316988d8b4b943a7961b9952db57e0bee70cbc36a0ccad9c8034bc07eb87956760ba84c7dea1f6b2c8b8bd4c7680705d79829050788c310c82db85341aa8330e91cdf7287530dd22e5bb7662ea66f3ecc4ed0cce3506b2e41ea85dc3e0af5ac28bcfe0b792a6ad7b65497a8dfb93af02cf073bde74240b4288a80c456be9e68646f21b25e5d25bbad3a4e1f208f4812cea24025864e61e131b0c9bdc4f8a6befae2f0b5312d2becb1f50687abc54beaf4ca186b04d7896636a1ff82c56e1374961760b3510b6bece5918e0ecb1aee64a176a0a305d847be85ff8ef1dfb2920b2da969059bc75aed8d88b920af5cd28241e10fb989c1d979c22298d6ca0773c0459cf0aea278ee4552a467a82afa508ff765e51456c6c8bf11db226acc08fa8b5b85d264a4471f695b6fb0f61eb3f0d76022f0398a1c852841a9b759058397c3b24d4d785062d8f6e400a614d0ee8946f510163aab6c3208879a5f9e8f171e46b311015849ad8c26282d5ea6f343ace1f36a7247ab8f9cae885cf93e6d1f34b8e6d07ae1d3161d56334ed1db3160d592046edda6efdf4c8fddf3930fef66a7973657466e052bdc41521230b083f53c582c8285cb62e599ad58952051390fb53263ad216285497b68c3bfab46af8d84ddb4054c5a9ae880b774861bbbd7990f62737e28b124487cd4ebd1316bfe787a7472783165641c57944c7ee28b685627522a9d9c1d1eb7d72045c8833545b8b411f8cc82193f7ea0a8ea042339308f6f72ef5101bac36c01c420fa30b1b5502f94dfdd638281fe15631895dfa8adaa1374e412720dd1aad875238b7e7bb8d1340b1d60e64faed220d818aa71fc6cefebbada8b3198f1c656706cbe003e7f389e9e0f5e64cedfd0d8261a48c4614e8c3002456df8c4c7cab691329601bdc4771a8b225f5a0794265af74e6d70786951ceaa4b76abf4d35e5678ecc3f3f3e9e9b1cb42328d9ace63385f4c14d551ebde7019e1c8f9bcb80872985f83059a60dac8cf0eac170be4966ab739b8d8c2c40a84f6804f76f56e6d0b02d576da716b21f3c3500b4e96f129513e9ebff2dcdbe0b1c6ca31456982814d60b653ae9bc40783fdd5da684409edd9bc4faa57675100a2f2459538ad1cf9875aac926c9a0a3219f56d0209b88495da457b16f93cfc28231bfb51ac6ce754f10256f14f8a57aa6a5dddecaa5ef40d3268df6eb1e935d6a83e7cbd73e0c031e66d6704db3611c0e38714ecde40ee5b552698c0831f64f22dbe8a401592f6e4590ec0d89ae1ce809fe26618cb6e600516ba3043f0c072eb218c226b1ee09eee1326012c8b88e347337eefa5615c40d534f4ef326b10857701a8e512fd9c3c58b1008ac32ba08188b32c9c47e4884163e0aea17f8ade07a860c653273a690f63c122ce5df424a1b14dae7212564ec0bb744e3b6fa5c098d4a01d89529d569bcc88d31efb4d4d9df1b3944202ee60b82ed65614dc0711664988be622e443b1988692cc0070698a1f557e753991b426cb2368676bb1b1881d580443331a488c4774aab22d0b1cfa59f4bbdeddf7aa9f5b98a1a1621fdbffdb4c1c59454c0100a2f534c56126edba4263cb92c79fa03b4e50f107e9e00973c9965b7ec4d573de88cef5fa612268a4c6a5183fb94aa51226f568f5afb3bccc112f60664edaa5282b7aa8bdc4c4d65cac236b5298184ea788b05c5cebdc865b198e68ce1c3e3e3d9d5ececf4f0c4bd3cfb0093eba5ad646bd651556c3236239635f5c20a711b5279095287939646ea44af730651288b320c645042481520f66310be307f1a879b50c6a7fad1b6583ef11dd19f7eeac3ff8c72b3b5e28b0cab56a32bb9092ca68291a086b452363ceef1e1152cfbcecf8ebe0599923202b9dfde4002f94b5477d2177410218401165e4bc2d27fb1b05ebcb15efc68bdf8f6e0c5fb8317977ddec86a4d0015958ef0a8c176e6659ada35f79ea45879fff3cf3fe789f02c9681098a6502621a5850de77ca1c0b11cc13037a208724a970423086442ee3ce815a53da4390849c97ebfb09b827d6501c1b923a0c603edb8130953417ad1b4b56b5669b9b36c39a44e4fb4d3c0a30e5555baacb969005d8f5c54863a89defa20cad7a08f523284e623d3a60deedd62442722dba3164f50731827ef8b6f3a90866fcf883024fb28e60c65a9038d637fa4ece3635174d58bc0949d7bb849ca4b053d61e77ea147b927a7377efa8e164438c6affa6b1d41cab92da083317b3cff2803377903488b6c0883159bd86b979e4c0c4d2b3aa0cd066e5680ec275ef20a78167396762c7a4d7145ddb1ebd53626b26345bc278cf08e5b537c9bb483ce61bdaf69e419e106088db386c0879de77910cb0c031e0ad0226ec8feb839b66a02f405b936b5b04cc8c9ce99809a26c2de887394c8d8f59fa24d8c32560f6ef46491a6368ce384f483b54fa3917b3006599b133781e88f261d8599fe127ea00cc704b30d0a3350c4a03f5e69aabd562fefa8feaaf68ce9d47c05f7eea63604402b3b494f732f29679908e309045699bf6b0a912cdeb936755a5a5ca88e52467db5ad8065ce720da7dea3e8e779d139f60dce9d71f34748d84a04282c6564e719bf9a9a084f3a1d73558f5c67de0ed54339e73071b9b0275734f6697574d4462b2bfc1336eee91be0cf3cd0e60759460ab63dd861dd38ed9dc3360769835d7d21ee5c998bc74e1ebfb4647bdb1147dd6e6d2755b671a3c4a35355dc8b45377311b112b5318b89c7bb833ea2bde684391df621b3f92f74dae489394ad5a054151f74e0b997f4faeff01ec461d9f573ace5cfd37b3d3c38b1f99aa0fad327d7b27f35a1e4edcdcb93c9d1796fca3d41acd45b495924d80cc31ff6fbf22974802977a68a9bf5b26635a5668ad3a6d42a467a76975952cb586334fb5b49dcad00eec6243c9eb79cc92d679a7b1232d0287e37117828520b7867c340c06c2986e13705812fa31c61a19b3f94f6b344a034a8f85f9f6696db9bc972f32f8df84fe2d0681d85f9e8faa4950390420e548a1f8f2f246fcee3a54d5704934b7831b864baabbeb507dbae132eb1da8af896f6dbec59609ba2517bbbdab3502471938e5b8f59107968b21be434b880011ad1c62b359d6966b5783edd4c6d9b06ca1d41fbe1ac113155bd622dbbbb38c8bcdc2f552ffb63cdc6a02cb3ccc02ff3558b8d5b98feb9b5e93a2097f92c83ce6aba6d601a01a48ed0869d9c27b85e85a1a57a75c11bdf912e30e2d37b3ab73d335be0a716af699c5008014d46aef107b90d028a3548b6349e1ab2a6385879126752853d2140ff67098cef12bf2bd317ca546ad6a61ab84962e0ca6ded9f6308adeb2d62666b150b31857a9d76661781e28ea576118021f5a9893d97034a7c7a772972e4b68da15027fc13d3d7c3fb58725a3451df9a0289451848f6f53d593088554f5c57454ce465a55a7da000896c856e92a840e6883654554431a3ca2ced9eeb19a57a98e5c63523e25b33abba2cb997ba9a63855928613130e7a1516c514ab112dcf439fb2abf8f855682391e46b7bb09a4b0b66edc9d42b4dd3fd3003316c8eeab9968eefda4b06740663587257eaa569932b52928c797ab19464acb48319c7cfa04a75c7390b9c9dfad00d33ea84de5d364a917400c27cf8216a38fb603cf7200d3d2d51caa16782a0c6c5e50312b2e07ca6ff5306dca57b3cac1a545fc99893f6da58a8d4bd0b28ad82fd3a3024aa4fc4d856158622ce5a7d120e91da8e91747131c956f2fb2a03f238f7227e7414f7233135d002ff2786852311286d885a23abba3d45325a42f6c6e0428309d9eb3bd6d7f24849c6d11ed3524d7cd167282f73b35b2fc569309ca760ae648fbea6eb0cd4e2a01626816292095a0fe0269d540fe9e8ac57c22cc29402ae4f622a28f5c6a097b5062be491576cc07308310b0696a0d5d452e12b652299d3ac56c6a0a406e660b5c511004c7370f9c98781d85bafce2395bbed7250fa36cf9383bd3db6bdd90891b5832c398e8aae8714a78345cd31aaad667932499146c0e057fa5d40b52bb78cd5c669005343962b101505e414cafe072f32620c63d339bb301e5f058ff9ecec7baa9a0ed486c7f093724c4aa60f2d7118786217f972f417bb762c8f77b95e573ee7a695f47a7ee4659955e00d660376ec45f8622801ae8b27345d779005d172580e161ed7cc03760e441a247efe03e6838a3d58b1cccbe0dbfaa59e9500cc3a40b17c93da58fea1669762240e49305c4f32e81719f9584c6e45aab0d467f518575bea2cc7a12fe28b28694a1b2d6bd43354c52126cca24df42c5a8eb696492b3c5c19c19f2a2e1a2f74e9944edbdba1335212aca093e538a922a6f74139a6e6655e9ea70369b4312d0ebd2a138725b071093430dba3b6e31e3a9e65b2150955112e06ae44551f83f6ed8b3c8c2837987ee19e59ecc751f9218bfdbb202f7f46f16a85d7560d0d98d6c0e6202d41d94f57c51facc142c41510087fb87c32a32bd87031328a79e6c3ca0467dcea23789d15ea0ce66836c406645ef6b4f175d2e84c778560192ee3f247bc5c46b1b730220b638584b042fc10cc19c324b292388e902d0644d9669d54ac110198aa2e1b6da987799108861ad0f978baac84466b57fe9817cba53436291d593422216da820bd088fc69704a512fb6fe3f8ce4c48751049488d4497ef01dfcb5fec9499190d399e1516d0bb5b7d08e96e368961b7c5e62e308f1aad902a6ed3a56e2567c3d5c69384deb82f586ac80af3454b60f4dee6f17a2e33be92a96c8d1c338937de6f587527c0bc77490f1907994bd3243de4a0c1ffbdaab938bd7359ae9a2c930befbefcf96b50983b9626951cafbc3c78f09ea4018c13492ae3bb3068e271fac4b857c9dadca5dbf2248ea5de2663d772844d63cfd2e2aa921b29ed17d64e96305499d9d895d14682db9b7b993c8fb581b286bbc1a2fbd71114b7f3fdce88b3eea08991607e9784cbd342ae6f94198ccfa6b3d3a3930fc7d3e653516674da21290dd78d3129ab4c22d1a6a0d1d92b7df847b371edd3f7b07ead7f647b67b5cf62576db20812588f80282f46f2251cb51ac7eec9e1c5bbe9dbd9c99427151b40a8f4eceddbcbe995fb66767539f9f397b6413ad92cada6cc28073d6929d6671932fda105cb4e71ac0cc0d840e35aad3ab353860a2576264ff96dbc71c186ddbbe2da902ac78a0207b8261757c0d91c06d16560deededdb8272ef596bbfbdfc7dfcdbfeefb6b850e7733d1bde31fba3618607dc0d141bfda432d87a0d82808b594345499845f214bffbf3a64c7d8fb35eaf29d07f126e8a47bb960f5b5d130d5ea91d7a30c0869b898caa088b95bd08b1bacab9e0c63dcae80eaf0c9388c52b6c98da8ccd498014e2a15ab80582c7f8d93d4fd2f77df6fdcffaf757ecfb5fcdf16d89ed5216f6d99bcbb393e9d5d43d999d7ef8c1fdc7f4e2747ad2b00d651803fb2c5a588ccdbdddf69ad444107de4de9d7eb01ba54622df75bffd7001ff964d100e5a758b39bf9e8d62828b629d2c8b2812a5f481ffc0f5162c026b2b36191bf21b6094653fde10ed3488d8b6fd267ec93410b41ea10ae02274fb66857c35b5be01f711fd6e0e4f600833cc8dfb3b7e920865156b8f0c574cfc1a226afd9e9d913d77847debffb431e4da52f016ef2ad6501ad3a811581986ea52a5f178fc0d480b6d493108eb36488383a65dedb277c67d334acea9b536655142de0a5988ade8cd9b63849fc1b4a8ad3c2d0be9e744b16b8ff8c44137ea9b8ea9d7b06cbb0ca45d818dae87bd5764e99e3403d16f58127851f955b2e8d2191a1913cea6d5ecd804a4eea535411dd413ba8958f5048f524570b26142300d44a865d4567ed7c5f4fdd977d36eee1751b7f15590eb0644378dc78d5ab365ea5de01989f0ad31a16f5b2e62cd90b7c6b9ca53f4425f491879bcab465f9b5592cc1d6d72c51b7e2faa54d034d722c8dafb394ef99126332ed226438ebe19ba216f9f9a0a37db9ad2b358cca6ff3344677d357ec962e8789e912ec5c7f71cb2709d444f56ffab7e2b0d2f3baab89eb5d27f8a0b6b13605bd691d88d4c715b80ed7a5068bfef68ab37ca704623e5e7232f0a3d8a72d26d79300d318f8fb937d8afafad2fc7af65496abcf992a2f0836a14a1a6fe09c0be149879e7bfb65e6f75450df4da37324d550bdf400bdbd07d1f3cc222188d212d578a0dde898f57c47aeb80475fa8601dd28308a36518448b11dd3008cdff8a8be986d68dfdfb6b079f099b639ebd25fd8dc93a059e39542d6b1fb0f7f9c316556ba2fb5f75694ee00f579b60b1c1808aa345daab0c1a7df5c49330d4e5935699ddfd03bc8e12b6e54d4c8d2896354a174f1b6f1dfa2a17d51b2e99fb3a644e27fbcfdedddb3408f0da4b93c060935507a345643b6d8e6c85ac9b470b555c51853cdb6d04ccb385cc53f90ecb70738b2749f1a11af9a8b4f82c4fb5fc9bda17feb1e6df62aa28bf23da08a23652bbc38c17195d155e26e7dc6ac7600d0dbcc808a8113518c93489d93583282ebffd5e9b7c198bb04772009e7d15bb2c662a64dcd7acc28dcc5af669281e2c98d8da98861d7692d4566ad3d28e5b1552ab4d5b159c8f9d6ef10d5b762b2a3c268e93007567b5e4ccf24a78956d2cf22a592811f13a2d0e50c6866458364ce22f5776cc6eba3ca04ee3b904054a59357cd19658db9134397684bfaff70f6e5a8e1528b06490e862d72d6494c389cea191bdd56e2b92cc365a29f9e21ebd45a99b32be4cee8c045d215ba9c884c2685752d65c41422334cec439c05653195e6902538b45d7d2889f4b5ca8f50d0b24b61bcd8932ed90138e8efe55f58089f9f192eeadb24b6b050b17014e0ba0141bcec9875b2f4756ca073d51fb28f17ba19f6c95550c59b830886c957f83fe20a558f1878cc694ebc25b34a8512d7f48dc46cd9d7e89648d5ab15c10e6b9792d5bdf21ef5739ffbc1a6fc26964b7120b506e899665955d5688f4c8b9a03ca3407930a02abdbb5f97bbb4b6700cc0564bf76c9f0639ffeb38f556f1e66df4641be3fae717672c5afdddf4e262763cddbec0e4e799eb2bcc1aaa7289f93793d5ba03ddad1d6a1e5afb4eafd1ae6115e32af9f0d23d99bdd9be379199539b804d398c96c94fca94fc50d36d89bced1b9530aa2c8ba578460aef76eae2c431e4df02f6d9dbc3e3e38b4b5b7f15874552c5eb5437a60c1dd54b9544a5920a496eea31c87a2fc41b59d80dbac941cb24a9076cf6e42ae60b0d3e164723176786f891d35c5dcb17b74727527dbc65a841365b066ffac3f46876faf6aca9aae687974f9039bda6d07909d23ee25b560e5b07f7e05376b51bed7582e8d6a59d14e6ffa02e6e5feffc6a8231df40f46b7de0d59ba7b60e83d0af83ed9b3d312cc4cab09271c3c774b301abc5a333e65afb0db5d8d6123bde5436fd8584b1e1460f5ef51bebab97bbec15b1413a9d7eef9e9d4f4fc9e874de273a0d1e2cc1ca4fba5374596cce2eededabf4326b68bb7ca5792701c3bdc0acd8c0dae931d03703e13b0ca21c626c9207633d295ed824118e76076e066bc3143cc9afadfd7d6b1107cca7bcf5eef14abafc36ce724a6664fbe3147fc5c7a6b27c6172ff060afd13eb2bf6d48c44dc37d6fecb1dcdcce587d333343457d38b53f7727af5edd9e5159de568b2ae75835ed7664e70f528b0b2e23a059bb5c9bd468348035fdea950068b9c4f6795c1dd331b64e10796dd53c34e8d9e80a8b75de201b2ad27ec3597263426a66c812ce36f1d342c8ef336da8c3ba61250db43305b44f114246f7afa9dfbddd9ecb8b34b707a06027b7a8c1ef22e75b6f90ff5ddf89363f7627a78727e78f5ad5669412c798649f9cc7aeff96797d6b7e1ead6ba0c8334f5489bbd390cdb013e14eb07d60f47f80ccbfe4bbc66320d6c341e98ec8f362f1befbf1c7f555bbbcae47c33b1f6ff77c71158af3d3fce1e477c61340273328106fe6a777a2e6a078c5fd52d45874b5c76370b1daeb7e988f433b1ad62d1ae41264512f0a712ad659fc4731dca05f554525ffbd177bacc8a005a77108d131ed56b8833b3d7a4ca27936a693bd59d47d00be3f353325e98b02cfe442f1e6ee20fd4973935acc45dd3cb41124fc4abbeb02af28a3cd6ef0a53aa4d384c7be606db1ac0a5d2569fc34099cd0da28bbba15a82cc671637f556b1ce1f310494e578112cbb28ca5b3c893744f05857794487e1d7677e943f64153dc52ed0fe158fca848fc09eb597dce275e596ef6df0a2598e6c1ee40f41b0116d0459af163d6c5c81b66d91b4ee402f6517b9bb0d930f265718be69cc75320e06b2c30576d81f73754d338fcc694b3b505247d79838a46304f3e76649b8a1fceb66a41d6fe2d2b1030d8bf8211362dcaa54aac8775ffa9d9c1dfdc3fd703975df7fb89afea0bcccfe09148565f1d4682dc7e119749e9f5dce7e00afe0bded6c6946199c67b4747609ed9ccf4ef1c3d6c6d4b17a466b2013c767df5fd6c6a1e99c8a19ddecfc0858e31e028ed9d5330cb198378449a73524cc03f7923db35b5f62aed797dbd5671b3a2560986be87b7da6290f1518e619b9ca2eb34c5d0f95c66de85114d9ad889ae62515d122b8afa3e28b4f665987eccfb6984453ea6a89c33124089860294c411e64cb552a6a077068ed6db315b79d30464df3d6f6a0bbb38d9577ecacc98e16b7e64f98a70dbdd338642d82c6e4a3bb8a4ebf9b9e5e91ca4fcfcf4e4e74cba261e73d7d0efa7ffcf3c3f4c3740b7e2194cf69e078fa5d871e90d43c07fdf9d9c5d556dccf249dd35df397998141ab55b5a4db2c3a6c63b059f4bd6eb3e87383cd92ab7c9ccdba733d989cbb1a8d3b170fece0a5af58cd141dfd0c8a84bfc8800cc15071772e963bf57742abd6844963985eddec703dcc9d21834eb367ac372d042823c30664b9b0cdc9060c61651e5f7df591389b3aa622d8e035b8bd2d7e69d33cf3ef3b81a89d6413c87fd30ca292226690166d1463baab7db99abd9f5e9095a1bfde1e9b43a7f59825d8933ddee8ee9b490d6dbba767b3d323dd8c6a3d7de6245335669e6ab4569e3511546dd4a6835dfc621dd9e9d9e9d464ff99b146fb5f11afdb7fdccd58c79b308f4db380545a9f0ba4c28619a15efde3e605033976c80f85ffc7591b5367ff3b9d56133d26c3631c74314abb0a3906cbdf9f9dceaece98a8cf4ecfae666f7fd495d3d8e6330d81dea4d91c185b7c9651d0dbfb04a64147d96420640dbee15794c89daaefcd93e2aff1cd02dfc5a30274cb36a593da749325ee67fa0d5b5aad75698ef259a97dd02953a204779ed7dccfc14ecd95e00646f2122561b7a9ed06a6b65eb7d4059afac46f9838e8b8192aae62ebbc6d52c3c0a8b0f5dda27863f94f2b3043d643602d62f211e8dcc7f9ecc81a8494ae888c09fd306fdd8bed186d3413b784d6ba6e9b1960db14edf0d2bdfcf6f0627a8ca95f1787173fd6a5b05b14d64c39dfd869c938aa552936ecdedc85c52bbb511cdf1549a3c495b7d1ef925df3e6e4f0e81f78d3b2f6d292116d53cb0fb7611eecdaf2f7dfceaea6ad2d4b68a596d12b4dfc34284f4f4adafb4b11a20ef1e20a137e50cf3028b0daa134f8e2f21324fcc02c217835e229f9a31196fea52e21654d43be0a169537038873b81a5a56de77ccb59938c84f249f1f5d4c5ff53be87a5397d41ed9ce0e647f1cd5fd96f95026b64a63de3e6e7a29cd5fe49dd2d67685166c9539ad5aba940e0009c72ddd959359c5c6bbf7c208f727c7f2c5ab64f8f018465a2479b0185b3fc6054bb0c96328006b1745d4b4b5c0670ae304670e2b0195f25601c6fc1621db2545987e87e4e86ee2569bf04ad84ee6531a76a7e32508fc66a155f098d8dddb60d251879794bc968927caccc17d52f5e664443207695ce0de68eb8c5cc2342d725aa9e9c22bd140d764bb52812ece3e5ccd4edff5db13ed04fe1bd329f6169760576a9f47692395ede9a31885f0bdc49b87113e8578cbdfb3d8bada6c23f2e8f0bcbf3d3b095a6dc8192de90983ac6b3f8a225cece1bfca2e28072c6c4aa2e8309b969df8f06176dc6f76593a9c699437201a7728cc89dd74ffc99cba93c55bb3c8bb8387f33f7fb92366ad42b7a50082373bf20426ce6c186c863a723ab8c2ca918922e54c081e1106b05e2b40736bddce0a68034f699c3511fd19a6bbdd8f36bcbd984ef1882a78d17f3f9c9d7448fbc3766aa77fe5dbb64d6e40d9357edeb48a9298e8d5b0996f119fbe7f03deffd1d9e9dbd9bb96a0a8f90af1b6e6a41d62a9a06195db8ebeebab26f4a489faa0460dbb33acb7e834b8445bdf35d9e531939d6610795426d2eb21a455ca1dedf5ce3cbf25777a7a2cb706803bb5c58a30fc926d91370ced5c9ac54d4262d807565ad0458cbed7b1b662ac6eb397c05a1302898ea59bd0753a13f8b3ed294be6ccaef9d61e2974435895deefe4685bdebd64ad53bb0cb6e9094cb5e512bae13dc9dadd65c1b2e5802e9d9914f75e0fcb3fc11360770c67fc00db8317ddb56312d868041a86a806cfaf2296ce324ac42c9dad083ec29e2cf96dce4bf5dadca67f767c1fe993d815d3396c2607079d6ec07bfe6348eaa19cdd1f46aa7eb1279268a9697825490c027f10a9344fac978ef48920af996a390737f53a4bedf6e06e03daf905a5b6416d7a4aa9bbf856ab954efd697fe0ed239402783ba4e73d3e911a7c12f16fe312d0dafe4859177df9383df938fd68d30e1a8d46d5d00a5a39f11142df59d87b5d5cecefa61797b3b3530a99e2e580dad2c0b2298a2a212ba0cc7db88dd975ed32b498ac47ea116d3e0157f52800a2cdc154ea17591eaf71dbb02de95205add0e26cad52b988c98d90405edec8bbb52a349fcecb9af27c4e1fd7decf4af9be5e1ee28d88f64b5bfd9c06f7fcb3912588ca90cc2361ac5a7c75d38ee3b501076bbec2f1fa6627c170df1c5e4e274c344a2e8158f4f52b82b7a0797ff8f7b30b090f32f3396866a72a9a70f31c3417d3ef664cec4b4cc8a767603afa707975f6be521f49380dcaa3c4019ebc75b44b44e6c7c3f727fdce67921976637c898a28d7593c506f37872d191e8a83c13a9b7e1decb40c8285bb81f2a6c5bb816c33e9829806e6fe9c19432b3a009b6128185bdef050ef1ec2e2b24cdeb1b85be91b16d6cfde2603c8be310f44e0e87c145a54d83d9cfbf7cbb3d3beb36bf89831a4e5e60369a08c5ca0ad909207edb1646a8cc69157b05b2e43d2a24804bfd32d0fff42ce50fc89f5e81370a0c951ea28904fdecf51bff18c53bb446a40d24569e2c20dc4becd1f93082d31a5ec3a599bd5df7247d40e2af11183ff7c01d8513dd8883c9f7e9804fe7ed2d289ba7411973b5cdd250c22e5d9a4b5b4a8865d4d2ebb14f1c5963ecdf6a6c00acb00422aef748a06a49dce6d032bed7876ebbfd0c8ff9909fe6726f8379f090cbaf84955b021c9a0805500a9663735dc5d05c96c3d5bff1a26beff7f94af6d9ef99839a6ebfcd2a0b2084c7e839ba741f06facb92dbec9bf05fb12bcaff53f987feed9c9f14e3c74e368f14cbbf9e9fc969ab3a2594cc9afd9d1689a17b95916b5ae71a97c4bba515dcaf0625da8b907ff7f9e845d5e9ef4bb8b0a11d919da4f9f923cb67796df2dad982b45c12adc3a7d23e65d53a276625c77a6edc4b09d99f51c4619996416e6c775bb303faeb7083300a8ae015679b53523151a113595ccaf3fb525651bb9cdd198c5a5465d5fa5ae31e9b541685a1b6b13b21fde9f58d2df189f83ffbcda7d4ae0146c518f472960873dee3cd9058f89973fcf00e95d9cfe707e78b58349a2a6ed3f9a21ac95367ff8510ebd12f3fe08a96fcc5eae673023ea4f33550a642db32580108be4e9f287f7273b2e31dadd807fa10e77e5f8ff535cdfc6f9ed9be3bb9ab64f6bde3e4aa3bb9bb946bd663660372fa1ab75dbc5b23d8b074d16cd3cbfb33768dd4598ee92027a7ef2e1ddecd43d9e5d349eea91119b37bc2408f5049e5cb581ec45302f56bb6cd31d4fdf7c78d777b6c3affa666a598b5bbca562330ff38e649dbe99a17ce837cd2b633e942b0f951364c34a927abd1e5e4a1f662e5e3198072e63e0805ed162b470e4dee689becad9cac9f2d161f7682d1fd9c61bbe787bb0b7877b6ff867c6ff5e8539ff2bcb6ef12f3caed513d7e137360dd570288171ac65b6d30fb5c7499cf0177df0752306263ffdb252795921e27f5d1f8cbebce949a9946a461f879230e05869791ad7d82d7ab438c2db2f8644e40d1d8ad50e79eb065535a06da8137c76e36668f90f8b8920aa43037ccc780d607579b31edec68db9833d7e79dda9b7965f69c3211120341243ab905f8040f65ab89e64c3840f8825da9d7d3e3b29ceefa41c244ff4becbc061fcc1ac1fc02f1f77869f03ac444d4962c175b94864912892ea191e2511b3a458a276ceb31f0514e63ae0270627dd8b10dfc3341bf267e5aa5774d90b85a23670d250b948aeed7747472e9e53241dbfa6566f1400baaf180ba9ace1666f2e89f5a729381d00df2be71eedf55cb5dfe508da2f32f66035e3e53879424b5b8eab4118b9a3c244027d137417c0e15862f656993a8a2f27d97d8e4acaafd0031cf85a037bcab87cf7a9905e0e41d6f0e21be9156aacc59ff06aac26ca6bf5666f5a2a61a15ee362facf0fb38b6973ad1240aec935acd2112eb8e4bac9a60c0afda125cc706981d1f80e2d9406f9991a3ed2ec8d45beabba276632ae0f647f8385ebe5fc9a8f31fe6b5071bccd986bc6d06c7c9b14c09b67f8dfd23af64a9a874c2f0d5acb615cedc9ebeb831bb5e08b89220da25af5c61bffabaa288a78cd5220caaaec7c6835ee62e0e800a828aa0697d78bb3dc65feb79483ae5c4caa80208eea037f2f8edbd67f044fda0398d59df4a2e363f0e483341fbc1cb297cdab6124db555b58708b561915930ebb3597e145c6076652fe459990151e268ce218b5d261e9d1adc2d75f38a35a9abd72db7d3f96a109ae1ff97d84615c00688a9304e0ad7e54cda18f84800400bcda0717c291996db885b5e2369e07f2a502ee2506f49e0e3422fb8e4c83d1831cea45cc23c53cb03dcc0da3b1801f9ca1b6692894966a15088e5feb802c432b2f2e586085c29d538d56fb45033ac2ea6a01abf9ce00861b879aa60e6608e5a94d7158084676b86a97e5eb6b0faaa15da98206b786c9978e3bd60b5b4bd76d85abb8ad34de463fd94231f28c45f06becb75edc62e2d4ca78e8b0ae33f8c86680e6c3f0086d3b614e3994f36a289920bf999d1e5efcc846740812d5f63c5ad72cf73d9ee82e0e98b009819abedebf116e9ff8edf476cc7637b8c76d49ee06ef98ccbef62ead5db936884674c8f0d4c76eb9ebcfc9556739ea9c91c4c25e63963e26a2db046ad779ed3843f3258498c86ec649355fdeec5a8fda6dc1683868d57472b03557de30f84de9f10d03ff71835f8ba0f0513232bffb137edd2e8aa9358eafede63e2ca7f2c072dde3c3ab434b080e11441ea39ba420688f03db65add8c372949d9a323a9aa3e59677b980f4a2118a86a311bd40cca70d7b5859175607f5c250bfc5b094d0e25d03f6b3c6bfa627c4eb5e944a76090cf4b3876be822a691b7cc83942e40a2db99eca10c48a676d219fc210df3809e7cdeac3213a616807003521728df9250fc76a479b8e4aebf0b737d85b7fe3359dbfeeec5d666d993d84b2fcb476b10394dadead0abd562feda7e1e9d1d6f8eea423360f0ef46606f725ae8d6c8d604b7b546e72ee035596e12fae8ac59ec5aaa1e8f4bb45caab563efd5464ec6d62862cf9c967e66c46fe1c123856857d811b62c663686fd4f9d9d404086b50686263f7468f2882505004feae718d69fc526fcc57df0d20d6acd400c903caf95a0c23a3a1dd0f061733ac1e215388ea48b344db92c9e4596c18d8b3c29f241fffa4576c378447c4176c8fd0373cbd9ea9441038c566b131a87a91fd5a3eb8a726d5e937692aa598cad46618458eb16942245eac1db5a74465188ea6e24fd11188c0060c4cf1e33511371089077cc11005fe8c1e032a509da0e334a821993851cf40508b8413fd1a2344d346c633f8ab360a07e05374008ac70b298b48e46de6231e2d431ed98182997464e164a6504ebceaa491070893e1414e92fb3d5bc17f36097fdcac605ce0f774dfcde69d55b85264cf18b41e10b0780491593238c271d582ff0ca0f587d2f98d24b91266b548f45394e4f93ce4a1a116bce1e8f123b9d281b00c0e594afece5c532aeadf07a161157bb8759395db9c8c33918dcf27174f82f5091f237a1d1bfc177cfb9dd034e0469cedf68e6a1142a102f3f5fdf94b32d60a7b9963da28e8d49428bafe5c4099ae3d16819a3d77817f097df335983a0d6f5c1ab1b7a0f7a34ea539ff1501f7c371c099c832777676ac3030fadc8d9be04fc7c8d5bb7a3d7e397b5a6f67953b596f6db5aa2de0ba7122b88d78923a5fbd7078890bdb5cdf89405393d17cfa1a8281b72468c99f688b7b98144971ed0755da2d175d71e0caedb17914e440143704695f973f58e54360635168f88f747f3fe10594a020a7f7aa40b93be9007f824fe9c68a2828f5867f9a42faa82de25fc97e5595912f8e112a645fef03c294d1adf870b986571c79c3da03d0e3721d45d030300fda4cfdf3dee3713bc6404f30c8267515cd6652467183df2605e665c201189f0f59afb209d8381dc8dbe82d147db8e1279208369e0e27991be204380c88ca36f82672dad24ac151e717c1617cabaeac071dbe2558ff7b06b5185380296272bf7ee820c80592531c428950ab3282c695d73a6ddb4f4e791f587de347b66af78b708856bee1c3db616a4d087966ef2be6dcafe968f9d2fc2d4d43d8cf3b6f5cde7121b05dea65d220408239a7ee10b808ccd2d2d04bc05bcba6c4b0b1c84b59016e0072709fbd88cfe9ea1afd4a1a5810a8835b10608a1485bfbb1620dd1be7e7b3302441e5eda43a502ba3c218ec0847acb254cef19987b90da6511455b69f0180d5eb66db038448d027c429cdebef236611efe1ac01c1ae6366a0ba38db5c4a6ed46ea883c3e19633760da7068038b08a6ffb8f851da9ee2c063ceec6aa2e21fcaad952a59023b5e6e20f1391bbf55bb43526c5ce0a75e54d82b1c553845be624bc2a702e878919f46b4a8b350eb1aabe16ece527076c259cdbec2b2385e87f9689982191a2531e578d937664ab6e3bca95358a68fa103813e8fc53670a890f3512a95d60059c5e666f8e605350fe997680cd793f1743b8554fda225737e995e956f244a75dbc36e657de35d5bdcf62393a5295fbd1118fb36d7cece3228534b784d1f95ca28304acfb799e7f5534b82449bd8823f78648f0aa4eb2d70155f1cc1b701950c2b962b044b7a831e6e2557e6ad8e866dea728bcc5df9b082a945e7ab56ea83a6aa4605694462240effd1b44182d5a3b5f488d0604b87da766c380a45ced98e202dc606b8995f327b48e013fc9723a5667001251fe9c08c85c64e1a668265b264c0c49c80b6ad1a4d375805390aff9fae1b4daa5111f95c29af315b2415a9bc7ed595d7bcba22617250a7ca00c6c759695d176ee84d5bee0b56eb668d04f9f953250fa506b73529c52084b2c37af03ccae9a5d93af93266a513d56454cae5b52da7125cba6f3ecc4e8ea717ae481ce1b955b849af09739f81a0dbd4770498d65435f3cf94e04bc69c9220dd93a4bef23ef496782e4a43532601d826640a8b3aabb5f2f4ac512234d6b377a10d92c13e3748062d00a4f4032de4d54fd7d6686951eef1e7e3b86f8e7d35d4c2c07abc7b35bc4178f7b6d858ef7dbe7b5576c1d8ced588278b38776fc7fe336ab2dc18377932d656c708d74e2d63249657d668b4f61ef909886cb2fff2e54bf81450a47982270e46bfb0b64b6ef12122965b5ee2019a577b467294c418be42a0902aae4d06e640f5ff054a6767af";
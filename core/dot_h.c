@@ -0,0 +1 @@
+char *uwsgi_dot_h = "78dad4bd6977dc469228fa99fa1568cf997191ad85a428593d9cee7b688a92392d911a9272dbd7e383832aa0aa60a2806a2c5cecdbfffdc5927b265028b5e7ddf7fab4c5426664e49e191119cb8bbda8fbdbf5fbf368efc593272ff6a2bc4cb3b28d9ee56fa267d31aff6bf09f79f4acd88f9e95eba6807ff335fe9c353221cd0fa0040020927fc9e769368fe278b62eba06ff7b923db4595d465f9d7e15fdf6e45fb232cde70007507999459fb1faf8d387cfefcf2fe2934fe73b876ede7727d7f1e5bb771f2e4fdec69fbffdfcee3a3a30403e9efc70f07ae7f5ab572f5f5b896f760e5fbdb6e15e1fc5d73757d157076f8e8e5e7f7374b4ffcdcb6ff6fff4ead5c1eb83575f294803f0d99f0e0f5fbefce670ffe5eb37af8ebef9e6d59bfd375fb9cd3bbb780bcd8b2f3fdd9c5f5e5c47bf45179f3f7c781aedd3fff9b7f9effe3f9e6a0cdd7db3c8e3acaeab7af2b01b89efa25a4cbefad7e6dfa37f6da29fe0bf0241ff35fdf9bfcbaf9e460f4fa3a6adb908fc5b56bb4f61b0df9d7f388b63fcf5e1fc027eed1e87ea88eb2c29d649bb742b53e9bb5135c76ae7495e64e9efda02a8286e92794675e7f36842c9cfab3a5fe4655250fe3c8dfef0e7e870374abbf56118e029661f1b8d7fe8e9ebff445dbff7ac60357999b779525033ffc0cd282b991a575dbbeeda5d0d1fc0901449bd9a40139e3f7fbe6bb6f627fafd8cf2bfc236c6f1f727f1c9d5fb6b688b83689eb4509d5a8af6ca3c8eb287bc9d1cf40c75b5ce4a774951da7fc380fdf757bbbfeb98d5d9df8d1d83a326939ffda5aba1f6ac8cfe12ed47fff66f91ce5865edb24ac37975b6aada2c4ed2b49600c628c677593dad9a2c38f7b076eabc5c44fffa7cafe17f26f8efee16fd7bfadf4f7676420d7dea35df4c113d75929ef677ab270ba7b668b2707fbdee62bfbe70dad26cda2dc28b942ea0b767df7e7eff73e42d536ffa937bdef53cf575de66934339d805adc35ddcd8c697b996bfe212bb5fb9eb1fe0f5ba9f55e52c690fb1b993d932a9a3bdddafa08453a4acda7cfe289b22b72ea6093ccf1544b0241ec7e9e3440237505196e2ec406af4e7e8008e1e173117b1d14b346ef392f5ba1180f7557d9bd50d9f07cf578ff779faf373cc0f14896740006c288630ba3ab52ddb7c954513633fc25d1f5773fcdd654dfb4c67346d52b746d6ee8b83fdfd7da30bedb2035204566e35bb358fc6bc8933380e7ffbef2751cffff490754d169b78068bc9ffc99539bb1558daa583e5b81fc93ffab36897e9b6b54b9cb5060e9b8351cd5a738178d5b5d90337efdf24266e1be57c41e3fee10f7a57fe5f1a76aef8ffc3032f1af83b0dbd187ef770787d84670a1c486dd515780631e57860ee8f8e4f0bebe87029532049e3f38f1fcfde9e9fdc9ced4c0ea2fff80fb8da02401f4fae6fceae04c44108e2c3e57b1bea300475f3ddd5d9c9db6b01f2320472faddd9c92785e52804f2fd7797d7373b02e255b0bd671f2faf7e1410af43109fae2e4f2f4e3eca5e7f13ecd3c9fffe5156f326047071199f5f9cdf9c9f7c10507fea81ba3ebbfa5e8f5f70883f419f62605ede9d5d9d5fbc97a0c1b13efdf0d99c8ee0487f3c87be4988e0405f9dfd973f6b0747e1e1bcb93a3f95d376f0ca5866c00cc5efcf2ea0d1a7824703eeebf08d9d0fabeb6f273f5e47af8facf41b68e395977a7a855c12243a0df9fefc04c6f1e22d12123b0781ccabcbcfb08a0f03398239dc7949dc6789ec276712cb78f6f1dbb3b76fcfdecaf63b087a6024976ae17b7b76fae1e4ea6c13ca7e308d552325a8f8f4f2e2ddf9fb273b825726a2c3cf3fde0480dce8b1cf63bf3dfb345997c92adb8d4479385dba99b8e763e0d281ed8908e25ffe457c1e1be53fa8f240ade2596a833e97b7381ea83b7c24ad7f72605615b429cfea839f81b6f937a72e817663d1677fa94ab80c92141bb2331e7c82a7f30e1cc33b741dfc66d5b75813cdf3973f87963bf769c720581fab2e5a26775994ada6599ac221dc5655b4ea66cb689195599dcf226e4813fde10f7f009299eade911c946887acfa27b30d1b87c6850f8d472f0c0f8299f7c73f8ae6e8b99ee74521aa8edb645a647801756b39f1dd1a09d4c06c3f60dbbbf5ff6f86999b1a1e0c8733ae8000982d711c80f29e23e3f9e7c7e387e307c0f2f0ec2f25eca8dda8a750dc56b7c88540d1a7d1afc08331825fff4cb7fb6d5c8bac7fbbdf3dfef5f8d7e8cf91cae04b9ff3769fe8a3288ecb2c4be3f3cbefe16cff4155eb26db474d1c375d19c71ac90f9fde1fc5fa3055df5c4cd775f6c3cdd9c5354ab6b0b4aacb4e168574951103a6933806deb17b003e2efa3fffc7487d7ff1f9946410b2224888af2f3f5f9d9ee95acc34b75d9fafcf30df68924a715b53ce8a2ecda2ff68da34af9e2fff622715f9d44b039c4e5abe2893c24e5b25ed12534cb0c7e645fbb8ce1aa7342437403666ad9d5e66ed8b5cd42466498c96eae8c7ebf7f13bb8c12f3f9d5de86bd448040a72ffe1709fffe7f4ddaa29a7da4aa7c57017acf2aa11a9c6adf4f9f3f95b03aeebf2f405fe43ad0d0c2d8a4102bd6e13bfcfd49276b61eecf8cde927bfe3666274f872a8bbe954f6c95e75f1edbb3acbbebd7ecbab4f969836d0bd3287b9b73b6896d605bdb5dc839586e0b199b5853f34eba44e567ef26c0dec53eba7ff92e48531605a32feeeeaec0c2bfe70feed7f9e9c7f308aa922bd1b02f0e6eb5960dab295bbb2db34a99d0926e18f6893b12bcfaf2f4ffff4276763ca4477a666b85dfc06a020c14ed593e30fc1f9bb93b76fafae0de87c8eb2adc69c4b23777d9f5a6beff4c7f77f3bbfe0c5472940ac9f03a5aa0e9fae0c26f7acbe45bd36db69e0cfe1fa43c1eea2aeba7533995565d33225b7f7345ae469dcee1e871a8c43d2b50dd2058439b46d14ec6c99a581e5567bab90cabe28f255de36fdab9ea09c15ff653b61557565eb5464f742d0a6384cebfcae6ae3baaa5a6b98caec9e129f4666eaba6be3aa488dc1337b29fb6724a6799d715b1c0a5fbc437d7b727d167ea1c29ce8abaf021525f53a7981679b3ff8ab5552faa9406965fe36cb55bb4cd8fb246fcdadf6b793f39bf8e4e247d54899104d9e2153e98ef0c9a74f289fd5f7cac9697c791dff1003df8ad738309417c8327e3ebf3a7b6bf06b03507eeec17e7ce46f87159041cfaa17e96391ba1728652cb2b6c9666d30af489bc75513be73d2623e73afb37555048edacebbf631d12d0bd8dc1d22643f81f9a8b3a6eaea993b7fd0976adddabb5f0fbd5e92d35b58e72f2eaf4fda6a95cffcaebf6893e636908cffd0d350681b6d776a599b9c88c3ddbec5e4ae5a319c02f8d3d5f925929c5174b8df73867c7772fed7cfde69218fc5dd2d57f5868aaddbad12a7dee08949375e99cafd68e7646a4d65c548626203c2bb4c1e8345701246e249b3bbbea6c9f1f6328c21778b7cbe7a2bd29bacbfc501f9c5e9c927978649d6c9149649fb183ced45eb8c42b81bb202f683052fd6ef0f48eda9d5ebb0335d904d514bdc632d3a9fdb08ea239c9e9c7e7716bffb70f23efe7cf1feece6e6e4db0f673bfb0ffb0703809fdea29c958568fd601f2e4f4f3e30d4613fd4c9b7d7673f7c827396215ff6437e3cb9f98e818efa81ce2f4e19e6553fccdb3301f37aa0b2cfa2e9df0ce039ff9e61def4c3bc3bffc1ecde9ffa214f2f3f7eba3abbbe3e7b2b46763f3c579f2e3f9c9ffe189fc2f0fe75e76008e4fae4239cc86f49d1c45cc8d7d726f58cefd74d53bc003ac36106650efc17ce00c258311fb87801b1ba232f3e7ffcf6ec0a8520fb0f2f05dbf601dfa3e55644e0cb4ff1d905aeb8f8af371fae7731fb0f325f22bcb8e44ca7a79885e9ee6169e7c6373ff4bd072890ab1ff4834000e6e6fcf4af6737f15fcf7ebcde397af2c49227c220c46d8e0c6f7c9b3d46bf3dd9e980ac797d14b7111ca7b3e5312494c8536729537048d9fe74f0fa672f23c91a44f1d3cb433f6f09b7a1cefcc7f160231a6cc58b175193fd1d5f709e46559a46f74b3859a3245ad7d52c6b9a286fa2a6ade8453f8980d48ca0a0d176287b6c7cd61570b73990a19038d47dacfda7e0c071b3fdab6b5154d31e1642b355f07d7af5e3a79bf83beb2cbdcfcbb4ba6f3c5e91197a3eff90918f5bb54438f114c50a70829da83a54ca64b66a16bbeac94a3f664d26f694eced4292180b2cb34c314d14ff23ac244d9a5a2336ede6f3acc6296234f08d839aff9ac138afab467f1459697c206d7f6cf793f408c44bcb931d6425e67047a76a98fd7542b20ba00b809d500db84b8a2e736b55333feb6099acfc944348baabf234dae3ef78ddd6dee230aadb43d96160e98ad2404ac2f2d28dc25d72ecb6107bb84c9a18d8736f21da78fa6ac3fd10e76db6d235e5a9ea09e5723fb0aafa1e7eac71f9008b968ac45952c62910ca08ebb6416337ea0f34a05ad316ed2b3be18620edbbab74326453442670bef8da3ce9c3b12b3bc5f0e320f9c5771876a8d9f5fd60c345f6164dafc7b7fd7e3c687d3fa6a3ff387ee2e99f89ce29e599e7723a9f9b79a162d4e9be72323350b0a7880f2c5eeb7d7095e176c798ad40313b375cb4af534eb65bb8a7a175b863f73de0f7617039b9c166f58e05ca1c48b708957474519dbcac2a28f7ec2fa82829f41048ca4d7a40156a2d1ee30349739fb7d0ede68f7f0c5540fa58811a387dfb2a2cd653886e4eafce2cde53271feedab707a5e981a04f2041df9e011b00ace8dfcedfde7c8774ad1611cceaecd06287a1487cf9fdd9e9cde555fced8f3767d7e7fffb6c52c2be2aff78b0bb07c851e4893552d17856a5723c30013718b1604e1d5b54f1525721b6329cab8823da5b1ff3af184ee23a89f6e80f6c6bb70196c0d83a0fd24738ea73c2292f0ba06fc43d00bff8a6f4af28f84d59c69db9ccdb46e4e23b41d77807a9aa6c6f5d6777c7bdb97cb16c3df33bbad75043d2a2f0519363de3d896bd1bb8cb1f593bd7957ce768dc3dd2f675c7edb36d34256678bec612da9959e2e8448156e9ca0081abacf37912a665dbafdc165514f5ba0b2bc0bbc9ed246858a51687bdc9bdb64253e0b1501ea4401092ee20d76aa2aaaba1fdb3a41e96e7f7e91cd0772eb7cb16c4dda4e2e631eae34699360336900f6f80b6f08857282056155f4d4c7dfabbcd40582989f463d0836a14ed274236ad9d9a711f71270d20fa9bb5bfc138d7bf2a42b91fe14f42f9cdff83863ac1595d424c75e228c25a4c77919c8ea28ab2b150b70f22e3ebf38bb791dc2f29ad1bcb6388150cb702b845ab7d7d7bcbd81f6ed6dd3c0bd400b81677d9fb4d97d022c2cac6bc9ab664d34592565b200d66bfa18b5cb2c5a250d6cff5df89db4a4e653a60d663c21b6b7be83e9985580619ec1615b670da63f7ba6b103150fd8b37955df46154cc63ab92f23a92ef9ec99b3e0175cccb8072cf664de158548502477b5862b0a169ab1c83c56a2ec56e217aa91f2bb3b5d0cfc7686e75b52c44d376d66754e7c4dbcced7d94f2c1f50ac7946ad6ff828c41a3aaa81ded8f0a50d3306f7b3e85ecce486df4bc118e257cc771eb19aa91a805fb37a71ac4aadabba1530f833167721f5b882fd05dcafdb24be188d8eca24d2f5d4a8abfb32f30e43393b7be28777b53afd9357288a48665557c0a2421dd30ca6111556a2a629d47dd13e1cf7c2098d1c6ee90a489b63be4871adbd4db25555f22ae697bea43096f32a8132095e7ff682760910c2a2efe15985af6ba9b394022b61074f244899567845caaf02ea8809c4214598dbcd1639b681c75bb2dadc045800c62c40b528a617e5148418d2769993740948ba3a5bc1e5049dcc6043423f51653e89447184292b58475557a6462f4436730f0d0fff9cd4b0cad9239a6cc9f20c104d6045255dd14607fbb0f567cdae9284fc5d766456956d5d151e51c5c3abd6030f49b5165b518d0bea93a9347b9375e626a331abcaaaab637adcf416a2250f69ab0ea583be5c568c7201f35119341a6fa026d6e7079c5755db16999e99d932cd6bd99455f2109b20bc01d18a82500464238b852998b2ce38aa14b6061d058208f4d8672a0ff7a37ce667e8dd63350bf37cd1d102d32788750c042f4ffc07a70ebee12881e196663e0a6f6752404214077f8e6d111bac23d8bdb4e366cb0ac8b0885b2ca1123cc476825db2085a7bb66c789ab3b8443ec71d475ce007afed73d4a4bb88caa31228b2fce9e5373fabf6c3b15815858983535c2cbc233a4b5a0778d3d8424f295c0749a1add321cb4a6f108c4e0599130ba04ff046307a50e4ead65d12588606664f2c858de36a1e8fee90d22ea79b406e8abf7755adae62002f17b44461bd00f7d2642d1dd0d8af689dd00d729f17055e0609303149bb7c9694b0e9cb59260e442022c4594885abe8209ae735ec793a00ef97b0f2b84a3c024975324bb9e82f15de093653a3e674dc6a50038cb3ec831ac9c6507b598d38cf830b26b8b6d43a02227c15a33d0be61ae9b0b71ff850371269d1dd277509e7e2906c91a5ad4f76cebeff149f9e7ffaeeec2a3ebdf901987ab8641ed76dcc17b59b9b6646ae3d7c8dd90f91e4ae3d998c0769a32f38bab0225ced4d047c79b2ca67111ee9cde0b640f078494b6323189006855c41f8eec2f8f1eee35a6149e15b7924d71da60c8adeb1d4a0709e661299f76130949f8d028485dfad47c0d1fe1901871b6304187634e64d34161a196409ab9665d3356b1860c0d2e64578c2369c7471320b3e68183214f7fa1468e5f5b97bacb7f222e6eb6ca0a20d420b209fba8cd69f162f30b955595b61dda14a3ca6791d6314f2f144ef12da1972e4da504920249771522c2a6f3888197f79689014927690f87d119342d63703068493102fb2568bae0cae5f434832d86a08b770d76fdc262cf055489988f31447ac0dfc97e0a010c727e9a23570ba8d49230d9f8a8a7cc9127326f1d47226b75b039d955949423029a54d827c453ac92ac8df4cab55d35f8e25bb2e19992829803e466a3f5a020b81560ace331fde726af1e0d58a3f6197cdf2399c6ff32259344685f4cd7730ae2f3cfaf012b6dfa8f1b199171f80e1d887c130c7474592ae68f2fa689ab7bb36c1a1914ec936144631a73d060c3d9cc0e53328b24ad6c4f3c108ace94016f59257910713215dfdf154cc1520a52a812b5ce775c268f7899fcc572b609793c22c4c50596316c419f32710b29134cbabae891ad85bcf683c7090cdcdcdc41bc01235d30bc7fbcac259d49d0b0549b183b1074ae3c311c2e50a87565637d0eda2c007fce7cfc52a461507d41488e23869e1ac9e766d16c7d16412c7447ba5718c7bee09b1e42b484212e2b1eada7f8f502385580360b151ab8126e26984e45534ed886e437b1fe0c923cc470612d724dafb073568befd4cba0b67173757e767d7d137a1f52cf0f28a7e83b30368806358c32dd336c6726c709273ac1b5fe823d827f5e3aede762dacf69ffa2bff590c71b79ac2e90d580923c9be2ae0ace73086c0d7cceb6ac5dcb7689658953433559935ba3e594aec713cde689b649b5aa1a09ba26a37008b23a22992291c0fb0fe93b6aaff3d5a652b1abcf459d33ec22cd0a69c0121d864cd533efb486c0209ac6d01dd10d9d00ba0ae5104129cb1eb0f27dfc6a71f4eaeafcfc8ea323061d89898b05977d86cd995b782c6735281e186631c9b25441144c9e337b001ed92e79321a30925d3c2230d1073eb2535fa38b1ae5a71cc3bf585742474dba9065e6fdc0d559b3c46ba528d1cd5b06bcc1a1531a7511cec888dbb80233f4bea3b285d24bfe6c5a35c5659447e0ce49a46d426622a628e901e17bcd3f18f1e97a7d6ba94aa4850655e528e806f9bac981b95204a712cf1688ad52289632a4a83328171a00668805d5e5bba150662718aa96f4d57d04505e5efb246350e27035771553f46747f4f92399c669489720ca8a9a9b018f40bd64e838480ea1a7514adfbfa66d85e98a558f9b2dbd89b12a5697a7bf0b4d02ce1d5eb1ce3c6caadb3224b1ab92c86162b0e5d2c97e7f02e12edfba96f1ffe6c2b52586037975767f1c793f7e7a7d1fec337af5ebd7c7574347f7578f4eae5fecb83cf1f3ed0f0e3a02197c8b307b39c88314419e053f505630deda4914e48fc5895b076817fcfe964036e1d6e87190c0026378fc034a5c1194064213279952cf299dc29cc91ab25470b629155ab0c4e75f3eaa39bc9dce164cc99080137a1426103cb41b951d163d61a05d2bc6e1fcda5a9c5017dc37a75f6096de12fafcec982fd0d8d621291a61fb458180ca7e256a29b88c5de2c62cda2afcbafe9aa820514fd2b1dcf62c312c9c447043e94b02483f72b770373f0793334b275b6063e46127fe8790d9bd1f0fc42c644d5cfd71c635bc18441c351e4ce132a7611502eac5eb91bd2b7ec516274cf77ea7baca93d5a66aa19c97a5de4fa5a85b507ffd4cc81ab5df11bdaf1baf5bb0df847c4beb6ec5d62cfd3cfbdc73e0f5ccc13f55bb07724beb11512242115c439463619a4b3551291b38d9f22a4247dec9820c555214a20cb6b971291981c323ab94bf202e11541ad717525de669cd1c04e4eecfc40362b0268b2089fe1443e93f80667b417ca307a2e325c96cbcef47a854c1a12cccd7120d123484a05dbc75bed0900bb4f2465931bdf91f8ca64a0b7dd57398da4ac62e644ccd6e0b3670f2bc9ddc89bc610bbe1c96a1587f3dbed201fbf78120ad9ac188f76299dc40dbfa9484117bda9a66b12aac552d83b24ae821ae3cd523244c9afcbcd18616560e3596f4d707f6377791cdd7bbb9925f28163ddd50b98c4ba3b76f82a214eb4d2a4ec503c6601fe14eefd56ca9e80a87b0ccc65739f65ebb82a456358120eb765add3988386b944f704c8fafebb71fb210907c7253e5b134941d2b35290bda4380e570d726248ef11dd9c237f748f6f30b35bf310a71ac24b1ce60933f9a3112d42855f586928249d20ae6748bcecd205d5fc3b9207f23ca7672238c0f1aea3a6a8b387981983395218cd11d2a9863c589f597b504fd3035f035d90ab06db7c6b34c1f33d4119ae6e0f3038c4463778b3c2bdb16baa0351e9f01120f8be3dfe6b35a754693c8f16536634629e3fe013199d5ad40e3eb976ed03850855409f561d8f1fd0837368163dd5e8a9940c8b7790514eb981c26c6050453d83dcd09efa297b97dde52c145d57453ecb0581856fc8399141b86e49e792561f7295689809747c412ff52d90fbc875aa7d67f49ed308efa3793bcc68ffd7d9dce6e82875c96ff67aad2433d40320bb098b1b63b4946ecb64b14ea079d685cd30d6809834dc92d6266c44ffe578dce4e5e387779fa324c5331907060e5f5437d002088028e69dd9a306968b434e514a7c9fa76d283d49d35cda88a83c55258ccd2fd9accde4d3189c4a2d50a5b0eef2991083cdaa043a8844f034211557a457256d09dba045a2933800bc9f1675b2d29b99a673d7528620b2c95d79468531ab08ecf413ab7bfc7740022b6ad1c23ddeb6e8bd659a2fa879762765cb7b9ad4dce6ebb51a23a54201ac2e5e5192e3609667421431298f489a5e4b4fe645d72cb37437bc774c2e67cffc321700f11eb127a5e0e4d24b6734340f72dd098601466241fc7152d2f955d3e25fc29f6555a4cc3530ffbff895ba1f4d064ce376e5ab3f23b2b69b873c940bb48ea0923ceab8c70a85942d1ed799d24aaaea76469c1d832db362ad95bf9c870cf957eb81d92a0f8ec83bd426dd20d63ff6558e4ddd0a9f31bcfcebcebe9374f2fee4fcc2b31d3c393d3dfb74834edb5c73cd4f279fd12cf1e5a075313e3c49eb7fd3e016f5b681d1797b76252ca0233b2dfaf39f21853fbe65c75ee727b60598998c16a7b63f8a31d6c5d3c736ab8078a94d7f181aed88baec4a84adfb6ed0d8fd5ba8ec525536d6645919264be5f7939befc8eafbcdc19ff4845cdd7c781bbf3d7b77f2f9c30dd9a5899545f68d8e49331ad1439917c6cc046d80af3f5d5e7e80d147dbe2ab8b930f3b3b072ec8c7cbb7e7efce01e6e4ad748d70767db373b0df07473835dc377d7067df637d87877df9e805e7dde78b538079dd07f3f1e4e2e4fd594c03767ef1ee72e7656fb33ec22902b03b3b2f0f3680c4275757273feebc3cdc04f7f1e4eafa3be8c4cb97bd903057e7a7d091f8e4e2e2123a73b6f3cd66e09d6f8efa603ee12685c1dfef9d26382d3f5d5e5c43470f5fbdd250171f6234a130ecb1bf8bafcf3ec94407dbd519f90c44ab90c89b41f4064f39de609ffd802e9229cf9bb3772790f716b78f0038f45c0ac6df9dffe7c9e95fcf54c52f3dfc744e5d5e30806be8fd5f9fcfcf6e0476d7dcfadbabcf37271fac8e790be1fd25fbee14d5bfb27d447e7fc29e1e5dedb96aed5d1cb63ab07807def1cbf92fd9d27d303a9ff39e8ea59eaeab876b5c57aeb26eb2ca0b69ba32450516f19b95de0c6d57e346a2077f573021135d755e42d6b5552cd47f51745b77e48d162ea73263827cd5011f3dcd22c1cda35ea9a6e150635b70bc591dcf485e60a994d2c3435db5d5ac2a9482347555a9a6626ecce3c0dc163039fc5246d2ca2412634a124e20c3d7add4bd9a88c29caab533cc99c07b1c60778f1ddcc82c247593510b25ec04f95c64f130715aa58fbb56457d35849033b382fabd405e67767b99f2ed6daeaf8b1946cef41f30413989d8f1611ec6769634aca89b65a9982ae8cd6a37d0044141365fdc149a20e90364b2cb3ac477d5ad3b411264708a642d431d2721b69c1c662cd4dcb1c237bef20320be1823f3452526bb48544b45586e129908d2146fd7793297c2f74d6c9658a0688bdf642830c026c93957f303a3024c4142cb366457be27db04b42e1a078d9f1629041e689b6019e42e4ed055e58666a0450e171bdf82de3691841ee96b3a4c64e3a668c7412f0f2972f772a4c4f3f7acc8f149c25a42f3fc61d3b80c8c8271840083dfe01088839eb153e206bc728359f871eff14edb4541daaa2bda9c8d5248e0e654239c75435fbab5ab4c264d1dcce38a2552bf321f8a3bf92e43894d13d8cb77fd732592f30a4aebf52c4cc31151962e20a1269e4fdc137b28017b54daf8491957f3396ad53be7bb3e7770e3611397c91d4e2977e7d95fe46024eb35240be4f3540c85643bf995ad00e658ea7bff9ad5d5eaef110a628a0c7bec2a05f305b8eea6c66f12844a97e8c078f14b08d661fb496f2329f0e5555b67b32cbfd3b7629a3728d54b953dc1ec2e4666cf17655bf6294a5cebd8c208eb0694fb28eb18f14eca310c50acca522e18d2eb4b20758075fb747975c3b255d24499f393234b73777505121b0d1c492f703410db5d32ebba55b402061ac12bd4f42dd9e8c5b76040df1fa4818bee4188ace8b53455f7f96fcad38649ccc83493b70e2ff55d0d1caea04f5d9025fa8e61218a9b92729679cd65f7d1642365faea13b6124612503789a95aa73c35bb1200d135e9dc58d389bc2d85370599288f80aa69e3812cb46ceb2339a58f0cfedbe89259494f6b6237f998c9d49373d9ba4db752f949ee3ff50412529688c7c3c33d46f5622c8e9e2685b3701c06b2e5b9e924b321963a554527edccd9e38cc80f7ba2c8e72356e6097f0c1832638cbbd4042272c5f8302a148ac823860908856e3574eb284854bfbbcdeb5cf54ee7e4bfe0ab281f23fed0002552c1f1d9b3ec80247930d3759717f92c3424721be0ba9bd1431dbdb5599e43f8d70435f92d082d4ce34ad83a2b16073c00885d678add24ae505d7afcddbf0605a22ae3710814f6091845ee69360ae66a3d537de0426f7419038d466d4d203abbe5c98b502959f4d004b58e0201ee4c17134d703ae677404b2fb2264e6b934b55d3d7d152f7163224c7e4ea6812e8aab35d50eda6b3700748c63d6c142cbfb64e66d96eef320e9ef11a43f680dc1b8ad24933e977c0839dfce7b100315e6f4623cf6155aca8062a57e37c073d4d0ae75e943798754a30642c263f7bc866bda5eca5c7b32e4e063d8fb2c1495d3cc681d5669ee2b1f2167fdb736959007c367d891389bc74bc3a4cbbbc48b5f2bee146023be781aff0f5696282d92e78e5211d2e182365bca934fd3380a962da5cf80336910134e3b1e05159e9916beebb559c2afb5a2f1c6b0834e24b2282a5627a6db649236803bbe9f0091e71f8d20db9ae20ffa7fd87f9fc678b3a925952fd888f3592f2c0e26933c38b07d0f6ac332453f6844730f1959577795d1958a4c8e058a35dd3fb0d7f51b834f58511df9295941f91c710f99285711ad0750090c7acb22f6550ebae86152c39b43de6da81bddc3ff6920efca443dd52f23f3a4f49a270ec26126f665e9ce234401f01faea1b66dcf45ced99d41b4b19462052a7010cf9cc7e592508eb414e1d645a11884c94d5f453125942c76c672d73b441919119af30510f8034ec47851cd6a9e474ee633855f02ccad20bb56785f69395d6ad6359997eccbe5bc46aa838d7e7269838d05e14b0bbf221e7e70da6fbb6d50d3a466e369bff88564bb24ea7c02aad639d6c392a6056b42ba5e12531804c44291f132e7b2a7aa674984c35326c6b2c9c741879b3ae6e9cd105d67195d5b3474af44caa31f2d1f9c57b525a5d549609435d01bbedbe4f60a0a4f8e2ec879b689f8d42d0b94e97c98272d98a451d2c7d7a7901557e3e8b0e08030a6fccb2c132df5e9d9dfc159f4b6c5730d8c2215745c28b459d2f18164685453365161283ef55775280bfb727ae84e31e791b90b525eb5fc428c5506a77dd14d52e84172421ac311263cbc9a4c8f0210d1f1ec073cd638b0f1f3c69784cd4590365cb6c91287d34f8d60eb142c69123913b3cb5683e7ed9f709a61cda00873ec44b1be2a50f7164431c490865a6c5f66538a9e20ae91a65326179abf26c3185d16732cd0ac32b277eda16de7c6d6bfbbf19eb955b1235290083fbb0ede09ee20183cd41d611d2b37ba39962549e9bf48e7128439c06be9728cc8ed5aa1cf426b6e5421aaca74fccc37077493dca3383641607dbe7b37d9a73930b9e221509cb959ef60cb6b8dec284580c912976082134dd59846c852986f271204d7307612721e663226d3d76b426693c4c7a638e37261cbc3635e068b71d5aea4690f2fac8bd6eeace7475407acc6c202d770ba7c4418574ea0b0ae8a89b3b43fdec9b1a46d1f3dc2be4238378773d7da141f0d0fb51a84f43cdc528e0e69bb1182bb840c49ae7896367295c9d35a8389e85ef1ec46deac0b0420336b6d070e426d326162b23dff57cb1c33fe56c902b2b0acfafdf16fd2b8a0dfd13163041ea409c16e26eecc14ebf9a9e7cd458ecf302e0dad3b235ad0a186d5b3cb9e26ab561e3f56d6b68549a7087a14e935ebdb3ece88de82ee0b45041079dcce8dc5ed7ce0bf370470398c357af4d1ed3b690810bda05908e3b77428807ea8d5980d9e73b29f86c6116dbf357b7f1ace63b4f1202006042e6a6731c93079674506f953dbd69eba46c00eb2a9197f6b6f7b483c1bf8524c54a569ec6e8e3bba0e4bd5562dec4b07395e1ec1b529424d5d65e45cada506ff1dd27c8dae9a94f5b4e849c9ebf3e720bbb7dd3839895dd4a456d2fd94657300c2717ef8145b9bc893f9d5c5d9fbd7d6a670413bf3ff970eea69d5f885461974a2f7344b29011e692cda39b0ace82bc918eee9bae0caa14d9178165ad25b482bba562f4d7eb58f9a6100e6f94a78aba313dc3e1bb6c6a1e189460d0c6374b32f6c5fa3a7cb25f929a05be45b26f3df469f308670a7240a4001dcda19fb5547c66ff60fca21fb3733056afc9ca34e89272160b9751b4877443e8f95a95108fd94bf8573e95077c09c8462098b09ea49fca3dc41fa383a7111b6167ab75fbc846f2bbc670ecc1411213328bee7723c41f0fe441f1b8c966b61d636a15560704090354e5f06911b775b6aae0361003a4c08ce410380a1502e0246b30c1a12d685c49cf2c26bc996e1590efb426b04cb3005759bbacac55c62916108686b3897b4eb180966dbb6e4c184a70f0a047cad8e5148c6443cbce4c255e4e5554a949e57a50da6d317328b8c0452dd4cc15a4996e9748ab5987b601b17037aca96a33c32e43b3046c686915d0a93634dd15cef4c93497158533d55d1794e4f6b2bacd9dfe618a0db5667bbf79652d0599688cb74eb3463be96039d442d3c53a8dcc0cd3cc9572eff2c4f21206531998726b2556695758dde1140b484bab8d5e8b347b3556f61ac36f7b6084085b41909f4c67e89a36b3870d129c49602791466b30c18631a5ae26a8258db5b19265c9226bed7e8a441b369f6bb353385f67568bbd4c53f8344f59bb4af9db9492fdd864698cc4585219812c41c956f3b993c17218fbe92026b747e67281a37c56b6ae6b16ba12d80a2829508a4f46ebeadc7710505a660d315fc08c5adcb9555ce24eae164e0a3249a86247a4b150ccb50166c239a6e3ef354811098538629779b0f4b3008f944816808ab9262281daa0c804feb4257b32708146c47aa362efea62c8e8c38dd6b516321acb786ed7c0c2009dd3e3995be365ac3d9c050663c0b36dceaa64bc00381b0899633b05152e8ad649242b4a343c329eab0402933ae724f54c65a5da4f536220d5fb95d97920346077248b242fed0c68c5a233f688f46667120d3cf6f4f265db14a2629b4c566268257a56618a5ad8884e8215bc885210193a587216909d3750ec3ec1a0cd498d1bf8ddf987b3482837f13928dd4d9b2594ab574b024a8a9b6545d8235eef44d69153179a330f5becc665d2c9b237460985533740a833032f9756ac6d872e1b85af4b381ca6a81a3e4dd0ab346a39569dd4c42484864f4c3296049678864abf70e667055a368b8641175e1ea2bc19e84ffe01dd699145516d8f9923895167f0d84b6d2bf5d259632801a16b493a96ec7c49be83849515b52b55e91a05b50ba50e2e397212c760a3d470d501c2848899c434b8e5b38c949991d1a85de70a56de0a56e9b1761a60e5a9834fe8769a793c61619cc664074a02e98bd6d9ce4a0940e89b8fd789dc58c890e33a351ee0f0083ab69ee3843a691af038c07209fe3becb940dae6a28e943ce607c091a8bfcb62f34608dd18f7d95484a81143300c841bc01e2c9d57664ab75527ae974963ca9a744eb59ed13ba68f089d96af92e63694679f42463d4aaa2564cc3a8b2e983513c13d991565da2d97440a1d043255bb3b14036bf221c8d4c51a011b7a5a8c890fe13133313b9af14a72b20f6e630c7160036002dd9321f10edadae27d66ecb237d2d399ca7337a930ae70a0d8479bf55c6903882514ae038d7fd90d8652d90ae148e1945de76c4f6f31e128968a73a91ecdb2177c4ec16b044db8c4d99d37b1483d560924bff293e98ef59315cd65e7d0d34d130ba7444a95dc80b57249762274536433ef56783891d9bcf085613cbcf06bd47a663ec6e816ba3976c54ea6eeafc8093566016b886cfa71e5c0c1e4350501fa1ae3e639cd71b3cd06719ee57f05ed76bc23ce95f4d9dffa9956a5671eabe165998c0cce7472dfa73c4f8af386eb7f240198886017aeac8902e41e399e5317b44ff9c70c786c2bf52b9578de798de11ae3ecf29db87894818575a365d55c7601c72d867e881dd477fe1398dc65740c7063b0c3d1e1f303570a6bbca11385f254533f4d1420699e1aa4cc931d4f0ecb595250b963b8ced024919da828227e1c977240163e5aad61e9a20c5b20e1d0275828b00f9dcbe1603d1408672718f3071f3a77fe61ca3c353581bc32b5d9e19fb91f867cc3be3cf94c0a45a79c9be14690caa660b55259cb7ac2c9d340dc1055192ca1d0e3820c6e25a2a42943d26db0ee1470e1466523cafb0a58826c9af6576721a76a5be196aff112e2b42a33af0d8341a8e477c8fd1adcfc6b720b4dceb0875ef68521407ff1be279c6c05207056a207290a97e358b660760e2384515bd0f9cf6f9ecc74e01ddb41bef1213b083fdc9ede48b1e4acc77d6263a26cb207344a555a462b5adf7e95cfeaca070860efb511e2d84453f43b84d25687744eda265ee3ab543d9065da1439ce35ae2e6f2e63f4aa70faddd9e95fbde0e622ffe407917ff8c6f511c2e67471560299971d4bc7994d460c18994d57405591afa6968e2eb4762d23d9a2b0ed93a0c8e40e5aa0623efa027b1402404d9d4cebae4d4219469914aea8ba7a0c14f272c8eb95878b95cf1b2f9daea08c7cf2c9cf82dd46aa372b12eac02a24651c12e5f8ab4b3cb026d696b0153bccd08796b9453f26bda00660941a36fb8c37332796fb18d307bdacde76415fa1881a970223e9f742e3c42755730ec347e3154d440c525a03cf8313899a151654604a77072a5233d95f9906e9ad4b8118515dd1144905598dc59733e3e8ae155f32fd2848b85c84719c5cfc6c1a27ef0bf6fe8b461d3ad619da988a9ff1d1c383fcf94afd3494d0699d5652eddc74aa7d6f398fcce5124649c1032ee17bb2d8e477ff40e003d6f5751b2f768e6c07ebf1ca4fb4e409f91d9a3756ec317c6b09ded6215bc680be03a3f3778b481f3e77a5454f4e02a390f9265da6142fa512279e707d436f6d868b08f929753f386817a7190fd5442b639c15850f175144116cc92e96acddc87cbb91a6ba4d4b2b2d9e192ad6d2ac9a007f0a1ee73f6f368c0f99c30f9c27e697217c62c5e3a45edc29f6654f7c190afde4299a64a2a4398a00382ed11f2321afc6afa7d16db66e69244ebe3d67af846d3ecd8bbc7dd4d1c730e09d41dab07b109d269aa0c5e0ea2178c64fa8356ce6073f1d259365eaa7b3b999971e129c595bdcf9f6038e38bbca4db0824a19af0c4c6a22c126ef353c75586e65f95409994e609054deb77191cf33b636b08b79d9cc285254bb16f678f3acc86f5137e22ecdeb21711f4334e67b2e35284b992ceaa19566d209706fa6f1968c0a11a285c06b66caca427992112e61f0dd871e405c32d1214a7ac2285bfda287c7bc91d2693ec365984f1de350790f904d1109310b6385049e830ca2e14c9eca405f94c6048511aca7ad0ecdd83d2c35d007397f634be76256ed0ce19621a0bdc57ef1f7e4af0110cde1c426b4f247b4c8074daf6dbd189230cb46b1fc0b76325eba760c4c993a285a1625627e83ee879bc20974cb93370075bf044e4d400909bb2c1793eac483ce51b03a075977e1465f877a949d0422f24e06e694a632e85c1ed52ae419c7317e1aa983813efae12e59a33d87b6ac8dd0b2562c19f815b3053caef7632f156dd5750047424f84121a4506de00acc150a6eb7349881829fae5d44c646e86fb7b9b936f1c6211d82beaf5f9fb9bb3ab8fc88b2ae79b4c764506d1259c5c64e82a189feb549834149e203e0e0821c3b44aaf48898c79ca3405bd651a115c71cfb1e30ca037508d8114b1303a64993f88b3566d587cb3678863970c90cf5ab8d54cb3a49ab46a5c0b2fd3c05fcd439da1aaa541eae98458b92b76d267d3f55c7a8e9cade3391207a855164ad3848d416ae245f9f068c8e44d57915052dc25968e6e30d3d2a627717eb09895e39569fa0b35e1524d6f039bded6d5c97db8889971689fe6e8214578c7311ca6d8f9cf7057394062a7199042b862c08994e3c0b5680862868534e657a3643c66aaed4a43e640356b27b627a563e81e71c862fc2d384556e8034de99fc8834ad0fcf8c0dddbb158864e35d394a3756368f2b4c88ce2f8a95f7c156e1914852c9da2225fd991aa640575d3c4941937d5bc3d1e84902e69cc06d2c145ee83d5dd4ccca67176d1db3bb6d23a9c8c66ebf301d88b8c1eeac94bb1a1fe05a9b148954655c29f1d0c7184eab51cf24548b8343921128e0dd28744601ee56b643c482f3f324dabcaab84209ce98e4fa69515c7d57292dbc73a51b36d27f615994b39824c273b7fdd410b930a356ca36027cb66921d98d8c95ae433f24be064c0dcd7ed344bdcf6938169dc2243cba2b52132579481abbf4e628a1adfa8502c0d54305b0a8fcd145f9adcd4d312e1675b8c632dcb48bd630a4452647759a1e3caa18705c2e0ce332c418e5ee5d63dcdcb94fdcc19971bde7576ed40321115f6485adfc6f70baef4b9bc15fbaa5505049bd7a137b36699c1bdcf5cb6ba678d9e24ec77919c4d033348aaa54fc55e4bf122974a360270532378722dd75871d971b0812932d186ad17454270a7defcde38d99ba5cd6ae97142e36dcf64da5405be1d32c9eaec5d150b9dedba8d7467a54e81464c39266e385d9dc65ab1db0329294eb1dd0492313b4859ee3c1f26c5798281ff815285080cb9195af8166eb6432d5c8e6c55c336659acc713a5a548fb0788519b87546538e24223883ddf0013f8424708e41e66047576b5ceabbdaddb6a88914f2b1c0b19f55ad45ceffa032ce0028108a059a6b1b8a3b220af56cdd45c97c8e97bb10d0404a2c5334a5cb6e16d03edf92bac74e0e85fe5c4b8609879922f98a458842b0aa54eac3c68d2b242672f7a32779eb82e17c6922218825645767286c093ad6527c36c3c46c84eaa60af9a4e0b445a2f27fe0a44bf27f93db34912d33f061d29009094a029dc5f78996d0b7fbde5ef6802c03aabcaef54636d3849eb14d659289926a94f529273eed566b760cb8acf0e927a33079f61c0088d13a0af152dda37f5e9402d619aae8b10a848c7626f8299e36e510ff5ecfa3261b716dced8e5848856a0e512b219e44f4518ff484784544c72e1b8b0711da1ee02acb1aece1a9b1ea480bb2c0308ba92d0fa33b50463bd0aa6659d0b4180b0e68390551849282bc447282b0976bdf1cd413f8c0436da5492a8a0d4457e9932388c1825b91e9be9f935ab17063dbe87df6ac5e187726a387058101cbb43910f180b604a8b62ca91b3541ae3a2db449c27b008e81c91060542fcb1a02b70214cc0f077971bf68a796a91bf0bf56d4800173051ebd1ba8c80a27175684e4f3e410d3074f4e24fb159d4db2026cb5bd60251e4a40235526411e53adf8d80c0f1a64af2c7796c7d1dbad80ad6261012eafcae52f63be2b8c85a587063425619801436c446a1de9c0c28c553702aec6e4322c169f3b4f9e9f5d1cf6e9a33020e01725fa3445e69b5a207301455d93120de0143f5ed35863730edb1e3f8fdc5e7f856674adcbf247ee0753b223c00c4f9fa486dfa9377f1f9c5d9cdeb11855eeb9e0cc36a39ee2f8aced3ed4393ea0443e498e7098bea8ecd0f434068242a6f698e3a5a932fd003cfb195d8a7ad6fa65b5c105ddd66a6f6298707f1b14d7f0b4809a2ae6c2487900010a2b7bc35de5670386ad3f96c962f962a0eab14d73fd52e48929a2249036d8737c08b624acf46b01f4a4b4cc078cc272399c264070c1b7bf62dc815adb2c492ac3d305309b0486bf466667ac5cd57e47f45c88299aa118ca6977668ba5191deae3f5f3c638fbbceaa915ea8a446bcfddd9078d59c5fcba29005b2e414d4cf104417cc993135e220435f6da67bad4102d24323ed0cb72b2475a8b62b8574844710eb6ce19a29daf392867be5831b0a368e3227bb8df68b889ca0cb320563f81131c31ee8a71fba98f13598dc2a3fa327a246d02c861318f14c24a4ddb7d36a35453156f2689803a4da33123ef9b3e29249ce1acf46f2edbaac3a64f8d2dcf05c8072f8bc6ae45fad2f4c419ada9958df5c9876c97737379fa22b529964eec1422fb40c596c405e66d05fb9d8ebd02ce56d5d3c97a0ac4b788a26cf70e47b40bdcfaaeed90fb63ac9b612b0d385a6be8d433b0e70d2b16eedd04f665a371f5961002b3073a2a8319607cbd807d3903cead6f26599b81652af077a04b3e75a85f1ef2a419ca709862924e112d2544ac396ec0b89ca92cfc3a41f855e2b6109ac50f2306b37bcfd20983411b39faf91b5dd23fd83611408129381e708b8a4214a6903147afde42b2ee8283550405f8a234be4e576f0ea2e1e0fcf26efdbc1c7ac2032bee375c607c43603b54d010e6b42dceeb6250eb62f0237c02cfb829a44b98d0bcb9073d5ede675a80e0982de027b3562914b68652d3d12be20a7005bac2b16336db3129510747c911559b48f87574fb63b4f866feb6cb6f9d020287d686c84d4a7c52650754c6c6ea3a4d537030a5f18e300d58930a6ff4c578ce93e53159be74b3665fc229225d4221a943c023db0797e096a9b4b810b6c732950892d2e05d1f0d19782841f7b2998f05b5c0a6aa4469ef17aa0c62e08d9b0f10bc22e71b07d91975b356c8bc3cb2972f005650ebfa0ccd1069a8c2db0366d0a06db66578812db6c0b2eb2c5be908d171b639b12e357942a32ea8ce9460e68b7fd88765f30a4ddd663da6d3fa8dd178c6a1718d6cda5acb82cf1087e01b523c9aa828c3be789963b79195a29560b9084765c1ab3c02626818d1616979b207af2adf79f5e2c0c15d00bce98c95b644105cc051b3657559395e27b1394e002171b2805ad5ab415b0897dc8db9ff1d18c6fc79714c116e9625bfbe4e47797196e5d9f5612810ab85aac2cadc950a80bbcd679b01cf27c24b0f4cebd010afa2a2095a92e09ff1bb8b7a755ad54fa8427535685d1eee429558b9786de3cd8c3e7267558e508b409c26a27abf2573302dd3c1d5b71932d482c360214852881d0eaa66bde6694a759f53de415558f4b9f689021a438502869d297b925ddc06f0e442c75dee951ae49e69918627a4c119f966727d2d56fe2b0108f5bc830686143b0c7764946e61b912befefca7ca621cbd8985cb4085516760ed40362be26701892b3ef3fc51fdf0e605d0d73bf8172f87015d323a1da4063cbc319916625aa2a361b3a85dbd180f64ecaf4b124091b86fe40095dbc4afc27c820d0613f14378961fba1506c87a2f8e17d286aa4c1628df68db052836233525896becc306996427f55fd942b0f47539465f76e681966e83b7859f245c3565fc0fc10b47ae0c014386ef33a337508399d0defc8ad7a4ac130ec6265254a5acaa59485ba87b280933525731653dacbe92433b7f0b3141d5d6d6de07601f8d02e99b5dd5ac99d67f8b066a531140e31bb30178ef0362f59ee6f137cd71904d631554695198d7b3bb431fb2a1d0dbb2d7ad3a5e496257455d2851e402d7e85ad9814c5981d46b09bcc5d4c58dae25b134efda48a81bbef9cb50dc8a33dfbdbd75b1a0437dcd56d558c1da6f8b4ef8662ac75be6521e3895de6d866604e6a4c2ecb7bc9873d1bdc50595797409c5633430b403ebd9baefd846357badacd7348a5c8c3443879815c74f4d1097f57dae24c5b198b2f00adee4b5b89e80ecd5e0d2da23be1a556fd8e39812dbef0b4c3077b3c9250f527a8c524dc156a3f8a712b5c9f0e818b98cc1eb0e99e5195119f5d2935dfc703c752bbd8f1ded1622c94bd7a1a5b6e221da7948ca12b519d41c4b518ea93092e0dac5805b226cb06559a3fe1cfb19f1497f88e6a3c84924dc45acf0a6af489a756b437ab6aa5dd895fd210ab2bcb47a14b10358f0dde7e96d155d6e21e22ab0da80b6b8f4ddd038a62eba5d68d919c018f1d874b3859546c9c06c106ed6536448b6df8a1028e4fdb4d80a6138a11e0b6778a11050c27071bdf99b804ec65d82981f8103db0f2917b13acd082d904c68e7586c7783e6a0000ca9abd4dc03d350bd701f467b859c2271079e5d920cc98c60ef046d12d452d143c883c336053ae137c1ad30feafae05dc081641ebcf4ed1926693da6a5b26d5512aca5e1472cd18ad64aee95ae63ed98537879803b8822b5b5c5b19b862aacdaabb54a2665ccfe38708e2309191eb8ec56f2d80a1683537a058d16df9a7110c5a57b6a1325590c896878667a55a7861727994af6e54eda9c0ee81295d7252557ae0c9d49f8909ef08d14bcef3a5690ef8dc24780c24a5ee2156711b14be95a6b80b02a3f1a1ba3e7b3a7d1125adfe74441075d11aed46243f345ac51a50ea34c8fb5775bdb77ad4a3e369ccc6aafb546f0c0602943f146860d42b76e240c315cd51ae6c5e25ab26d8e4d6b3569dd8c32e23b659081fe5259bd0f8e461a1a65fc62922a1cc6b6a91a2d483275b3f0a98d740a946b86f836cbd64991df653a89fc916a770dda4015b2cad4f10b0b89f5ec4ef8af63e7f38bcc9c92d9ba333c28ac1d7d51f17d683873c735a3154ce99328a743e5604f4643862eadf59657ee27eeb27a5a35b27e952c2f16c713859f2f8f553b9b2917a4631b7464ed66c30027f5524f36da4c10dd169399772ca3af88b344e70b872b629ad419a1282cdbd9b7659961393837524a49942b833193f84237775d51e8a63ec4c24f2e2da16c161ba18cc8ff8ef2c82e3dc8f25a23cd424c1534bb3caa4919143d6c2583770f8121946535602607cc3b7436909406ace580b45d92192a6ae7c24942c78a9448d2666942124b2ac2df018926ad4229b5d2021f59cc38e7dc6474d60d67b72fd335ce4ab8d71c54d09b3d5622c4c1aae6ca6e79ef858346a8f1eed9ce8c7056a5cf0407133936f2f1d81738c2f09390cfe562a60019a6500cf30e87422169f65c08b3a5b7252b321d9b0dae1eb5c1e0eaf13e4f8d7b3bd339d4da9932e2e58a853c5951e8f23506878668689123bfb59228ec193879458899f64e313cd3068f9d56911061830794bea1e5aaf3f8315bc2d2d3160cd24404d84f9d888b33b6419572b19527d957d37b230e7456ea7807e2fc14862bca0ea9c71828181091ff36c7e10897ec5db727d3702edb0762b8aeedadc2f6e4bb31c6a593d00c0497543f9b5142766e2c5d6e47fb2f8f47831e8d057db5bfaffd9d970b985c2bc677f01c94a7a8a9825dd5eb65a20d5d50366eb860a36fa96ea3d608f1bbb3fbf4d88d85627c1d0e739d79d9a8dbef2e9975dd4a1b3029a32b8ed8b6227b6733e0f2c3aae00bd2a003a839ec4b414e27ec49e1934a6b28a36f38d351944cc73e1bb6a13299fc2d09d7c62a71992f964a5c16d8d503a26cc10a6c04415b423d9e9c84d165845eb3f0aad8183fe1161f7ed1001024dee2956d8334701ee7caa445dadcb921a62c2a5a1d4b7cfac64eb25395729eacd0f9b783151ba13f9bd6b4b613519ec137e97a27ebbec6cd6a3206adf94890de6e6ab266d071c045ba083aae7d696c607495440c235437f62b6963d0121869523d8e36f46978c516a9e4a843332f6469739b3d46407272a8372552d3e1e2d0d108d61dbd1068749de80d1f9077357bceef33b39cec49d73f325dfb8355eeb1caaacde78fcad8d8f070cb391c70c67024cbdbbf45d7fe1c5a6aae1d235ae99508afad5c0c4e1f65749617184f069d49b033795121bae4a588526d15236b34e4b42b50c4ea9f0730cf1f06f029f8c574764ffa403822f410acc64519bc3619dbfc28bf1d569ae268d0ed115a9c0aa31729b0f6a55f98c639be0486ad7261fb49178ec1dcc5fa27f4b0f8feece2eceafc34fef4e1f3fbf38b6b69d9b8584bb249840c43e72759aacc6d0d4eae5b9380915ce76701e9a541de5a5ed76621ff6c000a5d8ae40f43680f09d27bafbcaddaead606c853d3280609758b25afef8dc40d16b4e2c915db3d78f852dfe940cd4b2ee35859ffef0fe7df6e87c07e88328299f26b89a824f85c3c0222614a7ee3bb6c4c32b2cd56d21ab81417b9f5364c8cabb28124b71b1163351fc41595a2dd72e84f74a2653d9fa3696e85310db3ce2ea89319875984658316b810173ad5c954fda6cee9e84a8adf9a47e97a999ead03ec91ce547dda0c6ae8f604939dd1e04c698a3717d6f34a62c3520083c73752cdb77e3ea783cf490c2c43a29a5f669ccb4eeb08889dc889b8ea0d01910129d78d5604905d832bae21fea68df3f5acc95643e78d78d50a78e8348038e8e3062029f3e6a084c3b01824601c2489d0c7814a9ff9e3a089a21987773d1b07d8249b20d85f74a305172f22c06e7aa95ba35690a77503c9463b8e7784f4c8505112d11d42ba4bb450b5845bb9a137b7afe923d9b501b732b3fb5542216e1eb597028511f2956470c4b38cd5ccf19087fed1ac5a80072c9268569b8587bc016ffc5e046a176338dbf429ade36c5b9969d536eb22578f28286face3e61ef5cf033a7754be29a4073dd8f96ade20554b6bc5b10d69c2bf9c505113d79a2ca0327be2164a152a1354e2d055b4abb5a9180729b76dd1189f6d2ec349a15a7a9b1856e66e36ad0f1bbb91db64b33ac0cad9505eb1df57d3a5940963f84480369e7b72cbbf97f88e67f99a6f2dc7f98731edf679012420f902a2bf3e0548c971326b0d28f1a9d8774e34c5dd22c9d8f422c5ddee22b9b9cdeead3cf5982401e0042d0a1211ba17a40d41fe720d30a312f2f884c706792613ceec7b7da488848f276fbf8f3f9e5dbd3f3bf9f6c39914e821c86d232529f0cb79f2e239c1740c4b88f113852e4728477078fa36f6ca397473a8b40011dd09cbcdbc08778d8c14b711ac1a05464c941b5b8e2b31d78283d89b78e1564301e9e994125b33045ae041cc06202d14ef18e7db51dd92c7c1ec583828ab6a09a8539a63ed4253235121bfe9ead5079991120bb706967b74911d7859910d5548835a474e77745836cf11bb00a058ef74bea4d958f7453d63654b5e642bf5839cf48b4676362ce712ec798eae190d67b202862424c320abbc80fa38448e011a4074e862d2ff0899c0c0894b1186e423565ea234244257dce402a18926c6bb6f92dee11a4e23e143907c4d6f366362a4ca75e0e80264fe64ba7d81ffdbfe383910273eb6a1fb4e8a66670a77a0f5e46edf22ec3092429e35caad9110205912472bcd62ec4c5ac42989ed9421d4f69fbf325e8be280133fb66e30a3e4685fb1b1e969dddc5a9025047d06d3d597a896b215dc6dfff937ee83bd07f166948dd97c789728b84d7ab61aa1d691342ae9a3b5c238b4facf713f397837fc8882e490f2bfb79966d1ce1fd8cd9433987f72d60ed0c0e8c6d6f2aa3de09bbf2b0ac777a4467db03fc6b7aef005466eaa371e856e21ed7cceadfb60d47c58dbca4975b42156d94a5f3d4a7660577ab459278e5f6447ebfc498d295dc2d4510a6c5ce3192b6eb3a44eb516afd1d057923db98f451017115a45a4dc09cf8ec4e4d3e19a154de67abdcce73001ecba6d80b98179c5734868a4f453c524ee2d9abb033b8ca5d1ea3fd92791564b59762df75387f742c5696106e184a6e7e52a89921d37b6a47af8bb759fa465bdc87a71fe6661a038c6087ccab18937af6ee99415df41f2a978deb5db60d42f9f4b822ef664a6e5eab79bca2033e3bd766877ccd2ac381c9146be0d39cda18752f5b0338af3b76c88ac0c4389f27884df21e53f85af78dd81b10e5464418cbab15585a6634563e66699d039904605a3865f1451add75a4da84f879b510811498549b9f6ec2cc3255f31d0f1eb6eb9d4143703da21baea6966e2a1f6ce4d5221b8dd8301c42c7a42450f484d5306d59a3a27fb48eb800e671aaa93b21e219cc4483da496a51fb4b95de240d43110e0c8238764f85a95a3e8769dd4a4126428d00a153b4ee053d35be5e2053fd86a3bd3f7d7afae1f0138ee22740ac5ec3330b46bc45ae6c8bdae8050cab6d0a73af2f2ea441d9218c2624141c45d16d40df00c00ba266817b06e1a472148a93c01017d6773f47696a15c49d148b409166975a24d39b05949231f78f8269001ca343f6fc429534bf9b14c5670cf4955b18d9c775502c3d1f1ab2de73b7162bcf05beaa884a578830c049e06ca393e87925b47a4b128b636cef664d7d2da131bedb9e159989c8a23ae9f0e7f0e44c843e9b20cd24771ed3e7f3cf9e1cdcfea5d0343f119e16b716b98d16c855a4dcf0b2bfded8fb10b5da91f5590c1dc0cd56b129cd436e69eb25ab897e5c609178b5cc38bbd27ed327ba490a54a311ac9418c79d838ead17b2f54acc7eb8b8f9fe2d3cbcf173767572f0fa3fd87a3033beffdc9e7f767987e182cf3fa08f35ebb5d24fd6ff6aa4dda67d84fd93b6165a99603e92f631f48a82ec212b6dd9ab028fd021fbfb8f237e2df5315f8da1ebfc96d06eb55398f5c565dad2cc525318961e1964a6694dd1aaa202415fba59aba818ed56ba73ac4fa233cb2eec9d38851ee1ad849c1103d604ad5078ceba0548aa90080acd6aa80a18e6e1dec424081bb09374fc43779846e7948095662c427951aa3b930a94ff4b4ee1930f57fef74c886759ef6e8d17050ca5eeb7a9683aad3cedf25acbbc69129ef1649f4663f7a387c25237acca23f084c42831e28ff068db07e7a73408ad2d57cce6e28a5b08e806dc3849fbe398cfe181d786a10fef2a29405fdfee9607f3f5cc25af0946216b022028833409d4c7de616a1abdc2e44b7407f0e1f962a8396c4e1abd7119971477b3276ac5029c7d170df08ace3ca7aebf46d8ad0a4888451d2217c961a1eb19d1ca944128872cee643a4837273fef1ec4aa99e7046b0a41bba5cfe08a1517912933e2cf0ad5138ecb6660c29263dbe32c8299eb252efc7d23a54911ffe6e97b45ca4dace73f15a0cb1c2b49df01feac8e9d5a5d6c4a1a75cb70bda3b889ba47c60530784f3c126ec915965b326d0c9cdd9df4e7ed42a402253c888c5c9a352e559e29635df7b51b33615b366d1e55de9e659447bf36850d42a1d49e750ba8cf895a53a4c47827a9d8118d6355e23561b03a14599cb0f461d15a6caa12cd1a35096307eb6727b9c945b18512ced279b5eadb5829fd41c8cb56ebcb4b9ae2507806117dbe619d0d240e7491a634feb2d923d273550df6c92b873625e2eefb299f96eb6a76c43b4498fb090ea8be9e0cb940e42179c48212d0d9deccdad307ff8cd88bc6c5d5fd614768d7bb793a6a73df8acfca90e8ac12543b46d3c6a310943370e51c5866ed1e43e69a2af65efbedef5c641594af716b6c6c7c060a56b343a44a1cc3263dda1c2a56df6661273cdafdea32846a493b7b04e6423a5d8f40f217cb953e02a63ad71b8580a53a7ac2c801509bd4fa1fbf03dc9a7a8bada07c51ae5bf244225447752a40502fa69ce90d44cf577beb0893d0a2d6546c86c04c5a68271552c9ad4649c38dd44a7c9cb3f3d9df05a35d7a43e060dbdebd08d92dc2ddcb7362fd4758d7a7ea60ab2e1dbd8e484f61fe67345b5481ed870cb6f9cd76a7a75da5aa5e15e7ce25b06f56ec550170d0d30a3dbdbed5015885d1914f74d00b62f34fc63667ee3d1141ce291cbc63bd688c22333a9df7aadaf427659c2b4aa276cbc44a8e6a76f518c9aa5beca856518af8f27428f950990ac453313c5f9d14d44723d442b93397599b4319944a715ac602b6f5155e9f4119d577559813740915a1ad84fa3e7cf9f2b60ed4f0023f98ad75bca42f9700cbcf50a5dd698190818cc2064c11cb4995d65224588d052d435c7a752159ecb7a167600dbd9da8653eae416ba74ed610bd418a7d0d4d5c442810b8f025796d9ac953ceaba2a0af47cf734e21114c9781aa0dd775fa3e599c3b87a1a6401192d0f65970a89a42d2c743cc8cae18b4644e9145c5ca7a94479d5f42af3f3a41a8e3e269a5de096f0efdd80b19f579603680e60607e98cac963c3de0af46c2cd690cd5efff0f10383f0a0a1c1144bcad5b005bb2817d14f3febfa4d3caff6f787c786c18ef65f8e033b1a07f66a0c18f09114971397348937fb4d32a8940c1783a2255a39f228970bd359da318af25469718ab1f1bd830a81cc638cb8f6e1b5f5541d452c7c75bf655785006012760901507c832a39014a8cfa814d399b7a3c451d177a0cb4b7a9edd84ea8725b3bd34241b1e1cb76629c4cf2afea94a7522ad1eab18705ce2db5a26061b0abebcbcf57a7674e14accfa71fcebf3dc5f8575242c988ef501d1cceabaa468b75f51b96383ee0ea2e187913eb7cc3a5858a397b69e29c7c3a671ade3374979bfa426e1edd853d0082d8956e20b2c63900b25651147d0bcbc089e0161532b20c5dd6aa8c9329a73d949f97b39175e9f3f2dbf3f7f1d9c5dbf3930b383415e32896d87db23e783d91a9504e391dd0002f0f273255003071aa005e1fa943d79832bd0ad609ce0a9afa6e38424c6759f84468511d9c8c6f0f13480a229ae30dccfe1e923b60003988980091c8fa4bcaa4788ad629e6b873dd8e095bbcc060dc81363a706a89e9b754b4749aa7ac2437308fe6656e15c423614439a34d1832b3dd781f9b25b02aa19cb261a95973473ec4ed5d25f62699de8d6b819a097aae18ec69d084558c994283ef781313dcabd70297430685c6c113a3b745054dbe5ac3fa10e5366c6471f2ba16a293dd68c217e273cf7874b22b0fb40495fee172c007367b56b2f20e172864f8d16b0980b76df3d8c400da082077b30295d74ffb6b8fdfc2ca6004a8b6920e028bcaf7243c9a40d27360e866545772c9c45a87b271547618750ec109e41279063567d3873f9ed804e263e253880152d0c2f19fd79717268e5f1aa58f3184c32018daba9cad825c8ccf162070be0534103e0deaec394d51cbd4a2d0a0d5b3446c089e373fb71cce3ef4576500a81c6a7e08bebf805615f6cbbdf47a3dd0a89743756c6ae1514f4d83351e8dacd19f343dc3c84925eb759ca79b286a8b4174da434bb05a3f4e9c8a0ccf5a74832bcad53855f8210bef617ee1819610f5ad77bd3836250dc027819188fe99269c6a53e324ab92faac9360f86ce325dceeb8c0ef1dbf43e48472c0de578adbcea1f464b34c3241104e55d30a5daa14e310a3a7a7dbc12ba9a71cb0c8a38e3c69296e4ed2d348bcadef720bd5c0eb7563406b2202c807335a3874b1e7e8e80387b6874a586b4a3c4224790b541129b14c5c7189cdb930e804b88ee96ea834663c8d3e5d7ef8707eb11b2c2b2ea711182e3fdfec9acdc49b07bdb4e2bd3a71f95335c8fe36f353c41a573f8e7b6a81dbbd4e1e7beb8a26db5522b6fa222bb31a9d480a253314601ad32f07edf3c7f30b180d18a5c924d9fdcb64bafbbfe0bf7f87dfbb06ccc90f1ae63f2c1873ff4a2fe5879390ad61a8f5660a7226a15fb6208cea48b3627c1d3646c14159c7333b16d8a6dd96c82a88ebe517e01a83f7e89fc7eb708fd25b3e9c29cdd811d047aa0568229cc1e1da1a2b6e133cb073f6121d59a0c87ca9a8236f30da4312699319b4962e3214f3ba5a91ed6f131c0bb76152ffcfc483863b186006df3d7b067468c17b13e63794f4c3061b690b004468836eb5c50407aa255f6fda0941ef40ce8bae593260d33fda8ced3ecbd06fc1263062d9492549dfc1d615b742372cb3892d3954d362e7f1a965aa537a828c3d33978b6b72dbca33987d471a1000e36b69000e168d106b78c2054ffdd3b79f0b81c5e493d700e6fef56126876a4076b00ff6c936c018fa83753236149303c1b297e18113638ba01b074fc06e8b5bc18fad40e21e036f356663016740f386fbb0d52c4021aec72e155c92a40636d16b6868f9b28f8da507fe342aaa72e11e8cac85666f238c0c242bec6b1189168492dcc46587fcf39774eebc5a7c243e2fa5c8687ec89d8897105d9f1c3e9161d1215e4b9dd21e30f75b41b9acbb35be26941a5c83cd17260d50442af239453cc10097101ad37daca3eea7c56d900b487b8c9c57147a6f0971746a88ebf5cc7d83b3b5c555ed0621eb08b14d1cce681b175764b1ab2609054c9689621caabe7b18d524cd3bc326d6507946186984786c53e06ed3fe2e651c68cd1bd118476b41aa2d2a3f6232c567108d4bc0e41bf8a9960bc5427f64e20b8f25c4a2e27e4e82d2196b3c3094408c16297496d97c8e23f420a199ab0d412a2e98684dde10603909bd2c3a3d110e0ce9b97c120c9be63e4bb5409188cc66a265b42a2677a5f4f5cd9621d905e827be200655105bcaa35f4eeeeba369deca928213b2c43818d405b3355d633ace6ebaa9370a7acc8de1168f564829688fdb13538a6ad64aa2f435aa838d174105a84bf39090080da31d323c2695c9b1b5089c70f9b9ca243a2789d91cc0e083edae35557107f7a9272751b26671c984a6996f1f58869310491f04469be98905a387454234cb89cb258771c1e21b44d5582d0be0742d109415388cba3213da2317995ab7153e85a994708698a6ece9508388a4d886ebc89c4403c1b78408d901b96987960e9e742bd0ab5c7e9fe58ba5b6dfc5ebccac9de2098adaa5e21a2a08a9b81c42df97cd765531fcb6bb85ae7f9c1112493edcac6e5d38480ac0251e5822a10cdd4100c1df1410716741bf17ac5368ba8f305109b710c6a82b6d79602f0b20aa0ac7ffad599a232f89c21bbc72fdbfe7884b36d7324da6f60aa347678d919d236b011a3bbdecd8fe718a37cac439066865088248dfa5e266dd750f15bc974c99e924f844209469d64532cbd0518b754605493fb47df0c9be414534767cd7dcc665966154b2876cd691c857fa745f799a6cb630d7ed1774074530288ae1b3da2372c80514b28570f0f693420a0a6f33ff75d0972fe40f7d728f270321bd7eebf3ec2bbf3644045bd7d9dd0610ad53eaf2368a8f0bb1e98a5d73babbcc8ab547b1da149b742c9da3dfa9c7553fb4fdac7868cc88fbe4f87220efc8ce0bfaea8afea09593f204ce947857681b120c2e19a0bd6699cb390461303eba1c1a533930a88b8646f6134f9f8893ed7773230783bd2389ead4620e58b2fa3bdacd95e8655950008197ec4d7f9d3d6f22d5ca785202e8bcb9098231a7a87ff55df6e5c457dfbb716c3d1c6f7a68464b9f7bf412800e79c7a9f7f5a9b8f1fa69ba12568fb87cf1cf62659e4bc6bcb8ca4d6d1d385d44951aa49acdba3a2b67592f6b60b06674b5d1ed3ea8fde3a92bf6a3b8ebc3619b0ee9b1da0db80572d1a34f95ed1a28c6b0b186c7682b49b7d0f3ff688c2154253df36e8dcaeb6f0837f6f90b50fb7bdae8f518151febb05525495faaf7d576d4047e51e5587043dddc636d92627417c80753f7f49f62e4862bb84bfe39ec4f3034990c95e00f83612e3fe9d331f30aadbfa8549ddc6f5b841c517c419983830da5bc751544d36c5b77336660a4574bcb8ffbd9d5e5c7fff211febafafb386c5ec939dcebb3ed2749162bd7cb0d4503bdff82fa9a9195e97d2f84418713db7ac5d6cf4cb56b187c8d9ca761cc61b52ef23afc3278cb0595d1c724b99227ace2e8f7ad6273ad65d63a3255db6cc02ee96a3c71a3e3120534e186bb42327be290df91aa14ddaa77aa83e9b2fdf722a5e7913b006e467919550adf0f05f898a5cffabe49210b05df61154c57da616702c0ca543280f349bf13232b097b8ec9937e7893a6ded60774bf0b682b49b8b30837c62a1622f46da52401ae703d3c8d1e77a3c1ea10e46974f1f9c387b08585180e9cefcd63d59f191271e2d4a11171607a295fa8fe91efb53e40b955a601768cb3a61397ade0a7522ee2db06b9d044040e03dbf423bfdcd6dd9655dc2f2bb412d8ba5cb79c90b264da6befe316833be5e1112bd944d5861450dcd678dd40893afc92aa0cc123d83509331f9cdc791a312221a39e71b60562a550c0f1945fda82f2a0063de7255d13949ee48b92bc25079436a57d342f6529b7c295596465dc46d2ef272966a2003bace4d8632d17c2d33978dca25d7f51d184d763dbf03a7877992737aa09a0fe145c6462a7f4df287e61abe4c6a2a132434d1bba5d7b0c4c15dd1a73d43839e1f874aee92e414ce545e6c80a02a7ab26c11a9c0143e413b05653171dd7a0809d25d795ca351ffe472a3cdebd11865f772d5a82f414335f8b4b141193ff0b577112efe3c7d5b42ac23b498ad058c24cd265e58c8b5f19bc664d2ccd8cd0a6174865376cacd43a290b6be96dd5d07c0ab2f19eb6b8a430860c8c0cd1196b390e89d67518aeb0b2032c959085854bc253ccd2008c2b41379c4af63c4a626cb17a322069921c453909c8eca84942f5b1a816a607018f4046ebd5245792524306e88e14e9da6f32180cd9f91823c46af52b727e98cffa88dbf4b1a46c45de8a6fa493263d907b83e614e6ce95c8600bf721eb2981f16b7bebf7f8b9f5ba78547e5e93468c30ef46d93ead55beeb6e2261291b9833a4e348f1612305c85785c1d91815ccf3870e03cd3786926058b9c4bd7da16a61a4eba897b3fd3eca3fbaba10fe378f3c3517dfcc4092cd4e51410dffbaebe314394fa3fd5db7daaca4b2fdb5624bcdb30d5d291b9d08b8145948c3607cf24a4397a7e1e3c349f0d7ac01eb92755c9d23fd472414e20257442058b4a27bfd2c6c3895f7f4ac9f6c7c5715ce50c84d6d57a2218e3e67d9ff85fca5a3b756d56d9e85bc7fdacfbabf853cc2981167cae32df4014c9738eae91e239e4f9baac058c9da1ba4f43915f65d65398e94e91872789611763b50c39adcde69dd03ac3ee8cc0c1d3119f53d68ef4ea8f8b24ad029bfd91e20ec332714cb464d07f4a9e5bac453da0f865bb5ba57d7413af79b3e72080bb83e525806795234db281cb076c14f07fb014738eedb3ffebb518d4078d4749ca2f5a82d0014f981a5c88a38f938511496639aa39fa2d92d9c1af7909fdc321059a4c3826b5b9e754c23215f34f9bafbfae9d7ffbdff75f4ec2fdcb4a7d1d74bfac2a3063ee6f421848ff0ddd0370a0765f00ea13d21be5815c15feeb68a028abeb3e4363afbdbc713d922e9de8a5ec8308c4ab4ca81aa12be4d77a35596346840cbde9cb24804277fb29356dd144e148ce266f9cbc3a86edd3a4dc843fec06ea57952bbf5367bf45baf55819485091c564b6b252ef3b6d93cd168d8b071cd845ee35d985e27ac67df7f8a3ffdf5ec47560502fa7a5ae433a1b983791fdfc6a7373f88dc99dab76f84024e56a28e5c1a0e4f70104d50df05579bf4b0dd177ce6ffa6a28c5452600faae49aa95984b8790456339afe327df9f2016fa1a05e9a496f1a0eb226522fd4cc47dfdd3a337877b95d3778462b6778c0461830b98318aa0873d4f5b96d85bf5f13bea0ea510bc2a4ebece041d0ed0226ac9c3d4e36acbca0cd5e9dadaabb6cdb5e0cd6346eec8889ff5d6a450d48a6952c89226d1d2209e5ce19128679bc26b1f283efbebe7347dd33f8b45c38395c8fb45e08189fca18f5a8c36b62f0664d6f62827554e6dda704e9bd6112903eca7b6bd2ef56c91a3cefc589794e62e20d2d728f1f29536bf17a821239256accfc1fa37579862a560f774135a1dfb315817d3bcd025315023b0c4da99eb9bc89a789728687c3e94a9550c026840f4af2444237fcc773643024bc63718078609ab8263fe10090a64f1219061283313a8a5c413f1ea7279f8c7e70ed33c39a017eb3fbf25870f43e3f8fd026d48038d130d9c770255a9cc32b41b8c477ee7d860dc8c1bcd6e0ea139883188205846feea142c174d3a380d199b1e0bc33f274d22b14436692ee58df6002d16ca552a2797e7b0c506c35645fe0f1c5d2ecc57fa3b5737c99df17a1099d1fdae0a481750747f332c387babaef3d5c79dd6470f454d30f19b0a51572f921935a0fe449d8ed9ef1a22d7cf9f5891fec120bc3d59a2db8080b857fcdea8590250785bc421eadd5b07b0e520c69462ab5a3946f111a5fc34603cf81951e0f4dfee6da7a343cbf246f85be4443946d0a38e7d898223a90c0b6258d936acb318b4987381d5d8c28462d39ddaa1c3dbe6d5dcaa86ddb89c3e252ea3cba900c5ac57700f0fd497fd16d152bdc0d047c5efc4bbedd78086d88adfb6594dd7a0e6c0d8ce1e2bec29a5c6edb9c165d3e7e4d2eb680a5dd92dc6fd3142c72f07a9a6f57826c13b72ab1ca16c9f4b1cd9aad4af9063123b75540716a64c90d4586742f158ea6d88c27b8900cd53f8a5b36dfb2df45f2ebe397f49a5e66b72d70b855098e9cb45d4da6ebc0adcaa4c556f0e3d724c63a9ca7ffdcf2e0d84fdb8fb918c12f29de94793fec46b5bc864dce50f2898193265fc4223705ab4ab8487abc32b192d13a5ba1fe85a5b4d14bc386b7d41ce8d4dbf1a4194287952c06175c3e34c0435eca15868755b1f1b4187467a9303d6e8bc9756aa930593c431faad0b9ddad92e676bb73d7620c46523f6cbbbf7d91c3ad2ea16ecb1b78db1b3b5fadb234479178f7c525b7ad332befc6532be5b6254434586925db6f93e8b22ef80629cccbc66f598cab86367118a97c0bb68a8dd856c97a7cfb7005d1e3fb364b8e427d6c55021feac7376adb41268ffde32f0e3362e0f84aa493e0d9122665ab62c8948c1f60c2bf91e2714b61ac39d25c1a5b4d9aadeb6c86afa4e32b294df79c637a3eb4e64d99ab0cba3eafea2105420b305e14d5743c3485d51c0f8e22f90218c27125f279e030e9872dab762bf8a0746700f736f09602e1c8a66f572440ea0ce3dfaa409ad75b21df069ee3386f857ecb22414e60b8862d8b2caba6b5a48c63ead8ba902c00e7503b5b7e515ddb14cd7c69a3aba28860c2fdcdc091e5bda004088b59b2de8e109131d187cad9446bf00149116bce13522fd5aa47aa5dad81a583ac77e71fce24ff8189b8b3bc7e5f5d7ebe39bf78ef9811919e8d614124fc9e51b2f59c857a9e7e5163667a64540835e67ae0c729026fc6441062f8794ecacfc3a5dc4ac8d5e3b6855480be6dcb1138ba9b0e8fde783751a177b96c35cd520a42ca0a53018b26cc218bab6e65063709b98195a06d9d940daa4e6c30fe0f2e8490ee4840fd9bfdf325eb3cc637c4d1aad87ecdf8ce9be6ec673db48c75bebb9ea36dbae7ac6fd63db6d7820ddff3a06a5c1c7bbe03be6ab50e3bdaa1acc39073132257d1a63720ff1f50adb6bb834a882dc6bff3cdde98b78153b9aedaa40dba106390b6eae04733196db4275eb5f0f12be01356fad4106f70d57dc01c6a96143376e797d5a6931ac39f212c03544ec317953af314017c90c3611811927918083ad625856f4aa382142cfcc68a3cf16614d8c7ec9c1823a3876cc6d49a371be21de0d2d193ad0b8fdaa7c0881891188dd5352bdb82b2bd2e7356de506e96067c2e66c04226b403ef89dc269bcb804500a9dac84763cbaa2fd8581984184e2ea3cdee333eac4894d7697b144c58cf9a6c35609727a4772c0608badeb120d0435691cf0ca19b0c2ae15a1dc277c082cbb5cccf66e86d8b1d64844c41358c76112c15a60267ac90c8a3fcb5cf127fb3019240826e080b0ac21d4fab4e6955214de74e270c4a22bc220e04bd14e40a3eea756d651c8b526fd3f095c3cac272a6bdcc028e177fe9428bed59f4b20e3dab46e9dfc702d5cc849b03f4dc6df0c11e98ee2cbf5382a4a11853bd663ee8e72c86edf360b86b75ced6a46db48743e1e5af9acf51d3bd426d7bb178da646a7ccd965d79ab3f450c6052a9858d31cf55b864e8771b0ab94ef5928b470ca452c22729fbf703e936e272391651cac3da4341e4383e7c1d04680a0e0f9fdc7b4ad5660bfaa2e686abfb6d1015ff55362349bd905ddac38769a3453b222ab50a1025f2e6ecb4cdb4fba8bb524602872b336b18903dde61d2a344cbd972c69287d84e21587cb1481e8d78c41c9a9bb00c74cd18ef9ee1e2d833f6038989807cc9064af82a7f6629f6421230c627f5441937d5236770f5efa95564c58f31cac399b9cada65d6853cac712b1484e1d92d042894102ca0509bac1b5d0734a18ef41653cbcbf3f36de4fa5e91ffa9cdd373a4ec99d8c8fa2b70b750a6b0cc0de15026986e19b2aa0d16090057d35f304c2cf9b9dbae88e5666a5319d263d9a612567cd9a68adbecf12e191aaa1e7988597a60ec46e3f0edd4c3080ca36ca51a3b84748bb66d877a24ca90b33f8563abc6f5621a2c1f2e825ddb50edd8b1c09c51fd188bb019d1b8312846356a081139031f1e5a5babbe9b366dde86244bbd6a91a4fcc19a523d01c37a9f6ae645b218ffe4c23ad95b2a7fa428221ddf226192fdb84d098ad3ee79b3df5490c29e0fe9b3797acedc958002b46e75289307790b6f4bcaf92e6965f4170a998551eb018814bb9d58c83ebf29dcb94c3c1fac90d7ad991a08e5916023949197703fe7ade1902a042524ccbe24d751cf410d1533a60364b311a0ce260d668a42c4b1be1fdaf1ba30c666054cb76dd14ca08650a40bcc6f73e216f16888496064461fb478fe2621eea8dfd4c57009e27b7293a1676759cd4f4981878c3ee92989dc67e918a9b4651bc3469528ebfa424347658e657565991cf4ebb7bb90f1619f32fc86c2abf4d56493069237484d32ca2f73595903d56c305773fdd024290967786475544ed72c83f8568f95145ededb5a73b46c7d8fcdbbcb66f08bae1e6688e5cf58c3b48feb4cb365f8b3c7ba252c9bc6deec849b6a30519ec5102a0cccab7a95f408a248df4e20ea35d10bd8ae889a7df31dc6e418f0981c445ff742b22a7ca36b8571db98c71a862fe6238d5600fccef424835f14a162c463896735268ac3808e2c1ec287fe5c9b59029768dd44499d4592b96ad0c2fdeb1c8fea1ce8731156e96bbb3ff2ad5060d06b984507ca49852543101c1efb5b0f494a5cacfe4a749b15ed891f2ea0872ab872d57272f16ee04afd868e87b44e63999d3768bd66d962a1b78c52cd4a34413b1fb83bd833c12e7b506043778098dd46755796e8fe02cae5186325cac957044abfa40f023c607076732045997689f0a2a1aa04622cf875513d26c5d751d2444d5595f83747c10cbe6d60ad62a1d92ba257d2a499f60ec5bdbeab000b40ba96f05d9118fe2e78812149dd355a2434adead21141adaad449a1ae3969ecf719c6ce1560a16cd8f566c2522d9142ae2a38c9865a6640424db3c4f6fe217cdd49c156d7648284945d4223fc9fd04b87fa12003fb1eb0ee9d285cb68ef0e8210154e1fb0ace8277f20d9267f8b4ed16fa3e39bb68ff8c1dde971368228310e71462ec668ff8bd8293af0ad1ebb595737402ff210516b52b8a1b3f4d8f3e1c02bf36b587a2d50b8537ca0dc75daab7d3e214c2370dc2fb3323aa0a5af16d90a38a6689a45fca2553cc220b4f91dea938955d53568901374c2a157aa1c9f053bd49b071d1005c19d271835d0ad2b66d4a55d581ab9b1c0327e580fb814a4b9c58ccba56745e84bc515c5c96589bf52fcb3e03fe19e235d402e3169e6fe872a750858dfab98ac694aa111abb82a79190f0cb3f7b2219deb716fea45d313bccab96b482190f99d8db7e1109a34af8121aeeac7df13d73f8786541d376208bffad20bad1d5b069302814304acfd7ce7baca056633e98aa0249c7853a1c7e067cbb73c2100697cbf5d96eb055a02a881294eeed0d3b67ca15ef4b606896996b6f7970f7b80f6e148eb99e424a8cd3c00c876a1218d9b154651ecf734ad9a33e48f5a88082cb831fedd6110f0c92084dd5b07eb2e4ee6f39c14a40330fab0359e3b2c4e262fd3e18e2a07a32a1642f825d35643e2afbe8707916bc7f2737d0a0f281e89f25e2c26d72171a85056a297aa8de52c6e8f0a0a2fc2e192a19aba377db5849c9e884268a7383422c18a0e5e17d9505d5ee0435d70fa65055f1e0e17c48ba9a760f165055f1f0d17f47cffc84532d45419fbd2afeef068faa5ed9c7e593b870ab20bb550b1b25bbd3eea2b36501df0d368aafb050d15f6dba1b7307ff38e0cc41942fdf2700c72a680dc9461e4def3d950bb378f44e8416ed41c88f2f9faae770603f24caf3b43e5fdfef4634cb359b2cedba4cdb63f55456b507fe5f5d1979fe8406d64753bd9e0657e2c9e98046659ba09dfc66e8dc233509e6c19bf785048b57cb9e12ee9919c0914686936b6fecdb7baebccdcf74e2600596f6e48c6d8135160037521a20cfd53e19d36a34775ebe9ff601dc269e7b01b365c0d1ccc89843fb1e1561810b25a689195fe1448f78656184d1f844239a7a6f7e53ecf716a35f6936c9e728ed09fc188a62550cccbaabad5e4a3e9fe986d6331aaf4a48f8465376cae12fe00c3ec32ce43bc794f5d5fc2a78fa976883bb77c9f287b935de59f9a1f10cf3ebcb315368b394ccd6cc0f35cdf2b5152a06f66e4bff8f5c63b103cd8ba734e334e36652c434814c74bc536089e5dd4bb630137b82ef3cd2f0881fb8ccb892c5f080d857880ee19f2ddb0ee1d4a8cd7fc93024ea2dc507ee35a2375cf969ec37c19298578d02f5c51cdcf60d6bb833a1fc2baa4dab535fb7526958a7d3fe9c04f3af4935eb2ce23ead1a2be0a3ed8cf2bf4638cc4350cace1efda1a0b01a08f3c27a121f78cc75b976a93bc18d64f35f419ff711c9ca03df38bb8d8f0a253987647e2e103857c1f6dc028293584f5d6913b0abfd114b097664e61ae5d48788f55f63acb6ae3b58a7f1c0ae9319c3b406b10dcacabebac548ec9f191247b5893de7ad456119c22b08a923bf23e2e508b3645a2076945af2ebf5453edbf183d5e57772c54c7fa4ad8806552d0c34666bf71b0f3f448aa053c85dfdca5e7cf9fdbcfc7f612f7973efc8e294feb52574c99b83b427c605eabfc6027f62d37b9cf8b02c5e9421c00e391f090e1980857d918e9da15d8abeb9fdad6b3aab3728147fc1eff152d689730fa7808e02c907b74dc5fe4e33c9fb1768673506cda33a147290fc8f0799ee00109d3c56ecf7bbb75703c90793894f97228f36828f3d550e6eba1cc6f8632df88371ae734f40f43ff2cb4538ebc94575eca6b2fe51b2f851a147a5c468507e70cf1a67237f0b4e32c39572783cd8d60a1a04115bf5d8fa2e043750b64fdcfe0f2d0db844b5298c39b8716eecec61eef85527d59f71628344d41d97db6b75b8e9f6febf82583e6aa530aa840f050b78f9bf1f7f42b24e554a53509b9dd7068e3c2406fb8c98d4961166169b57d3fcbf2e29eb6a4e581b6735b8813220b32cd9304ad8306c40c2eca92942fbf2808df20de1570576852527d4138711717718da3ba1c8cdd2447ed4b874ca0d92ef6f8935e17f3285c31ec2c374501d80ba0a0d7b6651bb26d25a3da215344e67b9b984302e272b53170be461453bc96896fa2e8018ae73d0919aa7395d4c2efd124f83c26b6030cec849d6a8f5213abd0694f8dbbb0e3f0871c604ac81dedeeddde910a30c5f3ea098d4beb01883e7b11a0544d89451adf4c979f2e6315b6c77d98de9b25d0f1b84bd752a996cc9e429a914071d561eb59cae94a238f918b254a438131eb50d0de1344cb3015dfe8bf8f9def8df70dc7befa56b364c8a9a8adb4474594d21e239087e917b9de331a528ef590e5d41b889e20dbb9b1cebf7755ddadb61d3214537d514ba9e0604b37b6188e956aa4436451c2535c917586a1cbb2020a2c13074940ab1b55c06b520409c86ee86a14b802f6ba4e25bdeddabcea849ed1002d26eb9ab57e694eb4b58fb62decadfba00b156f2906c78331a24263d8af83c632e87921309d966db194eed924d4daec23b9f53587c5b8e8d7ad17a552e792b6a6d6fb0a06e9c6387ee62dc8b7d1327b98f45a48779da9036a9cad28369d79dee2eca3590c421e272bb8acf0c4add3b0ef0d018900ee16ebf3d30ffb8a5c8e248588133256ff38e4eb85c2d0309a2d50b8be052a96a0dbc6b6563ff9014e862e746fd49ee8f6a29013b33014933e14c983a816f50a65c752147359dac0bb4114074fa3835ddb93433695ca27a6718ce197410258af125bd0b63602611c3c1acfc0f38e465c67b3bb5e9df9d1187a4373fbfe67e8a9922dc4fa382c3be8764091d36e8a8993a9c661cceaf1486d2d81353b78adb7a7d2e595992f0fed4cc32c698aafcaa113408fd212aeac6699dc665ffe6217de8376e46ef21f25c522bca19b2d76f46664b1a196d1ff24e8e04095d2ed4e97b1add398d1d66596fddef87f07263a840beedad2b6ed1e8155addb81bdc0c7309e98bfd7a00778db04184a7e3b278ad2d8a56158da98e3410f6d58c76953b81c7b68e1588faa78781a44cbc572ee9b57d796504817a655fa387c7889d34bffda888adc830ea3b3b15957b781acc9b2db3e44f4d8307ef17cf911320eff8c3e7fc7638a679586e18bc44836a2bb4d9844720e74d3ac2fe48ed1dd2f932a791cb78b9ba2297c196a498a5b1a17e669e7ab5c0446cde8e23c7f189ec9fe039c0c864be4dbca45bb9c0cc86bcd589aca4b1eb2838b8cdc7f61132759d9ad643598a3b5dc42bfc2fb2980b67f7c03711d03bd23741bb0f83ffaf1660febbcce9a11c3d583405a649149da97a3499336db2eec98c0f70446a66923f36c3455893072649009727d3ba0db49f6591df6f060db2c5475d68f45347d2b44a64015a63a4193844d16d42e59dcadd9a2a1fe7f6abbf6deb68d24fe77fa297805aea00d27f123cd2597c301b2ad26461c2b27cbbd5e8b96d083968988a42a4a8e9d20f7d96f67f6c1d9dd5992b27105da5ae4ccec7bb93b8fdf9473d1b75522f3c0364c16f73aeaf0cbbcc5dd74e0f4b6eb88d13ee5614839f4229a94f9847eda7d0f2b85c3a8f106b880064ab7992d19a804a9ef4d75423fa9946664b9742abd9645ce7981a136209b2dd22074a22451611932ac1cbeddcde42a7d5d677a191ed29158e586e84c0fa9511e245ceccbee89caa2d51e671d484d03db0869cfb5d16aab01250d0eb2a55c0c08f470541961659e676bb55f8527b5eaf91bb133344c3ffce2a8afcfb4dc14146bd7aba25e4f60b2ae98d64e10ee404103fa4aad82794f6fad72c14092d34d75cf8847784c19acda25367f3d5da2967c3136c26c6fc53b0c7b05d536c46a59907fcd8401bf00cb1fa0ad0cf660f8a4a5dc107a5d43315fdb85aa3fde30987e349abf0e33965e1d8cd7dbcb17c6e94e4112217ec537374a5257415ad454f93c841c53df509b3dcd3883c96bb8ba6a130c83f83c22c27b68e639ca19359b6b762e3438d8b8da69c2a56856bc6f35dfeae380f8f4dedd1f58164731709ae1b3d81057f978f5c9606754ab293d1d899f708a36af679595e97556ade56bc22e16f36aedca8067ae208f503f4ba48337d54d57f7c5344157500442851c9a26acd9c565da5647619d05199757c649829bf29519188ec35111bb077a95f559a970ee761a145e777b915e07df9f18ceeff7a2837df2060589873feeb4948c5709009401c1f77bd1972dca06dea723c10ba51f2af64e68a5bbcc4bcfb067634cba261165f2d608bfd2f936a65700774d4a0ea33c90fc681cb2996c2e6939cfc790e2412151d55f89693e537b25ce20f153c1f4c8d79fd27bfa5afc4c1c676405656b7eab4b588daca031308c10759ba1c56015ad7a609d25c9f3e791b8bf4ed29504064973c47f99c08e97ce2215cf5c912a208ddcda1544096052139e38179df63cafe03fe223bc238b8bca258086a27b26d78128e56bb867688330d137ed965bc04629f88e1295dc8fca22aa36e20051557bd1d303f8892913a258fc9b67559515736cc78eed76fbcd352790c19e933447fe7d93de65adc9d9204e999c665b88c5ab190b6d4665576c55e913a903e0fe6a112d0638283ac8e424e2e9cc0781332b3eeede5f85b6df429399838901a4f2f2b91ba84ea7ecee169d056ba2a3a4ee3261041e5b3bbe85be0e8297cc49ac1e25b15936dfe2c7d416f734710a721127485063a75a7b3914a8f84d8105f8cb6e1bd99c195f5af02b4fb233d6faca2ce174d4f9a301dec45207ff7a7e762c9e14d3c5669646fff8b2c826cf6efe493deed26bcc8c80a6e92fe0ab918ef31625785674e5a1ad5625353058567aba4baca64787b1b9ce6c69c49e7fc996f1360cd049e87b902f41bdb515ef7c53b0c5d59d07d541cc07da0f750c785b70ae752c0651124e8f13d6d2c14e959499a571786ac9c436e0a3ab969fb2f481077557d89fd5434ffc4c7e9e5b5bb67918b7d9a73c7627b10f9521ffdf0a6718a83887639be39508cef2560e0bcfa345a189c9efcb7a3c5980b5c5f3c2fbed77272016508cd6a5b9183ccc6f041486e678b452fe7c817c17e29a67053efb41d335bd8c60866d43c18fad791f2a99e20ad34549304b8afe693745ff6adce26852af4e521d73d32a4d3bf3d92efd1693ee52b8acd96fdadac668b81a4314dc7277029936d1ee27ada86e10b397618964e899c1c843ee6f5fcd88b98b5556705f87a812e5c82324e7e70981a6a5e59d57db4e74d8d951041d81a310dd8c6fd36892a6858a073b78f6fad9c13e84038acb48f9595d402b8cf2934184e25c2a3ed41184fc45cb5509b791b4b23cbca4ea487b8a3bdadd8de830fe95529c07deea3043de434e2680581205b5bdcac673d0233b2ef359a594129d4caf70ffbe9e851db6a8baa4b8b572d378af5a9271b958df545c4bea57cced874a7874dc74de5a5607e3604a4f48bdcbe4f25d6fd83f4dc45169d81bfec73ae864eb98c0dd5a58bb7e1a44cf84629919ac0eb8ae72264d1c3e6d0925579c6e642d596b402075fefe62932fa5e7a58785271bbb132589416c4c92288e93a4285782655524899b7d4e2c1ac4de53a869013d0bcd7f259f002e77e036402fca4159ec4572c580cf49a92cf56715f51060f0affc50b49f7e8156cbfb2e4a69941021d1024d6f3b8884c425454b5ffafa6ec98db93e6755a80bdc2b111c47c0133b17f3359b766c04593dbc3e84ed6b79945cde772ea451d7d2e21a8a2542826a7de66f2fd4bbefbafb73c5980e55aab674bac1f319eb0c9a8355ef21a8f81b8ed3360b020155b030fcce6b7a1643af6d080592c91b6043e894ee20e8366f247612e3b1db112bae9da58e64b08403adf123117f37e2429a12d077c9067e61c11fa52a900563a4af7de08ec6548a84357ccff04a69bcff39c76769a4253dacf074e15ab08183f78dd8f9c0bf3d6832bfceae4b7389e48cd140107ca1cc7d318bf00e9eb02ae7a73ba5d05f91991ac0a558981729265872871acf101a4c937d892e09fc2bed0411bb394bc5314c3b09b88ce2b8fd49c385ba1e3670e7d13197b5d0396446850bd47df2495ceddc61a1a6fd95d86216982ed86d97733ec2249d5901be4455ea555fbe9ea5eceb792929e27afbd3c7f2e5225b43e0da9ae8c5792727c6f2cb38032568f264bc7dfd14665e9e963a8199a8ad979c836c166ece4f162f156554a144885ee1ca478696ec2d73c069d55947439175783ceb90284439cfc056be2cb362cdee6bb6a38da1ad5b85ce915fbf7b22cfc81ffaa3e1d9497232b8ba18f5877bcee3b7bdabb77df761eff872707e35f29f9f9ff52edd87efce2e4783b7c3de873d6d9f12cbf429b81e89aa4f36183cf3f708cd4795b8bbc135edf00f29c1b0269757c7c9f1d9e812b322a477e3a9e8cc3520898ba3f0ea3e5a969fa5b16cfdb944b0fd2ac2498a80206161aaf428feefd15f2338216495b846ee449b255c190fff387a19c5e349b9594707afa39b72b3aa40a04c132afdcc5dcc2ba6901f8324c75727effb82e260fff08533d7c4c5765d8a0d01c7a9f6eb80c1b44c919b9cfeccc777f4a76ade6f81727f677c5772c8f208c98eb3c52cf4ae5c2c10879a73bcc17259e71bc9cda48ff0c486fc6a142198eaab9b72811855c4d868ac8faf24aa7fba2655c2df89a6d29a4e489858fbd580eb80f99557f31a6e47fc5096592b45816268ae64736b441b22f50fed4afb5929a1fc55658022b1d080c47b956640f3892520a6f35338f16e000fa92af2a5e80338fe8a9b236a819c32c6555117abe48a67be5cbdf69fab0de339ee1086c2e02861be1bca88ca1a3183459f4c52d4c01411c0342a0825711b2c57e29b1089f3a74908305e80ef9f52e688258903a83367d433265640e2d1fe8e29d198c62185d378a1c7deaa50aa042a4c243524316e97a8348a249e7724c12960f319fb2568d337953d563e58116860a3fb72134dc705e44a10b70d2959166678a89f96db6fa6a9a0bcbb46354d31bdb7ba1ca7b3ccf7aa1fd3a92a8f1cb65c71329763a2d567502f5550dd37ad8bd5fcf9e689556bad61933d8c032d51a24ac4d4929df0f2c524538bd7ef56f4562322e70af84b8da8271966d11e4e1f984ae233017d2d5b0edb76b676a6bc06ee520852a4626ab873c0469de989697686f152634eade6e2f82cbeac8876653aa2229e7a07d46def90fe38a2f04d4059bcb17e1f3abf8f0a0f348b6ed66220e07f2bb92f34ef48e6cf8acc0876b3a6005ba840159d835ba99abe62695e439f615783d78fb30327f81afd814c2f5718b20c2382653d5392a451238a113d6c0caa5cf0ccd26b7d312ee61bd81d000d5e9cc220d948edfd32932e25e22cf9541e85233cf2cab1892faececfe908e17ac63277f69c3a00820a268acc66a93e928cc5a5675d0fc52ed2a8d698cfb4523dc31a177b04d4243235713691384f57f33aff8fee48e981e642b2d5e7805df3e79b0e34892ca4e50beff9a3ea71df84be6b6aaeb1899b546603d91e4e59ae3b19011acc726154dcaa30ea224314009ec380221763be0db9b8f66c432eae875b49cf6e9bc9696a79c9324f79fd0e4bd921ba84eb4f7139b8dba619c8c26418259a317e0251217229fb6d6be79cdc27d92cde345450cac6b167c535b64e31c34c7830b3e7541360f647510998870434145a4e1012285470538769562e89a51f0b576f289eab27d9769a54d1b504b1294e21fb999b24616b41f25e835399afb5ee2c7b370cf556a8323bad17205705e112c4ce72f10d3e66ac9b978353023b78564e41799ca4be27ac7d4d6fc9f5d9c506ee685fa1d7909da51905a795af68f1c2b1bf3dd633f48886e79d0697acac2daa5852f897add8ba352cc02f6e5f8cd59bf8768cabf4e0f0555b7e0c1731c036f56261fa910ee525b9d31c6f6c955fc79b96fa458b79d32413e28063206f4f8d68c42502f2535ecfb295abadc7b3161cc26a486c478d672848c65bf5c418853dc5631b13c4d6c4cc5ebaa514ad28ac47cf04ed3b59906b46842270b8989a9060d79a5762143e90190a7ef9c2e5e61d1ddd321fc007c5bd62b85eb516b635171475f092e1e202909dc21ec007c51d1d326cc61f2f5cdc03f8c46129d0230d1cc16635f004ebd6c0139c18211e717adbb2358263ebd6089ead5b2378b66e0d2099783931584a0bd5919f566d049fdb08540c39f72d68dccb14345ee6ec4b4dc05698b1a516d118b7dee292ce42663dbe8090f5169d74c3a6e3a08f1171c7aa7dc46c472fe5d195cebc415a8e2544806558e2f13934e521476a4e48d063e23415c64699de06cbdb8b64a2945d954a04fe90596877bd8c2e46d0e1f692c81c95e30b6dd395e2dee39843abe24d014aa7faa569aaf87b911609e38c6079d7013284d4e83896bcbc9cd58d933f2c6f052f89fd3abbbed7f5b30ce31e1145bfe0b395e8b081b2724079e5929ac91493806313d7004ac124effc38c92c95b38a1b2ecc5c8031a2c161a3857a9eb4602397e0b6bcf5d4a4e22e3295e2c6eb0f3e49cd2e9b18081c8e670dc9c34c7c6a284bd65dbee89ca4aa05396f36be059dd23a53c18190c1c3ddc580469c8d97784a47ff34ef16de9447addec5b8c4bc5b00cc7995a215b720cc1a00bf195613af8a49381f25e111b5801e863f1f5e0b23e191b5785c0d5a4a0fa186032a03f81a31b0e1803a4ed492511dac1e374290bb18b14e59fceba58aa6ced22208e549d0cca16e9c96b9f607715bc2e3dafa1de16631f87fb4ce7574f77a1df5291cd63742dd0120d575e560f230349ca70843a612ff5a38df4c7eafe8871fa2bfe8c703b003f747fde4fcece2ea97e47d7f78d13fdff11d00c519a86877035ccad4633411991785a43e76987eca539afac80aaaa90e975c356dbc0140078e508d1155b0d53dfc25dd68e07ccddb14dda74cb6fadcb602b7441323d38cdfabc30dd0654b21e693888addc8841ca5c5ad4af1a4b26fd7a1f4bb10d44d910f7e3a797b961cf7df9e5d24c3febfaefa9723652d3cb0497ac783e1c82139b449fa17a70e41141dd9241f7bc3de87cbc8fae7854d72393a3dbbb02988838d26195c8d6c92971e497f38b449fe66939cf6463da79ce8954df2b63f4a7eee9d8b16d524af4324a2ed9757e7a25a07fb4ef7beeff73f2627830bd1ac27a25fed9782ebe3e042d456beb43bfd6af46e303cfb55bc7ce2f6f64f67e7a3be6ce113d1cdae501c0651e8878fb08405c9be4d71d2bb18251f3efea2eac5143ef8b93f3c1ff44efba7aae55e15ae2ede5f0cfe2d268ed8264845647846924c978b4d05ff7ef74daff3ff0138f1b97a";
@@ -58,6 +58,170 @@ static uint32_t murmur2_hash(char *key, uint64_t keylen) {
 	return h;
 }
 
+/*
+	wyhash (final version 4) Copyright (C) Wang Yi, released in the public domain
+
+	it consumes 16 bytes per round using 64x64->128 bit multiplications, on modern cpus
+	it is faster than any vectorized alternative for the (short) keys we deal with
+*/
+static inline uint64_t wy_read64(uint8_t *p) {
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+static inline uint64_t wy_read32(uint8_t *p) {
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = a;
+	r *= b;
+	return (uint64_t) r ^ (uint64_t) (r >> 64);
+#else
+	uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t) a, lb = (uint32_t) b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+	c += lo < t;
+	uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	return lo ^ hi;
+#endif
+}
+
+static uint32_t wyhash_hash(char *key, uint64_t keylen) {
+	static const uint64_t s[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+	uint8_t *p = (uint8_t *) key;
+	uint64_t seed = s[0];
+	uint64_t a, b;
+	if (keylen <= 16) {
+		if (keylen >= 4) {
+			a = (wy_read32(p) << 32) | wy_read32(p + ((keylen >> 3) << 2));
+			b = (wy_read32(p + keylen - 4) << 32) | wy_read32(p + keylen - 4 - ((keylen >> 3) << 2));
+		}
+		else if (keylen > 0) {
+			a = ((uint64_t) p[0] << 16) | ((uint64_t) p[keylen >> 1] << 8) | p[keylen - 1];
+			b = 0;
+		}
+		else {
+			a = b = 0;
+		}
+	}
+	else {
+		uint64_t i = keylen;
+		if (i > 48) {
+			uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = wy_mix(wy_read64(p) ^ s[1], wy_read64(p + 8) ^ seed);
+				see1 = wy_mix(wy_read64(p + 16) ^ s[2], wy_read64(p + 24) ^ see1);
+				see2 = wy_mix(wy_read64(p + 32) ^ s[3], wy_read64(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = wy_mix(wy_read64(p) ^ s[1], wy_read64(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = wy_read64(p + i - 16);
+		b = wy_read64(p + i - 8);
+	}
+	uint64_t h = wy_mix(s[1] ^ keylen, wy_mix(a ^ s[1], b ^ seed));
+	return (uint32_t) (h ^ (h >> 32));
+}
+
+/*
+	crc32c (Castagnoli) with a final avalanche step (murmur3 fmix32), the raw crc has
+	poor distribution of the high bits.
+
+	The hardware version (SSE4.2 on x86_64, CRC32 extension on ARMv8) is chosen at runtime,
+	the software one gives the same results (so persistent cache stores are portable).
+*/
+static uint32_t crc32c_table[256];
+
+static void crc32c_init_table() {
+	uint32_t i, j;
+	for (i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+		}
+		crc32c_table[i] = crc;
+	}
+}
+
+static inline uint32_t crc32c_fmix(uint32_t h) {
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return h;
+}
+
+static uint32_t crc32c_sw_hash(char *key, uint64_t keylen) {
+	uint8_t *p = (uint8_t *) key;
+	uint32_t crc = 0xffffffff;
+	while (keylen--) {
+		crc = crc32c_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+	}
+	return crc32c_fmix(~crc);
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define UWSGI_HASH_CRC32C_HW
+#include <nmmintrin.h>
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw_hash(char *key, uint64_t keylen) {
+	uint8_t *p = (uint8_t *) key;
+	uint64_t crc = 0xffffffff;
+	while (keylen >= 8) {
+		uint64_t v;
+		memcpy(&v, p, 8);
+		crc = _mm_crc32_u64(crc, v);
+		p += 8;
+		keylen -= 8;
+	}
+	uint32_t crc32 = (uint32_t) crc;
+	while (keylen--) {
+		crc32 = _mm_crc32_u8(crc32, *p++);
+	}
+	return crc32c_fmix(~crc32);
+}
+
+static int crc32c_hw_available() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse4.2");
+}
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define UWSGI_HASH_CRC32C_HW
+#include <arm_acle.h>
+static uint32_t crc32c_hw_hash(char *key, uint64_t keylen) {
+	uint8_t *p = (uint8_t *) key;
+	uint32_t crc = 0xffffffff;
+	while (keylen >= 8) {
+		uint64_t v;
+		memcpy(&v, p, 8);
+		crc = __crc32cd(crc, v);
+		p += 8;
+		keylen -= 8;
+	}
+	while (keylen--) {
+		crc = __crc32cb(crc, *p++);
+	}
+	return crc32c_fmix(~crc);
+}
+
+// the compiler has been instructed to target a cpu with the crc32 extension
+static int crc32c_hw_available() {
+	return 1;
+}
+#endif
+
 static uint32_t random_hash(char *key, uint64_t keylen) {
 	return (uint32_t) rand();
 }
@@ -112,4 +276,13 @@ void uwsgi_hash_algo_register_all() {
 	uwsgi_hash_algo_register("random", random_hash);
 	uwsgi_hash_algo_register("rand", random_hash);
 	uwsgi_hash_algo_register("rr", rr_hash);
+	uwsgi_hash_algo_register("wyhash", wyhash_hash);
+	crc32c_init_table();
+#ifdef UWSGI_HASH_CRC32C_HW
+	if (crc32c_hw_available()) {
+		uwsgi_hash_algo_register("crc32c", crc32c_hw_hash);
+		return;
+	}
+#endif
+	uwsgi_hash_algo_register("crc32c", crc32c_sw_hash);
 }
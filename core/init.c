@@ -81,6 +81,9 @@ void uwsgi_init_default() {
 	uwsgi.signal_socket = -1;
 	uwsgi.my_signal_socket = -1;
 	uwsgi.stats_fd = -1;
+	uwsgi.stats_prometheus_fd = -1;
+	uwsgi.stats_binary_fd = -1;
+	uwsgi.stats_binary_freq = 1;
 
 	uwsgi.stats_pusher_default_freq = 3;
 
@@ -100,6 +103,7 @@ void uwsgi_init_default() {
 	uwsgi.subscribe_freq = 10;
 	uwsgi.subscription_tolerance = 17;
 	uwsgi.subscription_tolerance_inactive = 17;
+	uwsgi.subscription_ewma_decay = 10000;
 
 	uwsgi.cores = 1;
 	uwsgi.threads = 1;
@@ -385,6 +389,16 @@ void uwsgi_setup_workers() {
 		// add 4 bytes for uwsgi header
 		void *buffers = uwsgi_malloc_shared((uwsgi.buffer_size+4) * uwsgi.cores);
 		void *hvec = uwsgi_malloc_shared(sizeof(struct iovec) * uwsgi.vec_size * uwsgi.cores);
+		// vars index, at least twice the number of keys to keep the probe chains short
+		void *var_index = NULL;
+		if (!uwsgi.vars_index_disable) {
+			if (!uwsgi.var_index_mask) {
+				uint32_t var_index_size = 16;
+				while (var_index_size < (uint32_t) uwsgi.vec_size) var_index_size <<= 1;
+				uwsgi.var_index_mask = var_index_size - 1;
+			}
+			var_index = uwsgi_malloc_shared(sizeof(uint16_t) * (uwsgi.var_index_mask + 1) * uwsgi.cores);
+		}
 		void *post_buf = NULL;
 		if (uwsgi.post_buffering > 0)
 			post_buf = uwsgi_malloc_shared(uwsgi.post_buffering_bufsize * uwsgi.cores);
@@ -397,6 +411,8 @@ void uwsgi_setup_workers() {
 			uwsgi.workers[i].cores[j].buffer = buffers + ((uwsgi.buffer_size+4) * j);
 			// iovec for uwsgi vars
 			uwsgi.workers[i].cores[j].hvec = hvec + ((sizeof(struct iovec) * uwsgi.vec_size) * j);
+			if (var_index)
+				uwsgi.workers[i].cores[j].var_index = var_index + ((sizeof(uint16_t) * (uwsgi.var_index_mask + 1)) * j);
 			if (post_buf)
 				uwsgi.workers[i].cores[j].post_buf = post_buf + (uwsgi.post_buffering_bufsize * j);
 		}
@@ -428,6 +428,7 @@ int master_loop(char **argv, char **environ) {
 
 	uwsgi_cache_start_sweepers();
 	uwsgi_cache_start_sync_servers();
+	uwsgi_cache_start_store_sync();
 
 	uwsgi.wsgi_req->buffer = uwsgi.workers[0].cores[0].buffer;
 
@@ -481,6 +482,40 @@ int master_loop(char **argv, char **environ) {
 		uwsgi_log("*** Stats server enabled on %s fd: %d ***\n", uwsgi.stats, uwsgi.stats_fd);
 	}
 
+	if (uwsgi.stats_prometheus) {
+		char *tcp_port = strrchr(uwsgi.stats_prometheus, ':');
+		if (tcp_port) {
+			int current_defer_accept = uwsgi.no_defer_accept;
+			uwsgi.no_defer_accept = 1;
+			uwsgi.stats_prometheus_fd = bind_to_tcp(uwsgi.stats_prometheus, uwsgi.listen_queue, tcp_port);
+			uwsgi.no_defer_accept = current_defer_accept;
+		}
+		else {
+			uwsgi.stats_prometheus_fd = bind_to_unix(uwsgi.stats_prometheus, uwsgi.listen_queue, uwsgi.chmod_socket, uwsgi.abstract_socket);
+		}
+
+		// managed by its own thread
+		uwsgi_stats_prometheus_start();
+		uwsgi_log("*** Prometheus stats server enabled on %s fd: %d ***\n", uwsgi.stats_prometheus, uwsgi.stats_prometheus_fd);
+	}
+
+	if (uwsgi.stats_binary) {
+		char *tcp_port = strrchr(uwsgi.stats_binary, ':');
+		if (tcp_port) {
+			int current_defer_accept = uwsgi.no_defer_accept;
+			uwsgi.no_defer_accept = 1;
+			uwsgi.stats_binary_fd = bind_to_tcp(uwsgi.stats_binary, uwsgi.listen_queue, tcp_port);
+			uwsgi.no_defer_accept = current_defer_accept;
+		}
+		else {
+			uwsgi.stats_binary_fd = bind_to_unix(uwsgi.stats_binary, uwsgi.listen_queue, uwsgi.chmod_socket, uwsgi.abstract_socket);
+		}
+
+		// managed by its own thread
+		uwsgi_stats_binary_start();
+		uwsgi_log("*** Binary stats server enabled on %s fd: %d ***\n", uwsgi.stats_binary, uwsgi.stats_binary_fd);
+	}
+
 
 	if (uwsgi.stats_pusher_instances) {
 		if (!uwsgi_thread_new(uwsgi_stats_pusher_loop)) {
@@ -531,9 +566,6 @@ int master_loop(char **argv, char **environ) {
 	// first subscription
 	uwsgi_subscribe_all(0, 1);
 
-	// sync the cache store if needed
-	uwsgi_cache_sync_all();
-
 	if (uwsgi.queue_store && uwsgi.queue_filesize) {
 		if (msync(uwsgi.queue_header, uwsgi.queue_filesize, MS_ASYNC)) {
 			uwsgi_error("msync()");
@@ -663,6 +695,9 @@ int master_loop(char **argv, char **environ) {
 		// check chain reload
 		uwsgi_master_check_chain();
 
+		// steer the reuseport shards to the accepting workers
+		uwsgi_steer_shard_sockets();
+
 		// check if some worker is taking too much to die...
 		uwsgi_master_check_mercy();
 
@@ -842,8 +877,6 @@ int master_loop(char **argv, char **environ) {
 				uwsgi_subscribe_all(0, 0);
 			}
 
-			uwsgi_cache_sync_all();
-
 			if (uwsgi.queue_store && uwsgi.queue_filesize && uwsgi.queue_store_sync && ((uwsgi.master_cycles % uwsgi.queue_store_sync) == 0)) {
 				if (msync(uwsgi.queue_header, uwsgi.queue_filesize, MS_ASYNC)) {
 					uwsgi_error("msync()");
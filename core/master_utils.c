@@ -107,6 +107,9 @@ void uwsgi_master_cleanup_hooks(void) {
 		}
 	}
 
+	// leave the cache stores in a consistent state
+	uwsgi_cache_flush_stores();
+
 }
 
 
@@ -988,16 +991,62 @@ struct uwsgi_stats *uwsgi_master_generate_stats() {
 			if (uwsgi_stats_keylong_comma(us, "blocksize", (unsigned long long) uc->blocksize))
 				goto end;
 
-			if (uwsgi_stats_keylong_comma(us, "items", (unsigned long long) uc->n_items))
+			// sharded caches report the sum of their partitions
+			uint64_t i, n_items = 0, hits = 0, miss = 0, full = 0, optimistic_retries = 0, evictions = 0, rejected = 0, compressed = 0;
+			for (i = 0; i < uwsgi_cache_nshards(uc); i++) {
+				struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, i);
+				n_items += ucs->n_items;
+				hits += ucs->hits;
+				miss += ucs->miss;
+				full += ucs->full;
+				optimistic_retries += ucs->optimistic_retries;
+				evictions += ucs->evictions;
+				rejected += ucs->admission_rejected;
+				compressed += ucs->compressed_items;
+			}
+
+			char *policy = "none";
+			if (uc->purge_lru) policy = "lru";
+			else if (uc->purge_policy == UWSGI_CACHE_POLICY_CLOCK) policy = "clock";
+			else if (uc->purge_policy == UWSGI_CACHE_POLICY_SAMPLED) policy = "sampled";
+
+			if (uwsgi_stats_keyval_comma(us, "policy", policy))
+				goto end;
+
+			if (uwsgi_stats_keyval_comma(us, "admission", uc->tinylfu ? "tinylfu" : "none"))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "shards", (unsigned long long) uc->shards))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "items", (unsigned long long) n_items))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "hits", (unsigned long long) hits))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "miss", (unsigned long long) miss))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "full", (unsigned long long) full))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "optimistic_retries", (unsigned long long) optimistic_retries))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "evictions", (unsigned long long) evictions))
+				goto end;
+
+			if (uwsgi_stats_keylong_comma(us, "admission_rejected", (unsigned long long) rejected))
 				goto end;
 
-			if (uwsgi_stats_keylong_comma(us, "hits", (unsigned long long) uc->hits))
+			if (uwsgi_stats_keylong_comma(us, "compressed_items", (unsigned long long) compressed))
 				goto end;
 
-			if (uwsgi_stats_keylong_comma(us, "miss", (unsigned long long) uc->miss))
+			if (uwsgi_stats_keylong_comma(us, "replication_seq", (unsigned long long) (uc->replog ? uc->replog->seq : 0)))
 				goto end;
 
-			if (uwsgi_stats_keylong_comma(us, "full", (unsigned long long) uc->full))
+			if (uwsgi_stats_keylong_comma(us, "replication_skipped", (unsigned long long) uc->replication_skipped))
 				goto end;
 
 			if (uwsgi_stats_keylong(us, "last_modified_at", (unsigned long long) uc->last_modified_at))
@@ -1110,6 +1159,9 @@ struct uwsgi_stats *uwsgi_master_generate_stats() {
 		if (uwsgi_stats_keylong_comma(us, "shared", (unsigned long long) uwsgi_sock->shared))
 			goto end;
 
+		if (uwsgi_stats_keylong_comma(us, "shard", (unsigned long long) uwsgi_sock->shard))
+			goto end;
+
 		if (uwsgi_stats_keylong(us, "can_offload", (unsigned long long) uwsgi_sock->can_offload))
 			goto end;
 
@@ -1206,6 +1258,28 @@ struct uwsgi_stats *uwsgi_master_generate_stats() {
 		if (uwsgi_stats_keylong_comma(us, "avg_rt", (unsigned long long) uwsgi.workers[i + 1].avg_response_time))
 			goto end;
 
+		if (uwsgi.metrics_response_time) {
+			struct uwsgi_histogram *uh = &uwsgi.metrics_response_time->histogram[i + 1];
+			if (uwsgi_stats_key(us, "rt_percentiles"))
+				goto end;
+			if (uwsgi_stats_object_open(us))
+				goto end;
+			if (uwsgi_stats_keylong_comma(us, "p50", (unsigned long long) uwsgi_histogram_percentile(uh, 500)))
+				goto end;
+			if (uwsgi_stats_keylong_comma(us, "p90", (unsigned long long) uwsgi_histogram_percentile(uh, 900)))
+				goto end;
+			if (uwsgi_stats_keylong_comma(us, "p99", (unsigned long long) uwsgi_histogram_percentile(uh, 990)))
+				goto end;
+			if (uwsgi_stats_keylong_comma(us, "p999", (unsigned long long) uwsgi_histogram_percentile(uh, 999)))
+				goto end;
+			if (uwsgi_stats_keylong(us, "max", (unsigned long long) uwsgi_histogram_percentile(uh, 1000)))
+				goto end;
+			if (uwsgi_stats_object_close(us))
+				goto end;
+			if (uwsgi_stats_comma(us))
+				goto end;
+		}
+
 		// applications list
 		if (uwsgi_stats_key(us, "apps"))
 			goto end;
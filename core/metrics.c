@@ -55,6 +55,29 @@ extern struct uwsgi_server uwsgi;
 
 	Updating metrics from your app MUST BE ATOMIC, for such a reason a uWSGI rwlock is initialized on startup and used for each operation (simple reading from a metric does not require locking)
 
+	The only exception are increments and decrements: each metric without a collector has a slot per worker (the master, the mules and the spoolers
+	share the slot 0) in shared memory, updated with atomic operations and without locking. The slots of a worker are contiguous and aligned
+	to the cpu cache line, so workers never compete for the same memory. The metrics thread moves them to the metric value (with the lock held)
+	at every collection, while uwsgi.metric_get() and the other operations take the pending increments into account.
+
+	To avoid the name lookup in hot paths, resolve the metric once and update it via its handle:
+
+	h = uwsgi.metric_handle("foobar.test")
+	uwsgi.metric_inc_handle(h, N=1)
+	uwsgi.metric_dec_handle(h, N=1)
+	uwsgi.metric_set_handle(h, N)
+	uwsgi.metric_get_handle(h)
+
+	(in C: struct uwsgi_metric *um = uwsgi_metric_handle("foobar.test", NULL); uwsgi_metric_handle_inc(um, 1);)
+
+	Histograms (type=histogram) collect the distribution of values (generally latencies in microseconds) in log-linear buckets. Each worker
+	has its own buckets in shared memory (updated with atomic operations), merged by the metrics thread. The value of a histogram metric is the
+	number of observations, while its percentiles are exposed as gauge metrics (name.p50, name.p90, name.p99, name.p999 and name.max) so
+	thresholds, the metrics_dir and the stats pushers work with them too. The core.response_time histogram is fed by the workers with the
+	response time of each request. Applications can feed their histograms with:
+
+	uwsgi.metric_observe("foobar.latency", N)
+
 	Metrics can be updated from the internal routing subsystem too:
 
 		route-if = equal:${REQUEST_URI};/foobar metricinc:foobar.test 2
@@ -306,6 +329,123 @@ struct uwsgi_metric *uwsgi_register_metric(char *name, char *oid, uint8_t value_
 	return uwsgi_register_metric_do(name, oid, value_type, collector, ptr, freq, custom, 0);
 }
 
+/*
+	histograms
+*/
+
+static char *uwsgi_histogram_children[] = {"p50", "p90", "p99", "p999", "max", NULL};
+static int64_t uwsgi_histogram_permilles[] = {500, 900, 990, 999, 1000};
+
+static uint64_t uwsgi_histogram_bucket(uint64_t value) {
+	if (value < (1 << UWSGI_HISTOGRAM_SUB_BITS)) return value;
+	int msb = 63 - __builtin_clzll(value);
+	// the first UWSGI_HISTOGRAM_SUB_BITS bits after the most significant one select the sub-bucket
+	uint64_t group = msb - UWSGI_HISTOGRAM_SUB_BITS + 1;
+	uint64_t sub = (value >> (msb - UWSGI_HISTOGRAM_SUB_BITS)) - (1 << UWSGI_HISTOGRAM_SUB_BITS);
+	uint64_t bucket = (group << UWSGI_HISTOGRAM_SUB_BITS) | sub;
+	if (bucket >= UWSGI_HISTOGRAM_BUCKETS) return UWSGI_HISTOGRAM_BUCKETS - 1;
+	return bucket;
+}
+
+// the highest value mapped to a bucket
+uint64_t uwsgi_histogram_bucket_max(uint64_t bucket) {
+	if (bucket < (1 << UWSGI_HISTOGRAM_SUB_BITS)) return bucket;
+	uint64_t group = bucket >> UWSGI_HISTOGRAM_SUB_BITS;
+	uint64_t sub = bucket & ((1 << UWSGI_HISTOGRAM_SUB_BITS) - 1);
+	uint64_t low = ((1 << UWSGI_HISTOGRAM_SUB_BITS) + sub) << (group - 1);
+	return low + (1ULL << (group - 1)) - 1;
+}
+
+// lock-free, the area is written only by the threads of its worker
+void uwsgi_histogram_add(struct uwsgi_histogram *uh, uint64_t value) {
+	__atomic_fetch_add(&uh->buckets[uwsgi_histogram_bucket(value)], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&uh->sum, value, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&uh->count, 1, __ATOMIC_RELAXED);
+	uint64_t max = __atomic_load_n(&uh->max, __ATOMIC_RELAXED);
+	while (value > max) {
+		if (__atomic_compare_exchange_n(&uh->max, &max, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+	}
+}
+
+static void uwsgi_histogram_merge(struct uwsgi_histogram *dst, struct uwsgi_histogram *src) {
+	int i;
+	dst->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+	dst->sum += __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+	uint64_t max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+	if (max > dst->max) dst->max = max;
+	for(i=0;i<UWSGI_HISTOGRAM_BUCKETS;i++) {
+		dst->buckets[i] += __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+	}
+}
+
+// merge the workers areas of a histogram metric
+void uwsgi_metric_histogram_merge(struct uwsgi_metric *um, struct uwsgi_histogram *dst) {
+	memset(dst, 0, sizeof(struct uwsgi_histogram));
+	if (!um->histogram) return;
+	int i;
+	for(i=0;i<=uwsgi.numproc;i++) {
+		uwsgi_histogram_merge(dst, &um->histogram[i]);
+	}
+}
+
+// permille = 1000 returns the max value
+uint64_t uwsgi_histogram_percentile(struct uwsgi_histogram *uh, uint64_t permille) {
+	uint64_t max = __atomic_load_n(&uh->max, __ATOMIC_RELAXED);
+	if (permille >= 1000) return max;
+	// the count is computed from the buckets, so it is consistent with them even during updates
+	uint64_t count = 0;
+	int i;
+	for(i=0;i<UWSGI_HISTOGRAM_BUCKETS;i++) {
+		count += __atomic_load_n(&uh->buckets[i], __ATOMIC_RELAXED);
+	}
+	if (count == 0) return 0;
+	uint64_t rank = ((count * permille) + 999) / 1000;
+	uint64_t seen = 0;
+	for(i=0;i<UWSGI_HISTOGRAM_BUCKETS;i++) {
+		seen += __atomic_load_n(&uh->buckets[i], __ATOMIC_RELAXED);
+		if (seen >= rank) {
+			uint64_t value = uwsgi_histogram_bucket_max(i);
+			return value > max ? max : value;
+		}
+	}
+	return max;
+}
+
+// percentiles are gauges collected from the merged histogram of the parent
+static void uwsgi_metric_histogram_children(struct uwsgi_metric *um) {
+	char name[4096];
+	char oid[4096];
+	int i;
+	for(i=0;uwsgi_histogram_children[i];i++) {
+		int ret = snprintf(name, 4096, "%s.%s", um->name, uwsgi_histogram_children[i]);
+		if (ret <= 0 || ret >= 4096) {
+			uwsgi_log("unable to register metric name %s.%s\n", um->name, uwsgi_histogram_children[i]);
+			exit(1);
+		}
+		if (um->oid) {
+			ret = snprintf(oid, 4096, "%s.%d", um->oid, i + 1);
+			if (ret <= 0 || ret >= 4096) {
+				uwsgi_log("unable to register metric oid %s.%d\n", um->oid, i + 1);
+				exit(1);
+			}
+		}
+		struct uwsgi_metric *child = uwsgi_register_metric(name, um->oid ? oid : NULL, UWSGI_METRIC_GAUGE, "percentile", um, um->freq, NULL);
+		child->arg1n = uwsgi_histogram_permilles[i];
+	}
+}
+
+int uwsgi_metric_handle_observe(struct uwsgi_metric *um, uint64_t value) {
+	if (!um->histogram) return -1;
+	uwsgi_histogram_add(&um->histogram[uwsgi.mywid], value);
+	return 0;
+}
+
+int uwsgi_metric_observe(char *name, char *oid, uint64_t value) {
+	struct uwsgi_metric *um = uwsgi_metric_handle(name, oid);
+	if (!um) return -1;
+	return uwsgi_metric_handle_observe(um, value);
+}
+
 struct uwsgi_metric *uwsgi_register_keyval_metric(char *arg) {
 	char *m_name = NULL;
 	char *m_oid = NULL;
@@ -361,6 +501,9 @@ struct uwsgi_metric *uwsgi_register_keyval_metric(char *arg) {
 		if (!strcmp(m_type, "gauge")) {
 			type = UWSGI_METRIC_GAUGE;
 		}
+		else if (!strcmp(m_type, "histogram")) {
+			type = UWSGI_METRIC_HISTOGRAM;
+		}
 		else if (!strcmp(m_type, "absolute")) {
 			type = UWSGI_METRIC_ABSOLUTE;
 		}
@@ -373,6 +516,10 @@ struct uwsgi_metric *uwsgi_register_keyval_metric(char *arg) {
 		collector = m_collector;	
 	}
 
+	if (type == UWSGI_METRIC_HISTOGRAM) {
+		collector = "histogram";
+	}
+
 	if (m_freq) freq = strtoul(m_freq, NULL, 10);
 
 	
@@ -387,6 +534,10 @@ struct uwsgi_metric *uwsgi_register_keyval_metric(char *arg) {
 		um->reset_after_push = 1;
 	}
 
+	if (type == UWSGI_METRIC_HISTOGRAM) {
+		uwsgi_metric_histogram_children(um);
+	}
+
 	if (m_children) {
 		char *p, *ctx = NULL;
         	uwsgi_foreach_token(m_children, ";", p, ctx) {
@@ -437,6 +588,31 @@ struct uwsgi_metric *uwsgi_register_keyval_metric(char *arg) {
 	return um;
 }
 
+// the slot of the current process (in the master, the mules and the spoolers mywid is 0)
+#define uwsgi_metric_slot(um) (um->slots + (uwsgi.mywid * uwsgi.metrics_slots_stride))
+
+// move the pending increments of all of the workers to the caller (the metrics lock must be held)
+static int64_t uwsgi_metric_slots_fold(struct uwsgi_metric *um) {
+	if (!um->slots) return 0;
+	int64_t delta = 0;
+	int i;
+	for(i=0;i<=uwsgi.numproc;i++) {
+		delta += __atomic_exchange_n(um->slots + (i * uwsgi.metrics_slots_stride), 0, __ATOMIC_RELAXED);
+	}
+	return delta;
+}
+
+// sum the pending increments without consuming them
+static int64_t uwsgi_metric_slots_sum(struct uwsgi_metric *um) {
+	if (!um->slots) return 0;
+	int64_t delta = 0;
+	int i;
+	for(i=0;i<=uwsgi.numproc;i++) {
+		delta += __atomic_load_n(um->slots + (i * uwsgi.metrics_slots_stride), __ATOMIC_RELAXED);
+	}
+	return delta;
+}
+
 static void *uwsgi_metrics_loop(void *arg) {
 
 	// block signals on this thread
@@ -464,6 +640,9 @@ static void *uwsgi_metrics_loop(void *arg) {
 			if (metric->collector) {
 				*metric->value = metric->initial_value + metric->collector->func(metric);
 			}
+			else if (metric->slots) {
+				*metric->value += uwsgi_metric_slots_fold(metric);
+			}
 			int64_t new_value = *metric->value;
 			uwsgi_rwunlock(uwsgi.metrics_lock);
 
@@ -543,6 +722,11 @@ struct uwsgi_metric *uwsgi_metric_find_by_namen(char *name, size_t len) {
         return NULL;
 }
 
+struct uwsgi_metric *uwsgi_metric_by_id(uint64_t id) {
+	if (!uwsgi.has_metrics || id >= uwsgi.metrics_cnt) return NULL;
+	return uwsgi.metrics_table[id];
+}
+
 struct uwsgi_metric_child *uwsgi_metric_add_child(struct uwsgi_metric *parent, struct uwsgi_metric *child) {
 	struct uwsgi_metric_child *umc = parent->children, *old_umc = NULL;
 	while(umc) {
@@ -608,39 +792,75 @@ struct uwsgi_metric *uwsgi_metric_find_by_asn(char *asn, size_t len) {
 	metric_mul
 	metric_div
 
+	the handle_* variants work on an already resolved metric (see uwsgi_metric_handle())
+
 */
 
-#define um_op struct uwsgi_metric *um = NULL;\
-	if (!uwsgi.has_metrics) return -1;\
-	if (name) {\
-                um = uwsgi_metric_find_by_name(name);\
-        }\
-        else if (oid) {\
-                um = uwsgi_metric_find_by_oid(oid);\
-        }\
-        if (!um) return -1;\
-	if (um->collector || um->type == UWSGI_METRIC_ALIAS) return -1;\
-	uwsgi_wlock(uwsgi.metrics_lock)
+// resolve an updatable metric (NULL if it does not exist or its value is collected, histograms excluded)
+struct uwsgi_metric *uwsgi_metric_handle(char *name, char *oid) {
+	struct uwsgi_metric *um = NULL;
+	if (!uwsgi.has_metrics) return NULL;
+	if (name) {
+		um = uwsgi_metric_find_by_name(name);
+	}
+	else if (oid) {
+		um = uwsgi_metric_find_by_oid(oid);
+	}
+	if (!um || (!um->slots && !um->histogram)) return NULL;
+	return um;
+}
 
-int uwsgi_metric_set(char *name, char *oid, int64_t value) {
-	um_op;
+int uwsgi_metric_handle_inc(struct uwsgi_metric *um, int64_t value) {
+	if (!um->slots) return -1;
+	__atomic_fetch_add(uwsgi_metric_slot(um), value, __ATOMIC_RELAXED);
+	return 0;
+}
+
+int uwsgi_metric_handle_dec(struct uwsgi_metric *um, int64_t value) {
+	if (!um->slots) return -1;
+	__atomic_fetch_sub(uwsgi_metric_slot(um), value, __ATOMIC_RELAXED);
+	return 0;
+}
+
+int uwsgi_metric_handle_set(struct uwsgi_metric *um, int64_t value) {
+	if (!um->slots) return -1;
+	uwsgi_wlock(uwsgi.metrics_lock);
+	// pending increments are overwritten
+	uwsgi_metric_slots_fold(um);
 	*um->value = value;
 	uwsgi_rwunlock(uwsgi.metrics_lock);
 	return 0;
 }
 
-int uwsgi_metric_inc(char *name, char *oid, int64_t value) {
-        um_op;
-	*um->value += value;
+int64_t uwsgi_metric_handle_get(struct uwsgi_metric *um) {
+	uwsgi_rlock(uwsgi.metrics_lock);
+	int64_t ret = *um->value + uwsgi_metric_slots_sum(um);
 	uwsgi_rwunlock(uwsgi.metrics_lock);
-	return 0;
+	return ret;
+}
+
+// operations not expressible as increments get the pending ones applied before
+#define um_op struct uwsgi_metric *um = uwsgi_metric_handle(name, oid);\
+	if (!um) return -1;\
+	uwsgi_wlock(uwsgi.metrics_lock);\
+	*um->value += uwsgi_metric_slots_fold(um)
+
+int uwsgi_metric_set(char *name, char *oid, int64_t value) {
+	struct uwsgi_metric *um = uwsgi_metric_handle(name, oid);
+	if (!um) return -1;
+	return uwsgi_metric_handle_set(um, value);
+}
+
+int uwsgi_metric_inc(char *name, char *oid, int64_t value) {
+	struct uwsgi_metric *um = uwsgi_metric_handle(name, oid);
+	if (!um) return -1;
+	return uwsgi_metric_handle_inc(um, value);
 }
 
 int uwsgi_metric_dec(char *name, char *oid, int64_t value) {
-        um_op;
-	*um->value -= value;
-	uwsgi_rwunlock(uwsgi.metrics_lock);
-	return 0;
+	struct uwsgi_metric *um = uwsgi_metric_handle(name, oid);
+	if (!um) return -1;
+	return uwsgi_metric_handle_dec(um, value);
 }
 
 int uwsgi_metric_mul(char *name, char *oid, int64_t value) {
@@ -661,7 +881,6 @@ int uwsgi_metric_div(char *name, char *oid, int64_t value) {
 
 int64_t uwsgi_metric_get(char *name, char *oid) {
 	if (!uwsgi.has_metrics) return 0;
-	int64_t ret = 0;
 	struct uwsgi_metric *um = NULL;
 	if (name) {
 		um = uwsgi_metric_find_by_name(name);
@@ -671,18 +890,11 @@ int64_t uwsgi_metric_get(char *name, char *oid) {
 	}
 	if (!um) return 0;
 
-	// now (in rlocked context) we get the value from
-	// the map
-	uwsgi_rlock(uwsgi.metrics_lock);
-	ret = *um->value;
-	// unlock
-	uwsgi_rwunlock(uwsgi.metrics_lock);
-	return ret;
+	return uwsgi_metric_handle_get(um);
 }
 
 int64_t uwsgi_metric_getn(char *name, size_t nlen, char *oid, size_t olen) {
         if (!uwsgi.has_metrics) return 0;
-        int64_t ret = 0;
         struct uwsgi_metric *um = NULL;
         if (name) {
                 um = uwsgi_metric_find_by_namen(name, nlen);
@@ -692,13 +904,7 @@ int64_t uwsgi_metric_getn(char *name, size_t nlen, char *oid, size_t olen) {
         }
         if (!um) return 0;
 
-        // now (in rlocked context) we get the value from
-        // the map
-        uwsgi_rlock(uwsgi.metrics_lock);
-        ret = *um->value;
-        // unlock
-        uwsgi_rwunlock(uwsgi.metrics_lock);
-        return ret;
+        return uwsgi_metric_handle_get(um);
 }
 
 int uwsgi_metric_set_max(char *name, char *oid, int64_t value) {
@@ -844,6 +1050,10 @@ void uwsgi_setup_metrics() {
 		uwsgi_sock = uwsgi_sock->next;
 	}
 
+	// the distribution of the requests response time (in microseconds)
+	uwsgi.metrics_response_time = uwsgi_register_metric("core.response_time", "5.105", UWSGI_METRIC_HISTOGRAM, "histogram", NULL, 0, NULL);
+	uwsgi_metric_histogram_children(uwsgi.metrics_response_time);
+
 	// create aliases
 	uwsgi_register_metric("rss_size", NULL, UWSGI_METRIC_ALIAS, NULL, total_rss, 0, NULL);
 	uwsgi_register_metric("vsz_size", NULL, UWSGI_METRIC_ALIAS, NULL, total_vsz, 0, NULL);
@@ -859,15 +1069,38 @@ void uwsgi_setup_metrics() {
 
 	// allocate shared memory
 	int64_t *values = uwsgi_calloc_shared(sizeof(int64_t) * uwsgi.metrics_cnt);
+	uwsgi.metrics_table = uwsgi_malloc(sizeof(struct uwsgi_metric *) * uwsgi.metrics_cnt);
 	pos = 0;
+	uint64_t slots = 0;
 
 	struct uwsgi_metric *metric = uwsgi.metrics;
 	while(metric) {
 		metric->value = &values[pos];
+		metric->id = pos;
+		uwsgi.metrics_table[pos] = metric;
+		if (!metric->collector && metric->type != UWSGI_METRIC_ALIAS) slots++;
+		if (metric->type == UWSGI_METRIC_HISTOGRAM) {
+			metric->histogram = uwsgi_calloc_shared(sizeof(struct uwsgi_histogram) * (uwsgi.numproc + 1));
+		}
 		pos++;
 		metric = metric->next;
 	}
 
+	// per-worker slots for atomic increments, each worker area is aligned to the cache line (mmap'ed memory is page aligned)
+	if (slots > 0) {
+		uwsgi.metrics_slots_stride = ((slots + 7) / 8) * 8;
+		int64_t *slots_area = uwsgi_calloc_shared(sizeof(int64_t) * uwsgi.metrics_slots_stride * (uwsgi.numproc + 1));
+		slots = 0;
+		metric = uwsgi.metrics;
+		while(metric) {
+			if (!metric->collector && metric->type != UWSGI_METRIC_ALIAS) {
+				metric->slots = slots_area + slots;
+				slots++;
+			}
+			metric = metric->next;
+		}
+	}
+
 	// remap aliases
 	metric = uwsgi.metrics;
         while(metric) {
@@ -1064,6 +1297,22 @@ static int64_t uwsgi_metric_collector_avg(struct uwsgi_metric *um) {
         return total/count;
 }
 
+// merge the workers areas (the metrics lock is held), the value is the number of observations
+static int64_t uwsgi_metric_collector_histogram(struct uwsgi_metric *um) {
+	if (!um->histogram) return 0;
+	if (!um->histogram_merged) {
+		um->histogram_merged = uwsgi_malloc(sizeof(struct uwsgi_histogram));
+	}
+	uwsgi_metric_histogram_merge(um, um->histogram_merged);
+	return um->histogram_merged->count;
+}
+
+static int64_t uwsgi_metric_collector_percentile(struct uwsgi_metric *um) {
+	struct uwsgi_metric *histogram = (struct uwsgi_metric *) um->ptr;
+	if (!histogram || !histogram->histogram_merged) return 0;
+	return uwsgi_histogram_percentile(histogram->histogram_merged, um->arg1n);
+}
+
 static int64_t uwsgi_metric_collector_func(struct uwsgi_metric *um) {
 	if (!um->arg1) return 0;
 	int64_t (*func)(struct uwsgi_metric *) = (int64_t (*)(struct uwsgi_metric *)) um->custom;
@@ -1084,4 +1333,6 @@ void uwsgi_metrics_collectors_setup() {
 	uwsgi_register_metric_collector("multiplier", uwsgi_metric_collector_multiplier);
 	uwsgi_register_metric_collector("avg", uwsgi_metric_collector_avg);
 	uwsgi_register_metric_collector("func", uwsgi_metric_collector_func);
+	uwsgi_register_metric_collector("histogram", uwsgi_metric_collector_histogram);
+	uwsgi_register_metric_collector("percentile", uwsgi_metric_collector_percentile);
 }
@@ -709,6 +709,9 @@ int uwsgi_parse_vars(struct wsgi_request *wsgi_req) {
 
 next:
 
+	// from now on the vars are looked up by the index
+	uwsgi_vars_index(wsgi_req);
+
 	// manage post buffering (if needed as post_file could be created before)
 	if (uwsgi.post_buffering > 0 && !wsgi_req->post_file) {
 		// read to disk if post_cl > post_buffering (it will eventually do upload progress...)
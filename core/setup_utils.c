@@ -96,8 +96,14 @@ void uwsgi_setup_inherited_sockets() {
 	while (uwsgi_sock) {
 		//a bit overengineering
 		if (uwsgi_sock->name[0] != 0 && !uwsgi_sock->bound) {
-			for (j = 3; j < (int) uwsgi.max_fd; j++) {
-				uwsgi_add_socket_from_fd(uwsgi_sock, j);
+			// shards share the same address
+			if (uwsgi_sock->shard) {
+				uwsgi_inherit_shard_socket(uwsgi_sock);
+			}
+			else {
+				for (j = 3; j < (int) uwsgi.max_fd; j++) {
+					uwsgi_add_socket_from_fd(uwsgi_sock, j);
+				}
 			}
 		}
 		uwsgi_sock = uwsgi_sock->next;
@@ -1673,6 +1673,11 @@ void uwsgi_map_sockets() {
 	while (uwsgi_sock) {
 		struct uwsgi_string_list *usl = uwsgi.map_socket;
 		int enabled = 1;
+		// every worker accepts only from its own shard
+		if (uwsgi_sock->shard) {
+			enabled = uwsgi_sock->shard == uwsgi.mywid;
+			usl = NULL;
+		}
 		while (usl) {
 
 			char *colon = strchr(usl->value, ':');
@@ -1723,6 +1728,196 @@ void uwsgi_map_sockets() {
 
 }
 
+/*
+	--reuse-port-shards
+
+	every tcp socket is bound once per worker with SO_REUSEPORT, so each worker accepts from its own
+	listen queue (no thundering herd, no accept lock). The master keeps all of the shards open
+	(they survive reloads like any other socket), so connections queued to a dead (or respawning)
+	worker are not lost.
+
+	the clones are added after the original socket, so (as long as only this instance binds the address)
+	the position of a shard in the kernel reuseport group is its worker id - 1.
+*/
+void uwsgi_setup_shard_sockets() {
+	if (uwsgi.reuse_port_cbpf) uwsgi.reuse_port_shards = 1;
+	if (!uwsgi.reuse_port_shards) return;
+
+	if (!uwsgi.master_process) {
+		uwsgi_log("--reuse-port-shards requires the master process\n");
+		exit(1);
+	}
+
+#ifndef SO_REUSEPORT
+	uwsgi_log("!!! your system does not support SO_REUSEPORT, --reuse-port-shards will be ignored !!!\n");
+	uwsgi.reuse_port_shards = 0;
+#else
+	uwsgi.reuse_port = 1;
+	if (uwsgi.numproc < 2) return;
+
+	// the shards of the cheaped workers would never be accepted
+	if (uwsgi.cheaper && !uwsgi.reuse_port_cbpf) {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+		uwsgi_log("cheaper mode enabled, steering the reuseport shards with --reuse-port-cbpf\n");
+		uwsgi.reuse_port_cbpf = 1;
+#else
+		uwsgi_log("--reuse-port-shards in cheaper mode requires SO_ATTACH_REUSEPORT_CBPF\n");
+		exit(1);
+#endif
+	}
+
+	if (uwsgi.cheaper && uwsgi.numproc > 2000) {
+		uwsgi_log("--reuse-port-shards in cheaper mode supports up to 2000 workers\n");
+		exit(1);
+	}
+
+	struct uwsgi_socket *uwsgi_sock = uwsgi.sockets;
+	// stop at the last configured socket (the clones are appended)
+	struct uwsgi_socket *last = NULL;
+	while (uwsgi_sock) {
+		last = uwsgi_sock;
+		uwsgi_sock = uwsgi_sock->next;
+	}
+
+	uwsgi_sock = uwsgi.sockets;
+	while (uwsgi_sock) {
+		char *tcp_port = uwsgi_sock->name ? strrchr(uwsgi_sock->name, ':') : NULL;
+		// only tcp sockets with a fixed port can be sharded
+		if (!uwsgi_sock->bound && !uwsgi_sock->shared && tcp_port && tcp_port[1] && strcmp(tcp_port + 1, "0")
+			&& uwsgi_startswith(uwsgi_sock->name, "fd://", 5)) {
+			int i;
+			uwsgi_sock->shard = 1;
+			for (i = 2; i <= uwsgi.numproc; i++) {
+				struct uwsgi_socket *shard = uwsgi_new_socket(uwsgi_str(uwsgi_sock->name));
+				shard->name_len = uwsgi_sock->name_len;
+				shard->proto_name = uwsgi_sock->proto_name;
+				shard->no_defer = uwsgi_sock->no_defer;
+				shard->lazy = uwsgi_sock->lazy;
+#ifdef UWSGI_SSL
+				shard->ssl_ctx = uwsgi_sock->ssl_ctx;
+#endif
+				shard->shard = i;
+			}
+		}
+		if (uwsgi_sock == last) break;
+		uwsgi_sock = uwsgi_sock->next;
+	}
+#endif
+}
+
+// the first inherited fd not already used by another shard
+void uwsgi_inherit_shard_socket(struct uwsgi_socket *uwsgi_sock) {
+	int j;
+	for (j = 3; j < (int) uwsgi.max_fd; j++) {
+		struct uwsgi_socket *used = uwsgi.sockets;
+		while (used) {
+			if (used != uwsgi_sock && used->bound && used->fd == j) break;
+			used = used->next;
+		}
+		if (used) continue;
+		uwsgi_add_socket_from_fd(uwsgi_sock, j);
+		if (uwsgi_sock->bound) return;
+	}
+}
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+#include <linux/filter.h>
+
+/*
+	--reuse-port-cbpf
+
+	the master attaches a classic bpf program to the reuseport groups selecting a shard of an accepting worker
+	(by the connection hash), and re-attaches it whenever the set of accepting workers changes.
+	Workers being reloaded, cheaped, paused or still loading the apps are removed from the group steering,
+	the connections already queued to them are accepted by the respawned process.
+*/
+static int shard_sockets_attach(int fd, int *wids, int n) {
+	// rxhash (or the cpu when missing) modulo the number of accepting workers, then a jump table
+	struct sock_filter *code = uwsgi_calloc(sizeof(struct sock_filter) * (5 + (n * 2)));
+	int pc = 0;
+	int i;
+	code[pc++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_RXHASH);
+	code[pc++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1);
+	code[pc++] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_CPU);
+	code[pc++] = (struct sock_filter) BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, n);
+	for (i = 0; i < n; i++) {
+		code[pc++] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, i, 0, 1);
+		code[pc++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, wids[i] - 1);
+	}
+	code[pc++] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, wids[0] - 1);
+
+	struct sock_fprog prog;
+	prog.len = pc;
+	prog.filter = code;
+	int ret = setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog));
+	if (ret) {
+		uwsgi_error("uwsgi_steer_shard_sockets()/setsockopt()");
+	}
+	free(code);
+	return ret;
+}
+
+void uwsgi_steer_shard_sockets() {
+	static uint64_t *accepting = NULL;
+	int i;
+
+	if (!uwsgi.reuse_port_cbpf || !uwsgi.reuse_port_shards || uwsgi.numproc < 2) return;
+
+	// BPF_MAXINSNS
+	if (uwsgi.numproc > 2000) {
+		uwsgi_log("--reuse-port-cbpf supports up to 2000 workers\n");
+		uwsgi.reuse_port_cbpf = 0;
+		return;
+	}
+
+	size_t words = (uwsgi.numproc / 64) + 1;
+	if (!accepting) {
+		accepting = uwsgi_calloc(sizeof(uint64_t) * words);
+	}
+
+	uint64_t current[words];
+	memset(current, 0, sizeof(uint64_t) * words);
+	int wids[uwsgi.numproc];
+	int n = 0;
+	for (i = 1; i <= uwsgi.numproc; i++) {
+		struct uwsgi_worker *uw = &uwsgi.workers[i];
+		if (uw->pid > 0 && uw->accepting && !uw->cheaped && !uw->cursed_at && !uw->suspended) {
+			current[i / 64] |= 1ULL << (i % 64);
+			wids[n++] = i;
+		}
+	}
+
+	// nobody is accepting, leave the queues as they are
+	if (!n) return;
+	if (!memcmp(current, accepting, sizeof(uint64_t) * words)) return;
+
+	struct uwsgi_socket *uwsgi_sock = uwsgi.sockets;
+	while (uwsgi_sock) {
+		// a single socket of the group is enough
+		if (uwsgi_sock->shard == 1 && uwsgi_sock->fd > -1) {
+			if (shard_sockets_attach(uwsgi_sock->fd, wids, n)) {
+				// without steering the cheaped workers would get their share of the connections
+				if (uwsgi.cheaper && !uwsgi_instance_is_dying) {
+					uwsgi_log_verbose("unable to steer the reuseport shards in cheaper mode, destroying the instance...\n");
+					kill_them_all(0);
+				}
+				return;
+			}
+		}
+		uwsgi_sock = uwsgi_sock->next;
+	}
+	memcpy(accepting, current, sizeof(uint64_t) * words);
+	uwsgi_log_verbose("reuseport shards steered to %d/%d workers\n", n, uwsgi.numproc);
+}
+#else
+void uwsgi_steer_shard_sockets() {
+	if (uwsgi.reuse_port_cbpf) {
+		uwsgi_log("!!! your system does not support SO_ATTACH_REUSEPORT_CBPF, --reuse-port-cbpf will be ignored !!!\n");
+		uwsgi.reuse_port_cbpf = 0;
+	}
+}
+#endif
+
 void uwsgi_bind_sockets() {
 	socklen_t socket_type_len;
 	union uwsgi_sockaddr usa;
@@ -1730,7 +1925,7 @@ void uwsgi_bind_sockets() {
 
 	struct uwsgi_socket *uwsgi_sock = uwsgi.sockets;
 	while (uwsgi_sock) {
-		if (!uwsgi_sock->bound && !uwsgi_socket_is_already_bound(uwsgi_sock->name)) {
+		if (!uwsgi_sock->bound && (uwsgi_sock->shard > 1 || !uwsgi_socket_is_already_bound(uwsgi_sock->name))) {
 			char *tcp_port = strrchr(uwsgi_sock->name, ':');
 			int current_defer_accept = uwsgi.no_defer_accept;
                         if (uwsgi_sock->no_defer) {
@@ -2,6 +2,9 @@
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 #include <openssl/md5.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
 
 extern struct uwsgi_server uwsgi;
 /*
@@ -48,7 +51,15 @@ int uwsgi_ssl_verify_callback(int ok, X509_STORE_CTX * x509_store) {
         return ok;
 }
 
-#ifdef UWSGI_SSL_SESSION_CACHE
+static const unsigned char *uwsgi_ssl_session_id(SSL_SESSION *sess, unsigned int *len) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+        *len = sess->session_id_length;
+        return sess->session_id;
+#else
+        return SSL_SESSION_get_id(sess, len);
+#endif
+}
+
 int uwsgi_ssl_session_new_cb(SSL *ssl, SSL_SESSION *sess) {
         char session_blob[4096];
         int len = i2d_SSL_SESSION(sess, NULL);
@@ -62,50 +73,212 @@ int uwsgi_ssl_session_new_cb(SSL *ssl, SSL_SESSION *sess) {
         unsigned char *p = (unsigned char *) session_blob;
         i2d_SSL_SESSION(sess, &p);
 
-        // ok let's write the value to the cache
-        uwsgi_wlock(uwsgi.ssl_sessions_cache->lock);
-        if (uwsgi_cache_set2(uwsgi.ssl_sessions_cache, (char *) sess->session_id, sess->session_id_length, session_blob, len, uwsgi.ssl_sessions_timeout, 0)) {
+        unsigned int id_len = 0;
+        const unsigned char *id = uwsgi_ssl_session_id(sess, &id_len);
+
+        // ok let's write the value to the cache (only the shard of the session is locked)
+        struct uwsgi_cache *uc = uwsgi_cache_shard(uwsgi.ssl_sessions_cache, (char *) id, id_len);
+        uwsgi_wlock(uc->lock);
+        if (uwsgi_cache_set2(uc, (char *) id, id_len, session_blob, len, uwsgi.ssl_sessions_timeout, 0)) {
                 if (uwsgi.ssl_verbose) {
                         uwsgi_log("[uwsgi-ssl] unable to store session of size %d in the cache\n", len);
                 }
         }
-        uwsgi_rwunlock(uwsgi.ssl_sessions_cache->lock);
+        uwsgi_rwunlock(uc->lock);
         return 0;
 }
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
 SSL_SESSION *uwsgi_ssl_session_get_cb(SSL *ssl, unsigned char *key, int keylen, int *copy) {
+#else
+SSL_SESSION *uwsgi_ssl_session_get_cb(SSL *ssl, const unsigned char *key, int keylen, int *copy) {
+#endif
 
         uint64_t valsize = 0;
 
         *copy = 0;
-        uwsgi_rlock(uwsgi.ssl_sessions_cache->lock);
-        char *value = uwsgi_cache_get2(uwsgi.ssl_sessions_cache, (char *)key, keylen, &valsize);
-        if (!value) {
-                uwsgi_rwunlock(uwsgi.ssl_sessions_cache->lock);
+        // lookups are optimistic (no lock is taken unless a writer is racing with us)
+        char *buf = uwsgi_cache_get_copy(uwsgi.ssl_sessions_cache, (char *) key, keylen, &valsize, NULL, NULL);
+        if (!buf) {
                 if (uwsgi.ssl_verbose) {
                         uwsgi_log("[uwsgi-ssl] cache miss\n");
                 }
                 return NULL;
         }
+        char *p = buf;
 #if (OPENSSL_VERSION_NUMBER >= 0x0090800fL)
-        SSL_SESSION *sess = d2i_SSL_SESSION(NULL, (const unsigned char **)&value, valsize);
+        SSL_SESSION *sess = d2i_SSL_SESSION(NULL, (const unsigned char **)&p, valsize);
 #else
-        SSL_SESSION *sess = d2i_SSL_SESSION(NULL, (unsigned char **)&value, valsize);
+        SSL_SESSION *sess = d2i_SSL_SESSION(NULL, (unsigned char **)&p, valsize);
 #endif
-        uwsgi_rwunlock(uwsgi.ssl_sessions_cache->lock);
+        free(buf);
         return sess;
 }
 
 void uwsgi_ssl_session_remove_cb(SSL_CTX *ctx, SSL_SESSION *sess) {
-        uwsgi_wlock(uwsgi.ssl_sessions_cache->lock);
-        if (uwsgi_cache_del2(uwsgi.ssl_sessions_cache, (char *) sess->session_id, sess->session_id_length, 0, 0)) {
+        unsigned int id_len = 0;
+        const unsigned char *id = uwsgi_ssl_session_id(sess, &id_len);
+        struct uwsgi_cache *uc = uwsgi_cache_shard(uwsgi.ssl_sessions_cache, (char *) id, id_len);
+        uwsgi_wlock(uc->lock);
+        if (uwsgi_cache_del2(uc, (char *) id, id_len, 0, 0)) {
                 if (uwsgi.ssl_verbose) {
                         uwsgi_log("[uwsgi-ssl] error removing cache item\n");
                 }
         }
-        uwsgi_rwunlock(uwsgi.ssl_sessions_cache->lock);
+        uwsgi_rwunlock(uc->lock);
+}
+
+/*
+
+	shared session ticket keys
+
+	the keys live in shared memory (allocated before forking) so the tickets issued by a process
+	are accepted by all of its siblings. Time is split in epochs of ssl-ticket-keys-rotation seconds,
+	every epoch has its own key (stored in the ring slot epoch % UWSGI_SSL_TICKET_KEYS, and whose name
+	starts with the epoch) generated by the first process needing it. Keys of the previous epochs are
+	still accepted for decryption during the grace window (and the tickets are renewed).
+
+	The ring is protected by a seqlock: readers never block, the (rare) writer takes it with a CAS.
+	When a secret is configured the keys are derived from it, so they survive reloads and can be
+	shared by multiple instances.
+
+*/
+
+static int uwsgi_ssl_ticket_key_read(uint64_t epoch, struct uwsgi_ssl_ticket_key *key) {
+	struct uwsgi_ssl_ticket_keys *tk = uwsgi.ssl_ticket_keys;
+	struct uwsgi_ssl_ticket_key *slot = &tk->keys[epoch % UWSGI_SSL_TICKET_KEYS];
+	// do not spin forever if a writer died in the middle of a rotation
+	int retries = 1000;
+	while (retries--) {
+		uint64_t seq = __atomic_load_n(&tk->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1) {
+			sched_yield();
+			continue;
+		}
+		memcpy(key, slot, sizeof(struct uwsgi_ssl_ticket_key));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&tk->seq, __ATOMIC_RELAXED) == seq) {
+			return key->epoch == epoch ? 0 : -1;
+		}
+	}
+	return -1;
 }
+
+static int uwsgi_ssl_ticket_key_generate(uint64_t epoch, struct uwsgi_ssl_ticket_key *key) {
+	memset(key, 0, sizeof(struct uwsgi_ssl_ticket_key));
+	key->epoch = epoch;
+	uint64_t be_epoch = uwsgi_be64((char *) &epoch);
+	memcpy(key->name, &be_epoch, 8);
+	if (uwsgi.ssl_ticket_keys_secret) {
+		// SHA256(secret + label + epoch) for every part of the key
+		const char *labels[] = { "name", "aes", "hmac" };
+		unsigned char *parts[] = { key->name + 8, key->aes_key, key->hmac_key };
+		size_t parts_len[] = { 8, 32, 32 };
+		int i;
+		for (i = 0; i < 3; i++) {
+			unsigned char digest[SHA256_DIGEST_LENGTH];
+			char *material = uwsgi_concat3n(uwsgi.ssl_ticket_keys_secret, strlen(uwsgi.ssl_ticket_keys_secret), (char *) labels[i], strlen(labels[i]), (char *) &be_epoch, 8);
+			SHA256((unsigned char *) material, strlen(uwsgi.ssl_ticket_keys_secret) + strlen(labels[i]) + 8, digest);
+			free(material);
+			memcpy(parts[i], digest, parts_len[i]);
+		}
+		return 0;
+	}
+	if (RAND_bytes(key->name + 8, 8) <= 0) return -1;
+	if (RAND_bytes(key->aes_key, 32) <= 0) return -1;
+	if (RAND_bytes(key->hmac_key, 32) <= 0) return -1;
+	return 0;
+}
+
+// get the key of the current epoch, generating it if needed
+static int uwsgi_ssl_ticket_key_current(struct uwsgi_ssl_ticket_key *key) {
+	struct uwsgi_ssl_ticket_keys *tk = uwsgi.ssl_ticket_keys;
+	uint64_t epoch = uwsgi_now() / uwsgi.ssl_ticket_keys_rotation;
+	if (!uwsgi_ssl_ticket_key_read(epoch, key)) return 0;
+
+	if (uwsgi_ssl_ticket_key_generate(epoch, key)) return -1;
+
+	uint64_t seq = __atomic_load_n(&tk->seq, __ATOMIC_ACQUIRE);
+	// another process is rotating, this ticket will be issued with our copy of the key (identical
+	// if derived from the secret, otherwise simply not resumable by the others)
+	if (seq & 1) return 0;
+	if (!__atomic_compare_exchange_n(&tk->seq, &seq, seq + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) return 0;
+	struct uwsgi_ssl_ticket_key *slot = &tk->keys[epoch % UWSGI_SSL_TICKET_KEYS];
+	// someone else could have completed the rotation between our read and the CAS
+	if (slot->epoch != epoch) {
+		memcpy(slot, key, sizeof(struct uwsgi_ssl_ticket_key));
+		tk->rotations++;
+	}
+	else {
+		memcpy(key, slot, sizeof(struct uwsgi_ssl_ticket_key));
+	}
+	__atomic_store_n(&tk->seq, seq + 2, __ATOMIC_RELEASE);
+	return 0;
+}
+
+// find the key used for a ticket, returns 1 if it is the current one, 2 if it is in the grace window
+static int uwsgi_ssl_ticket_key_find(unsigned char *name, struct uwsgi_ssl_ticket_key *key) {
+	uint64_t epoch = uwsgi_be64((char *) name);
+	uint64_t current = uwsgi_now() / uwsgi.ssl_ticket_keys_rotation;
+	if (epoch > current) return 0;
+	uint64_t grace_epochs = (uwsgi.ssl_ticket_keys_grace + uwsgi.ssl_ticket_keys_rotation - 1) / uwsgi.ssl_ticket_keys_rotation;
+	if (current - epoch > grace_epochs) return 0;
+	if (uwsgi_ssl_ticket_key_read(epoch, key)) {
+		// keys derived from a secret can be rebuilt (e.g. after a reload)
+		if (!uwsgi.ssl_ticket_keys_secret || uwsgi_ssl_ticket_key_generate(epoch, key)) return 0;
+	}
+	if (memcmp(key->name, name, 16)) return 0;
+	return epoch == current ? 1 : 2;
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static int uwsgi_ssl_ticket_key_cb(SSL *ssl, unsigned char *name, unsigned char *iv, EVP_CIPHER_CTX *ectx, EVP_MAC_CTX *hctx, int enc) {
+	OSSL_PARAM params[2];
+	params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *) "SHA256", 0);
+	params[1] = OSSL_PARAM_construct_end();
+#else
+static int uwsgi_ssl_ticket_key_cb(SSL *ssl, unsigned char *name, unsigned char *iv, EVP_CIPHER_CTX *ectx, HMAC_CTX *hctx, int enc) {
 #endif
+	struct uwsgi_ssl_ticket_key key;
+	int ret = 1;
+	if (enc) {
+		if (uwsgi_ssl_ticket_key_current(&key)) return -1;
+		if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) <= 0) return -1;
+		memcpy(name, key.name, 16);
+		if (!EVP_EncryptInit_ex(ectx, EVP_aes_256_cbc(), NULL, key.aes_key, iv)) return -1;
+	}
+	else {
+		ret = uwsgi_ssl_ticket_key_find(name, &key);
+		// unknown or expired key, fallback to a full handshake
+		if (!ret) return 0;
+		if (!EVP_DecryptInit_ex(ectx, EVP_aes_256_cbc(), NULL, key.aes_key, iv)) return -1;
+	}
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+	if (!EVP_MAC_init(hctx, key.hmac_key, 32, params)) return -1;
+#else
+	if (!HMAC_Init_ex(hctx, key.hmac_key, 32, EVP_sha256(), NULL)) return -1;
+#endif
+	return ret;
+}
+
+static void uwsgi_ssl_ticket_keys_init(void) {
+	if (uwsgi.ssl_ticket_keys) return;
+	if (uwsgi.ssl_ticket_keys_grace <= 0) {
+		uwsgi.ssl_ticket_keys_grace = uwsgi.ssl_ticket_keys_rotation;
+	}
+	// the ring must be able to hold the keys of the grace window
+	int max_grace = uwsgi.ssl_ticket_keys_rotation * (UWSGI_SSL_TICKET_KEYS - 1);
+	if (uwsgi.ssl_ticket_keys_grace > max_grace) {
+		uwsgi_log("[uwsgi-ssl] ticket keys grace window reduced to %d seconds\n", max_grace);
+		uwsgi.ssl_ticket_keys_grace = max_grace;
+	}
+	uwsgi.ssl_ticket_keys = uwsgi_calloc_shared(sizeof(struct uwsgi_ssl_ticket_keys));
+}
+
+uint64_t uwsgi_ssl_ticket_keys_rotations(void) {
+	if (!uwsgi.ssl_ticket_keys) return 0;
+	return __atomic_load_n(&uwsgi.ssl_ticket_keys->rotations, __ATOMIC_RELAXED);
+}
 
 #ifdef SSL_CTRL_SET_TLSEXT_HOSTNAME
 static int uwsgi_sni_cb(SSL *ssl, int *ad, void *arg) {
@@ -375,7 +548,6 @@ SSL_CTX *uwsgi_ssl_new_server_context(char *name, char *crt, char *key, char *ci
         // disable session caching by default
         SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
 
-#ifdef UWSGI_SSL_SESSION_CACHE
 	if (uwsgi.ssl_sessions_use_cache) {
 
 		// we need to early initialize locking and caching
@@ -409,7 +581,10 @@ SSL_CTX *uwsgi_ssl_new_server_context(char *name, char *crt, char *key, char *ci
                         SSL_SESS_CACHE_NO_AUTO_CLEAR);
 
 #ifdef SSL_OP_NO_TICKET
-                ssloptions |= SSL_OP_NO_TICKET;
+		// stateless tickets would bypass the cache (unless their keys are shared too)
+		if (!uwsgi.ssl_ticket_keys_rotation) {
+                	ssloptions |= SSL_OP_NO_TICKET;
+		}
 #endif
 
                 // just for fun
@@ -420,10 +595,25 @@ SSL_CTX *uwsgi_ssl_new_server_context(char *name, char *crt, char *key, char *ci
                 SSL_CTX_sess_set_get_cb(ctx, uwsgi_ssl_session_get_cb);
                 SSL_CTX_sess_set_remove_cb(ctx, uwsgi_ssl_session_remove_cb);
         }
+
+	if (uwsgi.ssl_ticket_keys_rotation > 0) {
+		uwsgi_ssl_ticket_keys_init();
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+		SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, uwsgi_ssl_ticket_key_cb);
+#else
+		SSL_CTX_set_tlsext_ticket_key_cb(ctx, uwsgi_ssl_ticket_key_cb);
 #endif
+	}
 
         SSL_CTX_set_timeout(ctx, uwsgi.ssl_sessions_timeout);
 
+#ifdef UWSGI_SSL_KTLS
+	// silently falls back to userspace encryption if the kernel or the cipher do not support it
+	if (uwsgi.ssl_ktls) {
+		ssloptions |= SSL_OP_ENABLE_KTLS;
+	}
+#endif
+
 	struct uwsgi_string_list *usl = NULL;
 	uwsgi_foreach(usl, uwsgi.ssl_options) {
 		ssloptions |= atoi(usl->value);
@@ -436,6 +626,16 @@ SSL_CTX *uwsgi_ssl_new_server_context(char *name, char *crt, char *key, char *ci
 }
 
 
+// after the handshake, report which directions of the connection are encrypted by the kernel
+int uwsgi_ssl_ktls(SSL *ssl) {
+	int ret = 0;
+#ifdef UWSGI_SSL_KTLS
+	if (BIO_get_ktls_send(SSL_get_wbio(ssl))) ret |= UWSGI_SSL_KTLS_TX;
+	if (BIO_get_ktls_recv(SSL_get_rbio(ssl))) ret |= UWSGI_SSL_KTLS_RX;
+#endif
+	return ret;
+}
+
 char *uwsgi_rsa_sign(char *algo_key, char *message, size_t message_len, unsigned int *s_len) {
 
         // openssl could not be initialized
@@ -601,17 +601,17 @@ int uwsgi_file_serve(struct wsgi_request *wsgi_req, char *document_root, uint16_
 #endif
 
 	if (uwsgi.static_cache_paths) {
-		uwsgi_rlock(uwsgi.static_cache_paths->lock);
-		uint64_t item_len;
-		char *item = uwsgi_cache_get2(uwsgi.static_cache_paths, filename, filename_len, &item_len);
+		uint64_t item_len = 0;
+		// a (decompressed) copy of the path
+		char *item = uwsgi_cache_get_copy(uwsgi.static_cache_paths, filename, filename_len, &item_len, NULL, NULL);
 		if (item && item_len > 0 && item_len <= PATH_MAX) {
 			memcpy(real_filename, item, item_len);
 			real_filename_len = item_len;
 			real_filename[real_filename_len] = 0;
-			uwsgi_rwunlock(uwsgi.static_cache_paths->lock);
+			free(item);
 			goto found;
 		}
-		uwsgi_rwunlock(uwsgi.static_cache_paths->lock);
+		free(item);
 	}
 
 	if (!realpath(filename, real_filename)) {
@@ -624,9 +624,10 @@ int uwsgi_file_serve(struct wsgi_request *wsgi_req, char *document_root, uint16_
 	real_filename_len = strlen(real_filename);
 
 	if (uwsgi.static_cache_paths) {
-		uwsgi_wlock(uwsgi.static_cache_paths->lock);
-		uwsgi_cache_set2(uwsgi.static_cache_paths, filename, filename_len, real_filename, real_filename_len, uwsgi.use_static_cache_paths, UWSGI_CACHE_FLAG_UPDATE);
-		uwsgi_rwunlock(uwsgi.static_cache_paths->lock);
+		struct uwsgi_cache *uc = uwsgi_cache_shard(uwsgi.static_cache_paths, filename, filename_len);
+		uwsgi_wlock(uc->lock);
+		uwsgi_cache_set2(uc, filename, filename_len, real_filename, real_filename_len, uwsgi.use_static_cache_paths, UWSGI_CACHE_FLAG_UPDATE);
+		uwsgi_rwunlock(uc->lock);
 	}
 
 found:
@@ -402,6 +402,566 @@ end:
 	close(client_fd);
 }
 
+/*
+	workers and cores counters exposed by the prometheus and the binary stats servers
+	(key is used by the binary schema, name/type/help by prometheus)
+*/
+
+struct uwsgi_stats_field {
+	char *key;
+	char *name;
+	char *type;
+	char *help;
+	size_t offset;
+};
+
+static struct uwsgi_stats_field uwsgi_stats_worker_fields[] = {
+	{"requests", "uwsgi_worker_requests_total", "counter", "requests managed by the worker", offsetof(struct uwsgi_worker, requests)},
+	{"failed_requests", "uwsgi_worker_failed_requests_total", "counter", "failed requests of the worker", offsetof(struct uwsgi_worker, failed_requests)},
+	{"respawn_count", "uwsgi_worker_respawns_total", "counter", "worker respawns", offsetof(struct uwsgi_worker, respawn_count)},
+	{"harakiri_count", "uwsgi_worker_harakiri_total", "counter", "worker harakiris", offsetof(struct uwsgi_worker, harakiri_count)},
+	{"signals", "uwsgi_worker_signals_total", "counter", "uwsgi signals managed by the worker", offsetof(struct uwsgi_worker, signals)},
+	{"tx", "uwsgi_worker_tx_bytes_total", "counter", "bytes sent by the worker", offsetof(struct uwsgi_worker, tx)},
+	{"running_time", "uwsgi_worker_running_time_microseconds_total", "counter", "time spent managing requests", offsetof(struct uwsgi_worker, running_time)},
+	{"avg_rt", "uwsgi_worker_avg_response_time_microseconds", "gauge", "average response time of the worker", offsetof(struct uwsgi_worker, avg_response_time)},
+	{"rss", "uwsgi_worker_rss_bytes", "gauge", "worker resident memory", offsetof(struct uwsgi_worker, rss_size)},
+	{"vsz", "uwsgi_worker_vsz_bytes", "gauge", "worker address space size", offsetof(struct uwsgi_worker, vsz_size)},
+	{NULL, NULL, NULL, NULL, 0},
+};
+
+static struct uwsgi_stats_field uwsgi_stats_core_fields[] = {
+	{"requests", "uwsgi_core_requests_total", "counter", "requests managed by the core", offsetof(struct uwsgi_core, requests)},
+	{"failed_requests", "uwsgi_core_failed_requests_total", "counter", "failed requests of the core", offsetof(struct uwsgi_core, failed_requests)},
+	{"static_requests", "uwsgi_core_static_requests_total", "counter", "static files served by the core", offsetof(struct uwsgi_core, static_requests)},
+	{"routed_requests", "uwsgi_core_routed_requests_total", "counter", "requests managed by the internal routing", offsetof(struct uwsgi_core, routed_requests)},
+	{"offloaded_requests", "uwsgi_core_offloaded_requests_total", "counter", "requests offloaded by the core", offsetof(struct uwsgi_core, offloaded_requests)},
+	{"write_errors", "uwsgi_core_write_errors_total", "counter", "write errors of the core", offsetof(struct uwsgi_core, write_errors)},
+	{"read_errors", "uwsgi_core_read_errors_total", "counter", "read errors of the core", offsetof(struct uwsgi_core, read_errors)},
+	{"exceptions", "uwsgi_core_exceptions_total", "counter", "exceptions raised in the core", offsetof(struct uwsgi_core, exceptions)},
+	{NULL, NULL, NULL, NULL, 0},
+};
+
+/*
+	Prometheus text exposition format (--stats-prometheus)
+
+	instead of building the whole json tree, values are read directly from the shared memory
+	areas (workers, cores, metrics and histograms) and streamed to the client in small chunks.
+	Scrapes are served by a dedicated thread, so a slow (or idle) client never stalls the master.
+*/
+
+static int uwsgi_prometheus_printf(struct uwsgi_buffer *ub, char *fmt, ...) {
+	char buf[4096];
+	va_list ap;
+	va_start(ap, fmt);
+	int ret = vsnprintf(buf, 4096, fmt, ap);
+	va_end(ap);
+	if (ret <= 0 || ret >= 4096) return -1;
+	return uwsgi_buffer_append(ub, buf, ret);
+}
+
+// send the buffer when it is big enough (or at the end)
+static int uwsgi_prometheus_flush(struct uwsgi_buffer *ub, int fd, int force) {
+	if (!force && ub->pos < 32768) return 0;
+	if (uwsgi_buffer_send(ub, fd)) return -1;
+	ub->pos = 0;
+	return 0;
+}
+
+static int uwsgi_prometheus_family(struct uwsgi_buffer *ub, char *name, char *type, char *help) {
+	return uwsgi_prometheus_printf(ub, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+// metric names can only contain [a-zA-Z0-9_:]
+static void uwsgi_prometheus_name(char *dst, size_t len, char *name) {
+	size_t i;
+	size_t prefix = strlen("uwsgi_metric_");
+	memcpy(dst, "uwsgi_metric_", prefix);
+	for(i=0;name[i] && prefix + i < len - 1;i++) {
+		char c = name[i];
+		dst[prefix + i] = isalnum((int) c) || c == '_' || c == ':' ? c : '_';
+	}
+	dst[prefix + i] = 0;
+}
+
+// socket names are label values: escape backslashes and double quotes
+static int uwsgi_prometheus_label(struct uwsgi_buffer *ub, char *value) {
+	while(*value) {
+		if (*value == '\\' || *value == '"') {
+			if (uwsgi_buffer_byte(ub, '\\')) return -1;
+		}
+		if (uwsgi_buffer_byte(ub, *value)) return -1;
+		value++;
+	}
+	return 0;
+}
+
+static int uwsgi_prometheus_metrics(struct uwsgi_buffer *ub, int fd) {
+	char name[512];
+	struct uwsgi_histogram *merged = NULL;
+	struct uwsgi_metric *um = uwsgi.metrics;
+	while(um) {
+		// aliases are duplicates, percentiles are computed by the scraper from the histogram buckets
+		if (um->type == UWSGI_METRIC_ALIAS || (um->collector && !strcmp(um->collector->name, "percentile"))) goto next;
+		uwsgi_prometheus_name(name, 512, um->name);
+		if (um->type == UWSGI_METRIC_HISTOGRAM) {
+			if (!um->histogram) goto next;
+			if (!merged) merged = uwsgi_malloc(sizeof(struct uwsgi_histogram));
+			uwsgi_metric_histogram_merge(um, merged);
+			if (uwsgi_prometheus_family(ub, name, "histogram", um->name)) goto error;
+			// a fixed set of bounds (4 per power of two) keeps the series stable between scrapes
+			uint64_t cumulative = 0;
+			int i;
+			for(i=0;i<UWSGI_HISTOGRAM_BUCKETS;i++) {
+				cumulative += merged->buckets[i];
+				if ((i+1) % 8) continue;
+				if (uwsgi_prometheus_printf(ub, "%s_bucket{le=\"%llu\"} %llu\n", name, (unsigned long long) uwsgi_histogram_bucket_max(i), (unsigned long long) cumulative)) goto error;
+				if (uwsgi_prometheus_flush(ub, fd, 0)) goto error;
+			}
+			if (uwsgi_prometheus_printf(ub, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %llu\n%s_count %llu\n", name, (unsigned long long) cumulative,
+				name, (unsigned long long) merged->sum, name, (unsigned long long) cumulative)) goto error;
+		}
+		else {
+			char *type = "gauge";
+			if (um->type == UWSGI_METRIC_COUNTER) type = "counter";
+			if (uwsgi_prometheus_family(ub, name, type, um->name)) goto error;
+			if (uwsgi_prometheus_printf(ub, "%s %lld\n", name, (long long) uwsgi_metric_handle_get(um))) goto error;
+		}
+		if (uwsgi_prometheus_flush(ub, fd, 0)) goto error;
+next:
+		um = um->next;
+	}
+	if (merged) free(merged);
+	return 0;
+error:
+	if (merged) free(merged);
+	return -1;
+}
+
+void uwsgi_send_prometheus(int fd) {
+	struct sockaddr_un client_src;
+	socklen_t client_src_len = 0;
+	char buf[4096];
+
+	int client_fd = accept(fd, (struct sockaddr *) &client_src, &client_src_len);
+	if (client_fd < 0) {
+		uwsgi_error("accept()");
+		return;
+	}
+
+	// the request is not parsed, every path returns the metrics
+	int ret = uwsgi_waitfd(client_fd, uwsgi.socket_timeout);
+	if (ret <= 0 || read(client_fd, buf, 4096) <= 0) {
+		close(client_fd);
+		return;
+	}
+
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(uwsgi.page_size);
+	if (uwsgi_buffer_append(ub, "HTTP/1.0 200 OK\r\nConnection: close\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n\r\n", 94)) goto end;
+
+	int i, j;
+	struct uwsgi_stats_field *upf;
+	for(upf = uwsgi_stats_worker_fields; upf->name; upf++) {
+		if (uwsgi_prometheus_family(ub, upf->name, upf->type, upf->help)) goto end;
+		for(i=1;i<=uwsgi.numproc;i++) {
+			uint64_t *value = (uint64_t *) (((char *) &uwsgi.workers[i]) + upf->offset);
+			if (uwsgi_prometheus_printf(ub, "%s{worker=\"%d\"} %llu\n", upf->name, i, (unsigned long long) *value)) goto end;
+		}
+		if (uwsgi_prometheus_flush(ub, client_fd, 0)) goto end;
+	}
+
+	for(upf = uwsgi_stats_core_fields; upf->name; upf++) {
+		if (uwsgi_prometheus_family(ub, upf->name, upf->type, upf->help)) goto end;
+		for(i=1;i<=uwsgi.numproc;i++) {
+			for(j=0;j<uwsgi.cores;j++) {
+				uint64_t *value = (uint64_t *) (((char *) &uwsgi.workers[i].cores[j]) + upf->offset);
+				if (uwsgi_prometheus_printf(ub, "%s{worker=\"%d\",core=\"%d\"} %llu\n", upf->name, i, j, (unsigned long long) *value)) goto end;
+			}
+			if (uwsgi_prometheus_flush(ub, client_fd, 0)) goto end;
+		}
+	}
+
+	if (uwsgi_prometheus_family(ub, "uwsgi_core_busy", "gauge", "1 if the core is managing a request")) goto end;
+	for(i=1;i<=uwsgi.numproc;i++) {
+		for(j=0;j<uwsgi.cores;j++) {
+			if (uwsgi_prometheus_printf(ub, "uwsgi_core_busy{worker=\"%d\",core=\"%d\"} %d\n", i, j, uwsgi.workers[i].cores[j].in_request ? 1 : 0)) goto end;
+		}
+		if (uwsgi_prometheus_flush(ub, client_fd, 0)) goto end;
+	}
+
+	struct uwsgi_socket *uwsgi_sock;
+	if (uwsgi_prometheus_family(ub, "uwsgi_socket_listen_queue", "gauge", "connections waiting in the listen queue")) goto end;
+	for(uwsgi_sock = uwsgi.sockets; uwsgi_sock; uwsgi_sock = uwsgi_sock->next) {
+		if (uwsgi_buffer_append(ub, "uwsgi_socket_listen_queue{socket=\"", 34)) goto end;
+		if (uwsgi_prometheus_label(ub, uwsgi_sock->name)) goto end;
+		if (uwsgi_prometheus_printf(ub, "\"} %llu\n", (unsigned long long) uwsgi_sock->queue)) goto end;
+	}
+
+	if (uwsgi.has_metrics && !uwsgi.stats_no_metrics) {
+		if (uwsgi_prometheus_metrics(ub, client_fd)) goto end;
+	}
+
+	uwsgi_prometheus_flush(ub, client_fd, 1);
+end:
+	uwsgi_buffer_destroy(ub);
+	close(client_fd);
+}
+
+static void uwsgi_stats_prometheus_loop(struct uwsgi_thread *ut) {
+	void *events = event_queue_alloc(64);
+	char buf[4096];
+
+	event_queue_add_fd_read(ut->queue, uwsgi.stats_prometheus_fd);
+
+	for (;;) {
+		int nevents = event_queue_wait_multi(ut->queue, -1, events, 64);
+		if (nevents < 0) {
+			if (errno == EINTR) continue;
+			uwsgi_log_verbose("ending the prometheus stats server thread...\n");
+			return;
+		}
+		int i;
+		for(i=0;i<nevents;i++) {
+			int interesting_fd = event_queue_interesting_fd(events, i);
+			if (interesting_fd == ut->pipe[1]) {
+				if (read(interesting_fd, buf, 4096) <= 0) {
+					uwsgi_log_verbose("ending the prometheus stats server thread...\n");
+					return;
+				}
+				continue;
+			}
+			if (interesting_fd == uwsgi.stats_prometheus_fd) {
+				uwsgi_send_prometheus(uwsgi.stats_prometheus_fd);
+			}
+		}
+	}
+}
+
+void uwsgi_stats_prometheus_start() {
+	if (!uwsgi_thread_new(uwsgi_stats_prometheus_loop)) {
+		uwsgi_log("!!! unable to spawn the prometheus stats server thread !!!\n");
+		exit(1);
+	}
+}
+
+/*
+	binary incremental stats (--stats-binary)
+
+	a dedicated thread serves the subscribers, so the master never serializes anything.
+	Each value (workers and cores counters, sockets listen queues, metrics) has a stable id.
+	Every packet is: u8 type, u32le payload size, payload (varints are unsigned LEB128)
+
+	'S' schema (sent on connect): varint count, count * (varint name length, name)
+	'F' full snapshot (sent on connect) and
+	'D' delta (every --stats-binary-freq seconds, only the changed values):
+		u64le timestamp (microseconds), u32le count, count * (varint id gap, varint zigzag value delta)
+
+	the id gap is the distance from the previous id + 1 (the first one is the id itself), while
+	the value is the difference from the previous one sent to the same client (0 for full snapshots)
+
+	subscribers are non-blocking: what the kernel does not accept is queued and sent as soon as the
+	socket is writable, a subscriber still lagging behind after UWSGI_STATS_BINARY_MAX_LAG more deltas is dropped.
+*/
+
+#define UWSGI_STATS_BINARY_MAX_LAG 3
+
+struct uwsgi_stats_binary_item {
+	char *name;
+	uint64_t *ptr;
+	struct uwsgi_metric *um;
+};
+
+struct uwsgi_stats_binary_client {
+	int fd;
+	uint64_t *values;
+	// the unsent packets
+	struct uwsgi_buffer *pending;
+	size_t pending_pos;
+	// the number of deltas queued behind them
+	int lag;
+	struct uwsgi_stats_binary_client *prev;
+	struct uwsgi_stats_binary_client *next;
+};
+
+static struct uwsgi_stats_binary_item *uwsgi_stats_binary_items;
+static uint64_t uwsgi_stats_binary_items_cnt;
+static struct uwsgi_stats_binary_client *uwsgi_stats_binary_clients;
+
+static void uwsgi_stats_binary_item(char *name, uint64_t *ptr, struct uwsgi_metric *um) {
+	struct uwsgi_stats_binary_item *item = &uwsgi_stats_binary_items[uwsgi_stats_binary_items_cnt];
+	item->name = uwsgi_str(name);
+	item->ptr = ptr;
+	item->um = um;
+	uwsgi_stats_binary_items_cnt++;
+}
+
+static void uwsgi_stats_binary_schema() {
+	char name[4096];
+	int i, j;
+	struct uwsgi_stats_field *usf;
+	uint64_t worker_fields = 0, core_fields = 0, count = 0;
+	for(usf = uwsgi_stats_worker_fields; usf->key; usf++) worker_fields++;
+	for(usf = uwsgi_stats_core_fields; usf->key; usf++) core_fields++;
+
+	count = (uwsgi.numproc * worker_fields) + (uwsgi.numproc * uwsgi.cores * core_fields);
+	struct uwsgi_socket *uwsgi_sock;
+	for(uwsgi_sock = uwsgi.sockets; uwsgi_sock; uwsgi_sock = uwsgi_sock->next) count++;
+	struct uwsgi_metric *um;
+	if (uwsgi.has_metrics) {
+		for(um = uwsgi.metrics; um; um = um->next) count++;
+	}
+
+	uwsgi_stats_binary_items = uwsgi_calloc(sizeof(struct uwsgi_stats_binary_item) * count);
+
+	for(i=1;i<=uwsgi.numproc;i++) {
+		for(usf = uwsgi_stats_worker_fields; usf->key; usf++) {
+			snprintf(name, 4096, "worker.%d.%s", i, usf->key);
+			uwsgi_stats_binary_item(name, (uint64_t *) (((char *) &uwsgi.workers[i]) + usf->offset), NULL);
+		}
+		for(j=0;j<uwsgi.cores;j++) {
+			for(usf = uwsgi_stats_core_fields; usf->key; usf++) {
+				snprintf(name, 4096, "worker.%d.core.%d.%s", i, j, usf->key);
+				uwsgi_stats_binary_item(name, (uint64_t *) (((char *) &uwsgi.workers[i].cores[j]) + usf->offset), NULL);
+			}
+		}
+	}
+
+	i = 0;
+	for(uwsgi_sock = uwsgi.sockets; uwsgi_sock; uwsgi_sock = uwsgi_sock->next) {
+		snprintf(name, 4096, "socket.%d.listen_queue", i++);
+		uwsgi_stats_binary_item(name, &uwsgi_sock->queue, NULL);
+	}
+
+	if (uwsgi.has_metrics) {
+		for(um = uwsgi.metrics; um; um = um->next) {
+			snprintf(name, 4096, "metric.%s", um->name);
+			uwsgi_stats_binary_item(name, NULL, um);
+		}
+	}
+}
+
+static void uwsgi_stats_binary_collect(uint64_t *values) {
+	uint64_t i;
+	for(i=0;i<uwsgi_stats_binary_items_cnt;i++) {
+		struct uwsgi_stats_binary_item *item = &uwsgi_stats_binary_items[i];
+		values[i] = item->um ? (uint64_t) uwsgi_metric_handle_get(item->um) : *item->ptr;
+	}
+}
+
+// the payload size is set by uwsgi_stats_binary_packet_size() when the packet is complete
+static int uwsgi_stats_binary_packet(struct uwsgi_buffer *ub, char type, size_t *start) {
+	*start = ub->pos;
+	if (uwsgi_buffer_byte(ub, type)) return -1;
+	return uwsgi_buffer_u32le(ub, 0);
+}
+
+static void uwsgi_stats_binary_packet_size(struct uwsgi_buffer *ub, size_t start) {
+	uint32_t size = ub->pos - start - 5;
+	ub->buf[start + 1] = (uint8_t) (size & 0xff);
+	ub->buf[start + 2] = (uint8_t) ((size >> 8) & 0xff);
+	ub->buf[start + 3] = (uint8_t) ((size >> 16) & 0xff);
+	ub->buf[start + 4] = (uint8_t) ((size >> 24) & 0xff);
+}
+
+// encode the values changed since the last packet sent to the client (all of them for full snapshots)
+static int uwsgi_stats_binary_values(struct uwsgi_buffer *ub, char type, struct uwsgi_stats_binary_client *client, uint64_t *values) {
+	size_t start;
+	if (uwsgi_stats_binary_packet(ub, type, &start)) return -1;
+	if (uwsgi_buffer_u64le(ub, uwsgi_micros())) return -1;
+	size_t count_pos = ub->pos;
+	if (uwsgi_buffer_u32le(ub, 0)) return -1;
+	uint32_t count = 0;
+	uint64_t i, next_id = 0;
+	for(i=0;i<uwsgi_stats_binary_items_cnt;i++) {
+		if (type == 'D' && values[i] == client->values[i]) continue;
+		int64_t delta = (int64_t) (values[i] - client->values[i]);
+		if (uwsgi_buffer_varint(ub, i - next_id)) return -1;
+		if (uwsgi_buffer_varint(ub, ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63))) return -1;
+		client->values[i] = values[i];
+		next_id = i + 1;
+		count++;
+	}
+	ub->buf[count_pos] = (uint8_t) (count & 0xff);
+	ub->buf[count_pos + 1] = (uint8_t) ((count >> 8) & 0xff);
+	ub->buf[count_pos + 2] = (uint8_t) ((count >> 16) & 0xff);
+	ub->buf[count_pos + 3] = (uint8_t) ((count >> 24) & 0xff);
+	uwsgi_stats_binary_packet_size(ub, start);
+	return 0;
+}
+
+static void uwsgi_stats_binary_close(struct uwsgi_stats_binary_client *client) {
+	if (client->prev) {
+		client->prev->next = client->next;
+	}
+	else {
+		uwsgi_stats_binary_clients = client->next;
+	}
+	if (client->next) {
+		client->next->prev = client->prev;
+	}
+	// closing the fd removes it from the event queue
+	close(client->fd);
+	if (client->pending) uwsgi_buffer_destroy(client->pending);
+	free(client->values);
+	free(client);
+}
+
+// write the queued bytes, returns -1 if the subscriber must be dropped
+static int uwsgi_stats_binary_flush(struct uwsgi_thread *ut, struct uwsgi_stats_binary_client *client) {
+	struct uwsgi_buffer *ub = client->pending;
+	while(client->pending_pos < ub->pos) {
+		ssize_t len = write(client->fd, ub->buf + client->pending_pos, ub->pos - client->pending_pos);
+		if (len < 0 && uwsgi_is_again()) return 0;
+		if (len <= 0) return -1;
+		client->pending_pos += len;
+	}
+	uwsgi_buffer_destroy(ub);
+	client->pending = NULL;
+	client->lag = 0;
+	return event_queue_fd_readwrite_to_read(ut->queue, client->fd);
+}
+
+// send (or queue) a packet without blocking
+static int uwsgi_stats_binary_send(struct uwsgi_thread *ut, struct uwsgi_stats_binary_client *client, struct uwsgi_buffer *ub) {
+	if (client->pending) {
+		// too slow
+		if (++client->lag > UWSGI_STATS_BINARY_MAX_LAG) return -1;
+		return uwsgi_buffer_append(client->pending, ub->buf, ub->pos);
+	}
+	ssize_t len = write(client->fd, ub->buf, ub->pos);
+	if (len < 0) {
+		if (!uwsgi_is_again()) return -1;
+		len = 0;
+	}
+	if ((size_t) len == ub->pos) return 0;
+	client->pending = uwsgi_buffer_new(ub->pos - len);
+	if (uwsgi_buffer_append(client->pending, ub->buf + len, ub->pos - len)) return -1;
+	client->pending_pos = 0;
+	return event_queue_fd_read_to_readwrite(ut->queue, client->fd);
+}
+
+static void uwsgi_stats_binary_accept(struct uwsgi_thread *ut, struct uwsgi_buffer *ub, uint64_t *values) {
+	struct sockaddr_un client_src;
+	socklen_t client_src_len = sizeof(struct sockaddr_un);
+	int client_fd = accept(uwsgi.stats_binary_fd, (struct sockaddr *) &client_src, &client_src_len);
+	if (client_fd < 0) {
+		uwsgi_error("uwsgi_stats_binary_accept()/accept()");
+		return;
+	}
+
+	uwsgi_socket_nb(client_fd);
+
+	struct uwsgi_stats_binary_client *client = uwsgi_calloc(sizeof(struct uwsgi_stats_binary_client));
+	client->fd = client_fd;
+	client->values = uwsgi_calloc(sizeof(uint64_t) * (uwsgi_stats_binary_items_cnt + 1));
+	client->next = uwsgi_stats_binary_clients;
+	if (uwsgi_stats_binary_clients) {
+		uwsgi_stats_binary_clients->prev = client;
+	}
+	uwsgi_stats_binary_clients = client;
+
+	ub->pos = 0;
+	size_t start;
+	if (uwsgi_stats_binary_packet(ub, 'S', &start)) goto error;
+	if (uwsgi_buffer_varint(ub, uwsgi_stats_binary_items_cnt)) goto error;
+	uint64_t i;
+	for(i=0;i<uwsgi_stats_binary_items_cnt;i++) {
+		size_t len = strlen(uwsgi_stats_binary_items[i].name);
+		if (uwsgi_buffer_varint(ub, len)) goto error;
+		if (uwsgi_buffer_append(ub, uwsgi_stats_binary_items[i].name, len)) goto error;
+	}
+	uwsgi_stats_binary_packet_size(ub, start);
+
+	uwsgi_stats_binary_collect(values);
+	if (uwsgi_stats_binary_values(ub, 'F', client, values)) goto error;
+	if (event_queue_add_fd_read(ut->queue, client_fd) < 0) goto error;
+	if (uwsgi_stats_binary_send(ut, client, ub)) goto error;
+	return;
+error:
+	uwsgi_stats_binary_close(client);
+}
+
+static void uwsgi_stats_binary_loop(struct uwsgi_thread *ut) {
+	uwsgi_stats_binary_schema();
+	uint64_t *values = uwsgi_calloc(sizeof(uint64_t) * (uwsgi_stats_binary_items_cnt + 1));
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(uwsgi.page_size);
+	void *events = event_queue_alloc(64);
+	char buf[4096];
+
+	event_queue_add_fd_read(ut->queue, uwsgi.stats_binary_fd);
+
+	time_t last_run = uwsgi_now();
+	for (;;) {
+		int timeout = uwsgi.stats_binary_freq - (uwsgi_now() - last_run);
+		if (timeout < 0) timeout = 0;
+		int nevents = event_queue_wait_multi(ut->queue, timeout, events, 64);
+		if (nevents < 0) {
+			if (errno == EINTR) continue;
+			uwsgi_log_verbose("ending the binary stats server thread...\n");
+			return;
+		}
+		int i;
+		for(i=0;i<nevents;i++) {
+			int interesting_fd = event_queue_interesting_fd(events, i);
+			if (interesting_fd == ut->pipe[1]) {
+				if (read(interesting_fd, buf, 4096) <= 0) {
+					uwsgi_log_verbose("ending the binary stats server thread...\n");
+					return;
+				}
+				continue;
+			}
+			if (interesting_fd == uwsgi.stats_binary_fd) {
+				uwsgi_stats_binary_accept(ut, ub, values);
+				continue;
+			}
+			// subscribers are not expected to send anything, just detect disconnections
+			struct uwsgi_stats_binary_client *client = uwsgi_stats_binary_clients;
+			while(client) {
+				if (client->fd == interesting_fd) {
+					if (client->pending && event_queue_interesting_fd_is_write(events, i)) {
+						if (uwsgi_stats_binary_flush(ut, client)) {
+							uwsgi_stats_binary_close(client);
+							break;
+						}
+					}
+					// errors and hangups are detected by reading
+					if (event_queue_interesting_fd_is_read(events, i) || !event_queue_interesting_fd_is_write(events, i)) {
+						ssize_t rlen = read(interesting_fd, buf, 4096);
+						if (rlen == 0 || (rlen < 0 && !uwsgi_is_again())) {
+							uwsgi_stats_binary_close(client);
+						}
+					}
+					break;
+				}
+				client = client->next;
+			}
+		}
+
+		time_t now = uwsgi_now();
+		if (now - last_run < uwsgi.stats_binary_freq) continue;
+		last_run = now;
+		if (!uwsgi_stats_binary_clients) continue;
+
+		uwsgi_stats_binary_collect(values);
+		struct uwsgi_stats_binary_client *client = uwsgi_stats_binary_clients;
+		while(client) {
+			struct uwsgi_stats_binary_client *next = client->next;
+			ub->pos = 0;
+			if (uwsgi_stats_binary_values(ub, 'D', client, values) || uwsgi_stats_binary_send(ut, client, ub)) {
+				uwsgi_stats_binary_close(client);
+			}
+			client = next;
+		}
+	}
+}
+
+void uwsgi_stats_binary_start() {
+	if (uwsgi.stats_binary_freq < 1) uwsgi.stats_binary_freq = 1;
+	if (!uwsgi_thread_new(uwsgi_stats_binary_loop)) {
+		uwsgi_log("!!! unable to spawn the binary stats server thread !!!\n");
+		exit(1);
+	}
+}
+
 struct uwsgi_stats_pusher *uwsgi_stats_pusher_get(char *name) {
 	struct uwsgi_stats_pusher *usp = uwsgi.stats_pushers;
 	while (usp) {
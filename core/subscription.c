@@ -403,9 +403,9 @@ struct uwsgi_subscribe_node *uwsgi_add_subscribe_node(struct uwsgi_subscribe_slo
 		node->load = usr->load;
 		node->weight = usr->weight;
 		node->backup_level = usr->backup_level;
-		if (usr->proto_len > 0) {
-			node->proto = usr->proto[0];
-		}
+		node->proto = usr->proto_len > 0 ? usr->proto[0] : 0;
+		node->ewma = 0;
+		node->ewma_updated = 0;
 		node->unix_check = usr->unix_check;
 		if (!node->weight)
 			node->weight = 1;
@@ -484,9 +484,9 @@ struct uwsgi_subscribe_node *uwsgi_add_subscribe_node(struct uwsgi_subscribe_slo
 		current_slot->nodes->load = usr->load;
 		current_slot->nodes->weight = usr->weight;
 		current_slot->nodes->backup_level = usr->backup_level;
-		if (usr->proto_len > 0) {
-			current_slot->nodes->proto = usr->proto[0];
-		}
+		current_slot->nodes->proto = usr->proto_len > 0 ? usr->proto[0] : 0;
+		current_slot->nodes->ewma = 0;
+		current_slot->nodes->ewma_updated = 0;
 		current_slot->nodes->unix_check = usr->unix_check;
 		if (!current_slot->nodes->weight)
 			current_slot->nodes->weight = 1;
@@ -1335,6 +1335,84 @@ retry:
         return chosen_node;
 }
 
+// the response time estimation decays (towards 0) with time, so idle nodes are tried again
+static double uwsgi_subscription_node_ewma(struct uwsgi_subscribe_node *node, uint64_t now) {
+	if (now <= node->ewma_updated) return node->ewma;
+	return node->ewma * exp(-((double) (now - node->ewma_updated)) / (uwsgi.subscription_ewma_decay * 1000.0));
+}
+
+// feed the response time of a node: slower responses are taken immediately (peak), faster ones are averaged
+void uwsgi_subscription_node_latency(struct uwsgi_subscribe_node *node, uint64_t rtt) {
+	uint64_t now = uwsgi_micros();
+	if (!node->ewma_updated || (double) rtt > node->ewma) {
+		node->ewma = rtt;
+	}
+	else {
+		double decay = exp(-((double) (now - node->ewma_updated)) / (uwsgi.subscription_ewma_decay * 1000.0));
+		node->ewma = (node->ewma * decay) + (rtt * (1.0 - decay));
+	}
+	node->ewma_updated = now;
+}
+
+// peak EWMA: least (response time * (in-flight requests + 1) / weight), with backup support
+static struct uwsgi_subscribe_node *uwsgi_subscription_algo_peakewma(struct uwsgi_subscribe_slot *current_slot, struct uwsgi_subscribe_node *node, struct uwsgi_subscription_client *client) {
+	uint64_t backup_level = 0;
+	uint64_t has_backup = 0;
+
+	// if node is NULL we are in the second step (in peakewma mode we do not use the first step)
+	if (node)
+		return NULL;
+
+	uint64_t now = uwsgi_micros();
+	struct uwsgi_subscribe_node *chosen_node = NULL;
+retry:
+	has_backup = 0;
+	// nodes without measurements are considered as fast as the fastest one (or as loaded as in lrc mode)
+	double unmeasured = 0;
+	node = current_slot->nodes;
+	while (node) {
+		if (!node->death_mark && node->backup_level == backup_level && node->ewma_updated) {
+			double latency = uwsgi_subscription_node_ewma(node, now);
+			if (!unmeasured || latency < unmeasured)
+				unmeasured = latency;
+		}
+		node = node->next;
+	}
+
+	double min_cost = 0;
+	node = current_slot->nodes;
+	while (node) {
+		if (!node->death_mark) {
+			if (node->backup_level == backup_level) {
+				double latency = node->ewma_updated ? uwsgi_subscription_node_ewma(node, now) : unmeasured;
+				if (latency < 1)
+					latency = 1;
+				// node->weight is always >= 1, we can safely use it as divider
+				double cost = (latency * (node->reference + 1)) / (double) node->weight;
+				// on equal cost prefer the less used node (so new nodes are measured)
+				if (!chosen_node || cost < min_cost || (cost == min_cost && node->requests < chosen_node->requests)) {
+					min_cost = cost;
+					chosen_node = node;
+				}
+			}
+			else if (node->backup_level > backup_level && (!has_backup || has_backup > node->backup_level)) {
+				has_backup = node->backup_level;
+			}
+		}
+		node = node->next;
+	}
+
+	if (chosen_node) {
+		chosen_node->reference++;
+	}
+	else if (has_backup) {
+		backup_level = has_backup;
+		goto retry;
+	}
+
+	return chosen_node;
+}
+
 // weighted round robin algo (with backup support)
 static struct uwsgi_subscribe_node *uwsgi_subscription_algo_wrr(struct uwsgi_subscribe_slot *current_slot, struct uwsgi_subscribe_node *node, struct uwsgi_subscription_client *client) {
 	uint64_t backup_level = 0;
@@ -1394,6 +1472,7 @@ void uwsgi_subscription_init_algos() {
 	uwsgi_register_subscription_algo("lrc", uwsgi_subscription_algo_lrc);
 	uwsgi_register_subscription_algo("wlrc", uwsgi_subscription_algo_wlrc);
 	uwsgi_register_subscription_algo("iphash", uwsgi_subscription_algo_iphash);
+	uwsgi_register_subscription_algo("peakewma", uwsgi_subscription_algo_peakewma);
 }
 
 void uwsgi_subscription_set_algo(char *algo) {
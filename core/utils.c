@@ -1079,6 +1079,9 @@ void uwsgi_close_request(struct wsgi_request *wsgi_req) {
 		tmp_rt = wsgi_req->end_of_request - wsgi_req->start_of_request;
 		uwsgi.workers[uwsgi.mywid].running_time += tmp_rt;
 		uwsgi.workers[uwsgi.mywid].avg_response_time = (uwsgi.workers[uwsgi.mywid].avg_response_time + tmp_rt) / 2;
+		if (uwsgi.metrics_response_time) {
+			uwsgi_histogram_add(&uwsgi.metrics_response_time->histogram[uwsgi.mywid], tmp_rt);
+		}
 	}
 
 	// get memory usage
@@ -1374,6 +1377,7 @@ void wsgi_req_setup(struct wsgi_request *wsgi_req, int async_id, struct uwsgi_so
 	wsgi_req->sendfile_fd = -1;
 
 	wsgi_req->hvec = uwsgi.workers[uwsgi.mywid].cores[wsgi_req->async_id].hvec;
+	wsgi_req->var_index = uwsgi.workers[uwsgi.mywid].cores[wsgi_req->async_id].var_index;
 	// skip the first 4 bytes;
 	wsgi_req->uh = (struct uwsgi_header *) uwsgi.workers[uwsgi.mywid].cores[wsgi_req->async_id].buffer;
 	wsgi_req->buffer = uwsgi.workers[uwsgi.mywid].cores[wsgi_req->async_id].buffer + 4;
@@ -3445,12 +3449,94 @@ void http_url_decode4(char *buf, uint16_t * len, char *dst, int no_slash_decode)
 
 
 /*
-	we scan the table in reverse, as updated values are at the end
+	request vars index
+
+	the keys in hvec are hashed into a per-core open addressing table (linear probing) storing
+	their hvec position + 1. It is built by uwsgi_parse_vars() and vars appended later (routing,
+	manage-script-name, path info rewrites...) are indexed on the next lookup. A duplicated key
+	takes the slot of the previous one, so like the reverse scan the last value wins.
+
+	The hash only looks at the length and at the first and last 8 bytes of the key, collisions
+	(like HTTP_X_FORWARDED_* keys with the same length) are resolved by comparing the keys.
+*/
+static inline uint32_t uwsgi_var_hash(char *key, uint16_t keylen) {
+	uint64_t a, b;
+	if (keylen >= 8) {
+		memcpy(&a, key, 8);
+		memcpy(&b, key + keylen - 8, 8);
+	}
+	else if (keylen >= 4) {
+		uint32_t a32, b32;
+		memcpy(&a32, key, 4);
+		memcpy(&b32, key + keylen - 4, 4);
+		a = a32;
+		b = b32;
+	}
+	else {
+		a = keylen ? (((uint8_t) key[0] << 16) | ((uint8_t) key[keylen >> 1] << 8) | (uint8_t) key[keylen - 1]) : 0;
+		b = 0;
+	}
+	// murmur3 fmix64, the slot is taken from the low bits so they need the full avalanche
+	uint64_t h = (a * 0x9e3779b97f4a7c15ULL) ^ (b * 0xc2b2ae3d27d4eb4fULL) ^ keylen;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return (uint32_t) h;
+}
+
+void uwsgi_vars_index(struct wsgi_request *wsgi_req) {
+	if (!wsgi_req->var_index) return;
+	// only complete key/value pairs
+	uint16_t var_cnt = wsgi_req->var_cnt & ~1;
+	uint16_t i = wsgi_req->var_indexed;
+	// the vars have been rebuilt (or never indexed), start from scratch
+	if (i == 0 || i > var_cnt) {
+		memset(wsgi_req->var_index, 0, sizeof(uint16_t) * (uwsgi.var_index_mask + 1));
+		i = 0;
+	}
+	for (; i < var_cnt; i += 2) {
+		char *key = wsgi_req->hvec[i].iov_base;
+		uint16_t keylen = wsgi_req->hvec[i].iov_len;
+		uint32_t slot = uwsgi_var_hash(key, keylen) & uwsgi.var_index_mask;
+		for (;;) {
+			uint16_t pos = wsgi_req->var_index[slot];
+			if (!pos || !uwsgi_strncmp(key, keylen, wsgi_req->hvec[pos - 1].iov_base, wsgi_req->hvec[pos - 1].iov_len)) {
+				wsgi_req->var_index[slot] = i + 1;
+				break;
+			}
+			slot = (slot + 1) & uwsgi.var_index_mask;
+		}
+	}
+	wsgi_req->var_indexed = var_cnt;
+}
+
+/*
+	without an index we scan the table in reverse, as updated values are at the end
 */
 char *uwsgi_get_var(struct wsgi_request *wsgi_req, char *key, uint16_t keylen, uint16_t * len) {
 
 	int i;
 
+	if (wsgi_req->var_index) {
+		// the index could still reference the previous request
+		if (wsgi_req->var_cnt < 2) return NULL;
+		if (wsgi_req->var_indexed != (wsgi_req->var_cnt & ~1)) {
+			uwsgi_vars_index(wsgi_req);
+		}
+		uint32_t slot = uwsgi_var_hash(key, keylen) & uwsgi.var_index_mask;
+		uint16_t pos;
+		while ((pos = wsgi_req->var_index[slot])) {
+			if (!uwsgi_strncmp(key, keylen, wsgi_req->hvec[pos - 1].iov_base, wsgi_req->hvec[pos - 1].iov_len)) {
+				*len = wsgi_req->hvec[pos].iov_len;
+				return wsgi_req->hvec[pos].iov_base;
+			}
+			slot = (slot + 1) & uwsgi.var_index_mask;
+		}
+		return NULL;
+	}
+
 	for (i = wsgi_req->var_cnt - 1; i > 0; i -= 2) {
 		if (!uwsgi_strncmp(key, keylen, wsgi_req->hvec[i - 1].iov_base, wsgi_req->hvec[i - 1].iov_len)) {
 			*len = wsgi_req->hvec[i].iov_len;
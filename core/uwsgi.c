@@ -164,6 +164,7 @@ static struct uwsgi_option uwsgi_base_options[] = {
 
 	{"listen", required_argument, 'l', "set the socket listen queue size", uwsgi_opt_set_int, &uwsgi.listen_queue, UWSGI_OPT_IMMEDIATE},
 	{"max-vars", required_argument, 'v', "set the amount of internal iovec/vars structures", uwsgi_opt_max_vars, NULL, 0},
+	{"disable-vars-index", no_argument, 0, "scan the request vars linearly instead of indexing them", uwsgi_opt_true, &uwsgi.vars_index_disable, 0},
 	{"max-apps", required_argument, 0, "set the maximum number of per-worker applications", uwsgi_opt_set_int, &uwsgi.max_apps, 0},
 	{"buffer-size", required_argument, 'b', "set internal buffer size", uwsgi_opt_set_64bit, &uwsgi.buffer_size, 0},
 	{"memory-report", optional_argument, 'm', "enable memory report. 1 for basic (default), 2 for uss/pss (Linux only)", uwsgi_opt_set_int, &uwsgi.logging_options.memory_report, 0},
@@ -623,6 +624,9 @@ static struct uwsgi_option uwsgi_base_options[] = {
 	{"stats", required_argument, 0, "enable the stats server on the specified address", uwsgi_opt_set_str, &uwsgi.stats, UWSGI_OPT_MASTER},
 	{"stats-server", required_argument, 0, "enable the stats server on the specified address", uwsgi_opt_set_str, &uwsgi.stats, UWSGI_OPT_MASTER},
 	{"stats-http", no_argument, 0, "prefix stats server json output with http headers", uwsgi_opt_true, &uwsgi.stats_http, UWSGI_OPT_MASTER},
+	{"stats-prometheus", required_argument, 0, "expose workers, cores and metrics in the prometheus text format (via http) on the specified address", uwsgi_opt_set_str, &uwsgi.stats_prometheus, UWSGI_OPT_MASTER},
+	{"stats-binary", required_argument, 0, "enable the binary incremental stats server (subscribers get only the changed values) on the specified address", uwsgi_opt_set_str, &uwsgi.stats_binary, UWSGI_OPT_MASTER},
+	{"stats-binary-freq", required_argument, 0, "set the frequency (in seconds) of the binary stats server updates (default 1)", uwsgi_opt_set_int, &uwsgi.stats_binary_freq, UWSGI_OPT_MASTER},
 	{"stats-minified", no_argument, 0, "minify statistics json output", uwsgi_opt_true, &uwsgi.stats_minified, UWSGI_OPT_MASTER},
 	{"stats-min", no_argument, 0, "minify statistics json output", uwsgi_opt_true, &uwsgi.stats_minified, UWSGI_OPT_MASTER},
 	{"stats-push", required_argument, 0, "push the stats json to the specified destination", uwsgi_opt_add_string_list, &uwsgi.requested_stats_pushers, UWSGI_OPT_MASTER|UWSGI_OPT_METRICS},
@@ -676,6 +680,7 @@ static struct uwsgi_option uwsgi_base_options[] = {
 	{"subscribe-freq", required_argument, 0, "send subscription announce at the specified interval", uwsgi_opt_set_int, &uwsgi.subscribe_freq, 0},
 	{"subscription-tolerance", required_argument, 0, "set tolerance for subscription servers", uwsgi_opt_set_int, &uwsgi.subscription_tolerance, 0},
 	{"subscription-tolerance-inactive", required_argument, 0, "set tolerance for subscription servers for inactive vassals", uwsgi_opt_set_int, &uwsgi.subscription_tolerance_inactive, 0},
+	{"subscription-ewma-decay", required_argument, 0, "set the decay time (in milliseconds) of the nodes response time used by the peakewma subscription algorithm (default 10000)", uwsgi_opt_set_int, &uwsgi.subscription_ewma_decay, 0},
 	{"unsubscribe-on-graceful-reload", no_argument, 0, "force unsubscribe request even during graceful reload", uwsgi_opt_true, &uwsgi.unsubscribe_on_graceful_reload, 0},
 	{"start-unsubscribed", no_argument, 0, "configure subscriptions but do not send them (useful with master fifo)", uwsgi_opt_true, &uwsgi.subscriptions_blocked, 0},
 	{"subscription-clear-on-shutdown", no_argument, 0, "force clear instead of unsubscribe during shutdown", uwsgi_opt_true, &uwsgi.subscription_clear_on_shutdown, 0},
@@ -687,13 +692,14 @@ static struct uwsgi_option uwsgi_base_options[] = {
 #ifdef UWSGI_SSL
 	{"ssl-verbose", no_argument, 0, "be verbose about SSL errors", uwsgi_opt_true, &uwsgi.ssl_verbose, 0},
 	{"ssl-verify-depth", optional_argument, 0, "set maximum certificate verification depth", uwsgi_opt_set_int, &uwsgi.ssl_verify_depth, 0},
-#ifdef UWSGI_SSL_SESSION_CACHE
 	// force master, as ssl sessions caching initialize locking early
 	{"ssl-sessions-use-cache", optional_argument, 0, "use uWSGI cache for ssl sessions storage", uwsgi_opt_set_str, &uwsgi.ssl_sessions_use_cache, UWSGI_OPT_MASTER},
 	{"ssl-session-use-cache", optional_argument, 0, "use uWSGI cache for ssl sessions storage", uwsgi_opt_set_str, &uwsgi.ssl_sessions_use_cache, UWSGI_OPT_MASTER},
 	{"ssl-sessions-timeout", required_argument, 0, "set SSL sessions timeout (default: 300 seconds)", uwsgi_opt_set_int, &uwsgi.ssl_sessions_timeout, 0},
 	{"ssl-session-timeout", required_argument, 0, "set SSL sessions timeout (default: 300 seconds)", uwsgi_opt_set_int, &uwsgi.ssl_sessions_timeout, 0},
-#endif
+	{"ssl-ticket-keys-rotation", required_argument, 0, "share the TLS session ticket keys between processes, rotating them every specified number of seconds", uwsgi_opt_set_int, &uwsgi.ssl_ticket_keys_rotation, 0},
+	{"ssl-ticket-keys-grace", required_argument, 0, "keep accepting tickets encrypted with rotated keys for the specified number of seconds (default: the rotation interval)", uwsgi_opt_set_int, &uwsgi.ssl_ticket_keys_grace, 0},
+	{"ssl-ticket-keys-secret", required_argument, 0, "derive the shared TLS session ticket keys from the specified secret (they survive reloads and can be shared between instances)", uwsgi_opt_set_str, &uwsgi.ssl_ticket_keys_secret, 0},
 	{"sni", required_argument, 0, "add an SNI-governed SSL context", uwsgi_opt_sni, NULL, 0},
 	{"sni-dir", required_argument, 0, "check for cert/key/client_ca file in the specified directory and create a sni/ssl context on demand", uwsgi_opt_set_str, &uwsgi.sni_dir, 0},
 	{"sni-dir-ciphers", required_argument, 0, "set ssl ciphers for sni-dir option", uwsgi_opt_set_str, &uwsgi.sni_dir_ciphers, 0},
@@ -701,6 +707,9 @@ static struct uwsgi_option uwsgi_base_options[] = {
 	{"ssl-enable-sslv3", no_argument, 0, "enable SSLv3 (insecure)", uwsgi_opt_true, &uwsgi.sslv3, 0},
 	{"ssl-enable-tlsv1", no_argument, 0, "enable TLSv1 (insecure)", uwsgi_opt_true, &uwsgi.tlsv1, 0},
 	{"ssl-option", required_argument, 0, "set a raw ssl option (numeric value)", uwsgi_opt_add_string_list, &uwsgi.ssl_options, 0},
+#ifdef UWSGI_SSL_KTLS
+	{"ssl-enable-ktls", no_argument, 0, "offload TLS records encryption to the kernel (kTLS) after the handshake, when supported by the kernel and the cipher", uwsgi_opt_true, &uwsgi.ssl_ktls, 0},
+#endif
 #if defined(UWSGI_PCRE) || defined(UWSGI_PCRE2)
 	{"sni-regexp", required_argument, 0, "add an SNI-governed SSL context (the key is a regexp)", uwsgi_opt_sni, NULL, 0},
 #endif
@@ -995,6 +1004,8 @@ static struct uwsgi_option uwsgi_base_options[] = {
 #endif
 	{"enable-proxy-protocol", no_argument, 0, "enable PROXY1 protocol support (only for http parsers)", uwsgi_opt_true, &uwsgi.enable_proxy_protocol, 0},
 	{"reuse-port", no_argument, 0, "enable REUSE_PORT flag on socket (BSD and Linux >3.9 only)", uwsgi_opt_true, &uwsgi.reuse_port, 0},
+	{"reuse-port-shards", no_argument, 0, "bind a REUSE_PORT socket for each worker (Linux >3.9 only)", uwsgi_opt_true, &uwsgi.reuse_port_shards, 0},
+	{"reuse-port-cbpf", no_argument, 0, "steer the REUSE_PORT shards only to the accepting workers with a bpf program (Linux >4.5 only)", uwsgi_opt_true, &uwsgi.reuse_port_cbpf, 0},
 	{"tcp-fast-open", required_argument, 0, "enable TCP_FASTOPEN flag on TCP sockets with the specified qlen value", uwsgi_opt_set_int, &uwsgi.tcp_fast_open, 0},
 	{"tcp-fastopen", required_argument, 0, "enable TCP_FASTOPEN flag on TCP sockets with the specified qlen value", uwsgi_opt_set_int, &uwsgi.tcp_fast_open, 0},
 	{"tcp-fast-open-client", no_argument, 0, "use sendto(..., MSG_FASTOPEN, ...) instead of connect() if supported", uwsgi_opt_true, &uwsgi.tcp_fast_open_client, 0},
@@ -2910,6 +2921,9 @@ int uwsgi_start(void *v_argv) {
 		}
 
 
+		// clone the sockets for each worker
+		uwsgi_setup_shard_sockets();
+
 		//check for inherited sockets
 		if (uwsgi.is_a_reload) {
 			uwsgi_setup_inherited_sockets();
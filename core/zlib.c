@@ -40,13 +40,13 @@ end:
 	return ub;
 }
 
-struct uwsgi_buffer *uwsgi_zlib_decompress(char *buf, size_t len) {
+static struct uwsgi_buffer *zlib_inflate(char *buf, size_t len, int window_bits) {
         z_stream z;
 
 	z.zalloc = Z_NULL;
         z.zfree = Z_NULL;
         z.opaque = Z_NULL;
-        if (inflateInit(&z) != Z_OK) {
+        if (inflateInit2(&z, window_bits) != Z_OK) {
 		return NULL;
         }
 
@@ -78,6 +78,15 @@ end:
         return ub;
 }
 
+struct uwsgi_buffer *uwsgi_zlib_decompress(char *buf, size_t len) {
+	return zlib_inflate(buf, len, MAX_WBITS);
+}
+
+// decompress a whole gzip member (like the ones generated by uwsgi_gzip())
+struct uwsgi_buffer *uwsgi_gunzip(char *buf, size_t len) {
+	return zlib_inflate(buf, len, 16 + MAX_WBITS);
+}
+
 
 int uwsgi_deflate_init(z_stream *z, char *dict, size_t dict_len) {
         z->zalloc = Z_NULL;
@@ -26,9 +26,17 @@
 
 		6 -> dump the whole cache
 
+		8 -> replication catch-up { "cache": "the cache name", "since": "epoch:sequence" (can be repeated) }
+			returns: {"status":"delta|full", "epoch": "epoch of the log", "seq": "current sequence", "items": "number of items", "size": "size of the following body"} + items
+			(a full dump is required when the replication log does not cover the requested sequence)
+
 		17 -> magic interface for plugins remote access { "cmd": "get|set|update|del|exists", "key": "cache key", "expires": "seconds", "cache": "the cache name"}
 			returns: {"status":"ok|notfound|error", "size": "size of the following body, if present"} + stream
 
+			batched commands { "cmd": "mget|mset|mupdate|mdel", "items": "number of items", "size": "size of the following body", "cache": "the cache name"} + items
+			returns: {"status":"ok", "items": "number of items", "size": "size of the following body"} + results
+			(check uwsgi_cache_mitems_pack() in core/cache.c for the encoding of the items)
+
 */
 
 extern struct uwsgi_server uwsgi;
@@ -61,6 +69,132 @@ static void cache_simple_command(char *key, uint16_t keylen, char *val, uint16_t
         }
 }
 
+static void manage_magic_batch(struct wsgi_request *wsgi_req, struct uwsgi_cache *uc, struct uwsgi_cache_magic_context *ucmc) {
+	int is_get = !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mget", 4);
+	int is_del = !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mdel", 4);
+	int is_update = !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mupdate", 7);
+	int with_values = !is_get && !is_del;
+	uint64_t i;
+
+	// every item needs at least 2 bytes
+	if (ucmc->items == 0 || ucmc->items > ucmc->size / 2) return;
+	if (ucmc->size > ucmc->items * (2 + uc->keysize + (with_values ? 16 + uc->max_item_size : 0))) return;
+	wsgi_req->post_cl = ucmc->size;
+	ssize_t rlen = 0;
+	char *body = uwsgi_request_body_read(wsgi_req, ucmc->size, &rlen);
+	if (rlen != (ssize_t) ucmc->size) return;
+
+	struct uwsgi_buffer *ub = NULL;
+	struct uwsgi_buffer *results = NULL;
+	struct uwsgi_cache_mitem *items = uwsgi_calloc(sizeof(struct uwsgi_cache_mitem) * ucmc->items);
+	if (uwsgi_cache_mitems_unpack(body, ucmc->size, items, ucmc->items, with_values)) {
+		free(items);
+		return;
+	}
+
+	if (is_get) {
+		uwsgi_cache_mget(uc, items, ucmc->items);
+	}
+	else if (is_del) {
+		uwsgi_cache_mdel(uc, items, ucmc->items);
+	}
+	else {
+		uwsgi_cache_mset(uc, items, ucmc->items, is_update ? UWSGI_CACHE_FLAG_UPDATE : 0);
+	}
+
+	// no lock is held here, mget returns copies of the values
+	results = uwsgi_buffer_new(uwsgi.page_size);
+	for (i = 0; i < ucmc->items; i++) {
+		if (uwsgi_buffer_u8(results, items[i].status ? 0 : 1)) goto end;
+		if (!is_get) continue;
+		if (uwsgi_buffer_u64be(results, items[i].vallen)) goto end;
+		if (uwsgi_buffer_u64be(results, items[i].expires)) goto end;
+		if (items[i].value && uwsgi_buffer_append(results, items[i].value, items[i].vallen)) goto end;
+	}
+
+	ub = uwsgi_buffer_new(uwsgi.page_size);
+	ub->pos = 4;
+	if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "items", 5, ucmc->items)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "size", 4, results->pos)) goto end;
+	if (uwsgi_buffer_set_uh(ub, 111, 17)) goto end;
+	if (uwsgi_buffer_append(ub, results->buf, results->pos)) goto end;
+	uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
+
+end:
+	if (is_get) {
+		for (i = 0; i < ucmc->items; i++) {
+			free(items[i].value);
+		}
+	}
+	free(items);
+	if (results) uwsgi_buffer_destroy(results);
+	if (ub) uwsgi_buffer_destroy(ub);
+}
+
+struct cache_catchup_request {
+	char *cache;
+	uint16_t cache_len;
+	uint64_t since[UWSGI_CACHE_REPLOG_ORIGINS][2];
+	int nsince;
+};
+
+static void cache_catchup_request_hook(char *key, uint16_t keylen, char *val, uint16_t vallen, void *data) {
+	struct cache_catchup_request *ccr = (struct cache_catchup_request *) data;
+	if (!uwsgi_strncmp(key, keylen, "cache", 5)) {
+		ccr->cache = val;
+		ccr->cache_len = vallen;
+	}
+	else if (!uwsgi_strncmp(key, keylen, "since", 5)) {
+		if (ccr->nsince >= UWSGI_CACHE_REPLOG_ORIGINS) return;
+		char *colon = memchr(val, ':', vallen);
+		if (!colon) return;
+		ccr->since[ccr->nsince][0] = uwsgi_str_num(val, colon - val);
+		ccr->since[ccr->nsince][1] = uwsgi_str_num(colon + 1, vallen - ((colon + 1) - val));
+		ccr->nsince++;
+	}
+}
+
+static void manage_catchup(struct wsgi_request *wsgi_req) {
+	struct cache_catchup_request ccr;
+	struct uwsgi_cache *uc = uwsgi.caches;
+	struct uwsgi_buffer *delta = NULL;
+	uint64_t seq = 0, items = 0;
+	int i;
+
+	memset(&ccr, 0, sizeof(struct cache_catchup_request));
+	if (wsgi_req->uh->_pktsize > 0 && uwsgi_hooked_parse(wsgi_req->buffer, wsgi_req->uh->_pktsize, cache_catchup_request_hook, &ccr)) return;
+	if (ccr.cache_len > 0) {
+		uc = uwsgi_cache_by_namelen(ccr.cache, ccr.cache_len);
+	}
+	if (!uc || !uc->replog) return;
+
+	uint64_t epoch = uc->replog->epoch;
+	seq = uc->replog->seq;
+	// only the positions in our epoch are meaningful
+	for (i = 0; i < ccr.nsince; i++) {
+		if (ccr.since[i][0] != epoch) continue;
+		delta = uwsgi_cache_replog_delta(uc, epoch, ccr.since[i][1], &seq, &items);
+		break;
+	}
+
+	struct uwsgi_buffer *ub = uwsgi_buffer_new(uwsgi.page_size);
+	ub->pos = 4;
+	if (uwsgi_buffer_append_keyval(ub, "status", 6, delta ? "delta" : "full", delta ? 5 : 4)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "epoch", 5, epoch)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "seq", 3, seq)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "items", 5, items)) goto end;
+	if (uwsgi_buffer_append_keynum(ub, "size", 4, delta ? delta->pos : 0)) goto end;
+	if (uwsgi_buffer_set_uh(ub, 111, 8)) goto end;
+	if (uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos)) goto end;
+	if (delta && delta->pos > 0) {
+		uwsgi_response_write_body_do(wsgi_req, delta->buf, delta->pos);
+	}
+end:
+	uwsgi_buffer_destroy(ub);
+	if (delta) uwsgi_buffer_destroy(delta);
+}
+
 // this function does not use the magic api internally to avoid too much copy
 static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cache_magic_context *ucmc) {
 
@@ -74,38 +208,50 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
 
 	if (!uc) return;
 
+	// batched commands lock every partition by themselves
+	if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mget", 4) || !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mset", 4) ||
+		!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mupdate", 7) || !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "mdel", 4)) {
+		manage_magic_batch(wsgi_req, uc, ucmc);
+		return;
+	}
+
+	// all of the commands (except clear) work on the partition holding the key
+	struct uwsgi_cache *ucs = uc;
+	if (ucmc->key_len > 0) {
+		ucs = uwsgi_cache_shard(uc, ucmc->key, ucmc->key_len);
+	}
+
 	// cache get
 	if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "get", 3)) {
 		uint64_t vallen = 0;
 		uint64_t expires = 0;
-		uwsgi_rlock(uc->lock);
-		char *value = uwsgi_cache_get3(uc, ucmc->key, ucmc->key_len, &vallen, &expires);
-		if (!value) {
-			uwsgi_rwunlock(uc->lock);
-			return;
-		}
-		// we are still locked !!!
+		// a (decompressed) copy, the lock is not held while sending it
+		char *value = uwsgi_cache_get_copy(ucs, ucmc->key, ucmc->key_len, &vallen, &expires, NULL);
+		if (!value) return;
 		ub = uwsgi_buffer_new(uwsgi.page_size);
 		ub->pos = 4;
-		if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto error;
-		if (uwsgi_buffer_append_keynum(ub, "size", 4, vallen)) goto error;
+		if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto value_error;
+		if (uwsgi_buffer_append_keynum(ub, "size", 4, vallen)) goto value_error;
 		if (expires) {
-			if (uwsgi_buffer_append_keynum(ub, "expires", 7, expires)) goto error;
+			if (uwsgi_buffer_append_keynum(ub, "expires", 7, expires)) goto value_error;
 		}
-		if (uwsgi_buffer_set_uh(ub, 111, 17)) goto error;
-		if (uwsgi_buffer_append(ub, value, vallen)) goto error;
-		// unlock !!!
-		uwsgi_rwunlock(uc->lock);
+		if (uwsgi_buffer_set_uh(ub, 111, 17)) goto value_error;
+		if (uwsgi_buffer_append(ub, value, vallen)) goto value_error;
+		free(value);
 		uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
 		uwsgi_buffer_destroy(ub);
 		return;	
+value_error:
+		free(value);
+		uwsgi_buffer_destroy(ub);
+		return;
 	}
 
 	// cache exists
 	if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "exists", 6)) {
-                uwsgi_rlock(uc->lock);
-                if (!uwsgi_cache_exists2(uc, ucmc->key, ucmc->key_len)) {
-                        uwsgi_rwunlock(uc->lock);
+                uwsgi_rlock(ucs->lock);
+                if (!uwsgi_cache_exists2(ucs, ucmc->key, ucmc->key_len)) {
+                        uwsgi_rwunlock(ucs->lock);
                         return;
                 }
                 // we are still locked !!!
@@ -114,7 +260,7 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
                 if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto error;
                 if (uwsgi_buffer_set_uh(ub, 111, 17)) goto error;
                 // unlock !!!
-                uwsgi_rwunlock(uc->lock);
+                uwsgi_rwunlock(ucs->lock);
                 uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
                 uwsgi_buffer_destroy(ub);
                 return;
@@ -122,9 +268,9 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
 
 	// cache del
         if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "del", 3)) {
-                uwsgi_wlock(uc->lock);
-                if (uwsgi_cache_del2(uc, ucmc->key, ucmc->key_len, 0, 0)) {
-                        uwsgi_rwunlock(uc->lock);
+                uwsgi_wlock(ucs->lock);
+                if (uwsgi_cache_del2(ucs, ucmc->key, ucmc->key_len, 0, 0)) {
+                        uwsgi_rwunlock(ucs->lock);
                         return;
                 }
                 // we are still locked !!!
@@ -133,7 +279,7 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
                 if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto error;
                 if (uwsgi_buffer_set_uh(ub, 111, 17)) goto error;
                 // unlock !!!
-                uwsgi_rwunlock(uc->lock);
+                uwsgi_rwunlock(ucs->lock);
                 uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
                 uwsgi_buffer_destroy(ub);
                 return;
@@ -141,13 +287,20 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
 
 	// cache clear
         if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "clear", 5)) {
-		uint64_t i;
-		uwsgi_wlock(uc->lock);
-		for (i = 1; i < uwsgi.caches->max_items; i++) {
-			if (uwsgi_cache_del2(uc, NULL, 0, i, 0)) {
-                                uwsgi_rwunlock(uc->lock);
-                                return;
-                        }	
+		uint64_t i, j;
+		for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+			ucs = uwsgi_cache_shard_n(uc, j);
+			uwsgi_wlock(ucs->lock);
+			for (i = 1; i < ucs->max_items; i++) {
+				if (uwsgi_cache_del2(ucs, NULL, 0, i, 0)) {
+                                	uwsgi_rwunlock(ucs->lock);
+                                	return;
+                        	}	
+			}
+			// the last partition is unlocked after the response has been built
+			if (j + 1 < uwsgi_cache_nshards(uc)) {
+				uwsgi_rwunlock(ucs->lock);
+			}
 		}
                 // we are still locked !!!
                 ub = uwsgi_buffer_new(uwsgi.page_size);
@@ -155,7 +308,7 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
                 if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto error;
                 if (uwsgi_buffer_set_uh(ub, 111, 17)) goto error;
                 // unlock !!!
-                uwsgi_rwunlock(uc->lock);
+                uwsgi_rwunlock(ucs->lock);
                 uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
                 uwsgi_buffer_destroy(ub);
                 return;
@@ -163,16 +316,27 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
 
 	// cache set
 	if (!uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "set", 3) || !uwsgi_strncmp(ucmc->cmd, ucmc->cmd_len, "update", 6)) {
-		if (ucmc->size == 0 || ucmc->size > uc->max_item_size) return;
+		if (ucmc->size == 0 || ucmc->size > ucs->max_item_size) return;
 		wsgi_req->post_cl = ucmc->size;
 		// read the value
 		ssize_t rlen = 0;
 		char *value = uwsgi_request_body_read(wsgi_req, ucmc->size, &rlen);
 		if (rlen != (ssize_t) ucmc->size) return;
+		uint64_t vallen = ucmc->size;
+		uint64_t flags = ucmc->cmd_len > 3 ? UWSGI_CACHE_FLAG_UPDATE : 0;
+		// compress before locking
+		struct uwsgi_buffer *gzipped = uwsgi_cache_precompress(ucs, value, vallen, flags);
+		if (gzipped) {
+			value = gzipped->buf;
+			vallen = gzipped->pos;
+			flags |= UWSGI_CACHE_FLAG_COMPRESSED;
+		}
 		// ok let's lock
-		uwsgi_wlock(uc->lock);
-		if (uwsgi_cache_set2(uc, ucmc->key, ucmc->key_len, value, ucmc->size, ucmc->expires, ucmc->cmd_len > 3 ? UWSGI_CACHE_FLAG_UPDATE : 0)) {
-			uwsgi_rwunlock(uc->lock);
+		uwsgi_wlock(ucs->lock);
+		int ret = uwsgi_cache_set2(ucs, ucmc->key, ucmc->key_len, value, vallen, ucmc->expires, flags);
+		if (gzipped) uwsgi_buffer_destroy(gzipped);
+		if (ret) {
+			uwsgi_rwunlock(ucs->lock);
 			return;
 		}
 		// we are still locked !!!
@@ -181,7 +345,7 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
                 if (uwsgi_buffer_append_keyval(ub, "status", 6, "ok", 2)) goto error;
 		if (uwsgi_buffer_set_uh(ub, 111, 17)) goto error;
 		// unlock !!!
-		uwsgi_rwunlock(uc->lock);
+		uwsgi_rwunlock(ucs->lock);
 		uwsgi_response_write_body_do(wsgi_req, ub->buf, ub->pos);
                 uwsgi_buffer_destroy(ub);
                 return;
@@ -189,7 +353,7 @@ static void manage_magic_context(struct wsgi_request *wsgi_req, struct uwsgi_cac
 
 	return;
 error:
-	uwsgi_rwunlock(uc->lock);
+	uwsgi_rwunlock(ucs->lock);
 	uwsgi_buffer_destroy(ub);
 }
 
@@ -271,6 +435,9 @@ static int uwsgi_cache_request(struct wsgi_request *wsgi_req) {
 
 			if (!uc) break;
 
+			// a sharded cache has no single memory area to dump
+			if (uc->shards) break;
+
 			uwsgi_wlock(uc->lock);
 			struct uwsgi_buffer *cache_dump = uwsgi_buffer_new(uwsgi.page_size + uc->filesize);
 			cache_dump->pos = 4;
@@ -298,6 +465,9 @@ static int uwsgi_cache_request(struct wsgi_request *wsgi_req) {
 			uwsgi_response_write_body_do(wsgi_req, cache_dump->buf, cache_dump->pos);
 			uwsgi_buffer_destroy(cache_dump);
 			break;
+		case 8:
+			manage_catchup(wsgi_req);
+			break;
 		case 17:
 			if (wsgi_req->uh->_pktsize == 0) break;
 			memset(&ucmc, 0, sizeof(struct uwsgi_cache_magic_context));
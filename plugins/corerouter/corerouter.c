@@ -61,21 +61,25 @@ struct corerouter_peer *uwsgi_cr_peer_add(struct corerouter_session *cs) {
 
 // reset a peer (allows it to connect to another backend)
 void uwsgi_cr_peer_reset(struct corerouter_peer *peer) {
-	if (peer->tmp_socket_name) {
-		free(peer->tmp_socket_name);
-		peer->tmp_socket_name = NULL;
-	}
-
 	cr_del_timeout(peer->session->corerouter, peer);
 	
 	if (peer->fd != -1) {
-		close(peer->fd);
+		// give back the connection to the pool (if the response has been fully received)
+		if (!peer->reusable || peer->failed || peer->timed_out || corerouter_pool_put(peer->session->corerouter, peer)) {
+			close(peer->fd);
+		}
 		peer->session->corerouter->cr_table[peer->fd] = NULL;
 		peer->fd = -1;
 		peer->hook_read = NULL;
 		peer->hook_write = NULL;
 	}
 
+	// the instance address could point to it, so free it after the pool lookup
+	if (peer->tmp_socket_name) {
+		free(peer->tmp_socket_name);
+		peer->tmp_socket_name = NULL;
+	}
+
 	if (peer->is_buffering) {
 		if (peer->buffering_fd != -1) {
 			close(peer->buffering_fd);
@@ -85,8 +89,11 @@ void uwsgi_cr_peer_reset(struct corerouter_peer *peer) {
 	peer->failed = 0;
 	peer->soopt = 0;
 	peer->timed_out = 0;
+	peer->reusable = 0;
+	peer->pooled = 0;
 
 	peer->un = NULL;
+	peer->un_started = 0;
 	peer->static_node = NULL;
 }
 
@@ -337,23 +344,20 @@ void corerouter_manage_subscription(char *key, uint16_t keylen, char *val, uint1
 	}
 }
 
+// forget the subscription node after dropping its reference (the shared lock must be held):
+// another thread could free it from now on, so the peer keeps its own copy of the node address
+static void corerouter_peer_detach_node(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
+	if (ucr->shared_lock && peer->instance_address == peer->un->name) {
+		if (peer->tmp_socket_name) free(peer->tmp_socket_name);
+		peer->tmp_socket_name = uwsgi_concat2n(peer->un->name, peer->un->len, "", 0);
+		peer->instance_address = peer->tmp_socket_name;
+	}
+	peer->un = NULL;
+}
+
 void corerouter_close_peer(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
 	struct corerouter_session *cs = peer->session;
 
-	// manage subscription reference count
-	if (ucr->subscriptions && peer->un && peer->un->len > 0) {
-
-                // decrease reference count
-#ifdef UWSGI_DEBUG
-		uwsgi_log("[1] node %.*s refcnt: %llu\n", peer->un->len, peer->un->name, peer->un->reference);
-#endif
-		peer->un->reference--;
-#ifdef UWSGI_DEBUG
-		uwsgi_log("[2] node %.*s refcnt: %llu\n", peer->un->len, peer->un->name, peer->un->reference);
-#endif
-		
-        }
-
 	if (peer->failed) {
 		if (peer->soopt) {
                         if (!ucr->quiet)
@@ -367,26 +371,53 @@ void corerouter_close_peer(struct uwsgi_corerouter *ucr, struct corerouter_peer
                                 }
                         }
                 }
+	}
 
-                // now check for dead nodes
-                if (ucr->subscriptions && peer->un && peer->un->len > 0) {
+	// the reference count, the death mark and the removal of the node happen in a single critical section,
+	// otherwise another thread could free the node as soon as its reference count drops
+	int subscribed = 0;
+	cr_shared_lock(ucr);
+	// manage subscription reference count
+	if (ucr->subscriptions && peer->un && peer->un->len > 0) {
+		struct uwsgi_subscribe_node *node = peer->un;
+		subscribed = 1;
+                // decrease reference count
+#ifdef UWSGI_DEBUG
+		uwsgi_log("[1] node %.*s refcnt: %llu\n", node->len, node->name, node->reference);
+#endif
+		// a request timed out before any response, account its time to the node
+		if (peer->un_started && peer->timed_out) {
+			uwsgi_subscription_node_latency(node, uwsgi_micros() - peer->un_started);
+		}
+		node->reference--;
+#ifdef UWSGI_DEBUG
+		uwsgi_log("[2] node %.*s refcnt: %llu\n", node->len, node->name, node->reference);
+#endif
+		corerouter_peer_detach_node(ucr, peer);
 
-                        if (peer->un->death_mark == 0)
+                // now check for dead nodes
+		if (peer->failed) {
+                        if (node->death_mark == 0)
                                 uwsgi_log("[uwsgi-%s] %.*s => marking %.*s as failed\n", ucr->short_name, (int) peer->key_len, peer->key, (int) peer->instance_address_len, peer->instance_address);
 
-                        peer->un->failcnt++;
-                        peer->un->death_mark = 1;
+                        node->failcnt++;
+                        node->death_mark = 1;
+			corerouter_pool_invalidate(ucr, peer->instance_address, peer->instance_address_len);
                         // check if i can remove the node
-                        if (peer->un->reference == 0) {
-                                uwsgi_remove_subscribe_node(ucr->subscriptions, peer->un);
+                        if (node->reference == 0) {
+                                uwsgi_remove_subscribe_node(ucr->subscriptions, node);
                         }
                         if (ucr->cheap && !ucr->i_am_cheap && !ucr->fallback && uwsgi_no_subscriptions(ucr->subscriptions)) {
                                 uwsgi_gateway_go_cheap(ucr->name, ucr->queue, &ucr->i_am_cheap);
                         }
+		}
+        }
+	cr_shared_unlock(ucr);
 
-                }
-		else if (peer->static_node) {
+	if (peer->failed) {
+		if (!subscribed && peer->static_node) {
 			peer->static_node->custom = uwsgi_now();
+			corerouter_pool_invalidate(ucr, peer->instance_address, peer->instance_address_len);
 			uwsgi_log("[uwsgi-%s] %.*s => marking %.*s as failed\n", ucr->short_name, (int) peer->key_len, peer->key, (int) peer->instance_address_len, peer->instance_address);
 		}
 
@@ -428,6 +459,10 @@ void corerouter_close_peer(struct uwsgi_corerouter *ucr, struct corerouter_peer
 	}
 
 end:
+	if (peer != cs->main_peer && cs->peer_closed) {
+		cs->peer_closed(peer);
+	}
+
 	if (uwsgi_cr_peer_del(peer) < 0) return;
 
 	if (peer == cs->main_peer) {
@@ -455,9 +490,12 @@ void corerouter_close_session(struct uwsgi_corerouter *ucr, struct corerouter_se
 		struct corerouter_peer *tmp_peer = peers;
 		peers = peers->next;
 		// special case here for subscription system
+		cr_shared_lock(ucr);
 		if (ucr->subscriptions && tmp_peer->un && tmp_peer->un->len) {
 			tmp_peer->un->reference--;
+			corerouter_peer_detach_node(ucr, tmp_peer);
 		}
+		cr_shared_unlock(ucr);
 		if (uwsgi_cr_peer_del(tmp_peer) < 0) return; 
 	}
 
@@ -465,6 +503,8 @@ void corerouter_close_session(struct uwsgi_corerouter *ucr, struct corerouter_se
 	if (cr_session->close)
 		cr_session->close(cr_session);
 
+	corerouter_splice_close(cr_session);
+
 	free(cr_session);
 
 	if (ucr->active_sessions == 0) {
@@ -504,12 +544,15 @@ static void corerouter_expire_timeouts(struct uwsgi_corerouter *ucr, time_t now)
 				peer->retries++;
 				// ignore return value
 				if (peer->un) {
+					cr_shared_lock(ucr);
 					if (peer->un->reference == 0) {
+						cr_shared_unlock(ucr);
 						uwsgi_log("[BUG] subscription reference counting is 0 !!!\n");
 						corerouter_close_peer(ucr, peer);
 						continue;
 					}
 					peer->un->reference--;
+					cr_shared_unlock(ucr);
 				}
 				peer->session->retry(peer);
 				// increase timeout;
@@ -646,6 +689,10 @@ struct corerouter_session *corerouter_alloc_session(struct uwsgi_corerouter *ucr
 	cs->corerouter = ucr;
 	cs->ugs = ugs;
 
+	// the splice pipe is created on first use
+	cs->splice_pipe[0] = -1;
+	cs->splice_pipe[1] = -1;
+
 	// set initial timeout (could be overridden)
 	peer->current_timeout = ucr->socket_timeout;
 
@@ -694,150 +741,30 @@ struct corerouter_session *corerouter_alloc_session(struct uwsgi_corerouter *ucr
 	return cs;
 }
 
-void uwsgi_corerouter_loop(int id, void *data) {
+// wait for events and run the hooks of the peers (harakiri is managed only by the main thread)
+static void corerouter_event_loop(struct uwsgi_corerouter *ucr, int id, void *events, int main_thread) {
 
 	int i;
-
-	struct uwsgi_corerouter *ucr = (struct uwsgi_corerouter *) data;
-
-	ucr->cr_stats_server = -1;
-
-	ucr->cr_table = uwsgi_malloc(sizeof(struct corerouter_session *) * uwsgi.max_fd);
-
-	for (i = 0; i < (int) uwsgi.max_fd; i++) {
-		ucr->cr_table[i] = NULL;
-	}
-
-	ucr->i_am_cheap = ucr->cheap;
-
-	void *events = uwsgi_corerouter_setup_event_queue(ucr, id);
-
-	if (ucr->has_subscription_sockets)
-		event_queue_add_fd_read(ucr->queue, ushared->gateways[id].internal_subscription_pipe[1]);
-
-
-	if (!ucr->socket_timeout)
-		ucr->socket_timeout = 60;
-
-	if (!ucr->defer_connect_timeout)
-		ucr->defer_connect_timeout = 5;
-
-	if (!ucr->static_node_gracetime)
-		ucr->static_node_gracetime = 30;
-
-	int i_am_the_first = 1;
-	for(i=0;i<id;i++) {
-		if (!strcmp(ushared->gateways[i].name, ucr->name)) {
-			i_am_the_first = 0;
-			break;
-		}
-	}
-
-	if (ucr->stats_server && i_am_the_first) {
-		char *tcp_port = strchr(ucr->stats_server, ':');
-		if (tcp_port) {
-			// disable deferred accept for this socket
-			int current_defer_accept = uwsgi.no_defer_accept;
-			uwsgi.no_defer_accept = 1;
-			ucr->cr_stats_server = bind_to_tcp(ucr->stats_server, uwsgi.listen_queue, tcp_port);
-			uwsgi.no_defer_accept = current_defer_accept;
-		}
-		else {
-			ucr->cr_stats_server = bind_to_unix(ucr->stats_server, uwsgi.listen_queue, uwsgi.chmod_socket, uwsgi.abstract_socket);
-		}
-
-		event_queue_add_fd_read(ucr->queue, ucr->cr_stats_server);
-		uwsgi_log("*** %s stats server enabled on %s fd: %d ***\n", ucr->short_name, ucr->stats_server, ucr->cr_stats_server);
-	}
-
-	if (ucr->emperor_socket) {
-		char *colon = strchr(ucr->emperor_socket, ':');
-		if (colon) {
-			ucr->emperor_socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
-                        ucr->emperor_socket_addr_len = socket_to_in_addr(ucr->emperor_socket, colon, 0, &ucr->emperor_socket_addr.sa_in);
-		}
-		else {
-			ucr->emperor_socket_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
-	  		ucr->emperor_socket_addr_len = socket_to_un_addr(ucr->emperor_socket, &ucr->emperor_socket_addr.sa_un);
-		}
-		if (ucr->emperor_socket_fd < 0) {
-			uwsgi_error("error creating emperor socket client: socket()");
-			exit(1);
-		}
-		uwsgi_log("emperor socket mapped to: %s\n", ucr->emperor_socket);	
-	}
-
-
-	if (ucr->use_socket) {
-		ucr->to_socket = uwsgi_get_socket_by_num(ucr->socket_num);
-		if (ucr->to_socket) {
-			// fix socket name_len
-			if (ucr->to_socket->name_len == 0 && ucr->to_socket->name) {
-				ucr->to_socket->name_len = strlen(ucr->to_socket->name);
-			}
-		}
-	}
-
-	if (!ucr->pb_base_dir) {
-		ucr->pb_base_dir = getenv("TMPDIR");
-		if (!ucr->pb_base_dir)
-			ucr->pb_base_dir = "/tmp";
-	}
-
 	int nevents;
-
 	time_t delta;
-
 	struct uwsgi_rb_timer *min_timeout;
-
 	int new_connection;
 
-
-	if (ucr->pattern) {
-		init_magic_table(ucr->magic_table);
-	}
-
 	union uwsgi_sockaddr cr_addr;
 	socklen_t cr_addr_len = sizeof(struct sockaddr_un);
 
-	ucr->mapper = uwsgi_cr_map_use_void;
-
-			if (ucr->use_cache) {
-				ucr->cache = uwsgi_cache_by_name(ucr->use_cache);
-				if (!ucr->cache) {
-					uwsgi_log("!!! unable to find cache \"%s\" !!!\n", ucr->use_cache);
-					exit(1);
-				}
-                        	ucr->mapper = uwsgi_cr_map_use_cache;
-                        }
-                        else if (ucr->pattern) {
-                                ucr->mapper = uwsgi_cr_map_use_pattern;
-                        }
-                        else if (ucr->has_subscription_sockets) {
-                                ucr->mapper = uwsgi_cr_map_use_subscription;
-				if (uwsgi.subscription_dotsplit) {
-                                	ucr->mapper = uwsgi_cr_map_use_subscription_dotsplit;
-				}
-                        }
-                        else if (ucr->base) {
-                                ucr->mapper = uwsgi_cr_map_use_base;
-                        }
-                        else if (ucr->code_string_code && ucr->code_string_function) {
-                                ucr->mapper = uwsgi_cr_map_use_cs;
-			}
-                        else if (ucr->to_socket) {
-                                ucr->mapper = uwsgi_cr_map_use_to;
-                        }
-                        else if (ucr->static_nodes) {
-                                ucr->mapper = uwsgi_cr_map_use_static_nodes;
-                        }
-
-	ucr->timeouts = uwsgi_init_rb_timer();
+	time_t last_pool_check = 0;
 
 	for (;;) {
 
 		time_t now = uwsgi_now();
 
+		// close the expired idle backend connections
+		if (ucr->pools && now != last_pool_check) {
+			corerouter_pool_expire(ucr, now);
+			last_pool_check = now;
+		}
+
 		// set timeouts and harakiri
 		min_timeout = uwsgi_min_rb_timer(ucr->timeouts, NULL);
 		if (min_timeout == NULL) {
@@ -851,7 +778,7 @@ void uwsgi_corerouter_loop(int id, void *data) {
 			}
 		}
 
-		if (uwsgi.master_process && ucr->harakiri > 0) {
+		if (main_thread && uwsgi.master_process && ucr->harakiri > 0) {
 			ushared->gateways_harakiri[id] = 0;
 		}
 
@@ -860,7 +787,7 @@ void uwsgi_corerouter_loop(int id, void *data) {
 
 		now = uwsgi_now();
 
-		if (uwsgi.master_process && ucr->harakiri > 0) {
+		if (main_thread && uwsgi.master_process && ucr->harakiri > 0) {
 			ushared->gateways_harakiri[id] = now + ucr->harakiri;
 		}
 
@@ -949,6 +876,13 @@ void uwsgi_corerouter_loop(int id, void *data) {
 				// call event hook
 				if (event_queue_interesting_fd_is_read(events, i)) {
 					hook = peer->hook_read;	
+					// first response from a subscription node (the peer still holds a reference to it)
+					if (peer->un_started && peer->un) {
+						cr_shared_lock(ucr);
+						uwsgi_subscription_node_latency(peer->un, uwsgi_micros() - peer->un_started);
+						cr_shared_unlock(ucr);
+						peer->un_started = 0;
+					}
 				}
 				else if (event_queue_interesting_fd_is_write(events, i)) {
 					hook = peer->hook_write;	
@@ -974,7 +908,211 @@ void uwsgi_corerouter_loop(int id, void *data) {
 			}
 		}
 	}
+}
+
+struct corerouter_thread {
+	struct uwsgi_corerouter *ucr;
+	int id;
+	void *events;
+};
 
+static void *corerouter_thread_loop(void *arg) {
+	struct corerouter_thread *crt = (struct corerouter_thread *) arg;
+	// signals are managed by the main thread
+	sigset_t smask;
+	sigfillset(&smask);
+	pthread_sigmask(SIG_BLOCK, &smask, NULL);
+	corerouter_event_loop(crt->ucr, crt->id, crt->events, 0);
+	return NULL;
+}
+
+// spawn the additional event loop threads, each one accepting connections on the router sockets
+static void corerouter_spawn_threads(struct uwsgi_corerouter *ucr, int id) {
+	int i;
+	ucr->shared_lock = uwsgi_malloc(sizeof(pthread_mutex_t));
+	pthread_mutex_init(ucr->shared_lock, NULL);
+	ucr->thread_routers = uwsgi_calloc(sizeof(struct uwsgi_corerouter *) * ucr->threads);
+	ucr->thread_routers[0] = ucr;
+
+	for (i = 1; i < ucr->threads; i++) {
+		struct uwsgi_corerouter *tcr = uwsgi_malloc(sizeof(struct uwsgi_corerouter));
+		memcpy(tcr, ucr, sizeof(struct uwsgi_corerouter));
+		// shared-nothing state
+		tcr->cr_table = uwsgi_calloc(sizeof(struct corerouter_peer *) * uwsgi.max_fd);
+		tcr->timeouts = uwsgi_init_rb_timer();
+		tcr->cr_stats_server = -1;
+		tcr->active_sessions = 0;
+		tcr->pools = NULL;
+		tcr->pool_idle = 0;
+		tcr->pool_hits = 0;
+		tcr->pool_misses = 0;
+		tcr->pool_expired = 0;
+		tcr->pool_invalidated = 0;
+		tcr->spliced = 0;
+		tcr->ktls = 0;
+		tcr->ssl_handshakes = 0;
+		tcr->ssl_resumed = 0;
+		tcr->queue = event_queue_init();
+		// subscription sockets are managed by the main thread
+		struct uwsgi_gateway_socket *ugs = uwsgi.gateway_sockets;
+		while (ugs) {
+			if (!strcmp(ucr->name, ugs->owner) && !ugs->subscription) {
+				event_queue_add_fd_read(tcr->queue, ugs->fd);
+			}
+			ugs = ugs->next;
+		}
+		ucr->thread_routers[i] = tcr;
+
+		struct corerouter_thread *crt = uwsgi_malloc(sizeof(struct corerouter_thread));
+		crt->ucr = tcr;
+		crt->id = id;
+		crt->events = event_queue_alloc(ucr->nevents);
+		pthread_t t;
+		if (pthread_create(&t, NULL, corerouter_thread_loop, crt)) {
+			uwsgi_error("corerouter_spawn_threads()/pthread_create()");
+			exit(1);
+		}
+	}
+	uwsgi_log("[%s pid %d] running %d event loop threads\n", ucr->name, (int) uwsgi.mypid, ucr->threads);
+}
+
+void uwsgi_corerouter_loop(int id, void *data) {
+
+	int i;
+
+	struct uwsgi_corerouter *ucr = (struct uwsgi_corerouter *) data;
+
+	ucr->cr_stats_server = -1;
+
+	ucr->cr_table = uwsgi_malloc(sizeof(struct corerouter_session *) * uwsgi.max_fd);
+
+	for (i = 0; i < (int) uwsgi.max_fd; i++) {
+		ucr->cr_table[i] = NULL;
+	}
+
+	ucr->i_am_cheap = ucr->cheap;
+
+	void *events = uwsgi_corerouter_setup_event_queue(ucr, id);
+
+	if (ucr->has_subscription_sockets)
+		event_queue_add_fd_read(ucr->queue, ushared->gateways[id].internal_subscription_pipe[1]);
+
+
+	if (!ucr->socket_timeout)
+		ucr->socket_timeout = 60;
+
+	if (!ucr->defer_connect_timeout)
+		ucr->defer_connect_timeout = 5;
+
+	if (!ucr->static_node_gracetime)
+		ucr->static_node_gracetime = 30;
+
+	int i_am_the_first = 1;
+	for(i=0;i<id;i++) {
+		if (!strcmp(ushared->gateways[i].name, ucr->name)) {
+			i_am_the_first = 0;
+			break;
+		}
+	}
+
+	if (ucr->stats_server && i_am_the_first) {
+		char *tcp_port = strchr(ucr->stats_server, ':');
+		if (tcp_port) {
+			// disable deferred accept for this socket
+			int current_defer_accept = uwsgi.no_defer_accept;
+			uwsgi.no_defer_accept = 1;
+			ucr->cr_stats_server = bind_to_tcp(ucr->stats_server, uwsgi.listen_queue, tcp_port);
+			uwsgi.no_defer_accept = current_defer_accept;
+		}
+		else {
+			ucr->cr_stats_server = bind_to_unix(ucr->stats_server, uwsgi.listen_queue, uwsgi.chmod_socket, uwsgi.abstract_socket);
+		}
+
+		event_queue_add_fd_read(ucr->queue, ucr->cr_stats_server);
+		uwsgi_log("*** %s stats server enabled on %s fd: %d ***\n", ucr->short_name, ucr->stats_server, ucr->cr_stats_server);
+	}
+
+	if (ucr->emperor_socket) {
+		char *colon = strchr(ucr->emperor_socket, ':');
+		if (colon) {
+			ucr->emperor_socket_fd = socket(AF_INET, SOCK_DGRAM, 0);
+                        ucr->emperor_socket_addr_len = socket_to_in_addr(ucr->emperor_socket, colon, 0, &ucr->emperor_socket_addr.sa_in);
+		}
+		else {
+			ucr->emperor_socket_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+	  		ucr->emperor_socket_addr_len = socket_to_un_addr(ucr->emperor_socket, &ucr->emperor_socket_addr.sa_un);
+		}
+		if (ucr->emperor_socket_fd < 0) {
+			uwsgi_error("error creating emperor socket client: socket()");
+			exit(1);
+		}
+		uwsgi_log("emperor socket mapped to: %s\n", ucr->emperor_socket);	
+	}
+
+
+	if (ucr->use_socket) {
+		ucr->to_socket = uwsgi_get_socket_by_num(ucr->socket_num);
+		if (ucr->to_socket) {
+			// fix socket name_len
+			if (ucr->to_socket->name_len == 0 && ucr->to_socket->name) {
+				ucr->to_socket->name_len = strlen(ucr->to_socket->name);
+			}
+		}
+	}
+
+	if (!ucr->pb_base_dir) {
+		ucr->pb_base_dir = getenv("TMPDIR");
+		if (!ucr->pb_base_dir)
+			ucr->pb_base_dir = "/tmp";
+	}
+
+
+	if (ucr->pattern) {
+		init_magic_table(ucr->magic_table);
+	}
+
+	ucr->mapper = uwsgi_cr_map_use_void;
+
+			if (ucr->use_cache) {
+				ucr->cache = uwsgi_cache_by_name(ucr->use_cache);
+				if (!ucr->cache) {
+					uwsgi_log("!!! unable to find cache \"%s\" !!!\n", ucr->use_cache);
+					exit(1);
+				}
+                        	ucr->mapper = uwsgi_cr_map_use_cache;
+                        }
+                        else if (ucr->pattern) {
+                                ucr->mapper = uwsgi_cr_map_use_pattern;
+                        }
+                        else if (ucr->has_subscription_sockets) {
+                                ucr->mapper = uwsgi_cr_map_use_subscription;
+				if (uwsgi.subscription_dotsplit) {
+                                	ucr->mapper = uwsgi_cr_map_use_subscription_dotsplit;
+				}
+                        }
+                        else if (ucr->base) {
+                                ucr->mapper = uwsgi_cr_map_use_base;
+                        }
+                        else if (ucr->code_string_code && ucr->code_string_function) {
+                                ucr->mapper = uwsgi_cr_map_use_cs;
+			}
+                        else if (ucr->to_socket) {
+                                ucr->mapper = uwsgi_cr_map_use_to;
+                        }
+                        else if (ucr->static_nodes) {
+                                ucr->mapper = uwsgi_cr_map_use_static_nodes;
+                        }
+
+	ucr->timeouts = uwsgi_init_rb_timer();
+
+	if (ucr->pool_max_idle && !ucr->pool_ttl)
+		ucr->pool_ttl = 30;
+
+	if (ucr->threads > 1) {
+		corerouter_spawn_threads(ucr, id);
+	}
+
+	corerouter_event_loop(ucr, id, events, 1);
 }
 
 int uwsgi_corerouter_has_backends(struct uwsgi_corerouter *ucr) {
@@ -1024,6 +1162,10 @@ int uwsgi_corerouter_init(struct uwsgi_corerouter *ucr) {
 		if (ucr->processes < 1)
 			ucr->processes = 1;
 		if (ucr->cheap) {
+			if (ucr->threads > 1) {
+				uwsgi_log("the %s cheap mode is not supported with multiple threads\n", ucr->name);
+				exit(1);
+			}
 			uwsgi_log("starting %s in cheap mode\n", ucr->name);
 		}
 		for (i = 0; i < ucr->processes; i++) {
@@ -1046,6 +1188,85 @@ struct uwsgi_plugin corerouter_plugin = {
 	.name = "corerouter",
 };
 
+// dump the subscriptions table (the caller holds the shared lock)
+static int corerouter_stats_subscriptions(struct uwsgi_corerouter *ucr, struct uwsgi_stats *us) {
+	if (uwsgi_stats_key(us , "subscriptions")) return -1;
+	if (uwsgi_stats_list_open(us)) return -1;
+
+	int i;
+	int first_processed = 0;
+	for(i=0;i<UMAX16;i++) {
+		struct uwsgi_subscribe_slot *s_slot = ucr->subscriptions[i];
+		if (s_slot && first_processed) {
+			if (uwsgi_stats_comma(us)) return -1;
+		}
+		while (s_slot) {
+			first_processed = 1;
+			if (uwsgi_stats_object_open(us)) return -1;
+			if (uwsgi_stats_keyvaln_comma(us, "key", s_slot->key, s_slot->keylen)) return -1;
+			if (uwsgi_stats_keylong_comma(us, "hash", (unsigned long long) s_slot->hash)) return -1;
+			if (uwsgi_stats_keylong_comma(us, "hits", (unsigned long long) s_slot->hits)) return -1;
+#ifdef UWSGI_SSL
+			if (uwsgi_stats_keylong_comma(us, "sni_enabled", (unsigned long long) s_slot->sni_enabled)) return -1;
+#endif
+			if (uwsgi_stats_keyval_comma(us, "algo", uwsgi_subscription_algo_name(s_slot->algo))) return -1;
+
+			if (uwsgi_stats_key(us , "nodes")) return -1;
+			if (uwsgi_stats_list_open(us)) return -1;
+
+			struct uwsgi_subscribe_node *s_node = s_slot->nodes;
+			while (s_node) {
+				if (uwsgi_stats_object_open(us)) return -1;
+
+				if (uwsgi_stats_keyvaln_comma(us, "name", s_node->name, s_node->len)) return -1;
+				if (uwsgi_stats_keyvaln_comma(us, "vassal", s_node->vassal, s_node->vassal_len)) return -1;
+
+				if (uwsgi_stats_keylong_comma(us, "modifier1", (unsigned long long) s_node->modifier1)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "modifier2", (unsigned long long) s_node->modifier2)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "last_check", (unsigned long long) s_node->last_check)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "pid", (unsigned long long) s_node->pid)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "uid", (unsigned long long) s_node->uid)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "gid", (unsigned long long) s_node->gid)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "requests", (unsigned long long) s_node->requests)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "last_requests", (unsigned long long) s_node->last_requests)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "tx", (unsigned long long) s_node->tx)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "rx", (unsigned long long) s_node->rx)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "cores", (unsigned long long) s_node->cores)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "load", (unsigned long long) s_node->load)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "weight", (unsigned long long) s_node->weight)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "backup", (unsigned long long) s_node->backup_level)) return -1;
+				if (uwsgi_stats_keyvaln_comma(us, "proto", &s_node->proto, s_node->proto ? 1 : 0)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "wrr", (unsigned long long) s_node->wrr)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "ewma", (unsigned long long) s_node->ewma)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "ref", (unsigned long long) s_node->reference)) return -1;
+				if (uwsgi_stats_keylong_comma(us, "failcnt", (unsigned long long) s_node->failcnt)) return -1;
+				if (uwsgi_stats_keylong(us, "death_mark", (unsigned long long) s_node->death_mark)) return -1;
+
+				if (uwsgi_stats_object_close(us)) return -1;
+				if (s_node->next) {
+					if (uwsgi_stats_comma(us)) return -1;
+				}
+				s_node = s_node->next;
+			}
+
+			if (uwsgi_stats_list_close(us)) return -1;
+			if (uwsgi_stats_object_close(us)) return -1;
+			if (s_slot->next) {
+				if (uwsgi_stats_comma(us)) return -1;
+			}
+
+			s_slot = s_slot->next;
+			// check for loopy optimization
+			if (s_slot == ucr->subscriptions[i])
+				break;
+		}
+	}
+
+	if (uwsgi_stats_list_close(us)) return -1;
+	if (uwsgi_stats_comma(us)) return -1;
+	return 0;
+}
+
 void corerouter_send_stats(struct uwsgi_corerouter *ucr) {
 
 	struct sockaddr_un client_src;
@@ -1074,7 +1295,36 @@ void corerouter_send_stats(struct uwsgi_corerouter *ucr) {
         char *cwd = uwsgi_get_cwd();
         if (uwsgi_stats_keyval_comma(us, "cwd", cwd)) goto end0;
 
-        if (uwsgi_stats_keylong_comma(us, "active_sessions", (unsigned long long) ucr->active_sessions)) goto end0;
+	// sum the counters of the event loop threads
+	uint64_t active_sessions = ucr->active_sessions;
+	uint64_t pool_idle = ucr->pool_idle;
+	uint64_t pool_hits = ucr->pool_hits;
+	uint64_t pool_misses = ucr->pool_misses;
+	uint64_t pool_expired = ucr->pool_expired;
+	uint64_t pool_invalidated = ucr->pool_invalidated;
+	uint64_t spliced = ucr->spliced;
+	uint64_t ktls = ucr->ktls;
+	uint64_t ssl_handshakes = ucr->ssl_handshakes;
+	uint64_t ssl_resumed = ucr->ssl_resumed;
+	int i;
+	for (i = 1; i < ucr->threads; i++) {
+		struct uwsgi_corerouter *tcr = ucr->thread_routers[i];
+		active_sessions += tcr->active_sessions;
+		pool_idle += tcr->pool_idle;
+		pool_hits += tcr->pool_hits;
+		pool_misses += tcr->pool_misses;
+		pool_expired += tcr->pool_expired;
+		pool_invalidated += tcr->pool_invalidated;
+		spliced += tcr->spliced;
+		ktls += tcr->ktls;
+		ssl_handshakes += tcr->ssl_handshakes;
+		ssl_resumed += tcr->ssl_resumed;
+	}
+
+        if (uwsgi_stats_keylong_comma(us, "active_sessions", (unsigned long long) active_sessions)) goto end0;
+	if (ucr->threads > 1) {
+		if (uwsgi_stats_keylong_comma(us, "threads", (unsigned long long) ucr->threads)) goto end0;
+	}
 
 	if (uwsgi_stats_key(us , ucr->short_name)) goto end0;
         if (uwsgi_stats_list_open(us)) goto end0;
@@ -1116,81 +1366,42 @@ void corerouter_send_stats(struct uwsgi_corerouter *ucr) {
         }
 
 	if (ucr->has_subscription_sockets) {
-		if (uwsgi_stats_key(us , "subscriptions")) goto end0;
-		if (uwsgi_stats_list_open(us)) goto end0;
-
-		int i;
-		int first_processed = 0;
-		for(i=0;i<UMAX16;i++) {
-			struct uwsgi_subscribe_slot *s_slot = ucr->subscriptions[i];
-			if (s_slot && first_processed) {
-				if (uwsgi_stats_comma(us)) goto end0;
-			}
-			while (s_slot) {
-				first_processed = 1;
-				if (uwsgi_stats_object_open(us)) goto end0;
-				if (uwsgi_stats_keyvaln_comma(us, "key", s_slot->key, s_slot->keylen)) goto end0;
-				if (uwsgi_stats_keylong_comma(us, "hash", (unsigned long long) s_slot->hash)) goto end0;
-				if (uwsgi_stats_keylong_comma(us, "hits", (unsigned long long) s_slot->hits)) goto end0;
-#ifdef UWSGI_SSL
-				if (uwsgi_stats_keylong_comma(us, "sni_enabled", (unsigned long long) s_slot->sni_enabled)) goto end0;
-#endif
-				if (uwsgi_stats_keyval_comma(us, "algo", uwsgi_subscription_algo_name(s_slot->algo))) goto end0;
-
-				if (uwsgi_stats_key(us , "nodes")) goto end0;
-				if (uwsgi_stats_list_open(us)) goto end0;
-
-				struct uwsgi_subscribe_node *s_node = s_slot->nodes;
-				while (s_node) {
-					if (uwsgi_stats_object_open(us)) goto end0;
-
-					if (uwsgi_stats_keyvaln_comma(us, "name", s_node->name, s_node->len)) goto end0;
-					if (uwsgi_stats_keyvaln_comma(us, "vassal", s_node->vassal, s_node->vassal_len)) goto end0;
-
-					if (uwsgi_stats_keylong_comma(us, "modifier1", (unsigned long long) s_node->modifier1)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "modifier2", (unsigned long long) s_node->modifier2)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "last_check", (unsigned long long) s_node->last_check)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "pid", (unsigned long long) s_node->pid)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "uid", (unsigned long long) s_node->uid)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "gid", (unsigned long long) s_node->gid)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "requests", (unsigned long long) s_node->requests)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "last_requests", (unsigned long long) s_node->last_requests)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "tx", (unsigned long long) s_node->tx)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "rx", (unsigned long long) s_node->rx)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "cores", (unsigned long long) s_node->cores)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "load", (unsigned long long) s_node->load)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "weight", (unsigned long long) s_node->weight)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "backup", (unsigned long long) s_node->backup_level)) goto end0;
-					if (uwsgi_stats_keyvaln_comma(us, "proto", &s_node->proto, 1)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "wrr", (unsigned long long) s_node->wrr)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "ref", (unsigned long long) s_node->reference)) goto end0;
-					if (uwsgi_stats_keylong_comma(us, "failcnt", (unsigned long long) s_node->failcnt)) goto end0;
-					if (uwsgi_stats_keylong(us, "death_mark", (unsigned long long) s_node->death_mark)) goto end0;
-
-					if (uwsgi_stats_object_close(us)) goto end0;
-					if (s_node->next) {
-						if (uwsgi_stats_comma(us)) goto end0;
-					}
-					s_node = s_node->next;
-				}
+		cr_shared_lock(ucr);
+		int ret = corerouter_stats_subscriptions(ucr, us);
+		cr_shared_unlock(ucr);
+		if (ret) goto end0;
+	}
 
-				if (uwsgi_stats_list_close(us)) goto end0;
-				if (uwsgi_stats_object_close(us)) goto end0;
-				if (s_slot->next) {
-					if (uwsgi_stats_comma(us)) goto end0;
-				}
+	if (ucr->pool_max_idle) {
+		if (uwsgi_stats_key(us , "pool")) goto end0;
+		if (uwsgi_stats_object_open(us)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "max_idle", (unsigned long long) ucr->pool_max_idle)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "ttl", (unsigned long long) ucr->pool_ttl)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "idle", (unsigned long long) pool_idle)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "hits", (unsigned long long) pool_hits)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "misses", (unsigned long long) pool_misses)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "expired", (unsigned long long) pool_expired)) goto end0;
+		if (uwsgi_stats_keylong(us, "invalidated", (unsigned long long) pool_invalidated)) goto end0;
+		if (uwsgi_stats_object_close(us)) goto end0;
+		if (uwsgi_stats_comma(us)) goto end0;
+	}
 
-				s_slot = s_slot->next;
-				// check for loopy optimization
-				if (s_slot == ucr->subscriptions[i])
-					break;
-			}
-		}
+	if (ucr->splice) {
+		if (uwsgi_stats_keylong_comma(us, "spliced", (unsigned long long) spliced)) goto end0;
+	}
 
-			if (uwsgi_stats_list_close(us)) goto end0;
-			if (uwsgi_stats_comma(us)) goto end0;
+#ifdef UWSGI_SSL
+	if (uwsgi.ssl_ktls) {
+		if (uwsgi_stats_keylong_comma(us, "ktls", (unsigned long long) ktls)) goto end0;
 	}
 
+	if (ucr->has_ssl_sockets) {
+		if (uwsgi_stats_keylong_comma(us, "ssl_handshakes", (unsigned long long) ssl_handshakes)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "ssl_resumed", (unsigned long long) ssl_resumed)) goto end0;
+		if (uwsgi_stats_keylong_comma(us, "ssl_ticket_keys_rotations", (unsigned long long) uwsgi_ssl_ticket_keys_rotations())) goto end0;
+	}
+#endif
+
 	if (uwsgi_stats_keylong(us, "cheap", (unsigned long long) ucr->i_am_cheap)) goto end0;	
 
 	if (uwsgi_stats_object_close(us)) goto end0;
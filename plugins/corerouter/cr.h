@@ -35,9 +35,32 @@
 
 #define cr_write_complete(peer) peer->out_pos == peer->out->pos
 
+#define cr_splice_read(peer, max, f) corerouter_splice_in(peer, max);\
+	if (len < 0) {\
+                cr_try_again;\
+                uwsgi_cr_error(peer, f);\
+                return -1;\
+        }\
+	if (peer != peer->session->main_peer && peer->un) peer->un->tx+=len;
+
+#define cr_splice_write(peer, f) corerouter_splice_out(peer);\
+	if (len < 0) {\
+                cr_try_again;\
+                uwsgi_cr_error(peer, f);\
+                return -1;\
+        }\
+	if (peer != peer->session->main_peer && peer->un) peer->un->rx+=len;
+
+#define cr_splice_complete(peer) peer->session->splice_pending == 0
+
+#define cr_shared_lock(ucr) if (ucr->shared_lock) pthread_mutex_lock(ucr->shared_lock);
+#define cr_shared_unlock(ucr) if (ucr->shared_lock) pthread_mutex_unlock(ucr->shared_lock);
+
 #define cr_write_complete_buf(peer, buf) buf##_pos == buf->pos
 
-#define cr_connect(peer, f) peer->fd = uwsgi_connectn(peer->instance_address, peer->instance_address_len, 0, 1);\
+#define cr_connect(peer, f) peer->fd = -1;\
+	if (peer->can_pool) peer->fd = corerouter_pool_get(peer->session->corerouter, peer);\
+	if (peer->fd < 0) peer->fd = uwsgi_connectn(peer->instance_address, peer->instance_address_len, 0, 1);\
         if (peer->fd < 0) {\
                 peer->failed = 1;\
                 peer->soopt = errno;\
@@ -158,6 +181,8 @@ struct corerouter_peer {
 
 	// backend info
         struct uwsgi_subscribe_node *un;
+	// when the subscription node has been chosen (0 once its response time has been measured)
+	uint64_t un_started;
         struct uwsgi_string_list *static_node;
 
 	// incoming data 
@@ -204,6 +229,31 @@ struct corerouter_peer {
 
 	char *vassal;
 	uint8_t vassal_len;
+
+	// the backend connection can be taken from (and given back to) the pool
+	int can_pool;
+	// the response is complete, give back the connection to the pool on close
+	int reusable;
+	// the connection has been taken from the pool
+	int pooled;
+};
+
+// an idle backend connection
+struct corerouter_pool_conn {
+	int fd;
+	time_t expires;
+	struct corerouter_pool_conn *prev;
+	struct corerouter_pool_conn *next;
+};
+
+// the idle connections to a backend address (most recent first)
+struct corerouter_pool {
+	char *address;
+	uint64_t address_len;
+	int count;
+	struct corerouter_pool_conn *head;
+	struct corerouter_pool_conn *tail;
+	struct corerouter_pool *next;
 };
 
 struct uwsgi_corerouter {
@@ -296,6 +346,34 @@ struct uwsgi_corerouter {
 
 	char *fallback_key;
 	int fallback_key_len;
+
+	// backend connections pool
+	int pool_max_idle;
+	int pool_ttl;
+	struct corerouter_pool *pools;
+	uint64_t pool_idle;
+	uint64_t pool_hits;
+	uint64_t pool_misses;
+	uint64_t pool_expired;
+	uint64_t pool_invalidated;
+
+	// relay raw streams and bodies with splice()
+	int splice;
+	uint64_t spliced;
+
+	// sessions encrypted by the kernel (kTLS) after the handshake
+	uint64_t ktls;
+
+	// TLS handshakes and how many of them resumed a session (ticket or cache)
+	int has_ssl_sockets;
+	uint64_t ssl_handshakes;
+	uint64_t ssl_resumed;
+
+	// event loop threads, each one has its own copy of this structure (sessions table, timers, event queue
+	// and pools) while the subscriptions table is shared (protected by the lock, like the code string mappers)
+	int threads;
+	pthread_mutex_t *shared_lock;
+	struct uwsgi_corerouter **thread_routers;
 };
 
 // a session is started when a client connect to the router
@@ -315,6 +393,8 @@ struct corerouter_session {
 
 	void (*close)(struct corerouter_session *);
 	int (*retry)(struct corerouter_peer *);
+	// called before destroying a backend peer (multiplexing protocols)
+	void (*peer_closed)(struct corerouter_peer *);
 
 	// leave the main peer alive
 	int can_keepalive;
@@ -329,6 +409,10 @@ struct corerouter_session {
 	// connect after the next successful write
 	struct corerouter_peer *connect_peer_after_write;
 
+	// pipe used for splice() relaying and the amount of data still in it
+	int splice_pipe[2];
+	size_t splice_pending;
+
 	union uwsgi_sockaddr client_sockaddr;
 #ifdef AF_INET6
 	char client_address[INET6_ADDRSTRLEN];
@@ -383,3 +467,16 @@ void corerouter_close_peer(struct uwsgi_corerouter *, struct corerouter_peer *);
 struct uwsgi_rb_timer *corerouter_reset_timeout(struct uwsgi_corerouter *, struct corerouter_peer *);
 
 int corerouter_spawn_vassal(struct uwsgi_corerouter *, struct uwsgi_subscribe_node *, int);
+
+int corerouter_pool_get(struct uwsgi_corerouter *, struct corerouter_peer *);
+int corerouter_pool_put(struct uwsgi_corerouter *, struct corerouter_peer *);
+void corerouter_pool_invalidate(struct uwsgi_corerouter *, char *, uint64_t);
+void corerouter_pool_expire(struct uwsgi_corerouter *, time_t);
+
+ssize_t corerouter_splice_in(struct corerouter_peer *, size_t);
+ssize_t corerouter_splice_out(struct corerouter_peer *);
+void corerouter_splice_close(struct corerouter_session *);
+
+#ifdef UWSGI_SSL
+int corerouter_ssl_handshake_done(struct uwsgi_corerouter *, SSL *);
+#endif
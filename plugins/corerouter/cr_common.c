@@ -134,6 +134,7 @@ void uwsgi_corerouter_manage_subscription(struct uwsgi_corerouter *ucr, int id,
 			usr.base_len = len - 4 - (2 + 4 + 2 + usr.sign_len);
 		}
 
+		cr_shared_lock(ucr);
 		// subscribe request ?
 		if (bbuf[3] == 0) {
 			if (uwsgi_add_subscribe_node(ucr->subscriptions, &usr) && ucr->i_am_cheap) {
@@ -155,6 +156,7 @@ void uwsgi_corerouter_manage_subscription(struct uwsgi_corerouter *ucr, int id,
 #ifdef UWSGI_SSL
 				if (uwsgi.subscriptions_sign_check_dir) {
 					if (!uwsgi_subscription_sign_check(node->slot, &usr)) {
+						cr_shared_unlock(ucr);
 						return;
 					}
 				}
@@ -163,6 +165,7 @@ void uwsgi_corerouter_manage_subscription(struct uwsgi_corerouter *ucr, int id,
 					uwsgi_log("[%s pid %d] %.*s => marking %.*s as failed\n", ucr->name, (int) uwsgi.mypid, (int) usr.keylen, usr.key, (int) usr.address_len, usr.address);
 				node->failcnt++;
 				node->death_mark = 1;
+				corerouter_pool_invalidate(ucr, node->name, node->len);
 				// check if i can remove the node
 				if (node->reference == 0) {
 					uwsgi_remove_subscribe_node(ucr->subscriptions, node);
@@ -172,6 +175,7 @@ void uwsgi_corerouter_manage_subscription(struct uwsgi_corerouter *ucr, int id,
 				}
 			}
 		}
+		cr_shared_unlock(ucr);
 
 		// propagate the subscription to other nodes
 		for (i = 0; i < ushared->gateways_cnt; i++) {
@@ -243,6 +247,7 @@ void uwsgi_corerouter_manage_internal_subscription(struct uwsgi_corerouter *ucr,
 		memset(&usr, 0, sizeof(struct uwsgi_subscribe_req));
 		uwsgi_hooked_parse(bbuf + 4, len - 4, corerouter_manage_subscription, &usr);
 
+		cr_shared_lock(ucr);
 		// subscribe request ?
 		if (bbuf[3] == 0) {
 			if (uwsgi_add_subscribe_node(ucr->subscriptions, &usr) && ucr->i_am_cheap) {
@@ -265,6 +270,7 @@ void uwsgi_corerouter_manage_internal_subscription(struct uwsgi_corerouter *ucr,
 					uwsgi_log("[%s pid %d] %.*s => marking %.*s as failed\n", ucr->name, (int) uwsgi.mypid, (int) usr.keylen, usr.key, (int) usr.address_len, usr.address);
 				node->failcnt++;
 				node->death_mark = 1;
+				corerouter_pool_invalidate(ucr, node->name, node->len);
 				// check if i can remove the node
 				if (node->reference == 0) {
 					uwsgi_remove_subscribe_node(ucr->subscriptions, node);
@@ -274,6 +280,7 @@ void uwsgi_corerouter_manage_internal_subscription(struct uwsgi_corerouter *ucr,
 				}
 			}
 		}
+		cr_shared_unlock(ucr);
 	}
 
 }
@@ -302,3 +309,18 @@ end:
 	uwsgi_buffer_destroy(ub);
 	return ret;
 }
+
+#ifdef UWSGI_SSL
+// the TLS handshake of a session is complete, update the counters and return the kTLS directions
+int corerouter_ssl_handshake_done(struct uwsgi_corerouter *ucr, SSL *ssl) {
+	ucr->ssl_handshakes++;
+	if (SSL_session_reused(ssl)) {
+		ucr->ssl_resumed++;
+	}
+	int ktls = uwsgi_ssl_ktls(ssl);
+	if (ktls & UWSGI_SSL_KTLS_TX) {
+		ucr->ktls++;
+	}
+	return ktls;
+}
+#endif
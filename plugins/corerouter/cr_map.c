@@ -10,8 +10,9 @@ int uwsgi_cr_map_use_void(struct uwsgi_corerouter *ucr, struct corerouter_peer *
 
 int uwsgi_cr_map_use_cache(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
 	uint64_t hits = 0;
-	uwsgi_rlock(ucr->cache->lock);
-	char *value = uwsgi_cache_get4(ucr->cache, peer->key, peer->key_len, &peer->instance_address_len, &hits);
+	struct uwsgi_cache *uc = uwsgi_cache_shard(ucr->cache, peer->key, peer->key_len);
+	uwsgi_rlock(uc->lock);
+	char *value = uwsgi_cache_get4(uc, peer->key, peer->key_len, &peer->instance_address_len, &hits);
 	if (!value)
 		goto end;
 	peer->tmp_socket_name = uwsgi_concat2n(value, peer->instance_address_len, "", 0);
@@ -33,7 +34,7 @@ int uwsgi_cr_map_use_cache(struct uwsgi_corerouter *ucr, struct corerouter_peer
 		peer->instance_address_len = (cs_mod - peer->instance_address);
 	}
 end:
-	uwsgi_rwunlock(ucr->cache->lock);
+	uwsgi_rwunlock(uc->lock);
 	return 0;
 }
 
@@ -55,6 +56,8 @@ int uwsgi_cr_map_use_subscription(struct uwsgi_corerouter *ucr, struct coreroute
 	usc.sockaddr = &peer->session->client_sockaddr;
 	usc.cookie = NULL;
 
+	cr_shared_lock(ucr);
+	peer->un_started = 0;
 	peer->un = uwsgi_get_subscribe_node(ucr->subscriptions, peer->key, peer->key_len, &usc);
 	if((peer->un == NULL) && (ucr->fallback_key != NULL)) {
 		peer->un = uwsgi_get_subscribe_node(ucr->subscriptions, ucr->fallback_key, ucr->fallback_key_len, &usc);
@@ -67,6 +70,7 @@ int uwsgi_cr_map_use_subscription(struct uwsgi_corerouter *ucr, struct coreroute
 		if (peer->un->len) {
 			peer->instance_address = peer->un->name;
 			peer->instance_address_len = peer->un->len;
+			peer->un_started = uwsgi_micros();
 		}
 		else if (peer->un->vassal_len) {
 			peer->vassal = peer->un->vassal;
@@ -78,6 +82,7 @@ int uwsgi_cr_map_use_subscription(struct uwsgi_corerouter *ucr, struct coreroute
 	else if (ucr->cheap && !ucr->i_am_cheap && uwsgi_no_subscriptions(ucr->subscriptions)) {
 		uwsgi_gateway_go_cheap(ucr->name, ucr->queue, &ucr->i_am_cheap);
 	}
+	cr_shared_unlock(ucr);
 
 	return 0;
 }
@@ -94,9 +99,12 @@ int uwsgi_cr_map_use_subscription_dotsplit(struct uwsgi_corerouter *ucr, struct
 	usc.sockaddr = &peer->session->client_sockaddr;
 	usc.cookie = NULL;
 
+	cr_shared_lock(ucr);
 split:
-	if (!count)
+	if (!count) {
+		cr_shared_unlock(ucr);
 		return 0;
+	}
 #ifdef UWSGI_DEBUG
 	uwsgi_log("trying with %.*s\n", name_len, name);
 #endif
@@ -121,6 +129,7 @@ split:
 	else if (ucr->cheap && !ucr->i_am_cheap && uwsgi_no_subscriptions(ucr->subscriptions)) {
 		uwsgi_gateway_go_cheap(ucr->name, ucr->queue, &ucr->i_am_cheap);
 	}
+	cr_shared_unlock(ucr);
 
 	return 0;
 }
@@ -141,7 +150,10 @@ int uwsgi_cr_map_use_base(struct uwsgi_corerouter *ucr, struct corerouter_peer *
 int uwsgi_cr_map_use_cs(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
 	if (uwsgi.p[ucr->code_string_modifier1]->code_string) {
 		char *name = uwsgi_concat2("uwsgi_", ucr->short_name);
+		// language plugins could be not thread safe
+		cr_shared_lock(ucr);
 		peer->instance_address = uwsgi.p[ucr->code_string_modifier1]->code_string(name, ucr->code_string_code, ucr->code_string_function, peer->key, peer->key_len);
+		cr_shared_unlock(ucr);
 		free(name);
 		if (peer->instance_address) {
 			peer->instance_address_len = strlen(peer->instance_address);
@@ -0,0 +1,152 @@
+/*
+
+   corerouter backend connections pool
+
+   routers speaking a protocol able to reuse backend connections (currently http to http nodes)
+   mark the peer with can_pool before connecting, and with reusable once a response has been
+   fully received. On peer reset the connection is given back to the pool of its instance
+   address instead of being closed.
+
+*/
+
+#include <uwsgi.h>
+
+#include "cr.h"
+
+extern struct uwsgi_server uwsgi;
+
+static struct corerouter_pool *corerouter_pool_find(struct uwsgi_corerouter *ucr, char *address, uint64_t address_len) {
+	struct corerouter_pool *pool = ucr->pools;
+	while (pool) {
+		if (!uwsgi_strncmp(pool->address, pool->address_len, address, address_len)) {
+			return pool;
+		}
+		pool = pool->next;
+	}
+	return NULL;
+}
+
+static void corerouter_pool_remove(struct uwsgi_corerouter *ucr, struct corerouter_pool *pool, struct corerouter_pool_conn *conn) {
+	if (conn->prev) {
+		conn->prev->next = conn->next;
+	}
+	else {
+		pool->head = conn->next;
+	}
+
+	if (conn->next) {
+		conn->next->prev = conn->prev;
+	}
+	else {
+		pool->tail = conn->prev;
+	}
+
+	close(conn->fd);
+	free(conn);
+	pool->count--;
+	ucr->pool_idle--;
+}
+
+// get an idle connection to the peer instance address, -1 if none is available
+int corerouter_pool_get(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
+	if (!ucr->pool_max_idle || peer->instance_address_len == 0) return -1;
+
+	struct corerouter_pool *pool = corerouter_pool_find(ucr, peer->instance_address, peer->instance_address_len);
+	if (!pool) goto miss;
+
+	time_t now = uwsgi_now();
+	while (pool->head) {
+		struct corerouter_pool_conn *conn = pool->head;
+		if (conn->expires <= now) {
+			ucr->pool_expired++;
+			corerouter_pool_remove(ucr, pool, conn);
+			continue;
+		}
+		// an idle connection must not be readable (closed by the backend or garbage on it)
+		char byte;
+		ssize_t rlen = recv(conn->fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+		if (rlen < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			int fd = conn->fd;
+			// detach it without closing
+			conn->fd = -1;
+			pool->head = conn->next;
+			if (pool->head) {
+				pool->head->prev = NULL;
+			}
+			else {
+				pool->tail = NULL;
+			}
+			free(conn);
+			pool->count--;
+			ucr->pool_idle--;
+			ucr->pool_hits++;
+			peer->pooled = 1;
+			return fd;
+		}
+		corerouter_pool_remove(ucr, pool, conn);
+	}
+
+miss:
+	ucr->pool_misses++;
+	peer->pooled = 0;
+	return -1;
+}
+
+// give back the peer connection to the pool, returns 0 if the fd has been taken
+int corerouter_pool_put(struct uwsgi_corerouter *ucr, struct corerouter_peer *peer) {
+	if (!ucr->pool_max_idle || peer->instance_address_len == 0) return -1;
+
+	struct corerouter_pool *pool = corerouter_pool_find(ucr, peer->instance_address, peer->instance_address_len);
+	if (!pool) {
+		pool = uwsgi_calloc(sizeof(struct corerouter_pool));
+		pool->address = uwsgi_concat2n(peer->instance_address, peer->instance_address_len, "", 0);
+		pool->address_len = peer->instance_address_len;
+		pool->next = ucr->pools;
+		ucr->pools = pool;
+	}
+
+	// stop monitoring it
+	if (uwsgi_cr_set_hooks(peer, NULL, NULL)) return -1;
+
+	// drop the oldest one
+	if (pool->count >= ucr->pool_max_idle) {
+		corerouter_pool_remove(ucr, pool, pool->tail);
+	}
+
+	struct corerouter_pool_conn *conn = uwsgi_calloc(sizeof(struct corerouter_pool_conn));
+	conn->fd = peer->fd;
+	conn->expires = uwsgi_now() + ucr->pool_ttl;
+	conn->next = pool->head;
+	if (pool->head) {
+		pool->head->prev = conn;
+	}
+	else {
+		pool->tail = conn;
+	}
+	pool->head = conn;
+	pool->count++;
+	ucr->pool_idle++;
+	return 0;
+}
+
+// close all of the idle connections to a (dead or removed) node
+void corerouter_pool_invalidate(struct uwsgi_corerouter *ucr, char *address, uint64_t address_len) {
+	struct corerouter_pool *pool = corerouter_pool_find(ucr, address, address_len);
+	if (!pool) return;
+	while (pool->head) {
+		ucr->pool_invalidated++;
+		corerouter_pool_remove(ucr, pool, pool->head);
+	}
+}
+
+// close the idle connections over their ttl (the oldest are at the tail)
+void corerouter_pool_expire(struct uwsgi_corerouter *ucr, time_t now) {
+	struct corerouter_pool *pool = ucr->pools;
+	while (pool) {
+		while (pool->tail && pool->tail->expires <= now) {
+			ucr->pool_expired++;
+			corerouter_pool_remove(ucr, pool, pool->tail);
+		}
+		pool = pool->next;
+	}
+}
@@ -0,0 +1,86 @@
+/*
+
+   corerouter zero-copy relaying
+
+   when the router does not need to look at the data anymore (raw streams, request and
+   response bodies) it can move it between the two sockets with splice() through a
+   per-session pipe, without copying it to userspace buffers.
+
+   Like the buffered path only one transfer is in flight at a time: the bytes read from
+   a peer stay in the pipe (splice_pending) until they have been fully written to the
+   other one.
+
+*/
+
+#include <uwsgi.h>
+
+#include "cr.h"
+
+extern struct uwsgi_server uwsgi;
+
+#ifdef __linux__
+
+static int corerouter_splice_pipe(struct corerouter_session *cs) {
+	if (cs->splice_pipe[0] > -1) return 0;
+	if (pipe2(cs->splice_pipe, O_NONBLOCK | O_CLOEXEC)) {
+		uwsgi_error("corerouter_splice_pipe()/pipe2()");
+		cs->splice_pipe[0] = -1;
+		cs->splice_pipe[1] = -1;
+		return -1;
+	}
+#ifdef F_SETPIPE_SZ
+	// the pipe is the internal buffer, size it like the buffered one (when bigger than the default)
+	if (cs->corerouter->buffer_size > 65536) {
+		// the kernel caps it to /proc/sys/fs/pipe-max-size
+		fcntl(cs->splice_pipe[1], F_SETPIPE_SZ, (int) UMIN(cs->corerouter->buffer_size, INT_MAX));
+	}
+#endif
+	return 0;
+}
+
+// move up to max bytes (0 for no limit) from the peer socket to the session pipe
+ssize_t corerouter_splice_in(struct corerouter_peer *peer, size_t max) {
+	struct corerouter_session *cs = peer->session;
+	if (corerouter_splice_pipe(cs)) return -1;
+	if (!max || max > INT_MAX) max = INT_MAX;
+	ssize_t len = splice(peer->fd, NULL, cs->splice_pipe[1], NULL, max, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (len > 0) {
+		cs->splice_pending += len;
+		cs->corerouter->spliced += len;
+	}
+	return len;
+}
+
+// move the pending bytes from the session pipe to the peer socket
+ssize_t corerouter_splice_out(struct corerouter_peer *peer) {
+	struct corerouter_session *cs = peer->session;
+	ssize_t len = splice(cs->splice_pipe[0], NULL, peer->fd, NULL, cs->splice_pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (len > 0) {
+		cs->splice_pending -= len;
+	}
+	return len;
+}
+
+void corerouter_splice_close(struct corerouter_session *cs) {
+	if (cs->splice_pipe[0] > -1) close(cs->splice_pipe[0]);
+	if (cs->splice_pipe[1] > -1) close(cs->splice_pipe[1]);
+	cs->splice_pipe[0] = -1;
+	cs->splice_pipe[1] = -1;
+}
+
+#else
+
+ssize_t corerouter_splice_in(struct corerouter_peer *peer, size_t max) {
+	errno = ENOSYS;
+	return -1;
+}
+
+ssize_t corerouter_splice_out(struct corerouter_peer *peer) {
+	errno = ENOSYS;
+	return -1;
+}
+
+void corerouter_splice_close(struct corerouter_session *cs) {
+}
+
+#endif
@@ -28,6 +28,7 @@ static struct uwsgi_option fastrouter_options[] = {
 	{"fastrouter", required_argument, 0, "run the fastrouter on the specified port", uwsgi_opt_corerouter, &ufr, 0},
 	{"fastrouter-processes", required_argument, 0, "prefork the specified number of fastrouter processes", uwsgi_opt_set_int, &ufr.cr.processes, 0},
 	{"fastrouter-workers", required_argument, 0, "prefork the specified number of fastrouter processes", uwsgi_opt_set_int, &ufr.cr.processes, 0},
+	{"fastrouter-threads", required_argument, 0, "run the specified number of event loop threads in each fastrouter process", uwsgi_opt_set_int, &ufr.cr.threads, 0},
 	{"fastrouter-zerg", required_argument, 0, "attach the fastrouter to a zerg server", uwsgi_opt_corerouter_zerg, &ufr, 0},
 	{"fastrouter-use-cache", optional_argument, 0, "use uWSGI cache as hostname->server mapper for the fastrouter", uwsgi_opt_set_str, &ufr.cr.use_cache, 0},
 
@@ -61,6 +62,9 @@ static struct uwsgi_option fastrouter_options[] = {
 	{"fastrouter-resubscribe-bind", required_argument, 0, "bind to the specified address when re-subscribing", uwsgi_opt_set_str, &ufr.cr.resubscribe_bind, 0},
 
 	{"fastrouter-buffer-size", required_argument, 0, "set internal buffer size (default: page size)", uwsgi_opt_set_64bit, &ufr.cr.buffer_size, 0},
+#ifdef __linux__
+	{"fastrouter-splice", no_argument, 0, "relay request and response bodies with splice() (zero-copy)", uwsgi_opt_true, &ufr.cr.splice, 0},
+#endif
 	{"fastrouter-fallback-on-no-key", no_argument, 0, "move to fallback node even if a subscription key is not found", uwsgi_opt_true, &ufr.cr.fallback_on_no_key, 0},
 
 	{"fastrouter-force-key", required_argument, 0, "skip uwsgi parsing and directly set a key", uwsgi_opt_set_str, &ufr.force_key, 0},
@@ -222,6 +226,50 @@ static ssize_t fr_instance_read(struct corerouter_peer *peer) {
         return len;
 }
 
+// writing client body to the instance (zero-copy)
+static ssize_t fr_splice_instance_write_body(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_write(peer, "fr_splice_instance_write_body()");
+	// end on empty write
+	if (!len) return 0;
+
+	if (cr_splice_complete(peer)) {
+		cr_reset_hooks(peer);
+	}
+
+	return len;
+}
+
+// read client body (zero-copy)
+static ssize_t fr_splice_read_body(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_read(main_peer, 0, "fr_splice_read_body()");
+	if (!len) return 0;
+
+	cr_write_to_backend(main_peer->session->peers, fr_splice_instance_write_body);
+	return len;
+}
+
+// write to the client (zero-copy)
+static ssize_t fr_splice_write(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_write(main_peer, "fr_splice_write()");
+	// end on empty write
+	if (!len) return 0;
+
+	if (cr_splice_complete(main_peer)) {
+		cr_reset_hooks(main_peer);
+	}
+
+	return len;
+}
+
+// data from instance (zero-copy)
+static ssize_t fr_splice_instance_read(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_read(peer, 0, "fr_splice_instance_read()");
+	if (!len) return 0;
+
+	cr_write_to_main(peer, fr_splice_write);
+	return len;
+}
+
 static ssize_t fr_instance_sendfile(struct corerouter_peer *peer) {
 	struct fastrouter_session *fr = (struct fastrouter_session *) peer->session;
 	ssize_t len = uwsgi_sendfile_do(peer->fd, peer->session->main_peer->buffering_fd, fr->buffered, fr->content_length - fr->buffered);
@@ -251,7 +299,7 @@ static ssize_t fr_instance_send_request(struct corerouter_peer *peer) {
                 peer->out->pos = 0;
 		if (!peer->session->main_peer->is_buffering) {
 			// start waiting for body
-			peer->session->main_peer->last_hook_read = fr_read_body;
+			peer->session->main_peer->last_hook_read = ufr.cr.splice ? fr_splice_read_body : fr_read_body;
                 	cr_reset_hooks(peer);
 		}
 		else {
@@ -354,7 +402,7 @@ static ssize_t fr_recv_uwsgi_vars(struct corerouter_peer *main_peer) {
 		struct uwsgi_corerouter *ucr = main_peer->session->corerouter;
 
 		new_peer = uwsgi_cr_peer_add(main_peer->session);
-		new_peer->last_hook_read = fr_instance_read;
+		new_peer->last_hook_read = ufr.cr.splice ? fr_splice_instance_read : fr_instance_read;
 
 		if (!ufr.force_key) {
 			// find the hostname
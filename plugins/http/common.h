@@ -10,6 +10,9 @@ extern struct uwsgi_server uwsgi;
 #define UWSGI_SPDY
 #endif
 #endif
+#ifdef TLSEXT_TYPE_application_layer_protocol_negotiation
+#define UWSGI_HTTP2_ALPN
+#endif
 #endif
 
 struct uwsgi_http {
@@ -51,8 +54,58 @@ struct uwsgi_http {
 
 	int proto_http;
 
+	int http2;
+	int http2_max_streams;
+
 }; 
 
+// an HPACK header field
+struct http2_hpack_field {
+	char *name;
+	size_t name_len;
+	char *value;
+	size_t value_len;
+};
+
+// an HTTP/2 stream (mapped to a backend peer)
+struct http2_stream {
+	uint32_t sid;
+	struct corerouter_peer *peer;
+	int64_t send_window;
+	// END_STREAM received from the client
+	int remote_closed;
+	// END_STREAM sent to the client
+	int local_closed;
+	// RST_STREAM received from the client
+	int reset;
+	// waiting for a WINDOW_UPDATE
+	int blocked;
+	// the request body is buffered until END_STREAM (no content-length)
+	struct uwsgi_buffer *body;
+	// the backend speaks http
+	int http;
+	// status to send if the backend did not answer
+	int error_status;
+	// declared body size (-1 if missing) and DATA received
+	int64_t content_length;
+	uint64_t data_received;
+	// dechunking of the backend response
+	int chunked;
+	int chunk_state;
+	size_t chunk_remains;
+	struct http2_stream *next;
+};
+
+// backend response framing states (used by the connections pool)
+#define HR_RESP_HEADERS		0
+#define HR_RESP_BODY		1
+#define HR_RESP_CHUNK_SIZE	2
+#define HR_RESP_CHUNK_EXT	3
+#define HR_RESP_CHUNK_DATA	4
+#define HR_RESP_CHUNK_CRLF	5
+#define HR_RESP_TRAILERS	6
+#define HR_RESP_DONE		7
+
 struct http_session {
 
         struct corerouter_session session;
@@ -90,6 +143,9 @@ struct http_session {
         char *ssl_cc;
         int force_https;
         struct uwsgi_buffer *force_ssl_buf;
+	// directions offloaded to kernel TLS (checked once the handshake is complete)
+	int ktls;
+	int ktls_checked;
 #endif
 
 #ifdef UWSGI_SPDY
@@ -145,6 +201,50 @@ struct http_session {
         uint16_t proxy_src_len;
         uint16_t proxy_src_port_len;
 
+	// backend connections pool
+	int backend_pool;
+	int resp_head;
+	int resp_state;
+	int resp_rnrn;
+	int resp_digits;
+	size_t resp_remains;
+	size_t resp_line;
+	struct uwsgi_buffer *resp_headers;
+	struct corerouter_peer *backend_done;
+	struct uwsgi_buffer *pool_request;
+	// the request can be sent again over a new connection
+	int idempotent;
+
+	// pipelined requests waiting for the current response
+	struct uwsgi_buffer *pipeline;
+
+	// HTTP/2
+	int h2;
+	int h2_goaway;
+	// the frame parser is running
+	int h2_parsing;
+	struct uwsgi_buffer *h2_out;
+	struct http2_stream *h2_streams;
+	int h2_streams_count;
+	uint32_t h2_last_sid;
+	// header block (HEADERS + CONTINUATION) being received
+	struct uwsgi_buffer *h2_hblock;
+	uint32_t h2_hblock_sid;
+	int h2_hblock_end_stream;
+	// HPACK decoder dynamic table (newest first)
+	struct http2_hpack_field *h2_dtable;
+	int h2_dtable_count;
+	size_t h2_dtable_size;
+	size_t h2_dtable_max;
+	// flow control and settings of the client
+	int64_t h2_send_window;
+	int64_t h2_initial_window;
+	uint32_t h2_max_frame;
+	// connection window to give back to the client
+	size_t h2_recv_pending;
+	// streams the client can still reset before being sent away (rapid reset)
+	int h2_reset_budget;
+
 };
 
 
@@ -195,3 +295,17 @@ void hr_session_close(struct corerouter_session *);
 ssize_t http_parse(struct corerouter_peer *);
 
 int http_response_parse(struct http_session *, struct uwsgi_buffer *, size_t);
+int hr_response_frame(struct http_session *, char *, size_t);
+int hr_instance_done(struct corerouter_peer *);
+
+void http_set_timeout(struct corerouter_peer *, int);
+
+int http2_preface(struct corerouter_peer *);
+ssize_t http2_parse(struct corerouter_peer *);
+ssize_t http2_instance_written(struct corerouter_peer *);
+ssize_t hr_instance_read_to_http2(struct corerouter_peer *);
+void http2_peer_closed(struct corerouter_peer *);
+void http2_session_close(struct http_session *);
+#ifdef UWSGI_HTTP2_ALPN
+int http2_alpn_select(SSL *, const unsigned char **, unsigned char *, const unsigned char *, unsigned int, void *);
+#endif
@@ -20,6 +20,7 @@ struct uwsgi_option http_options[] = {
 #endif
 	{"http-processes", required_argument, 0, "set the number of http processes to spawn", uwsgi_opt_set_int, &uhttp.cr.processes, 0},
 	{"http-workers", required_argument, 0, "set the number of http processes to spawn", uwsgi_opt_set_int, &uhttp.cr.processes, 0},
+	{"http-threads", required_argument, 0, "run the specified number of event loop threads in each http process", uwsgi_opt_set_int, &uhttp.cr.threads, 0},
 	{"http-var", required_argument, 0, "add a key=value item to the generated uwsgi packet", uwsgi_opt_add_string_list, &uhttp.http_vars, 0},
 	{"http-to", required_argument, 0, "forward requests to the specified node (you can specify it multiple time for lb)", uwsgi_opt_add_string_list, &uhttp.cr.static_nodes, 0 },
 	{"http-zerg", required_argument, 0, "attach the http router to a zerg server", uwsgi_opt_corerouter_zerg, &uhttp, 0 },
@@ -34,7 +35,7 @@ struct uwsgi_option http_options[] = {
 	{"http-subscription-fallback-key", required_argument, 0, "key to use for fallback http handler", uwsgi_opt_corerouter_fallback_key, &uhttp.cr, 0},
 	{"http-timeout", required_argument, 0, "set internal http socket timeout (default: 60 seconds)", uwsgi_opt_set_int, &uhttp.cr.socket_timeout, 0},
 	{"http-manage-expect", optional_argument, 0, "manage the Expect HTTP request header (optionally checking for Content-Length)", uwsgi_opt_set_64bit, &uhttp.manage_expect, 0},
-	{"http-keepalive", optional_argument, 0, "HTTP 1.1 keepalive support (non-pipelined) requests", uwsgi_opt_set_int, &uhttp.keepalive, 0},
+	{"http-keepalive", optional_argument, 0, "HTTP 1.1 keepalive support (pipelined requests are served in order)", uwsgi_opt_set_int, &uhttp.keepalive, 0},
 	{"http-auto-chunked", no_argument, 0, "automatically transform output to chunked encoding during HTTP 1.1 keepalive (if needed)", uwsgi_opt_true, &uhttp.auto_chunked, 0},
 #ifdef UWSGI_ZLIB
 	{"http-auto-gzip", no_argument, 0, "automatically gzip content if uWSGI-Encoding header is set to gzip, but content size (Content-Length/Transfer-Encoding) and Content-Encoding are not specified", uwsgi_opt_true, &uhttp.auto_gzip, 0},
@@ -60,6 +61,9 @@ struct uwsgi_option http_options[] = {
 	{"http-gid", required_argument, 0, "drop http router privileges to the specified gid", uwsgi_opt_gid, &uhttp.cr.gid, 0 },
 	{"http-resubscribe", required_argument, 0, "forward subscriptions to the specified subscription server", uwsgi_opt_add_string_list, &uhttp.cr.resubscribe, 0},
 	{"http-buffer-size", required_argument, 0, "set internal buffer size (default: page size)", uwsgi_opt_set_64bit, &uhttp.cr.buffer_size, 0},
+#ifdef __linux__
+	{"http-splice", no_argument, 0, "relay request and response bodies with splice() (zero-copy) when they do not need to be parsed or transformed", uwsgi_opt_true, &uhttp.cr.splice, 0},
+#endif
 
 	{"http-server-name-as-http-host", required_argument, 0, "force SERVER_NAME to HTTP_HOST", uwsgi_opt_true, &uhttp.server_name_as_http_host, 0},
 	{"http-headers-timeout", required_argument, 0, "set internal http socket timeout for headers", uwsgi_opt_set_int, &uhttp.headers_timeout, 0},
@@ -69,9 +73,14 @@ struct uwsgi_option http_options[] = {
 	{"http-enable-proxy-protocol", optional_argument, 0, "manage PROXY protocol requests", uwsgi_opt_true, &uhttp.enable_proxy_protocol, 0},
 
 	{"http-backend-http", no_argument, 0, "use plain http protocol instead of uwsgi for backend nodes", uwsgi_opt_true, &uhttp.proto_http, 0},
+	{"http-backend-pool", required_argument, 0, "keep up to N idle connections per http backend node", uwsgi_opt_set_int, &uhttp.cr.pool_max_idle, 0},
+	{"http-backend-pool-ttl", required_argument, 0, "close idle http backend connections after the specified number of seconds (default: 30)", uwsgi_opt_set_int, &uhttp.cr.pool_ttl, 0},
 
 	{"http-manage-rtsp", no_argument, 0, "manage RTSP sessions", uwsgi_opt_true, &uhttp.manage_rtsp, 0},
 
+	{"http2", no_argument, 0, "enable HTTP/2 (h2 via ALPN on https sockets and h2c with prior knowledge)", uwsgi_opt_true, &uhttp.http2, 0},
+	{"http2-max-streams", required_argument, 0, "set the maximum number of concurrent HTTP/2 streams per connection (default: 128)", uwsgi_opt_set_int, &uhttp.http2_max_streams, 0},
+
 	{"http-post-buffering", required_argument, 0, "enable HTTP fastrouter post buffering", uwsgi_opt_set_64bit, &uhttp.cr.post_buffering, 0},
         {"http-post-buffering-dir", required_argument, 0, "put fastrouter buffered files to the specified directory (noop, use TMPDIR env)", uwsgi_opt_set_str, &uhttp.cr.pb_base_dir, 0},
 
@@ -110,7 +119,7 @@ static int rebuild_key_for_mountpoint(struct http_session *hr, struct corerouter
 	return 0;
 }
 
-static void http_set_timeout(struct corerouter_peer *peer, int timeout) {
+void http_set_timeout(struct corerouter_peer *peer, int timeout) {
 	if (peer->current_timeout == timeout) return;
 	peer->current_timeout = timeout;
 	peer->timeout = corerouter_reset_timeout(peer->session->corerouter, peer);
@@ -440,6 +449,13 @@ static int http_headers_parse_first_round(struct corerouter_peer *peer) {
 	return skip;
 }
 
+// RFC 9110 9.2.2
+static int http_method_is_idempotent(char *method, size_t len) {
+	return !uwsgi_strncmp(method, len, "GET", 3) || !uwsgi_strncmp(method, len, "HEAD", 4)
+		|| !uwsgi_strncmp(method, len, "OPTIONS", 7) || !uwsgi_strncmp(method, len, "TRACE", 5)
+		|| !uwsgi_strncmp(method, len, "PUT", 3) || !uwsgi_strncmp(method, len, "DELETE", 6);
+}
+
 static int http_headers_parse_dumb(struct corerouter_peer *peer, int skip) {
 	struct http_session *hr = (struct http_session *) peer->session;
 	char *ptr = peer->session->main_peer->in->buf;
@@ -465,6 +481,11 @@ static int http_headers_parse_dumb(struct corerouter_peer *peer, int skip) {
                         if (uhttp.manage_source && !uwsgi_strncmp(base, ptr - base, "SOURCE", 6)) {
                                 hr->raw_body = 1;
                         }
+			// HEAD responses have no body
+			if (!uwsgi_strncmp(base, ptr - base, "HEAD", 4)) {
+				hr->resp_head = 1;
+			}
+			hr->idempotent = http_method_is_idempotent(base, ptr - base);
                         ptr++;
                         found = 1;
                         break;
@@ -602,6 +623,7 @@ int http_headers_parse(struct corerouter_peer *peer, int skip) {
 	while (ptr < watermark) {
 		if (*ptr == ' ') {
 			if (uwsgi_buffer_append_keyval(out, "REQUEST_METHOD", 14, base, ptr - base)) return -1;
+			hr->idempotent = http_method_is_idempotent(base, ptr - base);
 			// on SOURCE METHOD, force raw body
 			if (uhttp.manage_source && !uwsgi_strncmp(base, ptr - base, "SOURCE", 6)) {
 				hr->raw_body = 1;
@@ -886,7 +908,16 @@ ssize_t hr_instance_write(struct corerouter_peer *peer) {
         if (cr_write_complete(peer)) {
 		// destroy the buffer used for the uwsgi packet
 		if (peer->out_need_free == 1) {
-			uwsgi_buffer_destroy(peer->out);
+			struct http_session *hr = (struct http_session *) peer->session;
+			// a pooled connection could have been closed by the backend in the mean time,
+			// keep the whole request for sending it again over a new one (only if the backend
+			// could safely receive it twice, it could have been processed before closing)
+			if (peer->pooled && hr->content_length == 0 && hr->idempotent) {
+				hr->pool_request = peer->out;
+			}
+			else {
+				uwsgi_buffer_destroy(peer->out);
+			}
 			peer->out_need_free = 0;
 			peer->out = NULL;
 			// reset the main_peer input stream
@@ -897,6 +928,9 @@ ssize_t hr_instance_write(struct corerouter_peer *peer) {
 			peer->out->pos = 0;
 		}
                 cr_reset_hooks(peer);
+		if (((struct http_session *) peer->session)->h2) {
+			return http2_instance_written(peer);
+		}
 #ifdef UWSGI_SPDY
 		struct http_session *hr = (struct http_session *) peer->session;
 		if (hr->spdy) {
@@ -939,7 +973,13 @@ ssize_t hr_write(struct corerouter_peer *main_peer) {
 			main_peer->session->connect_peer_after_write = NULL;
 			return len;
 		}
+		int ret = hr_instance_done(main_peer);
+		if (ret <= 0) return ret;
+		if (ret > 1) return len;
                 cr_reset_hooks(main_peer);
+		if (((struct http_session *) main_peer->session)->h2) {
+			return http2_parse(main_peer);
+		}
         }
 
         return len;
@@ -998,26 +1038,160 @@ int hr_check_response_keepalive(struct corerouter_peer *peer) {
 
 }
 
+// the backend response is over, prepare the session for the next request (if keepalive is allowed)
+static void hr_session_rearm(struct http_session *hr) {
+	// disable keepalive on unread body
+	if (hr->content_length) hr->session.can_keepalive = 0;
+	if (hr->session.can_keepalive) {
+		hr->session.main_peer->disabled = 0;
+		hr->rnrn = 0;
+#ifdef UWSGI_ZLIB
+		hr->can_gzip = 0;
+		hr->has_gzip = 0;
+#endif
+		if (uhttp.keepalive > 1) {
+			http_set_timeout(hr->session.main_peer, uhttp.keepalive);
+		}
+	}
+}
+
+// store pipelined requests until the current response is sent
+static int hr_pipeline_push(struct http_session *hr, char *buf, size_t len) {
+	if (!hr->pipeline) {
+		hr->pipeline = uwsgi_buffer_new(uwsgi.page_size);
+		hr->pipeline->limit = UMAX16;
+	}
+	return uwsgi_buffer_append(hr->pipeline, buf, len);
+}
+
+// parse the next pipelined request (if any), returns 2 if a new backend peer has been created
+static int hr_pipeline_next(struct corerouter_peer *main_peer) {
+	struct http_session *hr = (struct http_session *) main_peer->session;
+	if (!hr->session.can_keepalive || !hr->pipeline || !hr->pipeline->pos) return 1;
+	main_peer->in->pos = 0;
+	if (uwsgi_buffer_append(main_peer->in, hr->pipeline->buf, hr->pipeline->pos)) return -1;
+	hr->pipeline->pos = 0;
+	if (http_parse(main_peer) < 0) return -1;
+	if (hr->rnrn == 4) return 2;
+	// incomplete request, wait for more data from the client
+	return 1;
+}
+
+/*
+	called whenever a response chunk has been fully sent to the client:
+	release the backend peer of a framed response and dispatch the next pipelined request.
+
+	returns 0 to close the session, 1 to restore the default hooks, 2 if a new request has been dispatched
+*/
+int hr_instance_done(struct corerouter_peer *main_peer) {
+	struct http_session *hr = (struct http_session *) main_peer->session;
+	struct corerouter_peer *peer = hr->backend_done;
+	if (peer) {
+		hr->backend_done = NULL;
+		// the peer could have been already destroyed (timeout)
+		if (peer != main_peer->session->peers) return 1;
+		hr_session_rearm(hr);
+		// the connection will be given back to the pool on session close
+		if (!hr->session.can_keepalive) return 0;
+		corerouter_close_peer(main_peer->session->corerouter, peer);
+	}
+	// the response is still in progress
+	else if (main_peer->session->peers || main_peer->disabled) {
+		return 1;
+	}
+	return hr_pipeline_next(main_peer);
+}
+
+// the pooled connection has been closed by the backend before sending a response, retry with a new one
+static ssize_t hr_instance_reconnect(struct corerouter_peer *peer) {
+	struct http_session *hr = (struct http_session *) peer->session;
+	if (uwsgi_cr_set_hooks(peer, NULL, NULL)) return -1;
+	close(peer->fd);
+	peer->session->corerouter->cr_table[peer->fd] = NULL;
+	peer->fd = -1;
+	peer->pooled = 0;
+	peer->can_pool = 0;
+	peer->in->pos = 0;
+	peer->out = hr->pool_request;
+	peer->out_need_free = 1;
+	peer->out_pos = 0;
+	hr->pool_request = NULL;
+	hr->resp_state = HR_RESP_HEADERS;
+	hr->resp_rnrn = 0;
+	hr->resp_headers->pos = 0;
+	http_set_timeout(peer, uhttp.connect_timeout);
+	cr_connect(peer, hr_instance_connected);
+	return 1;
+}
+
+// write to the client (zero-copy)
+static ssize_t hr_splice_write(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_write(main_peer, "hr_splice_write()");
+	// end on empty write
+	if (!len) return 0;
+
+	if (cr_splice_complete(main_peer)) {
+		cr_reset_hooks(main_peer);
+	}
+
+	return len;
+}
+
+// data from instance (zero-copy)
+static ssize_t hr_splice_instance_read(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_read(peer, 0, "hr_splice_instance_read()");
+	if (!len) return 0;
+
+	cr_write_to_main(peer, hr_splice_write);
+	return len;
+}
+
+// the response can be relayed as-is only on plain (or kernel TLS) connections not parsing (keepalive, pooling) or transforming (gzip, chunked) it
+static int hr_can_splice_response(struct http_session *hr, struct corerouter_peer *peer) {
+	if (!uhttp.cr.splice || peer->in->pos) return 0;
+	if (hr->func_write != hr_write) {
+#ifdef UWSGI_SSL
+		// the kernel encrypts whatever is written to the socket
+		if (hr->func_write != hr_ssl_write || !(hr->ktls & UWSGI_SSL_KTLS_TX)) return 0;
+#else
+		return 0;
+#endif
+	}
+	if (hr->session.can_keepalive || hr->backend_pool || hr->pool_request || hr->force_chunked) return 0;
+#ifdef UWSGI_ZLIB
+	if (hr->can_gzip) return 0;
+#endif
+	return 1;
+}
+
 // data from instance
 ssize_t hr_instance_read(struct corerouter_peer *peer) {
+	struct http_session *hr = (struct http_session *) peer->session;
+	if (hr_can_splice_response(hr, peer)) return hr_splice_instance_read(peer);
         peer->in->limit = UMAX16;
 	if (uwsgi_buffer_ensure(peer->in, uwsgi.page_size)) return -1;
-	struct http_session *hr = (struct http_session *) peer->session;
-        ssize_t len = cr_read(peer, "hr_instance_read()");
+        ssize_t len = read(peer->fd, peer->in->buf + peer->in->pos, peer->in->len - peer->in->pos);
+	if (len < 0) {
+		cr_try_again;
+		if (errno == ECONNRESET && hr->pool_request) return hr_instance_reconnect(peer);
+		uwsgi_cr_error(peer, "hr_instance_read()");
+		return -1;
+	}
+	if (peer->un) peer->un->tx += len;
+	peer->in->pos += len;
+
+	if (hr->pool_request) {
+		if (!len) return hr_instance_reconnect(peer);
+		// the backend is answering, no more retries
+		uwsgi_buffer_destroy(hr->pool_request);
+		hr->pool_request = NULL;
+		peer->pooled = 0;
+	}
+
         if (!len) {
-		// disable keepalive on unread body
-		if (hr->content_length) hr->session.can_keepalive = 0;
-		if (hr->session.can_keepalive) {
-			peer->session->main_peer->disabled = 0;
-			hr->rnrn = 0;
-#ifdef UWSGI_ZLIB
-			hr->can_gzip = 0;
-			hr->has_gzip = 0;
-#endif
-			if (uhttp.keepalive > 1) {
-				http_set_timeout(peer->session->main_peer, uhttp.keepalive);
-			}
-		}
+		// the backend closed the connection before the end of the (framed) response
+		if (hr->backend_pool) hr->session.can_keepalive = 0;
+		hr_session_rearm(hr);
 #ifdef UWSGI_ZLIB
 		if (hr->force_chunked || hr->force_gzip) {
 #else
@@ -1051,12 +1225,40 @@ ssize_t hr_instance_read(struct corerouter_peer *peer) {
 				hr->session.wait_full_write = 1;
 			}
 		}
+		// the response is over, the next pipelined request can be dispatched
+		else if (hr->session.can_keepalive && hr->pipeline && hr->pipeline->pos) {
+			struct corerouter_peer *main_peer = peer->session->main_peer;
+			corerouter_close_peer(peer->session->corerouter, peer);
+			// the peer has been destroyed, do not return <= 0 from now on
+			int ret = hr_instance_done(main_peer);
+			if (ret <= 0) {
+				hr->session.can_keepalive = 0;
+				corerouter_close_peer(main_peer->session->corerouter, main_peer);
+			}
+			else if (ret == 1) {
+				cr_reset_hooks(main_peer);
+			}
+			return 1;
+		}
 		else {
 			cr_reset_hooks(peer);
 		}
 		return 0;
 	}
 
+	// check for the end of the response (framing works on the raw backend stream)
+	if (hr->backend_pool) {
+		int ret = hr_response_frame(hr, peer->in->buf + (peer->in->pos - len), len);
+		if (ret != 0) {
+			hr->backend_pool = 0;
+			// the response is complete, release the backend connection as soon as it is sent to the client
+			if (ret > 0 && hr->content_length == 0 && !peer->hook_write) {
+				peer->reusable = 1;
+				hr->backend_done = peer;
+			}
+		}
+	}
+
 	// need to parse response headers
 #ifdef UWSGI_ZLIB
 	if (hr->session.can_keepalive || hr->can_gzip) {
@@ -1110,6 +1312,20 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
 	struct corerouter_session *cs = main_peer->session;
 	struct http_session *hr = (struct http_session *) cs;
 
+	if (hr->h2) return http2_parse(main_peer);
+
+	// check for the HTTP/2 client preface
+	if (uhttp.http2 && hr->rnrn != 4 && !cs->peers) {
+		int ret = http2_preface(main_peer);
+		// wait for the whole preface
+		if (ret == 0) return 1;
+		if (ret > 0) {
+			hr->h2 = 1;
+			http_set_timeout(main_peer, uhttp.cr.socket_timeout);
+			return http2_parse(main_peer);
+		}
+	}
+
 	// is it http body ?
 	if (hr->rnrn == 4) {
 		// something bad happened in keepalive mode...
@@ -1123,10 +1339,14 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
 		else {
 			if (hr->content_length) {
 				if (main_peer->in->pos > hr->content_length) {
+					// pipelined request, keep it for later
+					if (hr->session.can_keepalive) {
+						if (hr_pipeline_push(hr, main_peer->in->buf + hr->content_length, main_peer->in->pos - hr->content_length)) return -1;
+						main_peer->disabled = 1;
+						if (uwsgi_cr_set_hooks(main_peer, NULL, NULL)) return -1;
+					}
 					main_peer->in->pos = hr->content_length;
 					hr->content_length = 0;
-					// on pipeline attempt, disable keepalive
-					hr->session.can_keepalive = 0;
 				}		
 				else {
 					hr->content_length -= main_peer->in->pos;
@@ -1179,6 +1399,12 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
                 	struct corerouter_peer *new_peer = uwsgi_cr_peer_add(main_peer->session);
 			// default hook
 			new_peer->last_hook_read = hr_instance_read;
+
+			hr->resp_head = 0;
+			if (hr->pool_request) {
+				uwsgi_buffer_destroy(hr->pool_request);
+				hr->pool_request = NULL;
+			}
 		
 			int skip = http_headers_parse_first_round(new_peer);
 			if (skip < 0) return -1;
@@ -1225,11 +1451,20 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
 
 			if (hr->remains > 0) {
 				if (hr->content_length < hr->remains) {
-					if (hr->content_length > 0 || !hr->raw_body)
+					if (hr->content_length > 0 || !hr->raw_body) {
+						// pipelined requests, they will be parsed after the response
+						if (hr->session.can_keepalive && !hr->raw_body) {
+							if (hr_pipeline_push(hr, main_peer->in->buf + hr->headers_size + 1 + hr->content_length, hr->remains - hr->content_length)) return -1;
+						}
+						else {
+							hr->session.can_keepalive = 0;
+						}
 						hr->remains = hr->content_length;
+					}
+					else {
+						hr->session.can_keepalive = 0;
+					}
 					hr->content_length = 0;
-					// we need to avoid problems with pipelined requests
-					hr->session.can_keepalive = 0;
 				}
 				else {
 					hr->content_length -= hr->remains;
@@ -1256,6 +1491,27 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
 				if (uwsgi_cr_set_hooks(main_peer, NULL, NULL)) return -1;
 			}
 
+			// only plain http backends can reuse connections
+			if (ucr->pool_max_idle && (new_peer->proto == 'h' || uhttp.proto_http) && !hr->raw_body
+#ifdef UWSGI_SPDY
+				&& !hr->spdy
+#endif
+				) {
+				new_peer->can_pool = 1;
+				hr->backend_pool = 1;
+				hr->backend_done = NULL;
+				hr->resp_state = HR_RESP_HEADERS;
+				hr->resp_rnrn = 0;
+				if (!hr->resp_headers) {
+					hr->resp_headers = uwsgi_buffer_new(uwsgi.page_size);
+					hr->resp_headers->limit = UMAX16;
+				}
+				hr->resp_headers->pos = 0;
+			}
+			else {
+				hr->backend_pool = 0;
+			}
+
 			if (hr->send_expect_100) {
 				if (hr_manage_expect_continue(new_peer)) return -1;	
 				break;
@@ -1279,8 +1535,45 @@ ssize_t http_parse(struct corerouter_peer *main_peer) {
 	return 1;
 }
 
+// writing client body to the instance (zero-copy)
+static ssize_t hr_splice_instance_write(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_write(peer, "hr_splice_instance_write()");
+	// end on empty write
+	if (!len) { peer->session->can_keepalive = 0; return 0; }
+
+	if (cr_splice_complete(peer)) {
+		cr_reset_hooks(peer);
+	}
+
+	return len;
+}
+
+// read client body (zero-copy), never past content-length as the next pipelined request could follow
+static ssize_t hr_splice_read(struct corerouter_peer *main_peer) {
+	struct http_session *hr = (struct http_session *) main_peer->session;
+	ssize_t len = cr_splice_read(main_peer, hr->content_length, "hr_splice_read()");
+	if (!len) return 0;
+
+	if (hr->content_length) {
+		hr->content_length -= len;
+		if (hr->content_length == 0) {
+			main_peer->disabled = 1;
+			// stop reading from the client
+			if (uwsgi_cr_set_hooks(main_peer, NULL, NULL)) return -1;
+		}
+	}
+
+	cr_write_to_backend(main_peer->session->peers, hr_splice_instance_write);
+	return len;
+}
+
 // read from client
 ssize_t hr_read(struct corerouter_peer *main_peer) {
+	struct http_session *hr = (struct http_session *) main_peer->session;
+	// the request body (or the raw stream) can be relayed as-is
+	if (uhttp.cr.splice && hr->rnrn == 4 && !hr->h2 && main_peer->session->peers && main_peer->in->pos == 0 && (hr->content_length || hr->raw_body)) {
+		return hr_splice_read(main_peer);
+	}
         // try to always leave 4k available (this will dinamically increase the buffer...)
         if (uwsgi_buffer_ensure(main_peer->in, uwsgi.page_size)) return -1;
         ssize_t len = cr_read(main_peer, "hr_read()");
@@ -1301,6 +1594,22 @@ void hr_session_close(struct corerouter_session *cs) {
 		uwsgi_buffer_destroy(hr->last_chunked);
 	}
 
+	if (hr->resp_headers) {
+		uwsgi_buffer_destroy(hr->resp_headers);
+	}
+
+	if (hr->pool_request) {
+		uwsgi_buffer_destroy(hr->pool_request);
+	}
+
+	if (hr->pipeline) {
+		uwsgi_buffer_destroy(hr->pipeline);
+	}
+
+	if (hr->h2) {
+		http2_session_close(hr);
+	}
+
 #ifdef UWSGI_ZLIB
 	if (hr->z.next_in) {
 		deflateEnd(&hr->z);
@@ -1427,6 +1736,7 @@ int http_init() {
 
 	uhttp.cr.session_size = sizeof(struct http_session);
 	uhttp.cr.alloc_session = http_alloc_session;
+	if (!uhttp.http2_max_streams) uhttp.http2_max_streams = 128;
 	if (uhttp.cr.has_sockets && !uwsgi_corerouter_has_backends(&uhttp.cr)) {
 		if (!uwsgi.sockets) {
 			uwsgi_new_socket(uwsgi_concat2("127.0.0.1:0", ""));
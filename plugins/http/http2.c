@@ -0,0 +1,1542 @@
+/*
+
+   uWSGI HTTP/2 router
+
+   HTTP/2 connections are detected by the client preface ("h2c" with prior knowledge on plain sockets,
+   "h2" negotiated via ALPN on https ones). Every stream is mapped to a backend peer of the session
+   (peer->sid is the stream id): the request is translated to a uwsgi packet (or an HTTP/1.1 request
+   for http backends) and the HTTP/1.x response of the backend is translated back to HEADERS/DATA frames.
+
+   All of the frames to the client are queued in hr->h2_out. As the corerouter allows a single write
+   at a time, the frame parser suspends itself whenever a write to a backend is started and it is resumed
+   as soon as the write is complete.
+
+*/
+
+#include "common.h"
+
+extern struct uwsgi_http uhttp;
+
+#include "http2.h"
+
+#define HTTP2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define HTTP2_PREFACE_LEN 24
+
+#define HTTP2_DATA 0x0
+#define HTTP2_HEADERS 0x1
+#define HTTP2_PRIORITY 0x2
+#define HTTP2_RST_STREAM 0x3
+#define HTTP2_SETTINGS 0x4
+#define HTTP2_PUSH_PROMISE 0x5
+#define HTTP2_PING 0x6
+#define HTTP2_GOAWAY 0x7
+#define HTTP2_WINDOW_UPDATE 0x8
+#define HTTP2_CONTINUATION 0x9
+
+#define HTTP2_FLAG_END_STREAM 0x1
+#define HTTP2_FLAG_ACK 0x1
+#define HTTP2_FLAG_END_HEADERS 0x4
+#define HTTP2_FLAG_PADDED 0x8
+#define HTTP2_FLAG_PRIORITY 0x20
+
+#define HTTP2_NO_ERROR 0x0
+#define HTTP2_PROTOCOL_ERROR 0x1
+#define HTTP2_INTERNAL_ERROR 0x2
+#define HTTP2_FLOW_CONTROL_ERROR 0x3
+#define HTTP2_FRAME_SIZE_ERROR 0x6
+#define HTTP2_REFUSED_STREAM 0x7
+#define HTTP2_COMPRESSION_ERROR 0x9
+#define HTTP2_ENHANCE_YOUR_CALM 0xb
+
+#define HTTP2_SETTINGS_HEADER_TABLE_SIZE 0x1
+#define HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS 0x3
+#define HTTP2_SETTINGS_INITIAL_WINDOW_SIZE 0x4
+#define HTTP2_SETTINGS_MAX_FRAME_SIZE 0x5
+#define HTTP2_SETTINGS_MAX_HEADER_LIST_SIZE 0x6
+
+#define HTTP2_DEFAULT_FRAME_SIZE 16384
+#define HTTP2_DEFAULT_WINDOW 65535
+#define HTTP2_MAX_WINDOW 0x7fffffff
+#define HTTP2_HEADER_TABLE_SIZE 4096
+// decoded header lists (name + value + 32 bytes for each field) bigger than this are answered with a 431
+#define HTTP2_MAX_HEADER_LIST UMAX16
+// request bodies without content-length are buffered up to this size
+#define HTTP2_MAX_BODY (1024 * 1024)
+// every stream reset by the client spends the budget, every completed one gives it back
+#define HTTP2_RESET_BUDGET 256
+
+// frame parser results
+#define HTTP2_CONTINUE 0
+#define HTTP2_SUSPEND 1
+#define HTTP2_GOAWAY_SENT 2
+#define HTTP2_CLOSE 3
+
+// response dechunker states
+#define HTTP2_CHUNK_SIZE 0
+#define HTTP2_CHUNK_EXT 1
+#define HTTP2_CHUNK_DATA 2
+#define HTTP2_CHUNK_CRLF 3
+#define HTTP2_CHUNK_TRAILER 4
+
+static int16_t http2_huffman_tree[512][2];
+static pthread_once_t http2_huffman_once = PTHREAD_ONCE_INIT;
+
+static uint32_t http2_u32(uint8_t *buf) {
+	return (buf[0] << 24) | (buf[1] << 16) | (buf[2] << 8) | buf[3];
+}
+
+static int http2_frame(struct uwsgi_buffer *ub, uint32_t len, uint8_t type, uint8_t flags, uint32_t sid) {
+	if (uwsgi_buffer_u24be(ub, len)) return -1;
+	if (uwsgi_buffer_u8(ub, type)) return -1;
+	if (uwsgi_buffer_u8(ub, flags)) return -1;
+	return uwsgi_buffer_u32be(ub, sid & HTTP2_MAX_WINDOW);
+}
+
+static int http2_rst_stream(struct http_session *hr, uint32_t sid, uint32_t code) {
+	if (http2_frame(hr->h2_out, 4, HTTP2_RST_STREAM, 0, sid)) return -1;
+	return uwsgi_buffer_u32be(hr->h2_out, code);
+}
+
+static int http2_window_update(struct http_session *hr, uint32_t sid, uint32_t increment) {
+	if (http2_frame(hr->h2_out, 4, HTTP2_WINDOW_UPDATE, 0, sid)) return -1;
+	return uwsgi_buffer_u32be(hr->h2_out, increment);
+}
+
+// queue a GOAWAY, the connection will be closed after sending it
+static int http2_goaway(struct http_session *hr, uint32_t code) {
+	if (http2_frame(hr->h2_out, 8, HTTP2_GOAWAY, 0, 0)) return -1;
+	if (uwsgi_buffer_u32be(hr->h2_out, hr->h2_last_sid)) return -1;
+	if (uwsgi_buffer_u32be(hr->h2_out, code)) return -1;
+	return HTTP2_GOAWAY_SENT;
+}
+
+/*
+	HPACK
+*/
+
+static void http2_huffman_init() {
+	int i, b;
+	int nodes = 1;
+	for(i=0;i<256;i++) {
+		int node = 0;
+		for(b=http2_huffman_bits[i]-1;b>=0;b--) {
+			int bit = (http2_huffman_codes[i] >> b) & 1;
+			if (b == 0) {
+				// leaves are stored as negative values
+				http2_huffman_tree[node][bit] = -(i+1);
+				break;
+			}
+			if (!http2_huffman_tree[node][bit]) {
+				http2_huffman_tree[node][bit] = nodes++;
+			}
+			node = http2_huffman_tree[node][bit];
+		}
+	}
+}
+
+static int http2_huffman_decode(uint8_t *buf, size_t len, struct uwsgi_buffer *ub) {
+	size_t i;
+	int node = 0;
+	int depth = 0;
+	int ones = 1;
+	for(i=0;i<len;i++) {
+		int b;
+		for(b=7;b>=0;b--) {
+			int bit = (buf[i] >> b) & 1;
+			int next = http2_huffman_tree[node][bit];
+			if (next < 0) {
+				if (uwsgi_buffer_u8(ub, (uint8_t) (-next-1))) return -1;
+				node = 0;
+				depth = 0;
+				ones = 1;
+				continue;
+			}
+			// EOS or invalid code
+			if (next == 0) return -1;
+			node = next;
+			depth++;
+			if (!bit) ones = 0;
+		}
+	}
+	// padding must be the (shorter than a byte) prefix of EOS
+	if (depth > 7 || !ones) return -1;
+	return 0;
+}
+
+static int http2_hpack_int(uint8_t **ptr, uint8_t *end, uint8_t prefix, uint64_t *value) {
+	uint8_t mask = (1 << prefix) - 1;
+	uint64_t v = **ptr & mask;
+	(*ptr)++;
+	if (v < mask) {
+		*value = v;
+		return 0;
+	}
+	int shift = 0;
+	while(*ptr < end) {
+		uint8_t b = **ptr;
+		(*ptr)++;
+		v += (uint64_t) (b & 0x7f) << shift;
+		if (!(b & 0x80)) {
+			*value = v;
+			return 0;
+		}
+		shift += 7;
+		if (shift > 28) return -1;
+	}
+	return -1;
+}
+
+static int http2_hpack_int_encode(struct uwsgi_buffer *ub, uint8_t first, uint8_t prefix, uint64_t value) {
+	uint8_t mask = (1 << prefix) - 1;
+	if (value < mask) return uwsgi_buffer_u8(ub, first | value);
+	if (uwsgi_buffer_u8(ub, first | mask)) return -1;
+	value -= mask;
+	while(value >= 128) {
+		if (uwsgi_buffer_u8(ub, (value & 0x7f) | 0x80)) return -1;
+		value >>= 7;
+	}
+	return uwsgi_buffer_u8(ub, value);
+}
+
+static int http2_hpack_string(uint8_t **ptr, uint8_t *end, struct uwsgi_buffer *ub, char **str, size_t *len) {
+	if (*ptr >= end) return -1;
+	int huffman = **ptr & 0x80;
+	uint64_t slen = 0;
+	if (http2_hpack_int(ptr, end, 7, &slen)) return -1;
+	if (slen > (uint64_t) (end - *ptr)) return -1;
+	if (huffman) {
+		ub->pos = 0;
+		if (http2_huffman_decode(*ptr, slen, ub)) return -1;
+		*str = ub->buf;
+		*len = ub->pos;
+	}
+	else {
+		*str = (char *) *ptr;
+		*len = slen;
+	}
+	*ptr += slen;
+	return 0;
+}
+
+static void http2_dtable_evict(struct http_session *hr, size_t max) {
+	while(hr->h2_dtable_count > 0 && hr->h2_dtable_size > max) {
+		struct http2_hpack_field *hf = &hr->h2_dtable[hr->h2_dtable_count-1];
+		hr->h2_dtable_size -= hf->name_len + hf->value_len + 32;
+		// the value is allocated in the same block of the name
+		free(hf->name);
+		hr->h2_dtable_count--;
+	}
+}
+
+static int http2_dtable_add(struct http_session *hr, char *name, size_t name_len, char *value, size_t value_len) {
+	size_t size = name_len + value_len + 32;
+	if (size > hr->h2_dtable_max) {
+		http2_dtable_evict(hr, 0);
+		return 0;
+	}
+	// copy before evicting, the name could reference an entry of the table
+	char *mem = uwsgi_malloc(name_len + value_len);
+	memcpy(mem, name, name_len);
+	memcpy(mem + name_len, value, value_len);
+	http2_dtable_evict(hr, hr->h2_dtable_max - size);
+	if (!hr->h2_dtable) {
+		hr->h2_dtable = uwsgi_calloc(sizeof(struct http2_hpack_field) * (HTTP2_HEADER_TABLE_SIZE / 32));
+	}
+	// the newest entry is the first one
+	memmove(&hr->h2_dtable[1], &hr->h2_dtable[0], sizeof(struct http2_hpack_field) * hr->h2_dtable_count);
+	hr->h2_dtable[0].name = mem;
+	hr->h2_dtable[0].name_len = name_len;
+	hr->h2_dtable[0].value = mem + name_len;
+	hr->h2_dtable[0].value_len = value_len;
+	hr->h2_dtable_count++;
+	hr->h2_dtable_size += size;
+	return 0;
+}
+
+static struct http2_hpack_field *http2_hpack_get(struct http_session *hr, uint64_t index) {
+	if (index == 0) return NULL;
+	if (index <= 61) return &http2_static_table[index];
+	index -= 62;
+	if (index >= (uint64_t) hr->h2_dtable_count) return NULL;
+	return &hr->h2_dtable[index];
+}
+
+/*
+	decode a header block, the fields are stored as uwsgi vars (u16le keysize, key, u16le valsize, val).
+
+	Once the list is bigger than HTTP2_MAX_HEADER_LIST the fields are no more stored, but the block is still decoded
+	for keeping the dynamic table in sync: 1 is returned in such a case.
+*/
+static int http2_hpack_decode(struct http_session *hr, uint8_t *ptr, size_t len, struct uwsgi_buffer *fields) {
+	uint8_t *end = ptr + len;
+	struct uwsgi_buffer *hn = uwsgi_buffer_new(64);
+	struct uwsgi_buffer *hv = uwsgi_buffer_new(256);
+	size_t list_size = 0;
+	int too_big = 0;
+	int ret = -1;
+	while(ptr < end) {
+		uint8_t b = *ptr;
+		uint64_t index = 0;
+		struct http2_hpack_field *hf = NULL;
+		char *name = NULL, *value = NULL;
+		size_t name_len = 0, value_len = 0;
+		// indexed field
+		if (b & 0x80) {
+			if (http2_hpack_int(&ptr, end, 7, &index)) goto end;
+			hf = http2_hpack_get(hr, index);
+			if (!hf) goto end;
+			list_size += hf->name_len + hf->value_len + 32;
+			if (list_size > HTTP2_MAX_HEADER_LIST) too_big = 1;
+			if (!too_big && uwsgi_buffer_append_keyval(fields, hf->name, hf->name_len, hf->value, hf->value_len)) goto end;
+			continue;
+		}
+		// dynamic table size update
+		if ((b & 0xe0) == 0x20) {
+			if (http2_hpack_int(&ptr, end, 5, &index)) goto end;
+			if (index > HTTP2_HEADER_TABLE_SIZE) goto end;
+			hr->h2_dtable_max = index;
+			http2_dtable_evict(hr, index);
+			continue;
+		}
+		// literal with incremental indexing, without indexing or never indexed
+		int indexing = (b & 0xc0) == 0x40;
+		if (http2_hpack_int(&ptr, end, indexing ? 6 : 4, &index)) goto end;
+		if (index) {
+			hf = http2_hpack_get(hr, index);
+			if (!hf) goto end;
+			name = hf->name;
+			name_len = hf->name_len;
+		}
+		else {
+			if (http2_hpack_string(&ptr, end, hn, &name, &name_len)) goto end;
+		}
+		if (http2_hpack_string(&ptr, end, hv, &value, &value_len)) goto end;
+		if (name_len > 0xffff || value_len > 0xffff) goto end;
+		list_size += name_len + value_len + 32;
+		if (list_size > HTTP2_MAX_HEADER_LIST) too_big = 1;
+		if (!too_big && uwsgi_buffer_append_keyval(fields, name, name_len, value, value_len)) goto end;
+		if (indexing) {
+			if (http2_dtable_add(hr, name, name_len, value, value_len)) goto end;
+		}
+	}
+	ret = too_big;
+end:
+	uwsgi_buffer_destroy(hn);
+	uwsgi_buffer_destroy(hv);
+	return ret;
+}
+
+static int http2_field_next(struct uwsgi_buffer *fields, size_t *pos, char **name, uint16_t *name_len, char **value, uint16_t *value_len) {
+	uint8_t *buf = (uint8_t *) fields->buf;
+	if (*pos + 4 > fields->pos) return 0;
+	*name_len = buf[*pos] | (buf[*pos + 1] << 8);
+	*name = fields->buf + *pos + 2;
+	*pos += 2 + *name_len;
+	*value_len = buf[*pos] | (buf[*pos + 1] << 8);
+	*value = fields->buf + *pos + 2;
+	*pos += 2 + *value_len;
+	return 1;
+}
+
+// :status is indexed when available in the static table
+static int http2_hpack_status(struct uwsgi_buffer *ub, char *status) {
+	int i;
+	for(i=8;i<=14;i++) {
+		if (!memcmp(http2_static_table[i].value, status, 3)) {
+			return uwsgi_buffer_u8(ub, 0x80 | i);
+		}
+	}
+	if (http2_hpack_int_encode(ub, 0x00, 4, 8)) return -1;
+	if (uwsgi_buffer_u8(ub, 3)) return -1;
+	return uwsgi_buffer_append(ub, status, 3);
+}
+
+// literal without indexing (the encoder does not use the dynamic table)
+static int http2_hpack_literal(struct uwsgi_buffer *ub, char *name, size_t name_len, char *value, size_t value_len) {
+	int i;
+	int index = 0;
+	for(i=15;i<=61;i++) {
+		if (!uwsgi_strncmp(name, name_len, http2_static_table[i].name, http2_static_table[i].name_len)) {
+			index = i;
+			break;
+		}
+	}
+	if (http2_hpack_int_encode(ub, 0x00, 4, index)) return -1;
+	if (!index) {
+		if (http2_hpack_int_encode(ub, 0x00, 7, name_len)) return -1;
+		if (uwsgi_buffer_append(ub, name, name_len)) return -1;
+	}
+	if (http2_hpack_int_encode(ub, 0x00, 7, value_len)) return -1;
+	return uwsgi_buffer_append(ub, value, value_len);
+}
+
+/*
+	streams
+*/
+
+static struct http2_stream *http2_stream_find(struct http_session *hr, uint32_t sid) {
+	struct http2_stream *stream = hr->h2_streams;
+	while(stream) {
+		if (stream->sid == sid) return stream;
+		stream = stream->next;
+	}
+	return NULL;
+}
+
+static struct http2_stream *http2_stream_remove(struct http_session *hr, struct corerouter_peer *peer) {
+	struct http2_stream *stream = hr->h2_streams, *prev = NULL;
+	while(stream) {
+		if (stream->peer == peer) {
+			if (prev) {
+				prev->next = stream->next;
+			}
+			else {
+				hr->h2_streams = stream->next;
+			}
+			hr->h2_streams_count--;
+			return stream;
+		}
+		prev = stream;
+		stream = stream->next;
+	}
+	return NULL;
+}
+
+static void http2_stream_free(struct http2_stream *stream) {
+	if (stream->body) {
+		uwsgi_buffer_destroy(stream->body);
+	}
+	free(stream);
+}
+
+// stream error, the backend peer is closed without answering
+static int http2_stream_reset(struct http_session *hr, struct http2_stream *stream, uint32_t code) {
+	if (http2_rst_stream(hr, stream->sid, code)) return -1;
+	stream->reset = 1;
+	corerouter_close_peer(hr->session.corerouter, stream->peer);
+	return HTTP2_CONTINUE;
+}
+
+// send the pending frames to the client (unless another write is in progress)
+static int http2_flush(struct http_session *hr) {
+	struct corerouter_peer *main_peer = hr->session.main_peer;
+	if (hr->h2_recv_pending) {
+		if (http2_window_update(hr, 0, hr->h2_recv_pending)) return -1;
+		hr->h2_recv_pending = 0;
+	}
+	if (!hr->h2_out->pos || main_peer->hook_write) return 0;
+	struct corerouter_peer *p = hr->session.peers;
+	while(p) {
+		if (p->hook_write) return 0;
+		p = p->next;
+	}
+	main_peer->out = hr->h2_out;
+	main_peer->out_pos = 0;
+	cr_write_to_main(main_peer, hr->func_write);
+	return 0;
+}
+
+// split a header block in HEADERS and CONTINUATION frames
+static int http2_send_headers(struct http_session *hr, uint32_t sid, struct uwsgi_buffer *hb, int end_stream) {
+	size_t sent = 0;
+	uint8_t type = HTTP2_HEADERS;
+	do {
+		size_t chunk = UMIN(hb->pos - sent, hr->h2_max_frame);
+		uint8_t flags = 0;
+		if (sent + chunk == hb->pos) flags |= HTTP2_FLAG_END_HEADERS;
+		if (type == HTTP2_HEADERS && end_stream) flags |= HTTP2_FLAG_END_STREAM;
+		if (http2_frame(hr->h2_out, chunk, type, flags, sid)) return -1;
+		if (uwsgi_buffer_append(hr->h2_out, hb->buf + sent, chunk)) return -1;
+		sent += chunk;
+		type = HTTP2_CONTINUATION;
+	} while(sent < hb->pos);
+	return 0;
+}
+
+static int http2_send_status(struct http_session *hr, uint32_t sid, int status) {
+	char buf[4];
+	snprintf(buf, 4, "%03d", status);
+	struct uwsgi_buffer *hb = uwsgi_buffer_new(32);
+	int ret = -1;
+	if (http2_hpack_status(hb, buf)) goto end;
+	if (http2_hpack_literal(hb, "content-length", 14, "0", 1)) goto end;
+	ret = http2_send_headers(hr, sid, hb, 1);
+end:
+	uwsgi_buffer_destroy(hb);
+	return ret;
+}
+
+// answer a request without opening a stream for it, the client is asked to stop sending the body
+static int http2_stream_refuse(struct http_session *hr, uint32_t sid, int status, uint32_t code, int end_stream) {
+	if (http2_send_status(hr, sid, status)) return -1;
+	if (!end_stream && http2_rst_stream(hr, sid, code)) return -1;
+	return HTTP2_CONTINUE;
+}
+
+// translate the HTTP/1.x response headers of the backend
+static int http2_response_headers(struct http_session *hr, struct http2_stream *stream, char *buf, size_t len) {
+	char *end = buf + len;
+	char *ptr = memchr(buf, ' ', len);
+	if (!ptr || end - ptr < 4) return -1;
+
+	struct uwsgi_buffer *hb = uwsgi_buffer_new(uwsgi.page_size);
+	int ret = -1;
+	if (http2_hpack_status(hb, ptr + 1)) goto end;
+
+	ptr = memchr(buf, '\n', len);
+	if (!ptr) goto end;
+	ptr++;
+	while(ptr < end) {
+		char *eol = memchr(ptr, '\n', end - ptr);
+		if (!eol) eol = end;
+		size_t line_len = eol - ptr;
+		if (line_len > 0 && ptr[line_len-1] == '\r') line_len--;
+		if (line_len == 0) break;
+		char *colon = memchr(ptr, ':', line_len);
+		if (!colon) goto next;
+		size_t name_len = colon - ptr;
+		size_t i;
+		// HTTP/2 header names are lowercase
+		for(i=0;i<name_len;i++) {
+			ptr[i] = tolower((int) ptr[i]);
+		}
+		char *value = colon + 1;
+		size_t value_len = line_len - (name_len + 1);
+		while(value_len > 0 && (*value == ' ' || *value == '\t')) {
+			value++;
+			value_len--;
+		}
+		// connection specific headers are not allowed
+		if (!uwsgi_strncmp(ptr, name_len, "transfer-encoding", 17)) {
+			if (uwsgi_contains_n(value, value_len, "chunked", 7)) {
+				stream->chunked = 1;
+			}
+			goto next;
+		}
+		if (!uwsgi_strncmp(ptr, name_len, "connection", 10) ||
+			!uwsgi_strncmp(ptr, name_len, "keep-alive", 10) ||
+			!uwsgi_strncmp(ptr, name_len, "proxy-connection", 16) ||
+			!uwsgi_strncmp(ptr, name_len, "upgrade", 7)) {
+			goto next;
+		}
+		if (http2_hpack_literal(hb, ptr, name_len, value, value_len)) goto end;
+next:
+		ptr = eol + 1;
+	}
+
+	ret = http2_send_headers(hr, stream->sid, hb, 0);
+end:
+	uwsgi_buffer_destroy(hb);
+	return ret;
+}
+
+// remove the chunked encoding (in place) from the response body, returns the new size
+static size_t http2_dechunk(struct http2_stream *stream, char *buf, size_t len) {
+	size_t i = 0, j = 0;
+	while(i < len) {
+		char c = buf[i];
+		switch(stream->chunk_state) {
+			case HTTP2_CHUNK_SIZE:
+				if (isxdigit((int) c)) {
+					stream->chunk_remains = (stream->chunk_remains * 16) + (isdigit((int) c) ? c - '0' : (tolower((int) c) - 'a') + 10);
+				}
+				else if (c == ';') {
+					stream->chunk_state = HTTP2_CHUNK_EXT;
+				}
+				else if (c == '\n') {
+					stream->chunk_state = stream->chunk_remains ? HTTP2_CHUNK_DATA : HTTP2_CHUNK_TRAILER;
+				}
+				i++;
+				break;
+			case HTTP2_CHUNK_EXT:
+				if (c == '\n') {
+					stream->chunk_state = stream->chunk_remains ? HTTP2_CHUNK_DATA : HTTP2_CHUNK_TRAILER;
+				}
+				i++;
+				break;
+			case HTTP2_CHUNK_DATA: {
+				size_t chunk = UMIN(len - i, stream->chunk_remains);
+				memmove(buf + j, buf + i, chunk);
+				i += chunk;
+				j += chunk;
+				stream->chunk_remains -= chunk;
+				if (!stream->chunk_remains) {
+					stream->chunk_state = HTTP2_CHUNK_CRLF;
+				}
+				break;
+			}
+			case HTTP2_CHUNK_CRLF:
+				if (c == '\n') {
+					stream->chunk_state = HTTP2_CHUNK_SIZE;
+				}
+				i++;
+				break;
+			// the last chunk has been received, ignore the trailers
+			default:
+				i = len;
+				break;
+		}
+	}
+	return j;
+}
+
+// send the response body respecting the flow control windows of the client
+static int http2_send_data(struct http_session *hr, struct http2_stream *stream) {
+	struct corerouter_peer *peer = stream->peer;
+	size_t sent = 0;
+	while(sent < peer->in->pos) {
+		int64_t window = UMIN(stream->send_window, hr->h2_send_window);
+		if (window <= 0) break;
+		size_t chunk = UMIN(peer->in->pos - sent, (uint64_t) window);
+		chunk = UMIN(chunk, hr->h2_max_frame);
+		if (http2_frame(hr->h2_out, chunk, HTTP2_DATA, 0, stream->sid)) return -1;
+		if (uwsgi_buffer_append(hr->h2_out, peer->in->buf + sent, chunk)) return -1;
+		stream->send_window -= chunk;
+		hr->h2_send_window -= chunk;
+		sent += chunk;
+	}
+	if (uwsgi_buffer_decapitate(peer->in, sent)) return -1;
+
+	if (peer->in->pos > 0) {
+		// stop reading from the backend until a WINDOW_UPDATE is received
+		stream->blocked = 1;
+		peer->last_hook_read = NULL;
+		if (peer->hook_read) {
+			if (uwsgi_cr_set_hooks(peer, NULL, NULL)) return -1;
+		}
+	}
+	else if (stream->blocked) {
+		// reading will be resumed after the frames are sent
+		stream->blocked = 0;
+		peer->last_hook_read = hr_instance_read_to_http2;
+	}
+	return 0;
+}
+
+static int http2_unblock_streams(struct http_session *hr) {
+	struct http2_stream *stream = hr->h2_streams;
+	while(stream) {
+		if (stream->blocked) {
+			if (http2_send_data(hr, stream)) return -1;
+		}
+		stream = stream->next;
+	}
+	return 0;
+}
+
+// data from the backend
+ssize_t hr_instance_read_to_http2(struct corerouter_peer *peer) {
+	struct http_session *hr = (struct http_session *) peer->session;
+	if (uwsgi_buffer_ensure(peer->in, uwsgi.page_size)) return -1;
+	ssize_t len = cr_read(peer, "hr_instance_read_to_http2()");
+
+	struct http2_stream *stream = http2_stream_find(hr, peer->sid);
+	if (!stream) return -1;
+
+	if (!len) {
+		// no response, a 502 will be sent on close
+		if (peer->r_parser_status != 4) return 0;
+		if (http2_frame(hr->h2_out, 0, HTTP2_DATA, HTTP2_FLAG_END_STREAM, stream->sid)) return -1;
+		stream->local_closed = 1;
+		if (http2_flush(hr)) return -1;
+		return 0;
+	}
+
+	if (peer->r_parser_status != 4) {
+		size_t i;
+		for(i=peer->in->pos-len;i<peer->in->pos;i++) {
+			char c = peer->in->buf[i];
+			if (c == '\r' && (peer->r_parser_status == 0 || peer->r_parser_status == 2)) {
+				peer->r_parser_status++;
+			}
+			else if (c == '\r') {
+				peer->r_parser_status = 1;
+			}
+			else if (c == '\n' && peer->r_parser_status == 1) {
+				peer->r_parser_status = 2;
+			}
+			else if (c == '\n' && peer->r_parser_status == 3) {
+				peer->r_parser_status = 4;
+				break;
+			}
+			else {
+				peer->r_parser_status = 0;
+			}
+		}
+		// need more data
+		if (peer->r_parser_status != 4) return len;
+		if (http2_response_headers(hr, stream, peer->in->buf, i+1)) return -1;
+		if (uwsgi_buffer_decapitate(peer->in, i+1)) return -1;
+	}
+
+	if (stream->chunked) {
+		peer->in->pos = http2_dechunk(stream, peer->in->buf, peer->in->pos);
+	}
+
+	if (http2_send_data(hr, stream)) return -1;
+	if (http2_flush(hr)) return -1;
+	return len;
+}
+
+/*
+	requests
+*/
+
+static int http2_is_hop_by_hop(char *name, uint16_t name_len) {
+	if (!uwsgi_strncmp(name, name_len, "connection", 10)) return 1;
+	if (!uwsgi_strncmp(name, name_len, "keep-alive", 10)) return 1;
+	if (!uwsgi_strncmp(name, name_len, "proxy-connection", 16)) return 1;
+	if (!uwsgi_strncmp(name, name_len, "transfer-encoding", 17)) return 1;
+	if (!uwsgi_strncmp(name, name_len, "upgrade", 7)) return 1;
+	if (!uwsgi_strncmp(name, name_len, "te", 2)) return 1;
+	return 0;
+}
+
+/*
+	RFC 9113 8.2 and 8.3, a malformed request is never forwarded (the fields end as-is in the HTTP/1.1
+	request or in the uwsgi vars): names are lowercase tokens, values cannot contain CR, LF or NUL (nor start
+	or end with whitespace), connection-specific headers are not allowed and the pseudo-headers are the ones
+	of a request, not repeated and before the regular fields.
+*/
+static int http2_field_is_valid(char *name, uint16_t name_len, char *value, uint16_t value_len) {
+	uint16_t i;
+	if (name_len == 0) return 0;
+	for(i=0;i<name_len;i++) {
+		uint8_t c = name[i];
+		if (c == ':' && i == 0) continue;
+		if (c <= 0x20 || c >= 0x7f || c == ':' || (c >= 'A' && c <= 'Z')) return 0;
+	}
+	for(i=0;i<value_len;i++) {
+		uint8_t c = value[i];
+		if (c == 0 || c == '\r' || c == '\n') return 0;
+	}
+	if (value_len > 0 && (value[0] == ' ' || value[0] == '\t' || value[value_len-1] == ' ' || value[value_len-1] == '\t')) return 0;
+	if (http2_is_hop_by_hop(name, name_len)) {
+		// the only allowed one
+		return !uwsgi_strncmp(name, name_len, "te", 2) && !uwsgi_strncmp(value, value_len, "trailers", 8);
+	}
+	return 1;
+}
+
+static int http2_token_is_valid(char *token, uint16_t len, int path) {
+	uint16_t i;
+	if (len == 0) return 0;
+	for(i=0;i<len;i++) {
+		uint8_t c = token[i];
+		if (c <= 0x20 || c >= 0x7f) return 0;
+	}
+	if (path) return token[0] == '/' || (len == 1 && token[0] == '*');
+	return 1;
+}
+
+// the content-length (a single one) is returned, -1 if missing
+static int http2_request_is_valid(struct uwsgi_buffer *fields, int64_t *content_length) {
+	int method = 0, scheme = 0, path = 0, authority = 0, regular = 0;
+	size_t pos = 0;
+	char *name, *value;
+	uint16_t name_len, value_len;
+	*content_length = -1;
+	while(http2_field_next(fields, &pos, &name, &name_len, &value, &value_len)) {
+		if (!http2_field_is_valid(name, name_len, value, value_len)) return 0;
+		if (name[0] != ':') {
+			regular = 1;
+			if (!uwsgi_strncmp(name, name_len, "content-length", 14)) {
+				if (*content_length >= 0 || value_len == 0 || value_len > 18) return 0;
+				uint16_t i;
+				*content_length = 0;
+				for(i=0;i<value_len;i++) {
+					if (!isdigit((int) value[i])) return 0;
+					*content_length = (*content_length * 10) + (value[i] - '0');
+				}
+			}
+			continue;
+		}
+		if (regular) return 0;
+		if (!uwsgi_strncmp(name, name_len, ":method", 7)) {
+			if (method++ || !http2_token_is_valid(value, value_len, 0)) return 0;
+		}
+		else if (!uwsgi_strncmp(name, name_len, ":path", 5)) {
+			if (path++ || !http2_token_is_valid(value, value_len, 1)) return 0;
+		}
+		else if (!uwsgi_strncmp(name, name_len, ":scheme", 7)) {
+			if (scheme++) return 0;
+		}
+		else if (!uwsgi_strncmp(name, name_len, ":authority", 10)) {
+			if (authority++) return 0;
+		}
+		else {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// headers with the same name are merged (cookies are usually split by clients)
+static int http2_merge_field(struct uwsgi_buffer *fields, size_t pos, char *name, uint16_t name_len, char *value, uint16_t value_len, struct uwsgi_buffer *merged) {
+	char *sep = ", ";
+	if (!uwsgi_strncmp(name, name_len, "cookie", 6)) sep = "; ";
+	merged->pos = 0;
+	if (uwsgi_buffer_append(merged, value, value_len)) return -1;
+	char *n, *v;
+	uint16_t n_len, v_len;
+	while(http2_field_next(fields, &pos, &n, &n_len, &v, &v_len)) {
+		if (uwsgi_strncmp(name, name_len, n, n_len)) continue;
+		if (uwsgi_buffer_append(merged, sep, 2)) return -1;
+		if (uwsgi_buffer_append(merged, v, v_len)) return -1;
+	}
+	return 0;
+}
+
+static int http2_field_seen(struct uwsgi_buffer *fields, size_t limit, char *name, uint16_t name_len) {
+	size_t pos = 0;
+	char *n, *v;
+	uint16_t n_len, v_len;
+	while(pos < limit && http2_field_next(fields, &pos, &n, &n_len, &v, &v_len)) {
+		if (!uwsgi_strncmp(name, name_len, n, n_len)) return 1;
+	}
+	return 0;
+}
+
+static int http2_add_header(struct http2_stream *stream, struct uwsgi_buffer *out, char *name, uint16_t name_len, char *value, uint16_t value_len, struct uwsgi_buffer *tmp) {
+	if (stream->http) {
+		if (uwsgi_buffer_append(out, name, name_len)) return -1;
+		if (uwsgi_buffer_append(out, ": ", 2)) return -1;
+		if (uwsgi_buffer_append(out, value, value_len)) return -1;
+		return uwsgi_buffer_append(out, "\r\n", 2);
+	}
+	if (!uwsgi_strncmp(name, name_len, "content-length", 14)) {
+		return uwsgi_buffer_append_keyval(out, "CONTENT_LENGTH", 14, value, value_len);
+	}
+	if (!uwsgi_strncmp(name, name_len, "content-type", 12)) {
+		return uwsgi_buffer_append_keyval(out, "CONTENT_TYPE", 12, value, value_len);
+	}
+	tmp->pos = 0;
+	if (uwsgi_buffer_append(tmp, "HTTP_", 5)) return -1;
+	uint16_t i;
+	for(i=0;i<name_len;i++) {
+		char c = name[i] == '-' ? '_' : toupper((int) name[i]);
+		if (uwsgi_buffer_byte(tmp, c)) return -1;
+	}
+	return uwsgi_buffer_append_keyval(out, tmp->buf, tmp->pos, value, value_len);
+}
+
+#ifdef UWSGI_SSL
+// the client certificate is exported again for every stream
+static void http2_ssl_reset(struct http_session *hr) {
+	if (hr->ssl_client_cert) {
+		X509_free(hr->ssl_client_cert);
+		hr->ssl_client_cert = NULL;
+	}
+	if (hr->ssl_client_dn) {
+		OPENSSL_free(hr->ssl_client_dn);
+		hr->ssl_client_dn = NULL;
+	}
+	if (hr->ssl_cc) {
+		free(hr->ssl_cc);
+		hr->ssl_cc = NULL;
+	}
+	if (hr->ssl_bio) {
+		BIO_free(hr->ssl_bio);
+		hr->ssl_bio = NULL;
+	}
+}
+#endif
+
+// build the uwsgi packet (or the HTTP/1.1 request) for the backend, the body size is added on connect
+static int http2_build_request(struct http_session *hr, struct http2_stream *stream, struct uwsgi_buffer *fields, char *method, uint16_t method_len, char *path, uint16_t path_len, char *authority, uint16_t authority_len) {
+	struct corerouter_peer *peer = stream->peer;
+	struct uwsgi_buffer *out = peer->out;
+	char *client_address = peer->session->client_address;
+
+	if (stream->http) {
+		if (uwsgi_buffer_append(out, method, method_len)) return -1;
+		if (uwsgi_buffer_append(out, " ", 1)) return -1;
+		if (uwsgi_buffer_append(out, path, path_len)) return -1;
+		if (uwsgi_buffer_append(out, " HTTP/1.1\r\n", 11)) return -1;
+		if (authority && !http2_field_seen(fields, fields->pos, "host", 4)) {
+			if (uwsgi_buffer_append(out, "host: ", 6)) return -1;
+			if (uwsgi_buffer_append(out, authority, authority_len)) return -1;
+			if (uwsgi_buffer_append(out, "\r\n", 2)) return -1;
+		}
+	}
+	else {
+		// leave space for the uwsgi header
+		out->pos = 4;
+		if (uwsgi_buffer_append_keyval(out, "REQUEST_METHOD", 14, method, method_len)) return -1;
+		if (uwsgi_buffer_append_keyval(out, "REQUEST_URI", 11, path, path_len)) return -1;
+		char *query_string = memchr(path, '?', path_len);
+		uint16_t path_info_len = query_string ? query_string - path : path_len;
+		// PATH_INFO must be url-decoded
+		char *path_info = uwsgi_malloc(path_info_len + 1);
+		http_url_decode(path, &path_info_len, path_info);
+		int ret = uwsgi_buffer_append_keyval(out, "PATH_INFO", 9, path_info, path_info_len);
+		free(path_info);
+		if (ret) return -1;
+		if (query_string) {
+			if (uwsgi_buffer_append_keyval(out, "QUERY_STRING", 12, query_string + 1, (path + path_len) - (query_string + 1))) return -1;
+		}
+		else {
+			if (uwsgi_buffer_append_keyval(out, "QUERY_STRING", 12, "", 0)) return -1;
+		}
+		if (uwsgi_buffer_append_keyval(out, "SERVER_PROTOCOL", 15, "HTTP/2.0", 8)) return -1;
+		if (uwsgi_buffer_append_keyval(out, "SCRIPT_NAME", 11, "", 0)) return -1;
+		if (uhttp.server_name_as_http_host) {
+			if (uwsgi_buffer_append_keyval(out, "SERVER_NAME", 11, peer->key, peer->key_len)) return -1;
+		}
+		else {
+			if (uwsgi_buffer_append_keyval(out, "SERVER_NAME", 11, uwsgi.hostname, uwsgi.hostname_len)) return -1;
+		}
+		if (uwsgi_buffer_append_keyval(out, "SERVER_PORT", 11, hr->port, hr->port_len)) return -1;
+		if (uwsgi_buffer_append_keyval(out, "UWSGI_ROUTER", 12, "http", 4)) return -1;
+		if (hr->stud_prefix_pos > 0) {
+			if (uwsgi_buffer_append_keyval(out, "HTTPS", 5, "on", 2)) return -1;
+		}
+#ifdef UWSGI_SSL
+		// preserve the key (hr_https_add_vars could set it to the SNI name)
+		char key[0xff];
+		uint8_t key_len = peer->key_len;
+		memcpy(key, peer->key, key_len);
+		http2_ssl_reset(hr);
+		if (hr_https_add_vars(hr, peer, out)) return -1;
+		memcpy(peer->key, key, key_len);
+		peer->key_len = key_len;
+#endif
+		if (uwsgi_buffer_append_keyval(out, "REMOTE_ADDR", 11, client_address, strlen(client_address))) return -1;
+		if (uwsgi_buffer_append_keyval(out, "REMOTE_PORT", 11, peer->session->client_port, strlen(peer->session->client_port))) return -1;
+		if (uwsgi_buffer_append_keyval(out, "HTTP2", 5, "on", 2)) return -1;
+		if (uwsgi_buffer_append_keynum(out, "HTTP2_STREAM", 12, stream->sid)) return -1;
+		if (authority && !http2_field_seen(fields, fields->pos, "host", 4)) {
+			if (uwsgi_buffer_append_keyval(out, "HTTP_HOST", 9, authority, authority_len)) return -1;
+		}
+	}
+
+	struct uwsgi_buffer *merged = uwsgi_buffer_new(256);
+	struct uwsgi_buffer *tmp = uwsgi_buffer_new(64);
+	int broken = 0;
+	size_t pos = 0;
+	char *name, *value;
+	uint16_t name_len, value_len;
+	for(;;) {
+		size_t current = pos;
+		if (!http2_field_next(fields, &pos, &name, &name_len, &value, &value_len)) break;
+		if (name_len == 0 || name[0] == ':' || http2_is_hop_by_hop(name, name_len)) continue;
+		// already merged
+		if (http2_field_seen(fields, current, name, name_len)) continue;
+		if (http2_merge_field(fields, pos, name, name_len, value, value_len, merged) ||
+			merged->pos > 0xffff ||
+			http2_add_header(stream, out, name, name_len, merged->buf, merged->pos, tmp)) {
+			broken = 1;
+			break;
+		}
+	}
+	uwsgi_buffer_destroy(merged);
+	uwsgi_buffer_destroy(tmp);
+	if (broken) return -1;
+
+	if (stream->http) {
+		if (uwsgi_buffer_append(out, "x-forwarded-for: ", 17)) return -1;
+		if (uwsgi_buffer_append(out, client_address, strlen(client_address))) return -1;
+		if (uwsgi_buffer_append(out, "\r\n", 2)) return -1;
+#ifdef UWSGI_SSL
+		if (hr->stud_prefix_pos > 0 || hr->session.ugs->mode == UWSGI_HTTP_SSL) {
+			if (uwsgi_buffer_append(out, "x-forwarded-proto: https\r\n", 26)) return -1;
+		}
+#endif
+		// the end of the response is the end of the connection
+		if (uwsgi_buffer_append(out, "connection: close\r\n", 19)) return -1;
+		return 0;
+	}
+
+	struct uwsgi_string_list *hv = uhttp.http_vars;
+	while (hv) {
+		char *equal = strchr(hv->value, '=');
+		if (equal) {
+			if (uwsgi_buffer_append_keyval(out, hv->value, equal - hv->value, equal + 1, strlen(equal + 1))) return -1;
+		}
+		hv = hv->next;
+	}
+
+	return 0;
+}
+
+// complete the request (buffered body included) and connect to the backend
+static int http2_stream_connect(struct http_session *hr, struct http2_stream *stream) {
+	struct corerouter_peer *peer = stream->peer;
+	struct uwsgi_buffer *out = peer->out;
+
+	if (stream->http) {
+		if (stream->body) {
+			if (uwsgi_buffer_append(out, "content-length: ", 16)) return -1;
+			if (uwsgi_buffer_num64(out, stream->body->pos)) return -1;
+			if (uwsgi_buffer_append(out, "\r\n", 2)) return -1;
+		}
+		if (uwsgi_buffer_append(out, "\r\n", 2)) return -1;
+	}
+	else {
+		if (stream->body) {
+			if (uwsgi_buffer_append_keynum(out, "CONTENT_LENGTH", 14, stream->body->pos)) return -1;
+		}
+		if (out->pos - 4 > 0xffff) return -1;
+		uint16_t pktsize = out->pos - 4;
+		if (uhttp.modifier1)
+			peer->modifier1 = uhttp.modifier1;
+		if (uhttp.modifier2)
+			peer->modifier2 = uhttp.modifier2;
+		out->buf[0] = peer->modifier1;
+		out->buf[1] = (uint8_t) (pktsize & 0xff);
+		out->buf[2] = (uint8_t) ((pktsize >> 8) & 0xff);
+		out->buf[3] = peer->modifier2;
+	}
+
+	if (stream->body) {
+		if (uwsgi_buffer_append(out, stream->body->buf, stream->body->pos)) return -1;
+		uwsgi_buffer_destroy(stream->body);
+		stream->body = NULL;
+	}
+
+	peer->last_hook_read = hr_instance_read_to_http2;
+	peer->can_retry = 1;
+	peer->out_pos = 0;
+	http_set_timeout(peer, uhttp.connect_timeout);
+	cr_connect(peer, hr_instance_connected);
+	return HTTP2_SUSPEND;
+}
+
+// a failed connection is reported to the client as a 502
+static int http2_stream_start(struct http_session *hr, struct http2_stream *stream) {
+	int ret = http2_stream_connect(hr, stream);
+	if (ret < 0) {
+		stream->peer->can_retry = 0;
+		corerouter_close_peer(hr->session.corerouter, stream->peer);
+		return HTTP2_CONTINUE;
+	}
+	return ret;
+}
+
+static int http2_stream_open(struct http_session *hr, uint32_t sid, struct uwsgi_buffer *fields, int end_stream) {
+	struct uwsgi_corerouter *ucr = hr->session.corerouter;
+
+	if (hr->h2_streams_count >= uhttp.http2_max_streams) {
+		if (http2_rst_stream(hr, sid, HTTP2_REFUSED_STREAM)) return -1;
+		return HTTP2_CONTINUE;
+	}
+
+	// malformed requests are a stream error
+	int64_t content_length = -1;
+	if (!http2_request_is_valid(fields, &content_length) || (end_stream && content_length > 0)) {
+		return http2_stream_refuse(hr, sid, 400, HTTP2_PROTOCOL_ERROR, end_stream);
+	}
+
+	struct corerouter_peer *peer = uwsgi_cr_peer_add(&hr->session);
+	peer->sid = sid;
+	peer->in->limit = UMAX16;
+	// the peer does not have a socket until the request is complete
+	peer->last_hook_read = NULL;
+	peer->out = uwsgi_buffer_new(uwsgi.page_size);
+	// the buffer is reused for the request body and destroyed with the peer
+	peer->out_need_free = 2;
+	peer->out_pos = 0;
+
+	struct http2_stream *stream = uwsgi_calloc(sizeof(struct http2_stream));
+	stream->sid = sid;
+	stream->peer = peer;
+	stream->send_window = hr->h2_initial_window;
+	stream->remote_closed = end_stream;
+	stream->content_length = content_length;
+	stream->next = hr->h2_streams;
+	hr->h2_streams = stream;
+	hr->h2_streams_count++;
+
+	char *method = NULL, *path = NULL, *authority = NULL;
+	uint16_t method_len = 0, path_len = 0, authority_len = 0;
+
+	size_t pos = 0;
+	char *name, *value;
+	uint16_t name_len, value_len;
+	while(http2_field_next(fields, &pos, &name, &name_len, &value, &value_len)) {
+		if (!uwsgi_strncmp(name, name_len, ":method", 7)) {
+			method = value;
+			method_len = value_len;
+		}
+		else if (!uwsgi_strncmp(name, name_len, ":path", 5)) {
+			path = value;
+			path_len = value_len;
+		}
+		else if (!uwsgi_strncmp(name, name_len, ":authority", 10)) {
+			authority = value;
+			authority_len = value_len;
+		}
+		else if (!authority && !uwsgi_strncmp(name, name_len, "host", 4)) {
+			authority = value;
+			authority_len = value_len;
+		}
+	}
+
+	if (!method || !path || path_len == 0) {
+		stream->error_status = 400;
+		goto error;
+	}
+
+	if (authority) {
+		if (authority_len > 0xff) {
+			stream->error_status = 400;
+			goto error;
+		}
+		memcpy(peer->key, authority, authority_len);
+		peer->key_len = authority_len;
+	}
+	else {
+		memcpy(peer->key, uwsgi.hostname, uwsgi.hostname_len);
+		peer->key_len = uwsgi.hostname_len;
+	}
+
+	// find an instance using the key
+	if (ucr->mapper(ucr, peer)) goto error;
+	if (peer->instance_address_len == 0) goto error;
+
+	stream->http = peer->proto == 'h' || uhttp.proto_http;
+	if (http2_build_request(hr, stream, fields, method, method_len, path, path_len, authority, authority_len)) goto error;
+
+	// the body size is known, it will be streamed to the backend
+	if (end_stream || content_length >= 0) {
+		return http2_stream_start(hr, stream);
+	}
+
+	stream->body = uwsgi_buffer_new(uwsgi.page_size);
+	stream->body->limit = HTTP2_MAX_BODY;
+	return HTTP2_CONTINUE;
+
+error:
+	corerouter_close_peer(ucr, peer);
+	return HTTP2_CONTINUE;
+}
+
+/*
+	frames
+*/
+
+static int http2_manage_data(struct http_session *hr, uint8_t flags, uint32_t sid, uint8_t *buf, uint32_t len) {
+	if (!sid) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+
+	// the whole frame (padding included) counts for flow control
+	hr->h2_recv_pending += len;
+
+	uint8_t *data = buf;
+	size_t data_len = len;
+	if (flags & HTTP2_FLAG_PADDED) {
+		if (len < 1 || buf[0] >= len) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+		data = buf + 1;
+		data_len = len - 1 - buf[0];
+	}
+
+	struct http2_stream *stream = http2_stream_find(hr, sid);
+	// the stream could have been already closed by the backend
+	if (!stream || stream->remote_closed) return HTTP2_CONTINUE;
+
+	// the body must match the declared size (RFC 9113 8.1.1)
+	stream->data_received += data_len;
+	if (stream->content_length >= 0) {
+		if (stream->data_received > (uint64_t) stream->content_length ||
+			((flags & HTTP2_FLAG_END_STREAM) && stream->data_received != (uint64_t) stream->content_length)) {
+			return http2_stream_reset(hr, stream, HTTP2_PROTOCOL_ERROR);
+		}
+	}
+
+	if (flags & HTTP2_FLAG_END_STREAM) {
+		stream->remote_closed = 1;
+	}
+	// the data is consumed as soon as it is queued for the backend
+	else if (len > 0) {
+		if (http2_window_update(hr, sid, len)) return -1;
+	}
+
+	struct corerouter_peer *peer = stream->peer;
+	if (stream->body) {
+		if (uwsgi_buffer_append(stream->body, (char *) data, data_len)) {
+			stream->error_status = 413;
+			corerouter_close_peer(hr->session.corerouter, peer);
+			return HTTP2_CONTINUE;
+		}
+		if (stream->remote_closed) {
+			return http2_stream_start(hr, stream);
+		}
+		return HTTP2_CONTINUE;
+	}
+
+	if (data_len > 0) {
+		if (uwsgi_buffer_append(peer->out, (char *) data, data_len)) return -1;
+		peer->out_pos = 0;
+		cr_write_to_backend(peer, hr_instance_write);
+		return HTTP2_SUSPEND;
+	}
+	return HTTP2_CONTINUE;
+}
+
+static int http2_manage_headers(struct http_session *hr, uint8_t type, uint8_t flags, uint32_t sid, uint8_t *buf, uint32_t len) {
+	if (!sid) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+
+	if (type == HTTP2_HEADERS) {
+		size_t skip = 0;
+		size_t padding = 0;
+		if (flags & HTTP2_FLAG_PADDED) {
+			if (len < 1) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+			padding = buf[0];
+			skip = 1;
+		}
+		if (flags & HTTP2_FLAG_PRIORITY) {
+			skip += 5;
+		}
+		if (skip + padding > len) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+		hr->h2_hblock->pos = 0;
+		if (uwsgi_buffer_append(hr->h2_hblock, (char *) buf + skip, len - (skip + padding))) return -1;
+		hr->h2_hblock_sid = sid;
+		hr->h2_hblock_end_stream = flags & HTTP2_FLAG_END_STREAM;
+	}
+	else {
+		if (sid != hr->h2_hblock_sid) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+		if (uwsgi_buffer_append(hr->h2_hblock, (char *) buf, len)) return -1;
+	}
+
+	if (!(flags & HTTP2_FLAG_END_HEADERS)) return HTTP2_CONTINUE;
+
+	sid = hr->h2_hblock_sid;
+	hr->h2_hblock_sid = 0;
+
+	// the block is always decoded to keep the dynamic table in sync
+	struct uwsgi_buffer *fields = uwsgi_buffer_new(uwsgi.page_size);
+	fields->limit = HTTP2_MAX_HEADER_LIST;
+	int too_big = http2_hpack_decode(hr, (uint8_t *) hr->h2_hblock->buf, hr->h2_hblock->pos, fields);
+	if (too_big < 0) {
+		uwsgi_buffer_destroy(fields);
+		return http2_goaway(hr, HTTP2_COMPRESSION_ERROR);
+	}
+
+	int ret = HTTP2_CONTINUE;
+	struct http2_stream *stream = http2_stream_find(hr, sid);
+	// trailers (they are not forwarded, their size does not matter)
+	if (stream) {
+		if (hr->h2_hblock_end_stream && !stream->remote_closed) {
+			if (stream->content_length >= 0 && stream->data_received != (uint64_t) stream->content_length) {
+				uwsgi_buffer_destroy(fields);
+				return http2_stream_reset(hr, stream, HTTP2_PROTOCOL_ERROR);
+			}
+			stream->remote_closed = 1;
+			if (stream->body) {
+				ret = http2_stream_start(hr, stream);
+			}
+		}
+	}
+	else if (!(sid & 1)) {
+		ret = http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+	}
+	else if (sid > hr->h2_last_sid) {
+		hr->h2_last_sid = sid;
+		if (too_big) {
+			ret = http2_stream_refuse(hr, sid, 431, HTTP2_NO_ERROR, hr->h2_hblock_end_stream);
+		}
+		else {
+			ret = http2_stream_open(hr, sid, fields, hr->h2_hblock_end_stream);
+		}
+	}
+	uwsgi_buffer_destroy(fields);
+	return ret;
+}
+
+static int http2_manage_settings(struct http_session *hr, uint8_t flags, uint32_t sid, uint8_t *buf, uint32_t len) {
+	if (sid) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+	if (flags & HTTP2_FLAG_ACK) return HTTP2_CONTINUE;
+	if (len % 6) return http2_goaway(hr, HTTP2_FRAME_SIZE_ERROR);
+
+	int window_changed = 0;
+	uint32_t i;
+	for(i=0;i<len;i+=6) {
+		uint16_t id = (buf[i] << 8) | buf[i+1];
+		uint32_t value = http2_u32(buf + i + 2);
+		if (id == HTTP2_SETTINGS_INITIAL_WINDOW_SIZE) {
+			if (value > HTTP2_MAX_WINDOW) return http2_goaway(hr, HTTP2_FLOW_CONTROL_ERROR);
+			int64_t delta = (int64_t) value - hr->h2_initial_window;
+			struct http2_stream *stream = hr->h2_streams;
+			while(stream) {
+				stream->send_window += delta;
+				if (stream->send_window > HTTP2_MAX_WINDOW) return http2_goaway(hr, HTTP2_FLOW_CONTROL_ERROR);
+				stream = stream->next;
+			}
+			hr->h2_initial_window = value;
+			window_changed = 1;
+		}
+		else if (id == HTTP2_SETTINGS_MAX_FRAME_SIZE) {
+			if (value < HTTP2_DEFAULT_FRAME_SIZE || value > 0xffffff) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+			hr->h2_max_frame = value;
+		}
+	}
+
+	if (http2_frame(hr->h2_out, 0, HTTP2_SETTINGS, HTTP2_FLAG_ACK, 0)) return -1;
+	if (window_changed) {
+		if (http2_unblock_streams(hr)) return -1;
+	}
+	return HTTP2_CONTINUE;
+}
+
+static int http2_manage_window_update(struct http_session *hr, uint32_t sid, uint8_t *buf, uint32_t len) {
+	if (len != 4) return http2_goaway(hr, HTTP2_FRAME_SIZE_ERROR);
+	uint32_t increment = http2_u32(buf) & HTTP2_MAX_WINDOW;
+	if (!sid) {
+		if (!increment) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+		hr->h2_send_window += increment;
+		if (hr->h2_send_window > HTTP2_MAX_WINDOW) return http2_goaway(hr, HTTP2_FLOW_CONTROL_ERROR);
+		if (http2_unblock_streams(hr)) return -1;
+		return HTTP2_CONTINUE;
+	}
+	struct http2_stream *stream = http2_stream_find(hr, sid);
+	if (!stream) return HTTP2_CONTINUE;
+	if (!increment) return http2_stream_reset(hr, stream, HTTP2_PROTOCOL_ERROR);
+	stream->send_window += increment;
+	if (stream->send_window > HTTP2_MAX_WINDOW) return http2_stream_reset(hr, stream, HTTP2_FLOW_CONTROL_ERROR);
+	if (stream->blocked) {
+		if (http2_send_data(hr, stream)) return -1;
+	}
+	return HTTP2_CONTINUE;
+}
+
+static int http2_manage_frame(struct http_session *hr, uint8_t type, uint8_t flags, uint32_t sid, uint8_t *buf, uint32_t len) {
+	// a header block cannot be interrupted
+	if (hr->h2_hblock_sid && type != HTTP2_CONTINUATION) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+
+	struct http2_stream *stream = NULL;
+	switch(type) {
+		case HTTP2_DATA:
+			return http2_manage_data(hr, flags, sid, buf, len);
+		case HTTP2_HEADERS:
+			return http2_manage_headers(hr, type, flags, sid, buf, len);
+		case HTTP2_CONTINUATION:
+			if (!hr->h2_hblock_sid) return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+			return http2_manage_headers(hr, type, flags, sid, buf, len);
+		case HTTP2_SETTINGS:
+			return http2_manage_settings(hr, flags, sid, buf, len);
+		case HTTP2_WINDOW_UPDATE:
+			return http2_manage_window_update(hr, sid, buf, len);
+		case HTTP2_PING:
+			if (len != 8) return http2_goaway(hr, HTTP2_FRAME_SIZE_ERROR);
+			if (flags & HTTP2_FLAG_ACK) return HTTP2_CONTINUE;
+			if (http2_frame(hr->h2_out, 8, HTTP2_PING, HTTP2_FLAG_ACK, 0)) return -1;
+			if (uwsgi_buffer_append(hr->h2_out, (char *) buf, 8)) return -1;
+			return HTTP2_CONTINUE;
+		case HTTP2_RST_STREAM:
+			if (len != 4) return http2_goaway(hr, HTTP2_FRAME_SIZE_ERROR);
+			stream = http2_stream_find(hr, sid);
+			if (stream) {
+				stream->reset = 1;
+				corerouter_close_peer(hr->session.corerouter, stream->peer);
+				// opening and resetting streams costs nothing to the client (rapid reset)
+				if (--hr->h2_reset_budget < 0) return http2_goaway(hr, HTTP2_ENHANCE_YOUR_CALM);
+			}
+			return HTTP2_CONTINUE;
+		case HTTP2_GOAWAY:
+			hr->h2_goaway = 1;
+			if (!hr->h2_streams) return HTTP2_CLOSE;
+			return HTTP2_CONTINUE;
+		case HTTP2_PUSH_PROMISE:
+			return http2_goaway(hr, HTTP2_PROTOCOL_ERROR);
+		// PRIORITY and unknown frames are ignored
+		default:
+			return HTTP2_CONTINUE;
+	}
+}
+
+static int http2_init(struct http_session *hr) {
+	// the router could run multiple threads
+	pthread_once(&http2_huffman_once, http2_huffman_init);
+	hr->h2_out = uwsgi_buffer_new(uwsgi.page_size);
+	hr->h2_hblock = uwsgi_buffer_new(uwsgi.page_size);
+	hr->h2_hblock->limit = UMAX16;
+	hr->h2_dtable_max = HTTP2_HEADER_TABLE_SIZE;
+	hr->h2_send_window = HTTP2_DEFAULT_WINDOW;
+	hr->h2_initial_window = HTTP2_DEFAULT_WINDOW;
+	hr->h2_max_frame = HTTP2_DEFAULT_FRAME_SIZE;
+	hr->h2_reset_budget = HTTP2_RESET_BUDGET;
+	// streams are closed one by one
+	hr->session.can_keepalive = 1;
+	hr->session.peer_closed = http2_peer_closed;
+
+	// frames are already coalesced, do not wait for the ack of the previous segment
+	if (hr->session.client_sockaddr.sa.sa_family != AF_UNIX) {
+		uwsgi_tcp_nodelay(hr->session.main_peer->fd);
+	}
+
+	if (http2_frame(hr->h2_out, 12, HTTP2_SETTINGS, 0, 0)) return -1;
+	if (uwsgi_buffer_u16be(hr->h2_out, HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS)) return -1;
+	if (uwsgi_buffer_u32be(hr->h2_out, uhttp.http2_max_streams)) return -1;
+	if (uwsgi_buffer_u16be(hr->h2_out, HTTP2_SETTINGS_MAX_HEADER_LIST_SIZE)) return -1;
+	if (uwsgi_buffer_u32be(hr->h2_out, HTTP2_MAX_HEADER_LIST)) return -1;
+
+	return uwsgi_buffer_decapitate(hr->session.main_peer->in, HTTP2_PREFACE_LEN);
+}
+
+/*
+	check for the HTTP/2 client preface,
+	returns 1 if it has been found, 0 if more data is needed and -1 if it is not an HTTP/2 connection
+*/
+int http2_preface(struct corerouter_peer *main_peer) {
+	size_t len = UMIN(main_peer->in->pos, HTTP2_PREFACE_LEN);
+	if (memcmp(main_peer->in->buf, HTTP2_PREFACE, len)) return -1;
+	if (len < HTTP2_PREFACE_LEN) return 0;
+	return 1;
+}
+
+ssize_t http2_parse(struct corerouter_peer *main_peer) {
+	struct http_session *hr = (struct http_session *) main_peer->session;
+
+	if (!hr->h2_out) {
+		if (http2_init(hr)) return -1;
+	}
+
+	ssize_t ret = 1;
+	int rc = HTTP2_CONTINUE;
+	hr->h2_parsing = 1;
+	for(;;) {
+		struct uwsgi_buffer *ub = main_peer->in;
+		if (ub->pos < 9) break;
+		uint8_t *buf = (uint8_t *) ub->buf;
+		uint32_t len = (buf[0] << 16) | (buf[1] << 8) | buf[2];
+		if (len > HTTP2_DEFAULT_FRAME_SIZE) {
+			rc = http2_goaway(hr, HTTP2_FRAME_SIZE_ERROR);
+			break;
+		}
+		if (ub->pos < 9 + len) break;
+		rc = http2_manage_frame(hr, buf[3], buf[4], http2_u32(buf + 5) & HTTP2_MAX_WINDOW, buf + 9, len);
+		if (rc < 0) break;
+		if (uwsgi_buffer_decapitate(ub, 9 + len)) {
+			rc = -1;
+			break;
+		}
+		if (rc != HTTP2_CONTINUE) break;
+	}
+	hr->h2_parsing = 0;
+
+	if (rc < 0) return -1;
+	if (rc == HTTP2_CLOSE) return 0;
+	if (rc == HTTP2_GOAWAY_SENT) {
+		hr->h2_goaway = 1;
+		hr->session.can_keepalive = 0;
+		hr->session.wait_full_write = 1;
+	}
+	if (http2_flush(hr)) return -1;
+	return ret;
+}
+
+// the request (or a chunk of its body) has been sent to the backend, go on parsing frames
+ssize_t http2_instance_written(struct corerouter_peer *peer) {
+	struct corerouter_peer *main_peer = peer->session->main_peer;
+	if (http2_parse(main_peer) <= 0) {
+		// the peer will be destroyed with the session
+		peer->session->can_keepalive = 0;
+		corerouter_close_peer(peer->session->corerouter, main_peer);
+	}
+	return 1;
+}
+
+/*
+	called by the corerouter whenever a backend peer is closed:
+	the client is notified if the stream is not complete and pending frames are sent.
+*/
+void http2_peer_closed(struct corerouter_peer *peer) {
+	struct http_session *hr = (struct http_session *) peer->session;
+	struct corerouter_peer *main_peer = hr->session.main_peer;
+
+	// a failed stream does not bring down the whole connection
+	if (!hr->h2_goaway) {
+		hr->session.can_keepalive = 1;
+	}
+
+	struct http2_stream *stream = http2_stream_remove(hr, peer);
+	if (!stream) return;
+
+	if (stream->local_closed && hr->h2_reset_budget < HTTP2_RESET_BUDGET) {
+		hr->h2_reset_budget++;
+	}
+
+	int ret = 0;
+	if (!stream->reset && !stream->local_closed) {
+		if (peer->r_parser_status != 4) {
+			ret = http2_send_status(hr, stream->sid, stream->error_status ? stream->error_status : 502);
+		}
+		else {
+			ret = http2_rst_stream(hr, stream->sid, HTTP2_INTERNAL_ERROR);
+		}
+	}
+	http2_stream_free(stream);
+	if (ret) {
+		hr->session.can_keepalive = 0;
+		return;
+	}
+
+	if (hr->h2_goaway && !hr->h2_streams) {
+		hr->session.can_keepalive = 0;
+		if (hr->h2_out->pos || main_peer->hook_write) {
+			hr->session.wait_full_write = 1;
+		}
+	}
+
+	// the frame parser will flush the frames
+	if (hr->h2_parsing || main_peer->hook_write) return;
+
+	struct corerouter_peer *peers = hr->session.peers;
+	while(peers) {
+		if (peers != peer && peers->hook_write) return;
+		peers = peers->next;
+	}
+
+	// nobody is writing, send the frames or restore the default hooks
+	peers = hr->session.peers;
+	if (hr->h2_out->pos) {
+		main_peer->out = hr->h2_out;
+		main_peer->out_pos = 0;
+		if (uwsgi_cr_set_hooks(main_peer, NULL, hr->func_write)) goto error;
+		while(peers) {
+			if (peers != peer && uwsgi_cr_set_hooks(peers, NULL, NULL)) goto error;
+			peers = peers->next;
+		}
+		return;
+	}
+
+	if (uwsgi_cr_set_hooks(main_peer, main_peer->last_hook_read, NULL)) goto error;
+	while(peers) {
+		if (peers != peer && uwsgi_cr_set_hooks(peers, peers->last_hook_read, NULL)) goto error;
+		peers = peers->next;
+	}
+	return;
+error:
+	hr->session.can_keepalive = 0;
+	hr->session.wait_full_write = 0;
+}
+
+void http2_session_close(struct http_session *hr) {
+	struct http2_stream *stream = hr->h2_streams;
+	while(stream) {
+		struct http2_stream *next = stream->next;
+		http2_stream_free(stream);
+		stream = next;
+	}
+	hr->h2_streams = NULL;
+	http2_dtable_evict(hr, 0);
+	if (hr->h2_dtable) {
+		free(hr->h2_dtable);
+	}
+	if (hr->h2_out) {
+		uwsgi_buffer_destroy(hr->h2_out);
+	}
+	if (hr->h2_hblock) {
+		uwsgi_buffer_destroy(hr->h2_hblock);
+	}
+}
+
+#ifdef UWSGI_HTTP2_ALPN
+int http2_alpn_select(SSL *ssl, const unsigned char **out, unsigned char *outlen, const unsigned char *in, unsigned int inlen, void *arg) {
+	static const unsigned char protos[] = "\x02h2\x08http/1.1";
+	if (!uhttp.http2) return SSL_TLSEXT_ERR_NOACK;
+	if (SSL_select_next_proto((unsigned char **) out, outlen, protos, sizeof(protos) - 1, in, inlen) != OPENSSL_NPN_NEGOTIATED) {
+		return SSL_TLSEXT_ERR_NOACK;
+	}
+	return SSL_TLSEXT_ERR_OK;
+}
+#endif
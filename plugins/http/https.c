@@ -54,6 +54,10 @@ void uwsgi_opt_https(char *opt, char *value, void *cr) {
 	if (!ugs->ctx) {
 		exit(1);
 	}
+	ucr->has_ssl_sockets++;
+#ifdef UWSGI_HTTP2_ALPN
+	SSL_CTX_set_alpn_select_cb(ugs->ctx, http2_alpn_select, NULL);
+#endif
         // set the ssl mode
         ugs->mode = UWSGI_HTTP_SSL;
 
@@ -124,6 +128,10 @@ void uwsgi_opt_https2(char *opt, char *value, void *cr) {
         if (!ugs->ctx) {
                 exit(1);
         }
+	ucr->has_ssl_sockets++;
+#ifdef UWSGI_HTTP2_ALPN
+	SSL_CTX_set_alpn_select_cb(ugs->ctx, http2_alpn_select, NULL);
+#endif
 #ifdef UWSGI_SPDY
 	if (s2_spdy) {
         	SSL_CTX_set_info_callback(ugs->ctx, uwsgi_spdy_info_cb);
@@ -293,7 +301,13 @@ ssize_t hr_ssl_write(struct corerouter_peer *main_peer) {
                         	main_peer->session->connect_peer_after_write = NULL;
                         	return ret;
                 	}
+			int done = hr_instance_done(main_peer);
+			if (done <= 0) return done;
+			if (done > 1) return ret;
                         cr_reset_hooks(main_peer);
+			if (hr->h2) {
+				return http2_parse(main_peer);
+			}
 #ifdef UWSGI_SPDY
 			if (hr->spdy) {
 				return spdy_parse(main_peer);
@@ -337,6 +351,11 @@ ssize_t hr_ssl_read(struct corerouter_peer *main_peer) {
         if (uwsgi_buffer_ensure(main_peer->in, uwsgi.page_size)) return -1;
         int ret = SSL_read(hr->ssl, main_peer->in->buf + main_peer->in->pos, main_peer->in->len - main_peer->in->pos);
         if (ret > 0) {
+		// the handshake is complete, check for resumption and if the kernel took over the records encryption
+		if (!hr->ktls_checked) {
+			hr->ktls_checked = 1;
+			hr->ktls = corerouter_ssl_handshake_done(cs->corerouter, hr->ssl);
+		}
                 // fix the buffer
                 main_peer->in->pos += ret;
                 // check for pending data
@@ -431,6 +450,10 @@ void hr_setup_ssl(struct http_session *hr, struct uwsgi_gateway_socket *ugs) {
  	hr->ssl = SSL_new(ugs->ctx);
         SSL_set_fd(hr->ssl, hr->session.main_peer->fd);
         SSL_set_accept_state(hr->ssl);
+	// HTTP/2 frames could be queued while a write is in progress
+	if (uhttp.http2) {
+		SSL_set_mode(hr->ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+	}
 #ifdef UWSGI_SPDY
         SSL_set_ex_data(hr->ssl, uhttp.spdy_index, hr);
 #endif
@@ -185,3 +185,204 @@ end:
         return 0;
 }
 
+
+/*
+	backend responses framing
+
+	to give back a backend connection to the pool we need to know where the response ends
+	without waiting for the backend to close it. Only HTTP/1.1 responses with Content-Length
+	or chunked encoding (or without a body at all) can be framed, everything else falls back
+	to the "read until close" behaviour.
+*/
+
+static int hr_response_frame_headers(struct http_session *hr) {
+	char *buf = hr->resp_headers->buf;
+	size_t len = hr->resp_headers->pos;
+
+	if (len < 12 || memcmp(buf, "HTTP/1.1 ", 9)) return -1;
+	if (!isdigit((int) buf[9]) || !isdigit((int) buf[10]) || !isdigit((int) buf[11])) return -1;
+	int status = (buf[9] - '0') * 100 + (buf[10] - '0') * 10 + (buf[11] - '0');
+
+	// protocol switch, the connection is no more http
+	if (status == 101) return -1;
+	// informational response, the real one will follow
+	if (status >= 100 && status < 200) {
+		hr->resp_state = HR_RESP_HEADERS;
+		return 0;
+	}
+
+	int chunked = 0;
+	int has_size = 0;
+	size_t content_length = 0;
+
+	char *ptr = memchr(buf, '\n', len);
+	if (!ptr) return -1;
+	ptr++;
+	char *watermark = buf + len;
+
+	while (ptr < watermark) {
+		char *eol = memchr(ptr, '\n', watermark - ptr);
+		if (!eol) break;
+		size_t line_len = eol - ptr;
+		if (line_len > 0 && ptr[line_len - 1] == '\r') line_len--;
+		// end of headers
+		if (line_len == 0) break;
+
+		char *colon = memchr(ptr, ':', line_len);
+		if (!colon) return -1;
+		size_t keylen = colon - ptr;
+		char *val = colon + 1;
+		size_t vallen = line_len - (keylen + 1);
+		while (vallen > 0 && (*val == ' ' || *val == '\t')) {
+			val++;
+			vallen--;
+		}
+		while (vallen > 0 && (val[vallen - 1] == ' ' || val[vallen - 1] == '\t')) {
+			vallen--;
+		}
+
+		if (!uwsgi_strnicmp(ptr, keylen, "Content-Length", 14)) {
+			if (vallen == 0) return -1;
+			size_t i, cl = 0;
+			for (i = 0; i < vallen; i++) {
+				if (!isdigit((int) val[i])) return -1;
+				cl = (cl * 10) + (val[i] - '0');
+			}
+			// conflicting sizes
+			if (has_size && cl != content_length) return -1;
+			has_size = 1;
+			content_length = cl;
+		}
+		else if (!uwsgi_strnicmp(ptr, keylen, "Transfer-Encoding", 17)) {
+			if (uwsgi_strnicmp(val, vallen, "chunked", 7)) return -1;
+			chunked = 1;
+		}
+		else if (!uwsgi_strnicmp(ptr, keylen, "Connection", 10)) {
+			if (!uwsgi_strnicmp(val, vallen, "close", 5)) return -1;
+		}
+
+		ptr = eol + 1;
+	}
+
+	if (hr->resp_head || status == 204 || status == 304) {
+		hr->resp_state = HR_RESP_DONE;
+	}
+	else if (chunked) {
+		hr->resp_state = HR_RESP_CHUNK_SIZE;
+		hr->resp_remains = 0;
+		hr->resp_digits = 0;
+	}
+	else if (has_size) {
+		hr->resp_remains = content_length;
+		hr->resp_state = content_length ? HR_RESP_BODY : HR_RESP_DONE;
+	}
+	// the body ends when the backend closes the connection
+	else {
+		return -1;
+	}
+
+	return 0;
+}
+
+// returns 1 when the response ends exactly at the end of buf, 0 if more data is needed, -1 if the response cannot be framed
+int hr_response_frame(struct http_session *hr, char *buf, size_t len) {
+	size_t i = 0;
+	while (i < len) {
+		char c;
+		size_t chunk;
+		switch (hr->resp_state) {
+			case HR_RESP_HEADERS:
+				chunk = i;
+				for (; i < len; i++) {
+					c = buf[i];
+					if (c == '\r' && (hr->resp_rnrn == 0 || hr->resp_rnrn == 2)) {
+						hr->resp_rnrn++;
+					}
+					else if (c == '\r') {
+						hr->resp_rnrn = 1;
+					}
+					else if (c == '\n' && hr->resp_rnrn == 1) {
+						hr->resp_rnrn = 2;
+					}
+					else if (c == '\n' && hr->resp_rnrn == 3) {
+						hr->resp_rnrn = 4;
+						i++;
+						break;
+					}
+					else {
+						hr->resp_rnrn = 0;
+					}
+				}
+				if (uwsgi_buffer_append(hr->resp_headers, buf + chunk, i - chunk)) return -1;
+				if (hr->resp_rnrn != 4) return 0;
+				hr->resp_rnrn = 0;
+				if (hr_response_frame_headers(hr)) return -1;
+				hr->resp_headers->pos = 0;
+				break;
+			case HR_RESP_BODY:
+			case HR_RESP_CHUNK_DATA:
+				chunk = UMIN(hr->resp_remains, len - i);
+				i += chunk;
+				hr->resp_remains -= chunk;
+				if (hr->resp_remains == 0) {
+					hr->resp_state = hr->resp_state == HR_RESP_BODY ? HR_RESP_DONE : HR_RESP_CHUNK_CRLF;
+				}
+				break;
+			case HR_RESP_CHUNK_SIZE:
+			case HR_RESP_CHUNK_EXT:
+				c = buf[i++];
+				if (c == '\n') {
+					if (!hr->resp_digits) return -1;
+					hr->resp_digits = 0;
+					if (hr->resp_remains == 0) {
+						hr->resp_line = 0;
+						hr->resp_state = HR_RESP_TRAILERS;
+					}
+					else {
+						hr->resp_state = HR_RESP_CHUNK_DATA;
+					}
+				}
+				else if (hr->resp_state == HR_RESP_CHUNK_EXT) {
+					// skip chunk extensions
+				}
+				else if (isxdigit((int) c)) {
+					if (hr->resp_remains > (SIZE_MAX >> 4)) return -1;
+					hr->resp_remains = (hr->resp_remains << 4) + (isdigit((int) c) ? c - '0' : (tolower((int) c) - 'a') + 10);
+					hr->resp_digits++;
+				}
+				else if (c == ';' || c == ' ' || c == '\t' || c == '\r') {
+					hr->resp_state = HR_RESP_CHUNK_EXT;
+				}
+				else {
+					return -1;
+				}
+				break;
+			case HR_RESP_CHUNK_CRLF:
+				c = buf[i++];
+				if (c == '\n') {
+					hr->resp_state = HR_RESP_CHUNK_SIZE;
+				}
+				else if (c != '\r') {
+					return -1;
+				}
+				break;
+			case HR_RESP_TRAILERS:
+				c = buf[i++];
+				if (c == '\n') {
+					if (hr->resp_line == 0) {
+						hr->resp_state = HR_RESP_DONE;
+					}
+					hr->resp_line = 0;
+				}
+				else if (c != '\r') {
+					hr->resp_line++;
+				}
+				break;
+			// garbage after the end of the response
+			default:
+				return -1;
+		}
+	}
+
+	return hr->resp_state == HR_RESP_DONE;
+}
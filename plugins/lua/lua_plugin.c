@@ -293,6 +293,85 @@ static int uwsgi_api_metric_dec(lua_State *L) {
 	return uwsgi_lua_metric_do(L, uwsgi_metric_dec);
 }
 
+static int uwsgi_api_metric_handle(lua_State *L) {
+
+	if (!(lua_gettop(L)) || !(lua_isstring(L, 1))) {
+		return 0;
+	}
+
+	struct uwsgi_metric *um = uwsgi_metric_handle((char *) uwsgi_lua_tostring(L, 1), NULL);
+	if (!um) {
+		return 0;
+	}
+
+	lua_pushnumber(L, um->id);
+
+	return 1;
+}
+
+static int uwsgi_lua_metric_handle_do(lua_State *L, int metric_do(struct uwsgi_metric *, int64_t)) {
+
+	int64_t value = 1;
+
+	if (!(lua_gettop(L)) || !(lua_isnumber(L, 1))) {
+		return 0;
+	}
+
+	struct uwsgi_metric *um = uwsgi_metric_by_id(lua_tonumber(L, 1));
+	if (!um) {
+		return 0;
+	}
+
+	if (lua_gettop(L) > 1) {
+		value = lua_tonumber(L, 2);
+
+		if (!value && !lua_isnumber(L, 2)) {
+			value = 1;
+		}
+	}
+
+	if (metric_do(um, value)) {
+		return 0;
+	}
+
+	lua_pushboolean(L, 1);
+
+	return 1;
+}
+
+static int uwsgi_api_metric_inc_handle(lua_State *L) {
+	return uwsgi_lua_metric_handle_do(L, uwsgi_metric_handle_inc);
+}
+
+static int uwsgi_api_metric_dec_handle(lua_State *L) {
+	return uwsgi_lua_metric_handle_do(L, uwsgi_metric_handle_dec);
+}
+
+static int uwsgi_api_metric_set_handle(lua_State *L) {
+
+	if (lua_gettop(L) < 2 || !(lua_isnumber(L, 2))) {
+		return 0;
+	}
+
+	return uwsgi_lua_metric_handle_do(L, uwsgi_metric_handle_set);
+}
+
+static int uwsgi_api_metric_get_handle(lua_State *L) {
+
+	if (!(lua_gettop(L)) || !(lua_isnumber(L, 1))) {
+		return 0;
+	}
+
+	struct uwsgi_metric *um = uwsgi_metric_by_id(lua_tonumber(L, 1));
+	if (!um) {
+		return 0;
+	}
+
+	lua_pushnumber(L, uwsgi_metric_handle_get(um));
+
+	return 1;
+}
+
 static const char *uwsgi_lua_log_tostring(lua_State *L, int obj, size_t *len) {
 
 	int type = lua_type(L, obj);
@@ -492,6 +571,22 @@ static int uwsgi_api_register_rpc(lua_State *L) {
 }
 
 
+// build a batch from the keys in the stack (from index 'first' to 'last')
+static struct uwsgi_cache_mitem *uwsgi_lua_cache_mitems(lua_State *L, uint16_t first, uint16_t last) {
+
+	size_t keylen;
+	uint16_t i;
+
+	struct uwsgi_cache_mitem *items = uwsgi_calloc(sizeof(struct uwsgi_cache_mitem) * (last - first + 1));
+
+	for (i = first; i <= last; i++) {
+		items[i - first].key = (char *) uwsgi_lua_tolstring(L, i, &keylen);
+		items[i - first].keylen = keylen;
+	}
+
+	return items;
+}
+
 static int uwsgi_lua_cache_magic_set_value(lua_State *L, uint16_t argc, uint8_t isnum, uint64_t flag) {
 
 	char *cache = NULL;
@@ -768,17 +863,23 @@ static int uwsgi_api_cache_keys(lua_State *L) {
 
 	lua_newtable(L);
 
-	uwsgi_rlock(uc->lock);
-	do {
-		uci = uwsgi_cache_keys(uc, &pos, &uci);
-
-		if (uci) {
-			lua_pushlstring(L, uci->key, uci->keysize);
-			lua_rawseti(L, -2, ++i);
-		}
+	uint64_t j;
+	for (j = 0; j < uwsgi_cache_nshards(uc); j++) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, j);
+		uci = NULL;
+		pos = 0;
+		uwsgi_rlock(ucs->lock);
+		do {
+			uci = uwsgi_cache_keys(ucs, &pos, &uci);
+
+			if (uci) {
+				lua_pushlstring(L, uci->key, uci->keysize);
+				lua_rawseti(L, -2, ++i);
+			}
 
-	} while (uci);
-	uwsgi_rwunlock(uc->lock);
+		} while (uci);
+		uwsgi_rwunlock(ucs->lock);
+	}
 
 	return 1;
 }
@@ -849,8 +950,7 @@ static int uwsgi_api_cache_exists(lua_State *L) {
 
 static int uwsgi_api_cache_del_multi(lua_State *L) {
 
-	size_t keylen;
-	char *key;
+	struct uwsgi_cache_mitem *items;
 	char *cache;
 
 	uint16_t argc = lua_gettop(L);
@@ -863,12 +963,17 @@ static int uwsgi_api_cache_del_multi(lua_State *L) {
 
 	cache = (char *) uwsgi_lua_tostring(L, 1);
 
-	for (i = 2; i <= argc; i++) {
-		key = (char *) uwsgi_lua_tolstring(L, i, &keylen);
+	if (argc > 1) {
+		items = uwsgi_lua_cache_mitems(L, 2, argc);
+		uwsgi_cache_magic_mdel(items, argc - 1, cache);
 
-		if (!keylen || uwsgi_cache_magic_del(key, keylen, cache)) {
-			++error;
+		for (i = 0; i < argc - 1; i++) {
+			if (!items[i].keylen || items[i].status) {
+				++error;
+			}
 		}
+
+		free(items);
 	}
 
 	if (!error) {
@@ -1765,11 +1870,7 @@ static int uwsgi_api_cache_getnum(lua_State *L) {
 
 static int uwsgi_lua_cache_magic_get_multi(lua_State *L, uint8_t getnum) {
 
-	char *value ;
-	uint64_t valsize;
-
-	char *key;
-	size_t keylen;
+	struct uwsgi_cache_mitem *items;
 
 	char *cache;
 
@@ -1787,24 +1888,26 @@ static int uwsgi_lua_cache_magic_get_multi(lua_State *L, uint8_t getnum) {
 
 	cache = (char *) uwsgi_lua_tostring(L, 1);
 
-	for (i = 2; i <= argc; i++) {
-
-		key = (char *) uwsgi_lua_tolstring(L, i, &keylen);
+	// a single round trip (or a single lock per partition) for all of the keys
+	items = uwsgi_lua_cache_mitems(L, 2, argc);
+	uwsgi_cache_magic_mget(items, argc - 1, cache);
 
-		value = (keylen) ? uwsgi_cache_magic_get(key, keylen, &valsize, NULL, cache) : NULL;
+	for (i = 0; i < argc - 1; i++) {
 
-		if (value) {
+		if (items[i].keylen && items[i].value) {
 			if (getnum) {
-				lua_pushnumber(L, *((int64_t *) value));
+				lua_pushnumber(L, *((int64_t *) items[i].value));
 			} else {
-				lua_pushlstring(L, value, valsize);
+				lua_pushlstring(L, items[i].value, items[i].vallen);
 			}
-			free(value);
 		} else {
 			lua_pushnil(L);
 		}
+		free(items[i].value);
 	}
 
+	free(items);
+
 	return argc - 1;
 }
 
@@ -1818,11 +1921,7 @@ static int uwsgi_api_cache_getnum_multi(lua_State *L) {
 
 static int uwsgi_lua_cache_magic_get_tmulti(lua_State *L, uint8_t getnum) {
 
-	char *value ;
-	uint64_t valsize;
-
-	char *key;
-	size_t keylen;
+	struct uwsgi_cache_mitem *items;
 
 	char *cache;
 
@@ -1836,28 +1935,29 @@ static int uwsgi_lua_cache_magic_get_tmulti(lua_State *L, uint8_t getnum) {
 
 	cache = (char *) uwsgi_lua_tostring(L, 1);
 
-	lua_createtable(L, 0, argc - 1);
-
-	for (i = 2; i <= argc; i++) {
+	items = uwsgi_lua_cache_mitems(L, 2, argc);
+	uwsgi_cache_magic_mget(items, argc - 1, cache);
 
-		key = (char *) uwsgi_lua_tolstring(L, i, &keylen);
+	lua_createtable(L, 0, argc - 1);
 
-		value = (keylen) ? uwsgi_cache_magic_get(key, keylen, &valsize, NULL, cache) : NULL;
+	for (i = 0; i < argc - 1; i++) {
 
-		if (value) {
+		if (items[i].keylen && items[i].value) {
 			if (getnum) {
-				lua_pushnumber(L, *((int64_t *) value));
+				lua_pushnumber(L, *((int64_t *) items[i].value));
 			} else {
-				lua_pushlstring(L, value, valsize);
+				lua_pushlstring(L, items[i].value, items[i].vallen);
 			}
-			free(value);
-			lua_setfield(L, -2, key);
+			lua_setfield(L, -2, items[i].key);
 		} else {
 			++error;
 		}
+		free(items[i].value);
 
 	}
 
+	free(items);
+
 	if (!error) {
 		return 1;
 	}
@@ -2666,6 +2766,11 @@ static const luaL_Reg uwsgi_api_base[] = {
   {"metric_div", uwsgi_api_metric_div},
   {"metric_mul", uwsgi_api_metric_mul},
   {"metric_dec", uwsgi_api_metric_dec},
+  {"metric_handle", uwsgi_api_metric_handle},
+  {"metric_inc_handle", uwsgi_api_metric_inc_handle},
+  {"metric_dec_handle", uwsgi_api_metric_dec_handle},
+  {"metric_set_handle", uwsgi_api_metric_set_handle},
+  {"metric_get_handle", uwsgi_api_metric_get_handle},
 
   {"cache_get", uwsgi_api_cache_get},
   {"cache_get_multi", uwsgi_api_cache_get_multi},
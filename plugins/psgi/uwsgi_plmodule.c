@@ -771,6 +771,74 @@ XS(XS_metric_get) {
         XSRETURN(1);
 }
 
+XS(XS_metric_handle) {
+        dXSARGS;
+        char *metric = NULL;
+        STRLEN metric_len = 0;
+        psgi_check_args(1);
+        metric = SvPV(ST(0), metric_len);
+        struct uwsgi_metric *um = uwsgi_metric_handle(metric, NULL);
+        if (!um) {
+                XSRETURN_UNDEF;
+        }
+        ST(0) = newSVuv(um->id);
+        sv_2mortal(ST(0));
+        XSRETURN(1);
+}
+
+XS(XS_metric_inc_handle) {
+        dXSARGS;
+        int64_t value = 1;
+        psgi_check_args(1);
+        struct uwsgi_metric *um = uwsgi_metric_by_id((uint64_t) SvUV(ST(0)));
+        if (items > 1) {
+                value = (int64_t) SvIV(ST(1));
+        }
+        if (!um || uwsgi_metric_handle_inc(um, value)) {
+                croak("unable to update metric");
+                XSRETURN_UNDEF;
+        }
+        XSRETURN_YES;
+}
+
+XS(XS_metric_dec_handle) {
+        dXSARGS;
+        int64_t value = 1;
+        psgi_check_args(1);
+        struct uwsgi_metric *um = uwsgi_metric_by_id((uint64_t) SvUV(ST(0)));
+        if (items > 1) {
+                value = (int64_t) SvIV(ST(1));
+        }
+        if (!um || uwsgi_metric_handle_dec(um, value)) {
+                croak("unable to update metric");
+                XSRETURN_UNDEF;
+        }
+        XSRETURN_YES;
+}
+
+XS(XS_metric_set_handle) {
+        dXSARGS;
+        psgi_check_args(2);
+        struct uwsgi_metric *um = uwsgi_metric_by_id((uint64_t) SvUV(ST(0)));
+        if (!um || uwsgi_metric_handle_set(um, (int64_t) SvIV(ST(1)))) {
+                croak("unable to update metric");
+                XSRETURN_UNDEF;
+        }
+        XSRETURN_YES;
+}
+
+XS(XS_metric_get_handle) {
+        dXSARGS;
+        psgi_check_args(1);
+        struct uwsgi_metric *um = uwsgi_metric_by_id((uint64_t) SvUV(ST(0)));
+        if (!um) {
+                XSRETURN_UNDEF;
+        }
+        ST(0) = newSViv(uwsgi_metric_handle_get(um));
+        sv_2mortal(ST(0));
+        XSRETURN(1);
+}
+
 XS(XS_sharedarea_wait) {
         dXSARGS;
         int id;
@@ -1081,6 +1149,11 @@ void init_perl_embedded_module() {
 	psgi_xs(metric_div);
 	psgi_xs(metric_get);
 	psgi_xs(metric_set);
+	psgi_xs(metric_handle);
+	psgi_xs(metric_inc_handle);
+	psgi_xs(metric_dec_handle);
+	psgi_xs(metric_set_handle);
+	psgi_xs(metric_get_handle);
 
 	psgi_xs(chunked_read);
 	psgi_xs(chunked_read_nb);
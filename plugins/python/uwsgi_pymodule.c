@@ -3515,16 +3515,183 @@ PyObject *py_uwsgi_cache_keys(PyObject * self, PyObject * args) {
 
 	PyObject *l = PyList_New(0);
 
-	uwsgi_rlock(uc->lock);
-        for(;;) {
-                uci = uwsgi_cache_keys(uc, &pos, &uci);
-                if (!uci) break;
-		PyObject *ci = PyString_FromStringAndSize(uci->key, uci->keysize);
-		PyList_Append(l, ci);
-		Py_DECREF(ci);
-        }
-	uwsgi_rwunlock(uc->lock);
+	uint64_t i;
+	for (i = 0; i < uwsgi_cache_nshards(uc); i++) {
+		struct uwsgi_cache *ucs = uwsgi_cache_shard_n(uc, i);
+		uci = NULL;
+		pos = 0;
+		uwsgi_rlock(ucs->lock);
+        	for(;;) {
+                	uci = uwsgi_cache_keys(ucs, &pos, &uci);
+                	if (!uci) break;
+			PyObject *ci = PyString_FromStringAndSize(uci->key, uci->keysize);
+			PyList_Append(l, ci);
+			Py_DECREF(ci);
+        	}
+		uwsgi_rwunlock(ucs->lock);
+	}
+	return l;
+}
+
+// parse a sequence of keys in an array of batch items (the returned list holds the references)
+static PyObject *py_uwsgi_cache_mitems_keys(PyObject *keys, struct uwsgi_cache_mitem **items, Py_ssize_t *n) {
+	PyObject *l = PySequence_List(keys);
+	if (!l) return NULL;
+	*n = PyList_Size(l);
+	*items = uwsgi_calloc(sizeof(struct uwsgi_cache_mitem) * (*n + 1));
+	Py_ssize_t i;
+	for (i = 0; i < *n; i++) {
+		Py_ssize_t keylen = 0;
+		if (!PyArg_Parse(PyList_GetItem(l, i), "s#", &(*items)[i].key, &keylen)) goto error;
+		if (keylen > 0xffff) {
+			PyErr_SetString(PyExc_ValueError, "cache key too long");
+			goto error;
+		}
+		(*items)[i].keylen = keylen;
+	}
 	return l;
+error:
+	free(*items);
+	Py_DECREF(l);
+	return NULL;
+}
+
+PyObject *py_uwsgi_cache_mget(PyObject * self, PyObject * args) {
+	PyObject *keys;
+	char *cache = NULL;
+	struct uwsgi_cache_mitem *items = NULL;
+	Py_ssize_t n = 0, i;
+
+	if (!PyArg_ParseTuple(args, "O|s:cache_mget", &keys, &cache)) {
+		return NULL;
+	}
+
+	PyObject *l = py_uwsgi_cache_mitems_keys(keys, &items, &n);
+	if (!l) return NULL;
+
+	UWSGI_RELEASE_GIL
+	int ret = uwsgi_cache_magic_mget(items, n, cache);
+	UWSGI_GET_GIL
+
+	PyObject *res = NULL;
+	if (ret >= 0) {
+		res = PyList_New(n);
+		for (i = 0; i < n; i++) {
+			if (items[i].value) {
+				PyList_SetItem(res, i, PyString_FromStringAndSize(items[i].value, items[i].vallen));
+			}
+			else {
+				Py_INCREF(Py_None);
+				PyList_SetItem(res, i, Py_None);
+			}
+		}
+	}
+	else {
+		Py_INCREF(Py_None);
+		res = Py_None;
+	}
+
+	for (i = 0; i < n; i++) {
+		free(items[i].value);
+	}
+	free(items);
+	Py_DECREF(l);
+	return res;
+}
+
+static PyObject *py_uwsgi_cache_mset_do(PyObject * args, uint64_t flags, char *fmt) {
+	PyObject *dict;
+	uint64_t expires = 0;
+	char *cache = NULL;
+
+	if (!PyArg_ParseTuple(args, fmt, &dict, &expires, &cache)) {
+		return NULL;
+	}
+
+	if (!PyDict_Check(dict)) {
+		return PyErr_Format(PyExc_TypeError, "a dictionary is required");
+	}
+
+	// the list of (key, value) tuples keeps the objects alive without the GIL
+	PyObject *l = PyDict_Items(dict);
+	if (!l) return NULL;
+
+	Py_ssize_t n = PyList_Size(l), i;
+	struct uwsgi_cache_mitem *items = uwsgi_calloc(sizeof(struct uwsgi_cache_mitem) * (n + 1));
+	for (i = 0; i < n; i++) {
+		Py_ssize_t keylen = 0, vallen = 0;
+		PyObject *kv = PyList_GetItem(l, i);
+		if (!PyArg_Parse(PyTuple_GetItem(kv, 0), "s#", &items[i].key, &keylen)) goto error;
+		if (!PyArg_Parse(PyTuple_GetItem(kv, 1), "s#", &items[i].value, &vallen)) goto error;
+		if (keylen > 0xffff) {
+			PyErr_SetString(PyExc_ValueError, "cache key too long");
+			goto error;
+		}
+		items[i].keylen = keylen;
+		items[i].vallen = vallen;
+		items[i].expires = expires;
+	}
+
+	UWSGI_RELEASE_GIL
+	int ret = uwsgi_cache_magic_mset(items, n, flags, cache);
+	UWSGI_GET_GIL
+
+	long stored = 0;
+	for (i = 0; i < n; i++) {
+		if (!items[i].status) stored++;
+	}
+	free(items);
+	Py_DECREF(l);
+
+	if (ret < 0) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+	return PyInt_FromLong(stored);
+
+error:
+	free(items);
+	Py_DECREF(l);
+	return NULL;
+}
+
+PyObject *py_uwsgi_cache_mset(PyObject * self, PyObject * args) {
+	return py_uwsgi_cache_mset_do(args, 0, "O|ls:cache_mset");
+}
+
+PyObject *py_uwsgi_cache_mupdate(PyObject * self, PyObject * args) {
+	return py_uwsgi_cache_mset_do(args, UWSGI_CACHE_FLAG_UPDATE, "O|ls:cache_mupdate");
+}
+
+PyObject *py_uwsgi_cache_mdel(PyObject * self, PyObject * args) {
+	PyObject *keys;
+	char *cache = NULL;
+	struct uwsgi_cache_mitem *items = NULL;
+	Py_ssize_t n = 0, i;
+
+	if (!PyArg_ParseTuple(args, "O|s:cache_mdel", &keys, &cache)) {
+		return NULL;
+	}
+
+	PyObject *l = py_uwsgi_cache_mitems_keys(keys, &items, &n);
+	if (!l) return NULL;
+
+	UWSGI_RELEASE_GIL
+	int ret = uwsgi_cache_magic_mdel(items, n, cache);
+	UWSGI_GET_GIL
+
+	long removed = 0;
+	for (i = 0; i < n; i++) {
+		if (!items[i].status) removed++;
+	}
+	free(items);
+	Py_DECREF(l);
+
+	if (ret < 0) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+	return PyInt_FromLong(removed);
 }
 
 
@@ -3541,6 +3708,10 @@ static PyMethodDef uwsgi_cache_methods[] = {
 	{"cache_div", py_uwsgi_cache_div, METH_VARARGS, ""},
 	{"cache_num", py_uwsgi_cache_num, METH_VARARGS, ""},
 	{"cache_keys", py_uwsgi_cache_keys, METH_VARARGS, ""},
+	{"cache_mget", py_uwsgi_cache_mget, METH_VARARGS, ""},
+	{"cache_mset", py_uwsgi_cache_mset, METH_VARARGS, ""},
+	{"cache_mupdate", py_uwsgi_cache_mupdate, METH_VARARGS, ""},
+	{"cache_mdel", py_uwsgi_cache_mdel, METH_VARARGS, ""},
 	{NULL, NULL},
 };
 
@@ -3685,6 +3856,83 @@ PyObject *py_uwsgi_metric_set_min(PyObject * self, PyObject * args) {
 
 }
 
+PyObject *py_uwsgi_metric_handle(PyObject * self, PyObject * args) {
+        char *key;
+        if (!PyArg_ParseTuple(args, "s:metric_handle", &key)) return NULL;
+
+        struct uwsgi_metric *um = uwsgi_metric_handle(key, NULL);
+        if (!um) {
+                Py_INCREF(Py_None);
+                return Py_None;
+        }
+        return PyLong_FromUnsignedLongLong(um->id);
+}
+
+// handle based operations are lock-free (or hold the lock for a very short time), no need to release the GIL
+static PyObject *py_uwsgi_metric_handle_do(PyObject * args, char *format, int (*func)(struct uwsgi_metric *, int64_t)) {
+        unsigned long long id;
+        int64_t value = 1;
+        if (!PyArg_ParseTuple(args, format, &id, &value)) return NULL;
+
+        struct uwsgi_metric *um = uwsgi_metric_by_id(id);
+        if (!um || func(um, value)) {
+                Py_INCREF(Py_None);
+                return Py_None;
+        }
+        Py_INCREF(Py_True);
+        return Py_True;
+}
+
+PyObject *py_uwsgi_metric_inc_handle(PyObject * self, PyObject * args) {
+        return py_uwsgi_metric_handle_do(args, "K|l:metric_inc_handle", uwsgi_metric_handle_inc);
+}
+
+PyObject *py_uwsgi_metric_dec_handle(PyObject * self, PyObject * args) {
+        return py_uwsgi_metric_handle_do(args, "K|l:metric_dec_handle", uwsgi_metric_handle_dec);
+}
+
+PyObject *py_uwsgi_metric_set_handle(PyObject * self, PyObject * args) {
+        return py_uwsgi_metric_handle_do(args, "Kl:metric_set_handle", uwsgi_metric_handle_set);
+}
+
+PyObject *py_uwsgi_metric_get_handle(PyObject * self, PyObject * args) {
+        unsigned long long id;
+        if (!PyArg_ParseTuple(args, "K:metric_get_handle", &id)) return NULL;
+
+        struct uwsgi_metric *um = uwsgi_metric_by_id(id);
+        if (!um) {
+                Py_INCREF(Py_None);
+                return Py_None;
+        }
+        return PyLong_FromLongLong(uwsgi_metric_handle_get(um));
+}
+
+PyObject *py_uwsgi_metric_observe(PyObject * self, PyObject * args) {
+        char *key;
+        unsigned long long value;
+        if (!PyArg_ParseTuple(args, "sK:metric_observe", &key, &value)) return NULL;
+
+        if (uwsgi_metric_observe(key, NULL, value)) {
+                Py_INCREF(Py_None);
+                return Py_None;
+        }
+        Py_INCREF(Py_True);
+        return Py_True;
+}
+
+PyObject *py_uwsgi_metric_observe_handle(PyObject * self, PyObject * args) {
+        unsigned long long id;
+        unsigned long long value;
+        if (!PyArg_ParseTuple(args, "KK:metric_observe_handle", &id, &value)) return NULL;
+
+        struct uwsgi_metric *um = uwsgi_metric_by_id(id);
+        if (!um || uwsgi_metric_handle_observe(um, value)) {
+                Py_INCREF(Py_None);
+                return Py_None;
+        }
+        Py_INCREF(Py_True);
+        return Py_True;
+}
 
 static PyMethodDef uwsgi_metrics_methods[] = {
 	{"metric_inc", py_uwsgi_metric_inc, METH_VARARGS, ""},
@@ -3695,6 +3943,13 @@ static PyMethodDef uwsgi_metrics_methods[] = {
 	{"metric_set", py_uwsgi_metric_set, METH_VARARGS, ""},
 	{"metric_set_max", py_uwsgi_metric_set_max, METH_VARARGS, ""},
 	{"metric_set_min", py_uwsgi_metric_set_min, METH_VARARGS, ""},
+	{"metric_handle", py_uwsgi_metric_handle, METH_VARARGS, ""},
+	{"metric_inc_handle", py_uwsgi_metric_inc_handle, METH_VARARGS, ""},
+	{"metric_dec_handle", py_uwsgi_metric_dec_handle, METH_VARARGS, ""},
+	{"metric_set_handle", py_uwsgi_metric_set_handle, METH_VARARGS, ""},
+	{"metric_get_handle", py_uwsgi_metric_get_handle, METH_VARARGS, ""},
+	{"metric_observe", py_uwsgi_metric_observe, METH_VARARGS, ""},
+	{"metric_observe_handle", py_uwsgi_metric_observe_handle, METH_VARARGS, ""},
 	{NULL, NULL},
 };
 
@@ -28,6 +28,7 @@ static struct uwsgi_option rawrouter_options[] = {
 	{"rawrouter", required_argument, 0, "run the rawrouter on the specified port", uwsgi_opt_undeferred_corerouter, &urr, 0},
 	{"rawrouter-processes", required_argument, 0, "prefork the specified number of rawrouter processes", uwsgi_opt_set_int, &urr.cr.processes, 0},
 	{"rawrouter-workers", required_argument, 0, "prefork the specified number of rawrouter processes", uwsgi_opt_set_int, &urr.cr.processes, 0},
+	{"rawrouter-threads", required_argument, 0, "run the specified number of event loop threads in each rawrouter process", uwsgi_opt_set_int, &urr.cr.threads, 0},
 	{"rawrouter-zerg", required_argument, 0, "attach the rawrouter to a zerg server", uwsgi_opt_corerouter_zerg, &urr, 0},
 	{"rawrouter-use-cache", optional_argument, 0, "use uWSGI cache as hostname->server mapper for the rawrouter", uwsgi_opt_set_str, &urr.cr.use_cache, 0},
 
@@ -57,6 +58,9 @@ static struct uwsgi_option rawrouter_options[] = {
 	{"rawrouter-xclient", no_argument, 0, "use the xclient protocol to pass the client address", uwsgi_opt_true, &urr.xclient, 0},
 
 	{"rawrouter-buffer-size", required_argument, 0, "set internal buffer size (default: page size)", uwsgi_opt_set_64bit, &urr.cr.buffer_size, 0},
+#ifdef __linux__
+	{"rawrouter-splice", no_argument, 0, "relay data between client and backend with splice() (zero-copy)", uwsgi_opt_true, &urr.cr.splice, 0},
+#endif
 
 	{0, 0, 0, 0, 0, 0, 0},
 };
@@ -106,6 +110,42 @@ static ssize_t rr_instance_read(struct corerouter_peer *peer) {
 	return len;
 }
 
+// write to backend (zero-copy)
+static ssize_t rr_splice_instance_write(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_write(peer, "rr_splice_instance_write()");
+	// end on empty write
+	if (!len) return 0;
+
+	// the pipe is empty, start (again) reading from client and instances
+	if (cr_splice_complete(peer)) {
+		cr_reset_hooks(peer);
+	}
+
+	return len;
+}
+
+// write to client (zero-copy)
+static ssize_t rr_splice_write(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_write(main_peer, "rr_splice_write()");
+	// end on empty write
+	if (!len) return 0;
+
+	if (cr_splice_complete(main_peer)) {
+		cr_reset_hooks(main_peer);
+	}
+
+	return len;
+}
+
+// read from backend (zero-copy)
+static ssize_t rr_splice_instance_read(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_read(peer, 0, "rr_splice_instance_read()");
+	if (!len) return 0;
+
+	cr_write_to_main(peer, rr_splice_write);
+	return len;
+}
+
 // write the xclient banner
 static ssize_t rr_xclient_write(struct corerouter_peer *peer) {
         struct corerouter_session *cs = peer->session;
@@ -116,13 +156,13 @@ static ssize_t rr_xclient_write(struct corerouter_peer *peer) {
         if (cr_write_complete_buf(peer, rr->xclient)) {
                 if (peer->session->main_peer->out_pos > 0) {
                         // (eventually) send previous data
-			peer->last_hook_read = rr_instance_read;
+			peer->last_hook_read = urr.cr.splice ? rr_splice_instance_read : rr_instance_read;
                         cr_write_to_main(peer, rr_write);
                 }
                 else {
                         // reset to standard behaviour
 			peer->in->pos = 0;
-			cr_reset_hooks_and_read(peer, rr_instance_read);
+			cr_reset_hooks_and_read(peer, urr.cr.splice ? rr_splice_instance_read : rr_instance_read);
                 }
         }
 
@@ -173,7 +213,7 @@ static ssize_t rr_instance_connected(struct corerouter_peer *peer) {
 		cr_reset_hooks_and_read(peer, rr_xclient_read);
 		return 1;
 	}
-	cr_reset_hooks_and_read(peer, rr_instance_read);
+	cr_reset_hooks_and_read(peer, urr.cr.splice ? rr_splice_instance_read : rr_instance_read);
 	return 1;
 }
 
@@ -189,6 +229,15 @@ static ssize_t rr_read(struct corerouter_peer *main_peer) {
 	return len;
 }
 
+// read from client (zero-copy)
+static ssize_t rr_splice_read(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_read(main_peer, 0, "rr_splice_read()");
+	if (!len) return 0;
+
+	cr_write_to_backend(main_peer->session->peers, rr_splice_instance_write);
+	return len;
+}
+
 // retry the connection
 static int rr_retry(struct corerouter_peer *peer) {
 
@@ -222,7 +271,7 @@ static void rr_session_close(struct corerouter_session *cs) {
 static int rawrouter_alloc_session(struct uwsgi_corerouter *ucr, struct uwsgi_gateway_socket *ugs, struct corerouter_session *cs, struct sockaddr *sa, socklen_t s_len) {
 
 	// set default read hook
-	cs->main_peer->last_hook_read = rr_read;
+	cs->main_peer->last_hook_read = urr.cr.splice ? rr_splice_read : rr_read;
 	// set close hook
 	cs->close = rr_session_close;
 	// set retry hook
@@ -12,6 +12,9 @@ extern struct uwsgi_server uwsgi;
 
 	route = /^foobar1(.*)/ cache:key=foo$1poo,content_type=text/html,name=foobar
 
+	values of caches with compress=gzip are sent without decompressing them
+	(with Content-Encoding: gzip) to the clients accepting the gzip encoding
+
 */
 
 struct uwsgi_router_cache_conf {
@@ -172,7 +175,9 @@ static int uwsgi_routing_func_cache(struct wsgi_request *wsgi_req, struct uwsgi_
 
 	uint64_t valsize = 0;
 	uint64_t expires = 0;
-	char *value = uwsgi_cache_magic_get(ub->buf, ub->pos, &valsize, &expires, urcc->name);
+	// compressed items can be sent as-is
+	int gzipped = !urcc->content_encoding_len && uwsgi_contains_n(wsgi_req->encoding, wsgi_req->encoding_len, "gzip", 4);
+	char *value = uwsgi_cache_magic_get_encoded(ub->buf, ub->pos, &valsize, &expires, &gzipped, urcc->name);
 	if (urcc->mime && value) {
 		mime_type = uwsgi_get_mime_type(ub->buf, ub->pos, &mime_type_len);	
 	}
@@ -188,6 +193,10 @@ static int uwsgi_routing_func_cache(struct wsgi_request *wsgi_req, struct uwsgi_
 		if (urcc->content_encoding_len) {
 			if (uwsgi_response_add_header(wsgi_req, "Content-Encoding", 16, urcc->content_encoding, urcc->content_encoding_len)) goto error;	
 		}
+		else if (gzipped) {
+			if (uwsgi_response_add_header(wsgi_req, "Content-Encoding", 16, "gzip", 4)) goto error;
+			if (uwsgi_response_add_header(wsgi_req, "Vary", 4, "Accept-Encoding", 15)) goto error;
+		}
 		if (expires) {
 			if (uwsgi_response_add_expires(wsgi_req, expires)) goto error;	
 		}
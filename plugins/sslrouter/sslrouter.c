@@ -23,6 +23,9 @@ static struct uwsgi_sslrouter {
 struct sslrouter_session {
 	struct corerouter_session session;
 	SSL *ssl;
+	// directions offloaded to kernel TLS (checked once the handshake is complete)
+	int ktls;
+	int ktls_checked;
 };
 
 static void uwsgi_opt_sslrouter(char *opt, char *value, void *cr) {
@@ -69,6 +72,7 @@ static void uwsgi_opt_sslrouter(char *opt, char *value, void *cr) {
         if (!ugs->ctx) {
                 exit(1);
         }
+	ucr->has_ssl_sockets++;
 
         ucr->has_sockets++;
 }
@@ -117,6 +121,7 @@ static void uwsgi_opt_sslrouter2(char *opt, char *value, void *cr) {
         if (!ugs->ctx) {
                 exit(1);
         }
+	ucr->has_ssl_sockets++;
         ucr->has_sockets++;
 }
 
@@ -127,6 +132,7 @@ static struct uwsgi_option sslrouter_options[] = {
 	{"sslrouter-session-context", required_argument, 0, "set the session id context to the specified value", uwsgi_opt_set_str, &usr.ssl_session_context, 0},
 	{"sslrouter-processes", required_argument, 0, "prefork the specified number of sslrouter processes", uwsgi_opt_set_int, &usr.cr.processes, 0},
 	{"sslrouter-workers", required_argument, 0, "prefork the specified number of sslrouter processes", uwsgi_opt_set_int, &usr.cr.processes, 0},
+	{"sslrouter-threads", required_argument, 0, "run the specified number of event loop threads in each sslrouter process", uwsgi_opt_set_int, &usr.cr.threads, 0},
 	{"sslrouter-zerg", required_argument, 0, "attach the sslrouter to a zerg server", uwsgi_opt_corerouter_zerg, &usr, 0},
 	{"sslrouter-use-cache", optional_argument, 0, "use uWSGI cache as hostname->server mapper for the sslrouter", uwsgi_opt_set_str, &usr.cr.use_cache, 0},
 
@@ -156,6 +162,9 @@ static struct uwsgi_option sslrouter_options[] = {
 	{"sslrouter-sni", no_argument, 0, "use SNI to route requests", uwsgi_opt_true, &usr.sni, 0},
 #endif
 	{"sslrouter-buffer-size", required_argument, 0, "set internal buffer size (default: page size)", uwsgi_opt_set_64bit, &usr.cr.buffer_size, 0},
+#ifdef __linux__
+	{"sslrouter-splice", no_argument, 0, "relay responses to kernel TLS clients with splice() (zero-copy)", uwsgi_opt_true, &usr.cr.splice, 0},
+#endif
 
 	{0, 0, 0, 0, 0, 0, 0},
 };
@@ -178,8 +187,33 @@ static ssize_t sr_instance_write(struct corerouter_peer *peer) {
 	return len;
 }
 
+// write to the client (zero-copy, the kernel encrypts the records)
+static ssize_t sr_splice_write(struct corerouter_peer *main_peer) {
+	ssize_t len = cr_splice_write(main_peer, "sr_splice_write()");
+	// end on empty write
+	if (!len) return 0;
+
+	if (cr_splice_complete(main_peer)) {
+		cr_reset_hooks(main_peer);
+	}
+
+	return len;
+}
+
+// read from backend (zero-copy)
+static ssize_t sr_splice_instance_read(struct corerouter_peer *peer) {
+	ssize_t len = cr_splice_read(peer, 0, "sr_splice_instance_read()");
+	if (!len) return 0;
+
+	cr_write_to_main(peer, sr_splice_write);
+	return len;
+}
+
 // read from backend
 static ssize_t sr_instance_read(struct corerouter_peer *peer) {
+	struct sslrouter_session *sr = (struct sslrouter_session *) peer->session;
+	if (usr.cr.splice && (sr->ktls & UWSGI_SSL_KTLS_TX)) return sr_splice_instance_read(peer);
+
 	ssize_t len = cr_read(peer, "sr_instance_read()");
 	if (!len) return 0;
 
@@ -267,6 +301,11 @@ static ssize_t sr_read(struct corerouter_peer *main_peer) {
 
         int ret = SSL_read(sr->ssl, main_peer->in->buf + main_peer->in->pos, main_peer->in->len - main_peer->in->pos);
         if (ret > 0) {
+		// the handshake is complete, check for resumption and if the kernel took over the records encryption
+		if (!sr->ktls_checked) {
+			sr->ktls_checked = 1;
+			sr->ktls = corerouter_ssl_handshake_done(cs->corerouter, sr->ssl);
+		}
                 // fix the buffer
                 main_peer->in->pos += ret;
                 // check for pending data
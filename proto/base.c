@@ -318,6 +318,24 @@ int uwsgi_proto_base_sendfile(struct wsgi_request * wsgi_req, int fd, size_t pos
 int uwsgi_proto_ssl_sendfile(struct wsgi_request *wsgi_req, int fd, size_t pos, size_t len) {
 	char buf[32768];
 
+#ifdef UWSGI_SSL_KTLS
+	// the kernel encrypts the records, so the file can be sent without copying it to userspace
+	if (uwsgi_ssl_ktls(wsgi_req->ssl) & UWSGI_SSL_KTLS_TX) {
+		ossl_ssize_t wlen = SSL_sendfile(wsgi_req->ssl, fd, pos+wsgi_req->write_pos, len-wsgi_req->write_pos, 0);
+		if (wlen > 0) {
+			wsgi_req->write_pos += wlen;
+			if (wsgi_req->write_pos == len) {
+				return UWSGI_OK;
+			}
+			return UWSGI_AGAIN;
+		}
+		if (SSL_get_error(wsgi_req->ssl, wlen) == SSL_ERROR_WANT_WRITE) {
+			return UWSGI_AGAIN;
+		}
+		return -1;
+	}
+#endif
+
 	if (lseek(fd, pos+wsgi_req->write_pos, SEEK_SET) < 0) {
 		uwsgi_error("lseek()");
 		return -1;
@@ -0,0 +1,73 @@
+import uwsgi
+import unittest
+from uwsgitest import UwsgiServerTest, free_port
+
+
+class BatchTest(UwsgiServerTest):
+
+    __caches__ = [
+        'batch',
+        'batch_sharded',
+        'batch_compact',
+        'batch_small',
+    ]
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_mset_mget(self):
+        for cache in self.__caches__[:3]:
+            items = dict(('key%d' % i, 'value%d' % i) for i in range(50))
+            self.assertEqual(uwsgi.cache_mset(items, 0, cache), 50)
+            keys = ['key%d' % i for i in range(60)]
+            values = uwsgi.cache_mget(keys, cache)
+            self.assertEqual(len(values), 60)
+            for i in range(50):
+                self.assertEqual(values[i], ('value%d' % i).encode())
+            for i in range(50, 60):
+                self.assertIsNone(values[i])
+            # mixed with single key operations
+            self.assertEqual(uwsgi.cache_get('key7', cache), b'value7')
+
+    def test_mset_existing(self):
+        for cache in self.__caches__[:3]:
+            self.assertTrue(uwsgi.cache_set('key1', 'old', 0, cache))
+            self.assertEqual(uwsgi.cache_mset({'key1': 'new', 'key2': 'new'}, 0, cache), 1)
+            self.assertEqual(uwsgi.cache_mupdate({'key1': 'new', 'key2': 'new2'}, 0, cache), 2)
+            self.assertEqual(uwsgi.cache_mget(['key1', 'key2'], cache), [b'new', b'new2'])
+
+    def test_mdel(self):
+        for cache in self.__caches__[:3]:
+            uwsgi.cache_mset(dict(('key%d' % i, 'X') for i in range(20)), 0, cache)
+            self.assertEqual(uwsgi.cache_mdel(['key%d' % i for i in range(10, 30)], cache), 10)
+            self.assertEqual(sorted(uwsgi.cache_keys(cache)), sorted([('key%d' % i).encode() for i in range(10)]))
+
+    def test_partial_failure(self):
+        # items too big or not fitting in the cache fail one by one
+        self.assertEqual(uwsgi.cache_mset({'a': 'X', 'b': 'X' * 17}, 0, 'batch_small'), 1)
+        self.assertEqual(uwsgi.cache_mset(dict(('key%d' % i, 'X') for i in range(20)), 0, 'batch_small'), 8)
+        self.assertEqual(len(uwsgi.cache_keys('batch_small')), 9)
+
+    def test_empty(self):
+        self.assertEqual(uwsgi.cache_mget([], 'batch'), [])
+        self.assertEqual(uwsgi.cache_mset({}, 0, 'batch'), 0)
+        self.assertEqual(uwsgi.cache_mdel([], 'batch'), 0)
+
+    def test_remote(self):
+        port = free_port()
+        self.start_server(['--socket', '127.0.0.1:%d' % port, '--cache2', 'name=remote,items=100,blocksize=64,shards=2',
+                           '--need-app=0', '--disable-logging'], ready=port)
+        remote = 'remote@127.0.0.1:%d' % port
+        items = dict(('key%d' % i, 'value%d' % i) for i in range(30))
+        self.assertEqual(uwsgi.cache_mset(items, 0, remote), 30)
+        self.assertEqual(uwsgi.cache_mset({'key0': 'X'}, 0, remote), 0)
+        self.assertEqual(uwsgi.cache_mupdate({'key0': 'X'}, 0, remote), 1)
+        values = uwsgi.cache_mget(['key0', 'key1', 'missing'], remote)
+        self.assertEqual(values, [b'X', b'value1', None])
+        self.assertEqual(uwsgi.cache_get('key2', remote), b'value2')
+        self.assertEqual(uwsgi.cache_mdel(['key%d' % i for i in range(20)] + ['missing'], remote), 20)
+        self.assertIsNone(uwsgi.cache_mget(['key0'], 'remote@127.0.0.1:1'))
+
+
+unittest.main()
@@ -0,0 +1,66 @@
+# cache contention benchmark: N processes hammering the same cache
+#
+# environment variables:
+#   CACHE_BENCH_CACHES   comma separated list of caches to test (default: single,sharded,optimistic,sharded_optimistic)
+#   CACHE_BENCH_WORKERS  comma separated list of concurrency levels (default: 1,2,4,8)
+#   CACHE_BENCH_SECONDS  duration of each run (default: 2)
+#   CACHE_BENCH_SETS     percentage of set operations (default: 50)
+#   CACHE_BENCH_KEYS     number of distinct keys (default: 10000)
+import uwsgi
+import os
+import random
+import time
+
+
+def env_list(name, default):
+    return [x for x in os.environ.get(name, default).split(',') if x]
+
+caches = env_list('CACHE_BENCH_CACHES', 'single,sharded,optimistic,sharded_optimistic')
+workers = [int(x) for x in env_list('CACHE_BENCH_WORKERS', '1,2,4,8')]
+seconds = float(os.environ.get('CACHE_BENCH_SECONDS', '2'))
+sets = int(os.environ.get('CACHE_BENCH_SETS', '50'))
+nkeys = int(os.environ.get('CACHE_BENCH_KEYS', '10000'))
+
+keys = ['key%d' % i for i in range(nkeys)]
+value = b'x' * 100
+
+
+def hammer(cache, pipe):
+    random.seed(os.getpid())
+    ops = 0
+    deadline = time.time() + seconds
+    while True:
+        # check the clock every 1000 operations
+        for i in range(1000):
+            key = random.choice(keys)
+            if random.randint(0, 99) < sets:
+                uwsgi.cache_update(key, value, 0, cache)
+            else:
+                uwsgi.cache_get(key, cache)
+        ops += 1000
+        if time.time() >= deadline:
+            break
+    os.write(pipe, ('%d\n' % ops).encode())
+    os._exit(0)
+
+
+for cache in caches:
+    for key in keys:
+        uwsgi.cache_update(key, value, 0, cache)
+    for n in workers:
+        r, w = os.pipe()
+        pids = []
+        for i in range(n):
+            pid = os.fork()
+            if pid == 0:
+                os.close(r)
+                hammer(cache, w)
+            pids.append(pid)
+        os.close(w)
+        for pid in pids:
+            os.waitpid(pid, 0)
+        total = 0
+        with os.fdopen(r) as f:
+            for line in f:
+                total += int(line)
+        print('cache: %-20s workers: %3d ops/sec: %d' % (cache, n, total / seconds))
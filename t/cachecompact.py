@@ -0,0 +1,57 @@
+import uwsgi
+import unittest
+
+
+class CompactTest(unittest.TestCase):
+
+    __caches__ = [
+        'compact',
+        'compact_bitmap',
+        'compact_lru',
+        'compact_optimistic',
+    ]
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_set_get_del(self):
+        for cache in ('compact', 'compact_optimistic'):
+            for i in range(0, 32):
+                self.assertTrue(uwsgi.cache_set('key%d' % i, 'value%d' % i, 0, cache))
+            for i in range(0, 32):
+                self.assertEqual(uwsgi.cache_get('key%d' % i, cache), b'value%d' % i)
+            for i in range(0, 32):
+                self.assertTrue(uwsgi.cache_del('key%d' % i, cache))
+                self.assertIsNone(uwsgi.cache_get('key%d' % i, cache))
+
+    def test_fill(self):
+        # fill the whole cache multiple times to stress overflowing buckets
+        for j in range(0, 10):
+            for i in range(0, 63):
+                self.assertTrue(uwsgi.cache_set('key%d_%d' % (j, i), 'X', 0, 'compact'))
+            self.assertIsNone(uwsgi.cache_set('one_more', 'X', 0, 'compact'))
+            for i in range(0, 63):
+                self.assertEqual(uwsgi.cache_get('key%d_%d' % (j, i), 'compact'), b'X')
+            self.assertEqual(len(uwsgi.cache_keys('compact')), 63)
+            for i in range(0, 63):
+                self.assertTrue(uwsgi.cache_del('key%d_%d' % (j, i), 'compact'))
+            self.assertEqual(uwsgi.cache_keys('compact'), [])
+
+    def test_update(self):
+        self.assertTrue(uwsgi.cache_set('key', 'HELLO', 0, 'compact'))
+        self.assertIsNone(uwsgi.cache_set('key', 'WORLD', 0, 'compact'))
+        self.assertTrue(uwsgi.cache_update('key', 'WORLD', 0, 'compact'))
+        self.assertEqual(uwsgi.cache_get('key', 'compact'), b'WORLD')
+
+    def test_bitmap(self):
+        self.assertTrue(uwsgi.cache_set('key', 'X' * 64, 0, 'compact_bitmap'))
+        self.assertEqual(uwsgi.cache_get('key', 'compact_bitmap'), b'X' * 64)
+
+    def test_lru(self):
+        for i in range(0, 100):
+            self.assertTrue(uwsgi.cache_set('KEY%d' % i, 'Y' * 16, 0, 'compact_lru'))
+            self.assertIsNone(uwsgi.cache_get('KEY%d' % (i - 7), 'compact_lru'))
+        self.assertEqual(uwsgi.cache_get('KEY99', 'compact_lru'), b'Y' * 16)
+
+unittest.main()
@@ -0,0 +1,108 @@
+import uwsgi
+import unittest
+import os
+import shutil
+import gzip
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, STATS = free_ports(2)
+BIG = b'<html>' + b'<p>hello world</p>' * 500 + b'</html>'
+
+
+class CompressTest(UwsgiServerTest):
+
+    __caches__ = ['gzip', 'gzip_bitmap', 'gzip_sharded', 'plain']
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_roundtrip(self):
+        for cache in ('gzip', 'gzip_bitmap', 'gzip_sharded'):
+            self.assertTrue(uwsgi.cache_set('big', BIG, 0, cache))
+            self.assertEqual(uwsgi.cache_get('big', cache), BIG)
+            # below the threshold
+            self.assertTrue(uwsgi.cache_set('small', b'x' * 32, 0, cache))
+            self.assertEqual(uwsgi.cache_get('small', cache), b'x' * 32)
+
+    def test_bigger_than_blocksize(self):
+        # stored only because it is compressed
+        self.assertTrue(uwsgi.cache_set('big', BIG, 0, 'gzip'))
+        self.assertIsNone(uwsgi.cache_set('big', BIG, 0, 'plain'))
+        self.assertIsNone(uwsgi.cache_set('random', os.urandom(4096), 0, 'gzip'))
+
+    def test_update(self):
+        self.assertTrue(uwsgi.cache_set('key', BIG, 0, 'gzip'))
+        self.assertTrue(uwsgi.cache_update('key', b'plain', 0, 'gzip'))
+        self.assertEqual(uwsgi.cache_get('key', 'gzip'), b'plain')
+        self.assertTrue(uwsgi.cache_update('key', BIG, 0, 'gzip'))
+        self.assertEqual(uwsgi.cache_get('key', 'gzip'), BIG)
+
+    def test_batch(self):
+        values = dict(('key%d' % i, BIG + b'%d' % i) for i in range(10))
+        values['small'] = b'small'
+        for cache in ('gzip', 'gzip_sharded'):
+            self.assertEqual(uwsgi.cache_mset(values, 0, cache), 11)
+            keys = sorted(values)
+            self.assertEqual(uwsgi.cache_mget(keys, cache), [values[k] for k in keys])
+
+    def test_math(self):
+        self.assertTrue(uwsgi.cache_inc('counter', 1, 0, 'gzip'))
+        self.assertTrue(uwsgi.cache_inc('counter', 1, 0, 'gzip'))
+        self.assertEqual(uwsgi.cache_num('counter', 'gzip'), 2)
+
+    def test_router(self):
+        self.start_server(['--http-socket', '127.0.0.1:%d' % HTTP, '--need-app=0',
+                           '--cache2', 'name=pages,items=10,blocksize=4096,compress=gzip',
+                           '--add-cache-item', 'pages index=' + BIG.decode(),
+                           '--route', '^/(.*) cache:key=$1,name=pages,content_type=text/html'], ready=HTTP)
+        conn = http.client.HTTPConnection('127.0.0.1', HTTP)
+        conn.request('GET', '/index', headers={'Accept-Encoding': 'gzip, deflate'})
+        r = conn.getresponse()
+        body = r.read()
+        self.assertEqual(r.getheader('Content-Encoding'), 'gzip')
+        self.assertEqual(gzip.decompress(body), BIG)
+        conn.close()
+        conn = http.client.HTTPConnection('127.0.0.1', HTTP)
+        conn.request('GET', '/index')
+        r = conn.getresponse()
+        self.assertIsNone(r.getheader('Content-Encoding'))
+        self.assertEqual(r.read(), BIG)
+        conn.close()
+
+    def test_static_paths(self):
+        # the resolved paths are long enough to be stored compressed
+        root = '/tmp/cachecompress' + 'x' * 200 + '%d' % os.getpid()
+        os.makedirs(root, exist_ok=True)
+        self.addCleanup(shutil.rmtree, root)
+        with open(root + '/index.html', 'wb') as f:
+            f.write(BIG)
+        self.start_server(['--http-socket', '127.0.0.1:%d' % HTTP, '--need-app=0',
+                           '--cache2', 'name=paths,items=10,blocksize=4096,compress=gzip,compress_threshold=16',
+                           '--static-map', '/static=' + root,
+                           '--static-cache-paths', '60', '--static-cache-paths-name', 'paths'], ready=HTTP)
+        # the second request is resolved from the cache
+        for i in range(2):
+            conn = http.client.HTTPConnection('127.0.0.1', HTTP)
+            conn.request('GET', '/static/index.html')
+            r = conn.getresponse()
+            self.assertEqual(r.status, 200)
+            self.assertEqual(r.read(), BIG)
+            conn.close()
+
+    def test_remote_set(self):
+        self.start_server(['--socket', '127.0.0.1:%d' % HTTP, '--need-app=0', '--stats', '127.0.0.1:%d' % STATS,
+                           '--cache2', 'name=remote,items=10,blocksize=4096,compress=gzip'], ready=HTTP)
+        remote = 'remote@127.0.0.1:%d' % HTTP
+        value = BIG[:4000]
+        self.assertTrue(uwsgi.cache_set('big', value, 0, remote))
+        self.assertEqual(uwsgi.cache_get('big', remote), value)
+        self.assertTrue(uwsgi.cache_update('big', value + b'!', 0, remote))
+        self.assertEqual(uwsgi.cache_get('big', remote), value + b'!')
+        # stored compressed
+        cache = [c for c in self.stats(STATS)['caches'] if c['name'] == 'remote'][0]
+        self.assertEqual(cache['compressed_items'], 1)
+
+
+unittest.main()
@@ -0,0 +1,64 @@
+# fill the caches with mixed size values up to a fill ratio, then replace random items
+# measuring the set latency and the number of failed sets
+#
+# environment variables:
+#   CACHE_FILL_CACHES  comma separated list of caches to test (default: bitmap,slabs)
+#   CACHE_FILL_RATIOS  comma separated list of fill ratios (default: 50,80,90,95)
+#   CACHE_FILL_OPS     number of replacements for each fill ratio (default: 5000)
+import uwsgi
+import os
+import random
+import time
+
+caches = [x for x in os.environ.get('CACHE_FILL_CACHES', 'bitmap,slabs').split(',') if x]
+ratios = [int(x) for x in os.environ.get('CACHE_FILL_RATIOS', '50,80,90,95').split(',') if x]
+nops = int(os.environ.get('CACHE_FILL_OPS', '5000'))
+
+memory = 1048576 * 16
+values = [b'X' * random.randint(64, 4096) for i in range(1000)]
+
+
+def run(cache):
+    uwsgi.cache_clear(cache)
+    random.seed(0)
+    # live keys and their size
+    keys = []
+    sizes = {}
+    used = 0
+    n = 0
+    for ratio in ratios:
+        # fill (give up after too many failures)
+        errors = 0
+        while used < memory * ratio / 100 and errors < 100:
+            value = random.choice(values)
+            if uwsgi.cache_set('key%d' % n, value, 0, cache):
+                keys.append('key%d' % n)
+                sizes['key%d' % n] = len(value)
+                used += len(value)
+            else:
+                errors += 1
+            n += 1
+        # churn: replace a random item with a new one
+        failed = 0
+        start = time.time()
+        for i in range(nops):
+            pos = random.randint(0, len(keys) - 1)
+            key = keys[pos]
+            keys[pos] = keys[-1]
+            keys.pop()
+            uwsgi.cache_del(key, cache)
+            used -= sizes.pop(key)
+            value = random.choice(values)
+            if uwsgi.cache_set('key%d' % n, value, 0, cache):
+                keys.append('key%d' % n)
+                sizes['key%d' % n] = len(value)
+                used += len(value)
+            else:
+                failed += 1
+            n += 1
+        elapsed = time.time() - start
+        print('cache: %-8s fill: %d%% (reached %d%%) usec/op: %.2f failed sets: %d' % (cache, ratio, used * 100 / memory, elapsed * 1000000 / nops, failed))
+
+
+for cache in caches:
+    run(cache)
@@ -0,0 +1,33 @@
+# fill the caches with 1M items and measure set, hit and miss throughput
+#
+# environment variables:
+#   CACHE_LAYOUT_CACHES  comma separated list of caches to test (default: chained,compact)
+#   CACHE_LAYOUT_ITEMS   number of items (default: 1000000)
+import uwsgi
+import os
+import random
+import time
+
+caches = [x for x in os.environ.get('CACHE_LAYOUT_CACHES', 'chained,compact').split(',') if x]
+nitems = int(os.environ.get('CACHE_LAYOUT_ITEMS', '1000000'))
+
+keys = ['key%d' % i for i in range(nitems)]
+misses = ['miss%d' % i for i in range(nitems)]
+random.shuffle(keys)
+
+
+def bench(name, cache, func, items):
+    start = time.time()
+    for item in items:
+        func(item, cache)
+    elapsed = time.time() - start
+    print('cache: %-10s %-4s ops/sec: %d' % (cache, name, len(items) / elapsed))
+
+
+def set_item(key, cache):
+    uwsgi.cache_set(key, 'value', 0, cache)
+
+for cache in caches:
+    bench('set', cache, set_item, keys)
+    bench('hit', cache, uwsgi.cache_get, keys)
+    bench('miss', cache, uwsgi.cache_get, misses)
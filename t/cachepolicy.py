@@ -0,0 +1,67 @@
+import uwsgi
+import unittest
+
+
+class PolicyTest(unittest.TestCase):
+
+    __caches__ = [
+        'clock',
+        'sampled',
+        'clock_tinylfu',
+        'clock_optimistic',
+    ]
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_purge(self):
+        for cache in ('clock', 'sampled'):
+            for i in range(0, 100):
+                self.assertTrue(uwsgi.cache_set('key%d' % i, 'X', 0, cache))
+            self.assertEqual(len(uwsgi.cache_keys(cache)), 10)
+            self.assertEqual(uwsgi.cache_get('key99', cache), b'X')
+
+    def test_clock_referenced(self):
+        for i in range(0, 10):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'X', 0, 'clock'))
+        # referenced items survive a round of the hand
+        self.assertEqual(uwsgi.cache_get('key0', 'clock'), b'X')
+        for i in range(0, 5):
+            self.assertTrue(uwsgi.cache_set('cold%d' % i, 'X', 0, 'clock'))
+        self.assertEqual(uwsgi.cache_get('key0', 'clock'), b'X')
+
+    def test_sampled_recent(self):
+        for i in range(0, 10):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'X', 0, 'sampled'))
+        # sampling all of the items always evicts the least recently used one
+        for i in range(0, 9):
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'sampled'), b'X')
+        self.assertTrue(uwsgi.cache_set('new', 'X', 0, 'sampled'))
+        self.assertIsNone(uwsgi.cache_get('key9', 'sampled'))
+        for i in range(0, 9):
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'sampled'), b'X')
+
+    def test_tinylfu(self):
+        for i in range(0, 10):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'X', 0, 'clock_tinylfu'))
+            for j in range(0, 3):
+                uwsgi.cache_get('key%d' % i, 'clock_tinylfu')
+        # one-time keys are not admitted
+        for i in range(0, 100):
+            self.assertIsNone(uwsgi.cache_set('scan%d' % i, 'X', 0, 'clock_tinylfu'))
+        for i in range(0, 10):
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'clock_tinylfu'), b'X')
+        # frequent keys are
+        for i in range(0, 10):
+            uwsgi.cache_get('frequent', 'clock_tinylfu')
+        self.assertTrue(uwsgi.cache_set('frequent', 'F', 0, 'clock_tinylfu'))
+        self.assertEqual(uwsgi.cache_get('frequent', 'clock_tinylfu'), b'F')
+
+    def test_optimistic(self):
+        for i in range(0, 1000):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'V%d' % i, 0, 'clock_optimistic'))
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'clock_optimistic'), b'V%d' % i)
+        self.assertTrue(len(uwsgi.cache_keys('clock_optimistic')) > 90)
+
+unittest.main()
@@ -0,0 +1,86 @@
+import uwsgi
+import unittest
+import tempfile
+import shutil
+import time
+import os
+from uwsgitest import UwsgiServerTest, free_ports
+
+ORIGIN, REPLICA, REPLICA_UDP, BIG_UDP = ['127.0.0.1:%d' % port for port in free_ports(4)]
+
+
+class ReplicationTest(UwsgiServerTest):
+
+    def spawn(self, address, *args):
+        return self.start_server(['--master', '--need-app=0', '--socket', address] + list(args), ready=int(address.split(':')[1]))
+
+    def spawn_replica(self):
+        return self.spawn(REPLICA, '--cache2', 'name=replica,items=100,blocksize=64,replication_log=100,udp=%s,sync=%s,store=%s' % (
+            REPLICA_UDP, ORIGIN, os.path.join(self.tmp, 'replica.store')),
+            '--cache2', 'name=big,items=10,blocksize=131072,replication_log=100,udp=%s,sync=%s,store=%s' % (
+            BIG_UDP, ORIGIN, os.path.join(self.tmp, 'big.store')))
+
+    def log(self, p):
+        p.log.seek(0)
+        return p.log.read().decode()
+
+    def setUp(self):
+        self.tmp = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, self.tmp)
+        self.origin = self.spawn(ORIGIN, '--cache2', 'name=replica,items=100,blocksize=64,replication_log=100,replication_freq=20,nodes=%s' % REPLICA_UDP,
+                                 '--cache2', 'name=big,items=10,blocksize=131072,replication_log=100,replication_freq=20,nodes=%s' % BIG_UDP)
+
+    def test_stream(self):
+        self.spawn_replica()
+        origin = 'replica@' + ORIGIN
+        replica = 'replica@' + REPLICA
+        for i in range(10):
+            # repeated writes are coalesced
+            self.assertTrue(uwsgi.cache_update('counter', str(i), 0, origin))
+        self.assertEqual(uwsgi.cache_mset(dict(('key%d' % i, 'value%d' % i) for i in range(30)), 0, origin), 30)
+        self.assertEqual(uwsgi.cache_mdel(['key%d' % i for i in range(10)], origin), 10)
+        time.sleep(0.5)
+        self.assertEqual(uwsgi.cache_get('counter', replica), b'9')
+        values = uwsgi.cache_mget(['key%d' % i for i in range(30)], replica)
+        self.assertEqual(values[:10], [None] * 10)
+        self.assertEqual(values[10:], [('value%d' % i).encode() for i in range(10, 30)])
+
+    def test_catchup(self):
+        origin = 'replica@' + ORIGIN
+        replica = 'replica@' + REPLICA
+        self.assertTrue(uwsgi.cache_set('before', 'X', 0, origin))
+        # the first start requires a full dump
+        p = self.spawn_replica()
+        self.assertEqual(uwsgi.cache_get('before', replica), b'X')
+        self.assertTrue(uwsgi.cache_set('streamed', 'X', 0, origin))
+        time.sleep(0.5)
+        self.assertEqual(uwsgi.cache_get('streamed', replica), b'X')
+        self.stop_server(p)
+        # changes while the replica is down
+        self.assertTrue(uwsgi.cache_del('before', origin))
+        self.assertTrue(uwsgi.cache_set('missed', 'Y', 0, origin))
+        p = self.spawn_replica()
+        self.assertIsNone(uwsgi.cache_get('before', replica))
+        self.assertEqual(uwsgi.cache_get('streamed', replica), b'X')
+        self.assertEqual(uwsgi.cache_get('missed', replica), b'Y')
+        output = self.log(p)
+        self.assertIn('applied 2 changes', output)
+        self.assertNotIn('getting cache dump', output)
+
+    def test_too_big(self):
+        origin = 'big@' + ORIGIN
+        replica = 'big@' + REPLICA
+        p = self.spawn_replica()
+        self.assertTrue(uwsgi.cache_set('small', 'X', 0, origin))
+        self.assertTrue(uwsgi.cache_set('huge', 'H' * 70000, 0, origin))
+        time.sleep(0.5)
+        self.assertEqual(uwsgi.cache_get('small', replica), b'X')
+        self.assertIsNone(uwsgi.cache_get('huge', replica))
+        self.assertIn('item "huge" of cache "big" too big for a datagram', self.log(self.origin))
+        # the incomplete batch is not tracked, so a restart catches up with it
+        self.stop_server(p)
+        self.spawn_replica()
+        self.assertEqual(uwsgi.cache_get('huge', replica), b'H' * 70000)
+
+
+unittest.main()
@@ -0,0 +1,46 @@
+# a skewed (zipf-like) workload of get-or-set requests interleaved with scans of one-time keys,
+# reporting the hit ratio of the hot keys for every cache
+#
+# environment variables:
+#   CACHE_SCAN_CACHES    comma separated list of caches to test (default: all of the t/cachescan.ini ones)
+#   CACHE_SCAN_REQUESTS  number of requests (default: 200000)
+#   CACHE_SCAN_RATIO     percentage of requests belonging to scans (default: 30)
+import uwsgi
+import os
+import random
+import time
+
+caches = [x for x in os.environ.get('CACHE_SCAN_CACHES', 'lru,clock,sampled,clock_tinylfu,sampled_tinylfu').split(',') if x]
+nrequests = int(os.environ.get('CACHE_SCAN_REQUESTS', '200000'))
+scan_ratio = int(os.environ.get('CACHE_SCAN_RATIO', '30'))
+
+hot_keys = 5000
+weights = [1.0 / (i + 1) for i in range(hot_keys)]
+
+random.seed(0)
+requests = []
+scan = 0
+while len(requests) < nrequests:
+    if random.randint(0, 99) < scan_ratio:
+        # a scan of 100 keys
+        for i in range(100):
+            requests.append('scan%d' % scan)
+            scan += 1
+    else:
+        requests.extend('hot%d' % k for k in random.choices(range(hot_keys), weights, k=100))
+requests = requests[:nrequests]
+
+for cache in caches:
+    uwsgi.cache_clear(cache)
+    hits = 0
+    hot = 0
+    start = time.time()
+    for key in requests:
+        if uwsgi.cache_get(key, cache) is None:
+            uwsgi.cache_set(key, 'value', 0, cache)
+        elif key.startswith('hot'):
+            hits += 1
+        if key.startswith('hot'):
+            hot += 1
+    elapsed = time.time() - start
+    print('cache: %-16s hot hit ratio: %.2f%% requests/sec: %d' % (cache, hits * 100.0 / hot, len(requests) / elapsed))
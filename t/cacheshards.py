@@ -0,0 +1,79 @@
+import uwsgi
+import unittest
+
+
+class ShardsTest(unittest.TestCase):
+
+    __caches__ = [
+        'sharded',
+        'sharded_bitmap',
+        'sharded_lru',
+        'optimistic',
+        'sharded_optimistic',
+    ]
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_set_get_del(self):
+        for i in range(0, 32):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'value%d' % i, 0, 'sharded'))
+        for i in range(0, 32):
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'sharded'), b'value%d' % i)
+        for i in range(0, 32):
+            self.assertTrue(uwsgi.cache_del('key%d' % i, 'sharded'))
+            self.assertIsNone(uwsgi.cache_get('key%d' % i, 'sharded'))
+
+    def test_keys(self):
+        keys = ['key%d' % i for i in range(0, 16)]
+        for key in keys:
+            self.assertTrue(uwsgi.cache_set(key, 'X', 0, 'sharded'))
+        self.assertEqual(sorted(k.decode() for k in uwsgi.cache_keys('sharded')), sorted(keys))
+
+    def test_clear(self):
+        for i in range(0, 16):
+            self.assertTrue(uwsgi.cache_set('key%d' % i, 'X', 0, 'sharded'))
+        self.assertTrue(uwsgi.cache_clear('sharded'))
+        self.assertEqual(uwsgi.cache_keys('sharded'), [])
+
+    def test_update(self):
+        self.assertTrue(uwsgi.cache_set('key', 'HELLO', 0, 'sharded'))
+        self.assertIsNone(uwsgi.cache_set('key', 'WORLD', 0, 'sharded'))
+        self.assertTrue(uwsgi.cache_update('key', 'WORLD', 0, 'sharded'))
+        self.assertEqual(uwsgi.cache_get('key', 'sharded'), b'WORLD')
+
+    def test_bitmap(self):
+        self.assertTrue(uwsgi.cache_set('key', 'X' * 64, 0, 'sharded_bitmap'))
+        self.assertEqual(uwsgi.cache_get('key', 'sharded_bitmap'), b'X' * 64)
+
+    def test_full(self):
+        stored = 0
+        for i in range(0, 128):
+            if uwsgi.cache_set('key%d' % i, 'X', 0, 'sharded'):
+                stored += 1
+        # every shard holds at most items/shards keys
+        self.assertLessEqual(stored, 64)
+        self.assertEqual(len(uwsgi.cache_keys('sharded')), stored)
+
+    def test_lru(self):
+        for i in range(0, 100):
+            self.assertTrue(uwsgi.cache_set('KEY%d' % i, 'Y' * 16, 0, 'sharded_lru'))
+        self.assertEqual(uwsgi.cache_get('KEY99', 'sharded_lru'), b'Y' * 16)
+        self.assertLessEqual(len(uwsgi.cache_keys('sharded_lru')), 8)
+
+    def test_optimistic(self):
+        for cache in ('optimistic', 'sharded_optimistic'):
+            self.assertTrue(uwsgi.cache_set('key', 'HELLO', 0, cache))
+            self.assertEqual(uwsgi.cache_get('key', cache), b'HELLO')
+            self.assertTrue(uwsgi.cache_update('key', 'WORLD', 0, cache))
+            self.assertEqual(uwsgi.cache_get('key', cache), b'WORLD')
+            self.assertTrue(uwsgi.cache_del('key', cache))
+            self.assertIsNone(uwsgi.cache_get('key', cache))
+
+    def test_optimistic_big_value(self):
+        # bigger than optimistic_max_size, the locked path is used
+        self.assertTrue(uwsgi.cache_set('key', 'X' * 64, 0, 'optimistic'))
+        self.assertEqual(uwsgi.cache_get('key', 'optimistic'), b'X' * 64)
+
+unittest.main()
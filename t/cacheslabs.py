@@ -0,0 +1,88 @@
+import uwsgi
+import unittest
+import random
+
+
+class SlabsTest(unittest.TestCase):
+
+    __caches__ = [
+        'slabs',
+        'slabs_small',
+        'slabs_lru',
+        'slabs_sharded',
+    ]
+
+    def setUp(self):
+        for cache in self.__caches__:
+            uwsgi.cache_clear(cache)
+
+    def test_mixed_sizes(self):
+        for cache in ('slabs', 'slabs_sharded'):
+            values = {}
+            for i in range(0, 500):
+                values['key%d' % i] = b'%d' % i * random.randint(1, 500)
+                self.assertTrue(uwsgi.cache_set('key%d' % i, values['key%d' % i], 0, cache))
+            for key, value in values.items():
+                self.assertEqual(uwsgi.cache_get(key, cache), value)
+            for key in values:
+                self.assertTrue(uwsgi.cache_del(key, cache))
+                self.assertIsNone(uwsgi.cache_get(key, cache))
+
+    def test_update_class(self):
+        self.assertTrue(uwsgi.cache_set('key', 'X', 0, 'slabs'))
+        self.assertTrue(uwsgi.cache_update('key', 'Y' * 10000, 0, 'slabs'))
+        self.assertEqual(uwsgi.cache_get('key', 'slabs'), b'Y' * 10000)
+        self.assertTrue(uwsgi.cache_update('key', 'Z' * 10, 0, 'slabs'))
+        self.assertEqual(uwsgi.cache_get('key', 'slabs'), b'Z' * 10)
+
+    def test_too_big(self):
+        # the max item size is the page size
+        self.assertIsNone(uwsgi.cache_set('key', 'X' * 257, 0, 'slabs_small'))
+        self.assertTrue(uwsgi.cache_set('key', 'X' * 256, 0, 'slabs_small'))
+
+    def test_pages_reuse(self):
+        # fill the cache with small values, free it and fill it again with big values
+        for j in range(0, 5):
+            i = 0
+            while uwsgi.cache_set('small%d' % i, 'X' * 16, 0, 'slabs_small'):
+                i += 1
+            self.assertTrue(i > 50)
+            for k in range(0, i):
+                self.assertTrue(uwsgi.cache_del('small%d' % k, 'slabs_small'))
+            for k in range(0, 4):
+                self.assertTrue(uwsgi.cache_set('big%d' % k, 'Y' * 256, 0, 'slabs_small'))
+            for k in range(0, 4):
+                self.assertEqual(uwsgi.cache_get('big%d' % k, 'slabs_small'), b'Y' * 256)
+                self.assertTrue(uwsgi.cache_del('big%d' % k, 'slabs_small'))
+
+    def test_fallback_class(self):
+        # when no page is available, bigger classes are used
+        for k in range(0, 4):
+            self.assertTrue(uwsgi.cache_set('big%d' % k, 'Y' * 200, 0, 'slabs_small'))
+        self.assertTrue(uwsgi.cache_del('big0', 'slabs_small'))
+        self.assertTrue(uwsgi.cache_set('small', 'X', 0, 'slabs_small'))
+        self.assertEqual(uwsgi.cache_get('small', 'slabs_small'), b'X')
+
+    def test_lru(self):
+        for i in range(0, 100):
+            self.assertTrue(uwsgi.cache_set('KEY%d' % i, 'Y' * 100, 0, 'slabs_lru'))
+        self.assertEqual(uwsgi.cache_get('KEY99', 'slabs_lru'), b'Y' * 100)
+
+    def test_lru_update_class(self):
+        # growing an item when no page is available purges the lru one, like a set does
+        self.assertTrue(uwsgi.cache_set('small', 'X' * 16, 0, 'slabs_lru'))
+        for k in range(0, 3):
+            self.assertTrue(uwsgi.cache_set('big%d' % k, 'Y' * 200, 0, 'slabs_lru'))
+        self.assertTrue(uwsgi.cache_update('small', 'Z' * 200, 0, 'slabs_lru'))
+        self.assertEqual(uwsgi.cache_get('small', 'slabs_lru'), b'Z' * 200)
+        self.assertIsNone(uwsgi.cache_get('big0', 'slabs_lru'))
+        self.assertEqual(uwsgi.cache_get('big2', 'slabs_lru'), b'Y' * 200)
+
+    def test_store(self):
+        # the allocator state is persisted with the items
+        for i in range(0, 50):
+            uwsgi.cache_update('key%d' % i, 'V' * i, 0, 'slabs_store')
+        for i in range(1, 50):
+            self.assertEqual(uwsgi.cache_get('key%d' % i, 'slabs_store'), b'V' * i)
+
+unittest.main()
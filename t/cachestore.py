@@ -0,0 +1,94 @@
+import uwsgi
+import unittest
+import tempfile
+import shutil
+import os
+import signal
+from uwsgitest import UwsgiServerTest, free_port
+
+PORT = free_port()
+CACHE = 'store@127.0.0.1:%d' % PORT
+
+
+class StoreTest(UwsgiServerTest):
+
+    def start(self, options=''):
+        self.server = self.start_server(['--master', '--need-app=0', '--socket', '127.0.0.1:%d' % PORT, '--cache2',
+                                         'name=store,items=100,blocksize=64,store=%s%s' % (self.store, options)], ready=PORT)
+
+    def stop(self):
+        return self.stop_server(self.server).decode()
+
+    def setUp(self):
+        self.tmp = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, self.tmp)
+        self.store = os.path.join(self.tmp, 'cache.store')
+
+    def fill(self):
+        self.start()
+        self.assertEqual(uwsgi.cache_mset(dict(('key%d' % i, 'value%d' % i) for i in range(20)), 0, CACHE), 20)
+        self.assertEqual(uwsgi.cache_mdel(['key%d' % i for i in range(5)], CACHE), 5)
+        self.stop()
+
+    def check(self):
+        values = uwsgi.cache_mget(['key%d' % i for i in range(20)], CACHE)
+        self.assertEqual(values[:5], [None] * 5)
+        self.assertEqual(values[5:], [('value%d' % i).encode() for i in range(5, 20)])
+
+    def test_clean_restart(self):
+        self.fill()
+        self.start()
+        self.check()
+        log = self.stop()
+        self.assertIn('restored 15 items', log)
+        self.assertNotIn('invalid header', log)
+        self.assertNotIn('cleanly synced', log)
+
+    def test_crash(self):
+        self.start()
+        self.assertEqual(uwsgi.cache_mset(dict(('key%d' % i, 'value%d' % i) for i in range(20)), 0, CACHE), 20)
+        self.assertEqual(uwsgi.cache_mdel(['key%d' % i for i in range(5)], CACHE), 5)
+        # the header is dirty while running, the writers never flush it
+        pid = self.server.pid
+        with open('/proc/%d/task/%d/children' % (pid, pid)) as f:
+            workers = [int(x) for x in f.read().split()]
+        for worker in workers:
+            os.kill(worker, signal.SIGKILL)
+        self.server.send_signal(signal.SIGKILL)
+        self.server.wait()
+        self.start()
+        self.check()
+        log = self.stop()
+        self.assertIn('has not been cleanly synced', log)
+        self.assertIn('restored 15 items', log)
+
+    def test_torn_header(self):
+        self.fill()
+        # simulate a crash in the middle of a sync
+        page_size = os.sysconf('SC_PAGE_SIZE')
+        with open(self.store, 'r+b') as f:
+            f.seek(os.path.getsize(self.store) - page_size + 24)
+            f.write(b'\x01')
+        self.start()
+        self.check()
+        log = self.stop()
+        self.assertIn('invalid header in cache store file', log)
+        self.assertIn('restored 15 items', log)
+        # repaired and synced, the next start is clean
+        self.start()
+        self.check()
+        self.assertNotIn('invalid header', self.stop())
+
+    def test_legacy_store(self):
+        self.fill()
+        # strip the header: 100 items (88 bytes header + 2048 bytes key) + 100 blocks
+        with open(self.store, 'r+b') as f:
+            f.truncate((88 + 2048) * 100 + 64 * 100)
+        self.start(',store_delete=1')
+        self.check()
+        log = self.stop()
+        self.assertIn('adding the consistency header', log)
+        self.assertIn('restored 15 items', log)
+
+
+unittest.main()
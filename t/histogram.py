@@ -0,0 +1,84 @@
+import unittest
+import os
+import time
+import shutil
+import tempfile
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, STATS = free_ports(2)
+
+APP = b'''
+import time
+import uwsgi
+
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    path = e['PATH_INFO']
+    if path == '/slow':
+        time.sleep(0.05)
+    elif path == '/observe':
+        for i in range(1, 1001):
+            uwsgi.metric_observe('app.latency', i)
+    return [b'ok']
+'''
+
+
+class HistogramTest(UwsgiServerTest):
+
+    def setUp(self):
+        self.dir = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, self.dir)
+        self.start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--processes', '2',
+                           '--enable-metrics', '--metric', 'name=app.latency,type=histogram', '--metrics-dir', self.dir,
+                           '--stats', '127.0.0.1:%d' % STATS, '--wsgi-file', self.write_app(APP)], ready=HTTP)
+
+    def get(self, path):
+        c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+        c.request('GET', path)
+        r = c.getresponse()
+        self.assertEqual(r.read(), b'ok')
+        c.close()
+
+    def metrics(self, name, count):
+        # wait for the metrics thread to merge the workers histograms
+        for i in range(30):
+            metrics = self.stats(STATS)['metrics']
+            if metrics[name]['value'] == count:
+                break
+            time.sleep(0.1)
+        self.assertEqual(metrics[name]['value'], count)
+        time.sleep(1.1)
+        return self.stats(STATS)['metrics']
+
+    def test_response_time(self):
+        for i in range(90):
+            self.get('/fast')
+        for i in range(10):
+            self.get('/slow')
+        metrics = self.metrics('core.response_time', 100)
+        self.assertLess(metrics['core.response_time.p50']['value'], 50000)
+        self.assertGreaterEqual(metrics['core.response_time.p99']['value'], 48000)
+        self.assertLess(metrics['core.response_time.p99']['value'], 100000)
+        self.assertGreaterEqual(metrics['core.response_time.max']['value'], metrics['core.response_time.p99']['value'])
+        # every worker exposes its own percentiles
+        workers = self.stats(STATS)['workers']
+        self.assertEqual(sum(w['requests'] for w in workers), 100)
+        for w in workers:
+            if w['requests'] > 10:
+                self.assertGreater(w['rt_percentiles']['p999'], 0)
+
+    def test_custom_histogram(self):
+        self.get('/observe')
+        metrics = self.metrics('app.latency', 1000)
+        # log-linear buckets are within ~3% from the real value
+        self.assertAlmostEqual(metrics['app.latency.p50']['value'], 500, delta=16)
+        self.assertAlmostEqual(metrics['app.latency.p90']['value'], 900, delta=29)
+        self.assertAlmostEqual(metrics['app.latency.p99']['value'], 990, delta=31)
+        self.assertEqual(metrics['app.latency.max']['value'], 1000)
+        with open(os.path.join(self.dir, 'app.latency.max')) as f:
+            self.assertEqual(f.read().split('\x00')[0].strip(), '1000')
+
+
+if __name__ == '__main__':
+    unittest.main()
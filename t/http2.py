@@ -0,0 +1,234 @@
+import unittest
+import subprocess
+import socket
+import os
+import shutil
+import tempfile
+import struct
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, HTTPS, BACKEND = free_ports(3)
+
+APP = b'''
+def application(e, sr):
+    if e['PATH_INFO'] == '/big':
+        body = b'x' * 300000
+    else:
+        body = ('%s %s %s %s %s' % (e['SERVER_PROTOCOL'], e['REQUEST_METHOD'], e['PATH_INFO'],
+                                   e.get('HTTP_COOKIE', ''), e['wsgi.input'].read().decode())).encode()
+    sr('200 OK', [('Content-Type', 'text/plain'), ('Content-Length', str(len(body)))])
+    return [body]
+'''
+
+
+def curl_has_http2():
+    try:
+        return 'HTTP2' in subprocess.check_output(['curl', '-V']).decode()
+    except (OSError, subprocess.CalledProcessError):
+        return False
+
+
+@unittest.skipUnless(curl_has_http2(), 'curl with HTTP/2 support is required')
+class Http2Test(UwsgiServerTest):
+
+    def spawn(self, *args):
+        return self.start_server(['--master', '--http', '127.0.0.1:%d' % HTTP, '--http2'] + list(args), ready=HTTP)
+
+    def curl(self, *args):
+        return subprocess.check_output(['curl', '-s', '-k', '--max-time', '10'] + list(args))
+
+    def frame(self, type, flags, sid, payload):
+        return struct.pack('>I', len(payload))[1:] + struct.pack('>BBI', type, flags, sid) + payload
+
+    # send all of the requests at once, returns the body size of each stream
+    def multiplex(self, paths):
+        s = socket.create_connection(('127.0.0.1', HTTP))
+        s.settimeout(10)
+        data = b'PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n' + self.frame(4, 0, 0, b'')
+        for i, path in enumerate(paths):
+            # GET, http, literal :path and :authority without indexing
+            block = b'\x82\x86\x04' + bytes([len(path)]) + path.encode() + b'\x01\x09127.0.0.1'
+            data += self.frame(1, 5, i * 2 + 1, block)
+        # enlarge the connection window for the big responses
+        data += self.frame(8, 0, 0, struct.pack('>I', 1 << 30))
+        s.sendall(data)
+        bodies = {}
+        closed = 0
+        buf = b''
+        while closed < len(paths):
+            chunk = s.recv(65536)
+            if not chunk:
+                break
+            buf += chunk
+            while len(buf) >= 9 and len(buf) >= 9 + int.from_bytes(buf[:3], 'big'):
+                size = int.from_bytes(buf[:3], 'big')
+                type, flags, sid = struct.unpack('>BBI', buf[3:9])
+                payload = buf[9:9 + size]
+                buf = buf[9 + size:]
+                if type == 0:
+                    bodies[sid] = bodies.get(sid, 0) + size
+                    # give back the window of the stream
+                    if size:
+                        s.sendall(self.frame(8, 0, sid, struct.pack('>I', size)))
+                elif type == 1:
+                    # :status 200 from the static table
+                    self.assertEqual(payload[0], 0x88)
+                if type in (0, 1) and flags & 1:
+                    closed += 1
+        s.close()
+        return bodies
+
+    def hpack_int(self, first, prefix, value):
+        limit = (1 << prefix) - 1
+        if value < limit:
+            return bytes([first | value])
+        out = [first | limit]
+        value -= limit
+        while value >= 128:
+            out.append((value & 0x7f) | 0x80)
+            value >>= 7
+        out.append(value)
+        return bytes(out)
+
+    def literal(self, name, value):
+        # literal without indexing, new name
+        return b'\x00' + self.hpack_int(0, 7, len(name)) + name + self.hpack_int(0, 7, len(value)) + value
+
+    # send the frames, returns the frames received until all of the streams are closed (or reset)
+    def exchange(self, frames, sids):
+        s = socket.create_connection(('127.0.0.1', HTTP))
+        s.settimeout(10)
+        s.sendall(b'PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n' + self.frame(4, 0, 0, b'') + frames)
+        received = []
+        pending = set(sids)
+        buf = b''
+        while pending:
+            chunk = s.recv(65536)
+            if not chunk:
+                break
+            buf += chunk
+            while len(buf) >= 9 and len(buf) >= 9 + int.from_bytes(buf[:3], 'big'):
+                size = int.from_bytes(buf[:3], 'big')
+                type, flags, sid = struct.unpack('>BBI', buf[3:9])
+                received.append((type, flags, sid, buf[9:9 + size]))
+                buf = buf[9 + size:]
+                if type == 3 or (type in (0, 1) and flags & 1):
+                    pending.discard(sid)
+        s.close()
+        return received
+
+    def status(self, frames, sid):
+        for type, flags, fsid, payload in frames:
+            if type == 1 and fsid == sid:
+                # indexed (static table) or literal :status
+                if payload[0] & 0x80:
+                    return {0x88: 200, 0x8c: 400, 0x8d: 404}[payload[0]]
+                return int(payload[2:5])
+        return None
+
+    def setUp(self):
+        self.app = self.write_app(APP)
+
+    def test_h2c(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        url = 'http://127.0.0.1:%d' % HTTP
+        self.assertEqual(self.curl('--http2-prior-knowledge', '-H', 'Cookie: a=1', '-H', 'Cookie: b=2', url + '/foo'),
+                         b'HTTP/2.0 GET /foo a=1; b=2 ')
+        self.assertEqual(self.curl('--http2-prior-knowledge', '-d', 'foobar', url + '/post'),
+                         b'HTTP/2.0 POST /post  foobar')
+        self.assertEqual(len(self.curl('--http2-prior-knowledge', url + '/big')), 300000)
+        # streams multiplexed over a single connection
+        self.assertEqual(self.multiplex(['/big', '/1', '/2']), {1: 300000, 3: 17, 5: 17})
+        # HTTP/1.1 still works on the same socket
+        self.assertEqual(self.curl('--http1.1', url + '/foo'), b'HTTP/1.1 GET /foo  ')
+
+    def test_header_list_size(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app,
+                   '--buffer-size', '32768')
+        # a 4k field added to the dynamic table and referenced again (about 80k once decoded)
+        block = b'\x82\x86\x84\x40\x05x-big' + self.hpack_int(0, 7, 4000) + b'a' * 4000 + b'\xbe' * 20
+        frames = self.exchange(self.frame(1, 5, 1, block) + self.frame(1, 5, 3, b'\x82\x86\x84\xbe'), [1, 3])
+        settings = [payload for type, flags, sid, payload in frames if type == 4 and not flags & 1][0]
+        self.assertIn(struct.pack('>HI', 6, 65536), [settings[i:i + 6] for i in range(0, len(settings), 6)])
+        self.assertEqual(self.status(frames, 1), 431)
+        # the dynamic table is still in sync
+        self.assertEqual(self.status(frames, 3), 200)
+        self.assertNotIn(7, [type for type, flags, sid, payload in frames])
+
+    def test_malformed(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        get = b'\x82\x86\x84'
+        blocks = [get + self.literal(b'x-a', b'b\r\nx-injected: 1'),
+                  get + self.literal(b'X-A', b'b'),
+                  get + self.literal(b'connection', b'keep-alive'),
+                  b'\x82\x86\x04' + self.hpack_int(0, 7, 17) + b'/ HTTP/1.1\r\nfoo: ',
+                  get + self.literal(b'te', b'trailers'),
+                  get]
+        data = b''
+        for i, block in enumerate(blocks):
+            data += self.frame(1, 5, i * 2 + 1, block)
+        frames = self.exchange(data, range(1, len(blocks) * 2, 2))
+        self.assertEqual([self.status(frames, i * 2 + 1) for i in range(len(blocks))], [400, 400, 400, 400, 200, 200])
+        # a malformed request without END_STREAM is reset
+        frames = self.exchange(self.frame(1, 4, 1, get + self.literal(b'X-A', b'b')), [1])
+        self.assertEqual(self.status(frames, 1), 400)
+        self.assertIn((3, 0, 1, struct.pack('>I', 1)), frames)
+
+    def resets(self, frames):
+        return dict((sid, struct.unpack('>I', payload)[0]) for type, flags, sid, payload in frames if type == 3)
+
+    def test_flow_control(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        big = b'\x82\x86\x04\x04/big'
+        data = self.frame(1, 5, 1, big) + self.frame(8, 0, 1, struct.pack('>I', 0x7fffffff))
+        data += self.frame(1, 5, 3, big) + self.frame(8, 0, 3, struct.pack('>I', 0))
+        frames = self.exchange(data, [1, 3])
+        # FLOW_CONTROL_ERROR and PROTOCOL_ERROR
+        self.assertEqual(self.resets(frames), {1: 3, 3: 1})
+
+    def test_content_length(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        def post(sid, content_length, body):
+            block = b'\x83\x86\x84' + self.literal(b'content-length', content_length)
+            return self.frame(1, 4, sid, block) + self.frame(0, 1, sid, body)
+        frames = self.exchange(post(1, b'10', b'abc') + post(3, b'3', b'abcdef') + post(5, b'3', b'abc'), [1, 3, 5])
+        self.assertEqual(self.resets(frames), {1: 1, 3: 1})
+        self.assertEqual(self.status(frames, 5), 200)
+        # a body is declared but the stream is already closed
+        frames = self.exchange(self.frame(1, 5, 1, b'\x83\x86\x84' + self.literal(b'content-length', b'3')), [1])
+        self.assertEqual(self.status(frames, 1), 400)
+
+    def test_rapid_reset(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        data = b''
+        for i in range(300):
+            data += self.frame(1, 5, i * 2 + 1, b'\x82\x86\x84') + self.frame(3, 0, i * 2 + 1, struct.pack('>I', 8))
+        frames = self.exchange(data, [599])
+        goaway = [payload for type, flags, sid, payload in frames if type == 7]
+        # ENHANCE_YOUR_CALM
+        self.assertEqual(len(goaway), 1)
+        self.assertEqual(struct.unpack('>I', goaway[0][4:8])[0], 11)
+
+    def test_dead_backend(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND)
+        out = self.curl('--http2-prior-knowledge', '-o', '/dev/null', '-w', '%{http_code}', 'http://127.0.0.1:%d/' % HTTP)
+        self.assertEqual(out, b'502')
+
+    def test_alpn(self):
+        d = tempfile.mkdtemp()
+        self.addCleanup(shutil.rmtree, d)
+        crt = os.path.join(d, 'h2.crt')
+        key = os.path.join(d, 'h2.key')
+        try:
+            subprocess.check_call(['openssl', 'req', '-x509', '-newkey', 'rsa:2048', '-nodes', '-subj', '/CN=localhost',
+                                   '-keyout', key, '-out', crt, '-days', '1'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        except (OSError, subprocess.CalledProcessError):
+            self.skipTest('openssl is required')
+        self.spawn('--https', '127.0.0.1:%d,%s,%s' % (HTTPS, crt, key), '--http-to', '127.0.0.1:%d' % BACKEND,
+                   '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app)
+        url = 'https://127.0.0.1:%d' % HTTPS
+        self.assertEqual(self.curl('--http2', url + '/foo'), b'HTTP/2.0 GET /foo  ')
+        self.assertEqual(self.curl('--http1.1', url + '/foo'), b'HTTP/1.1 GET /foo  ')
+
+if __name__ == '__main__':
+    unittest.main()
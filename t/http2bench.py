@@ -0,0 +1,58 @@
+# http router benchmark: HTTP/2 streams vs HTTP/1.1 connections, driven by h2load
+#
+#   python3 t/http2bench.py
+#
+# environment variables:
+#   HTTP2_BENCH_REQUESTS  total number of requests of each run (default: 20000)
+#   HTTP2_BENCH_CLIENTS   comma separated list of client connections (default: 1,8,32)
+#   HTTP2_BENCH_STREAMS   max concurrent streams per HTTP/2 connection (default: 32)
+#   HTTP2_BENCH_PROCESSES number of backend workers (default: 4)
+#   HTTP2_BENCH_SIZE      response body size (default: 1024)
+import subprocess
+import os
+import re
+from uwsgitest import start_server, stop_server, write_app, free_ports
+
+requests = int(os.environ.get('HTTP2_BENCH_REQUESTS', '20000'))
+clients = [int(x) for x in os.environ.get('HTTP2_BENCH_CLIENTS', '1,8,32').split(',') if x]
+streams = int(os.environ.get('HTTP2_BENCH_STREAMS', '32'))
+processes = os.environ.get('HTTP2_BENCH_PROCESSES', '4')
+size = int(os.environ.get('HTTP2_BENCH_SIZE', '1024'))
+
+HTTP, BACKEND = free_ports(2)
+
+APP = b'''
+body = b'x' * %d
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'text/plain'), ('Content-Length', str(len(body)))])
+    return [body]
+''' % size
+
+
+def h2load(*args):
+    try:
+        return subprocess.check_output(['h2load'] + list(args), stderr=subprocess.STDOUT).decode()
+    except OSError:
+        return None
+    except subprocess.CalledProcessError as e:
+        return e.output.decode()
+
+
+if h2load('--version') is None:
+    print('h2load (nghttp2) is required to run the http2 benchmark')
+else:
+    app = write_app(APP)
+    p = start_server(['--master', '--http', '127.0.0.1:%d' % HTTP, '--http2', '--http-keepalive',
+                      '--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND,
+                      '--processes', processes, '--disable-logging', '--wsgi-file', app.name], ready=HTTP)
+    try:
+        url = 'http://127.0.0.1:%d/' % HTTP
+        for c in clients:
+            for proto, args in (('h2c', ['-m', str(streams)]), ('http/1.1', ['--h1'])):
+                out = h2load('-n', str(requests), '-c', str(c), *(args + [url]))
+                rps = re.search(r'finished in .*?, ([\d.]+) req/s', out)
+                ok = re.search(r'(\d+) succeeded', out)
+                print('proto: %-8s clients: %3d req/sec: %s succeeded: %s' % (proto, c, rps.group(1) if rps else '?', ok.group(1) if ok else '?'))
+    finally:
+        stop_server(p)
+        app.close()
@@ -0,0 +1,98 @@
+import unittest
+import socket
+import time
+import threading
+import http.client
+import http.server
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, BACKEND = free_ports(2)
+
+APP = b'''
+def application(e, sr):
+    body = e['PATH_INFO'].encode() + b':' + e['wsgi.input'].read()
+    sr('200 OK', [('Content-Length', str(len(body)))])
+    return [body]
+'''
+
+
+class Backend(http.server.BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, *args):
+        pass
+
+    def do_GET(self):
+        body = self.path.encode() + b':' * 3000
+        self.send_response(200)
+        self.send_header('Transfer-Encoding', 'chunked')
+        self.end_headers()
+        self.wfile.write(b'%x\r\n%s\r\n0\r\n\r\n' % (len(body), body))
+
+
+class FakeSocket:
+
+    # HTTPResponse closes its file at the end of each response
+    class Reader:
+
+        def __init__(self, f):
+            self.f = f
+
+        def __getattr__(self, name):
+            return getattr(self.f, name)
+
+        def close(self):
+            pass
+
+    def __init__(self, f):
+        self.f = self.Reader(f)
+
+    def makefile(self, *args, **kwargs):
+        return self.f
+
+
+class HttpPipelineTest(UwsgiServerTest):
+
+    def spawn(self, *args):
+        return self.start_server(['--master', '--http', '127.0.0.1:%d' % HTTP, '--http-keepalive'] + list(args), ready=HTTP)
+
+    def pipeline(self, chunks, n):
+        s = socket.create_connection(('127.0.0.1', HTTP))
+        s.settimeout(10)
+        for chunk in chunks:
+            s.sendall(chunk)
+            time.sleep(0.1)
+        f = s.makefile('rb')
+        responses = []
+        for i in range(n):
+            r = http.client.HTTPResponse(FakeSocket(f))
+            r.begin()
+            responses.append((r.status, r.read()))
+        s.close()
+        return responses
+
+    def test_uwsgi_backend(self):
+        app = self.write_app(APP)
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', app)
+        reqs = [b'GET /%d HTTP/1.1\r\nHost: localhost\r\n\r\n' % i for i in range(5)]
+        reqs.insert(2, b'POST /post HTTP/1.1\r\nHost: localhost\r\nContent-Length: 6\r\n\r\nfoobar')
+        expected = [(200, b'/0:'), (200, b'/1:'), (200, b'/post:foobar'), (200, b'/2:'), (200, b'/3:'), (200, b'/4:')]
+        # all of the requests in a single packet
+        self.assertEqual(self.pipeline([b''.join(reqs)], 6), expected)
+        # requests split between packets
+        data = b''.join(reqs)
+        self.assertEqual(self.pipeline([data[:50], data[50:107], data[107:]], 6), expected)
+
+    def test_http_backend_pool(self):
+        backend = http.server.ThreadingHTTPServer(('127.0.0.1', BACKEND), Backend)
+        backend.daemon_threads = True
+        threading.Thread(target=backend.serve_forever, daemon=True).start()
+        self.addCleanup(backend.server_close)
+        self.addCleanup(backend.shutdown)
+        self.spawn('--need-app=0', '--http-to', '127.0.0.1:%d' % BACKEND, '--http-backend-http', '--http-backend-pool', '2')
+        reqs = [b'GET /%d HTTP/1.1\r\nHost: localhost\r\n\r\n' % i for i in range(10)]
+        responses = self.pipeline([b''.join(reqs)], 10)
+        self.assertEqual(responses, [(200, b'/%d' % i + b':' * 3000) for i in range(10)])
+
+if __name__ == '__main__':
+    unittest.main()
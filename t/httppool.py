@@ -0,0 +1,159 @@
+import unittest
+import time
+import threading
+import http.client
+import http.server
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, BACKEND, STATS = free_ports(3)
+BODY = b'<html>' + b'<p>hello world</p>' * 2000 + b'</html>'
+
+
+class Backend(http.server.BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+    # idle connections are closed by the backend after this timeout
+    timeout = 1
+
+    def setup(self):
+        self.server.connections += 1
+        http.server.BaseHTTPRequestHandler.setup(self)
+
+    def log_message(self, *args):
+        pass
+
+    def send_body(self, body):
+        if self.path == '/chunked':
+            self.send_header('Transfer-Encoding', 'chunked')
+            self.end_headers()
+            if self.command == 'HEAD':
+                return
+            for i in range(0, len(body), 7000):
+                part = body[i:i + 7000]
+                self.wfile.write(b'%x;ext=1\r\n%s\r\n' % (len(part), part))
+            self.wfile.write(b'0\r\nX-Trailer: yes\r\n\r\n')
+        elif self.path == '/close':
+            self.send_header('Connection', 'close')
+            self.end_headers()
+            self.wfile.write(body)
+            self.close_connection = True
+        else:
+            self.send_header('Content-Length', str(len(body)))
+            self.end_headers()
+            if self.command != 'HEAD':
+                self.wfile.write(body)
+
+    def drop(self):
+        # the connection is closed without answering (like a reused connection closed in the mean time)
+        self.server.drops += 1
+        self.close_connection = True
+
+    def do_GET(self):
+        if self.path == '/drop':
+            return self.drop()
+        if self.path == '/empty':
+            self.send_response(204)
+            self.end_headers()
+            return
+        self.send_response(200)
+        self.send_header('Content-Type', 'text/html')
+        self.send_body(BODY)
+
+    def do_HEAD(self):
+        self.do_GET()
+
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers['Content-Length']))
+        if self.path == '/drop':
+            return self.drop()
+        self.send_response(200)
+        self.send_body(body[::-1])
+
+
+class HttpPoolTest(UwsgiServerTest):
+
+    def setUp(self):
+        self.backend = http.server.ThreadingHTTPServer(('127.0.0.1', BACKEND), Backend)
+        self.backend.daemon_threads = True
+        self.backend.connections = 0
+        self.backend.drops = 0
+        threading.Thread(target=self.backend.serve_forever, daemon=True).start()
+        self.addCleanup(self.backend.server_close)
+        self.addCleanup(self.backend.shutdown)
+        self.start_server(['--master', '--need-app=0', '--http', '127.0.0.1:%d' % HTTP,
+                           '--http-to', '127.0.0.1:%d' % BACKEND, '--http-backend-http', '--http-keepalive',
+                           '--http-backend-pool', '4', '--http-stats', '127.0.0.1:%d' % STATS], ready=HTTP)
+
+    def pool(self):
+        return self.stats(STATS)['pool']
+
+    def request(self, method, path, body=None, conn=None):
+        c = conn or http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+        c.request(method, path, body)
+        r = c.getresponse()
+        data = r.read()
+        if not conn:
+            c.close()
+        return r.status, data
+
+    def test_reuse(self):
+        for i in range(20):
+            self.assertEqual(self.request('GET', '/'), (200, BODY))
+            self.assertEqual(self.request('GET', '/chunked'), (200, BODY))
+            self.assertEqual(self.request('HEAD', '/'), (200, b''))
+            self.assertEqual(self.request('HEAD', '/chunked'), (200, b''))
+            self.assertEqual(self.request('GET', '/empty'), (204, b''))
+            self.assertEqual(self.request('POST', '/', b'foobar' * 1000), (200, b'raboof' * 1000))
+        self.assertEqual(self.backend.connections, 1)
+        stats = self.pool()
+        self.assertEqual(stats['hits'], 119)
+        self.assertEqual(stats['idle'], 1)
+
+    def test_client_keepalive(self):
+        conn = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+        for i in range(10):
+            self.assertEqual(self.request('GET', '/', conn=conn), (200, BODY))
+            self.assertEqual(self.request('GET', '/chunked', conn=conn), (200, BODY))
+        conn.close()
+        self.assertEqual(self.backend.connections, 1)
+
+    def test_concurrency(self):
+        errors = []
+
+        def client():
+            try:
+                for i in range(20):
+                    self.assertEqual(self.request('GET', '/chunked'), (200, BODY))
+            except Exception as e:
+                errors.append(e)
+        threads = [threading.Thread(target=client) for i in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+        self.assertLessEqual(self.pool()['idle'], 4)
+
+    def test_backend_close(self):
+        self.assertEqual(self.request('GET', '/'), (200, BODY))
+        # the backend closes the idle connection
+        time.sleep(1.5)
+        self.assertEqual(self.request('GET', '/'), (200, BODY))
+        self.assertEqual(self.backend.connections, 2)
+        # the backend explicitely closes the connection
+        self.assertEqual(self.request('GET', '/close'), (200, BODY))
+        self.assertEqual(self.request('GET', '/'), (200, BODY))
+        self.assertEqual(self.backend.connections, 3)
+
+    def test_retry_idempotent(self):
+        self.assertEqual(self.request('GET', '/'), (200, BODY))
+        # sent again over a new connection
+        self.assertRaises(http.client.RemoteDisconnected, self.request, 'GET', '/drop')
+        self.assertEqual(self.backend.drops, 2)
+        self.assertEqual(self.request('GET', '/'), (200, BODY))
+        # the backend could have processed it, never sent twice
+        self.assertRaises(http.client.RemoteDisconnected, self.request, 'POST', '/drop', b'')
+        self.assertEqual(self.backend.drops, 3)
+
+
+if __name__ == '__main__':
+    unittest.main()
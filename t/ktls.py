@@ -0,0 +1,126 @@
+import unittest
+import subprocess
+import socket
+import ssl
+import os
+import re
+import tempfile
+import shutil
+from uwsgitest import UwsgiServerTest, UWSGI_BINARY, free_ports, read_all
+
+HTTPS, BACKEND, STATS = free_ports(3)
+
+APP = b'''
+import os
+def application(e, sr):
+    if e['PATH_INFO'] == '/file':
+        sr('200 OK', [('Content-Length', str(os.path.getsize(os.environ['UWSGI_FILE'])))])
+        return e['wsgi.file_wrapper'](open(os.environ['UWSGI_FILE'], 'rb'))
+    body = b'k' * int(e['PATH_INFO'][1:])
+    sr('200 OK', [('Content-Length', str(len(body)))])
+    return [body]
+'''
+
+
+def kernel_has_ktls():
+    s = socket.socket()
+    l = socket.socket()
+    try:
+        l.bind(('127.0.0.1', 0))
+        l.listen(1)
+        s.connect(l.getsockname())
+        s.setsockopt(socket.SOL_TCP, 31, b'tls')
+        return True
+    except OSError:
+        return False
+    finally:
+        s.close()
+        l.close()
+
+
+class KTLSTest(UwsgiServerTest):
+
+    @classmethod
+    def setUpClass(cls):
+        out = subprocess.run([UWSGI_BINARY, '--help'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL).stdout
+        if not re.search(rb'^\s*--ssl-enable-ktls\s', out, re.M):
+            raise unittest.SkipTest('uWSGI has been built without kTLS support')
+        cls.dir = tempfile.mkdtemp()
+        cls.crt = os.path.join(cls.dir, 'ktls.crt')
+        cls.key = os.path.join(cls.dir, 'ktls.key')
+        try:
+            subprocess.check_call(['openssl', 'req', '-x509', '-newkey', 'rsa:2048', '-nodes', '-subj', '/CN=localhost',
+                                   '-keyout', cls.key, '-out', cls.crt, '-days', '1'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        except (OSError, subprocess.CalledProcessError):
+            shutil.rmtree(cls.dir)
+            raise unittest.SkipTest('openssl is required')
+        cls.app = os.path.join(cls.dir, 'app.py')
+        with open(cls.app, 'wb') as f:
+            f.write(APP)
+        cls.file = os.path.join(cls.dir, 'file')
+        with open(cls.file, 'wb') as f:
+            f.write(os.urandom(1024 * 1024))
+        cls.ktls = kernel_has_ktls()
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.dir)
+
+    def spawn(self, *args):
+        return self.start_server(['--master', '--ssl-enable-ktls', '--wsgi-file', self.app, '--env', 'UWSGI_FILE=%s' % self.file] + list(args),
+                                 ready=HTTPS)
+
+    def get(self, path):
+        ctx = ssl.create_default_context()
+        ctx.check_hostname = False
+        ctx.verify_mode = ssl.CERT_NONE
+        s = ctx.wrap_socket(socket.create_connection(('127.0.0.1', HTTPS)))
+        s.sendall(b'GET ' + path + b' HTTP/1.0\r\nHost: localhost\r\n\r\n')
+        data = b''
+        while True:
+            chunk = s.recv(65536)
+            if not chunk:
+                break
+            data += chunk
+        s.close()
+        headers, body = data.split(b'\r\n\r\n', 1)
+        return headers, body
+
+    def check_counters(self, spliced):
+        stats = read_all(STATS).decode()
+        ktls = int(re.search(r'"ktls":(\d+)', stats).group(1))
+        if self.ktls:
+            self.assertGreater(ktls, 0)
+            if spliced:
+                self.assertGreater(int(re.search(r'"spliced":(\d+)', stats).group(1)), 0)
+        else:
+            # the connections fall back to userspace encryption
+            self.assertEqual(ktls, 0)
+
+    def test_https_router(self):
+        self.spawn('--https', '127.0.0.1:%d,%s,%s' % (HTTPS, self.crt, self.key), '--http-splice',
+                   '--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--http-stats', '127.0.0.1:%d' % STATS)
+        for size in (1, 300000, 4 * 1024 * 1024):
+            headers, body = self.get(b'/%d' % size)
+            self.assertIn(b' 200 OK', headers)
+            self.assertEqual(body, b'k' * size)
+        self.check_counters(True)
+
+    def test_sslrouter(self):
+        self.spawn('--sslrouter', '127.0.0.1:%d,%s,%s' % (HTTPS, self.crt, self.key), '--sslrouter-splice',
+                   '--sslrouter-to', '127.0.0.1:%d' % BACKEND, '--http-socket', '127.0.0.1:%d' % BACKEND, '--sslrouter-stats', '127.0.0.1:%d' % STATS)
+        headers, body = self.get(b'/300000')
+        self.assertIn(b' 200 OK', headers)
+        self.assertEqual(body, b'k' * 300000)
+        self.check_counters(True)
+
+    def test_https_socket_sendfile(self):
+        self.spawn('--https-socket', '127.0.0.1:%d,%s,%s' % (HTTPS, self.crt, self.key))
+        headers, body = self.get(b'/file')
+        self.assertIn(b' 200 OK', headers)
+        with open(self.file, 'rb') as f:
+            self.assertEqual(body, f.read())
+
+
+if __name__ == '__main__':
+    unittest.main()
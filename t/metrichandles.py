@@ -0,0 +1,94 @@
+import unittest
+import time
+import threading
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, STATS = free_ports(2)
+
+APP = b'''
+import uwsgi
+
+handle = uwsgi.metric_handle('test.hits')
+
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    path = e['PATH_INFO']
+    if path == '/hit':
+        uwsgi.metric_inc_handle(handle)
+        uwsgi.metric_inc('test.named', 2)
+        uwsgi.metric_dec('test.named')
+        return [b'ok']
+    if path == '/mul':
+        uwsgi.metric_mul('test.hits', 2)
+    elif path == '/set':
+        uwsgi.metric_set_handle(handle, 7)
+    elif path == '/collected':
+        return [repr(uwsgi.metric_handle('core.busy_workers')).encode()]
+    return [str(uwsgi.metric_get_handle(handle)).encode() + b' ' + str(uwsgi.metric_get('test.named')).encode()]
+'''
+
+
+class MetricHandlesTest(UwsgiServerTest):
+
+    def setUp(self):
+        self.start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--processes', '4', '--threads', '2',
+                           '--enable-metrics', '--metric', 'test.hits', '--metric', 'test.named',
+                           '--stats', '127.0.0.1:%d' % STATS, '--wsgi-file', self.write_app(APP)], ready=HTTP)
+
+    def get(self, path):
+        c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+        c.request('GET', path)
+        r = c.getresponse()
+        body = r.read()
+        c.close()
+        self.assertEqual(r.status, 200)
+        return body
+
+    def hammer(self, clients=8, requests=50):
+        errors = []
+
+        def client():
+            try:
+                for i in range(requests):
+                    if self.get('/hit') != b'ok':
+                        errors.append(i)
+            except Exception as e:
+                errors.append(e)
+        threads = [threading.Thread(target=client) for n in range(clients)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        return errors
+
+    def stats_metric(self, name):
+        return self.stats(STATS)['metrics'][name]['value']
+
+    def test_concurrent_increments(self):
+        self.assertEqual(self.hammer(), [])
+        # the pending increments of all of the workers are visible immediately
+        self.assertEqual(self.get('/'), b'400 400')
+        # and folded by the metrics thread
+        for i in range(30):
+            if self.stats_metric('test.hits') == 400:
+                break
+            time.sleep(0.1)
+        self.assertEqual(self.stats_metric('test.hits'), 400)
+        self.assertEqual(self.stats_metric('test.named'), 400)
+
+    def test_locked_operations(self):
+        self.assertEqual(self.hammer(clients=4, requests=10), [])
+        self.assertEqual(self.get('/mul'), b'80 40')
+        self.assertEqual(self.hammer(clients=1, requests=5), [])
+        self.assertEqual(self.get('/'), b'85 45')
+        self.assertEqual(self.get('/set'), b'7 45')
+        self.assertEqual(self.hammer(clients=1, requests=1), [])
+        self.assertEqual(self.get('/'), b'8 46')
+
+    def test_collected_metric_has_no_handle(self):
+        self.assertEqual(self.get('/collected'), b'None')
+
+
+if __name__ == '__main__':
+    unittest.main()
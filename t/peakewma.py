@@ -0,0 +1,73 @@
+import unittest
+import time
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports
+
+HTTP, FAST, SLOW, STATS, SUBSCRIPTION = free_ports(5)
+
+APP = b'''
+import os
+import time
+
+def application(e, sr):
+    time.sleep(float(os.environ['BACKEND_DELAY']))
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    return [os.environ['BACKEND_NAME'].encode()]
+'''
+
+
+class PeakEWMATest(UwsgiServerTest):
+
+    def setUp(self):
+        self.app = self.write_app(APP)
+
+    def spawn(self, *args, **kwargs):
+        return self.start_server(['--master'] + list(args), **kwargs)
+
+    def backend(self, name, port, delay):
+        self.spawn('--socket', '127.0.0.1:%d' % port, '--processes', '4', '--wsgi-file', self.app,
+                   '--env', 'BACKEND_NAME=%s' % name, '--env', 'BACKEND_DELAY=%s' % delay,
+                   '--subscribe-to', '127.0.0.1:%d:ewma.local' % SUBSCRIPTION)
+
+    def nodes(self):
+        nodes = {}
+        for subscription in self.stats(STATS)['subscriptions']:
+            for node in subscription['nodes']:
+                nodes[node['name']] = node
+        return nodes
+
+    def test_fast_node_preferred(self):
+        self.spawn('--http', '127.0.0.1:%d' % HTTP, '--http-subscription-server', '127.0.0.1:%d' % SUBSCRIPTION,
+                   '--http-stats', '127.0.0.1:%d' % STATS, '--subscription-algo', 'peakewma', ready=STATS)
+        self.backend('fast', FAST, 0)
+        self.backend('slow', SLOW, 0.1)
+        for i in range(100):
+            if len(self.nodes()) == 2:
+                break
+            time.sleep(0.1)
+        self.assertEqual(len(self.nodes()), 2)
+
+        answers = {b'fast': 0, b'slow': 0}
+        for i in range(60):
+            c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+            c.request('GET', '/', headers={'Host': 'ewma.local'})
+            r = c.getresponse()
+            self.assertEqual(r.status, 200)
+            answers[r.read()] += 1
+            c.close()
+
+        # both nodes have been measured, the slow one only a few times
+        self.assertGreater(answers[b'slow'], 0)
+        self.assertGreater(answers[b'fast'], answers[b'slow'] * 5)
+
+        nodes = self.nodes()
+        fast = nodes['127.0.0.1:%d' % FAST]
+        slow = nodes['127.0.0.1:%d' % SLOW]
+        self.assertGreater(slow['ewma'], 100000)
+        self.assertLess(fast['ewma'], slow['ewma'])
+        self.assertEqual(fast['ref'], 0)
+        self.assertEqual(slow['ref'], 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
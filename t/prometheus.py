@@ -0,0 +1,106 @@
+import unittest
+import re
+import time
+import http.client
+from uwsgitest import UwsgiServerTest, connect, read_all, free_ports
+
+HTTP, PROMETHEUS, STATS = free_ports(3)
+
+APP = b'''
+import uwsgi
+
+def application(e, sr):
+    uwsgi.metric_inc('test.hits')
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    return [b'ok']
+'''
+
+SAMPLE = re.compile(r'^([a-zA-Z_:][a-zA-Z0-9_:]*)(\{[^}]*\})? (-?\d+)$')
+
+
+class PrometheusTest(UwsgiServerTest):
+
+    def spawn(self, *args):
+        self.start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--processes', '2', '--threads', '2',
+                           '--stats-prometheus', '127.0.0.1:%d' % PROMETHEUS, '--wsgi-file', self.write_app(APP)] + list(args),
+                          ready=HTTP)
+        for i in range(10):
+            c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+            c.request('GET', '/')
+            self.assertEqual(c.getresponse().read(), b'ok')
+            c.close()
+
+    def scrape(self):
+        c = http.client.HTTPConnection('127.0.0.1', PROMETHEUS, timeout=10)
+        c.request('GET', '/metrics')
+        r = c.getresponse()
+        self.assertEqual(r.status, 200)
+        self.assertTrue(r.getheader('Content-Type').startswith('text/plain; version=0.0.4'))
+        body = r.read().decode()
+        c.close()
+        families = {}
+        samples = []
+        for line in body.splitlines():
+            if line.startswith('# TYPE '):
+                _, _, name, kind = line.split(' ')
+                self.assertNotIn(name, families)
+                families[name] = kind
+            elif line.startswith('# HELP '):
+                continue
+            else:
+                m = SAMPLE.match(line)
+                self.assertTrue(m, line)
+                name = m.group(1)
+                family = re.sub(r'_(bucket|sum|count)$', '', name) if name not in families else name
+                self.assertIn(family, families)
+                samples.append((name, m.group(2) or '', int(m.group(3))))
+        return families, samples
+
+    def values(self, samples, name):
+        return [v for n, l, v in samples if n == name]
+
+    def test_workers_and_cores(self):
+        self.spawn()
+        families, samples = self.scrape()
+        self.assertEqual(families['uwsgi_worker_requests_total'], 'counter')
+        self.assertEqual(sum(self.values(samples, 'uwsgi_worker_requests_total')), 10)
+        self.assertEqual(len(self.values(samples, 'uwsgi_worker_requests_total')), 2)
+        self.assertEqual(sum(self.values(samples, 'uwsgi_core_requests_total')), 10)
+        self.assertEqual(len(self.values(samples, 'uwsgi_core_requests_total')), 4)
+        self.assertEqual(len(self.values(samples, 'uwsgi_socket_listen_queue')), 1)
+        # no metrics without --enable-metrics
+        self.assertFalse([n for n in families if n.startswith('uwsgi_metric_')])
+
+    def test_metrics_and_histograms(self):
+        self.spawn('--enable-metrics', '--metric', 'test.hits')
+        families, samples = self.scrape()
+        self.assertEqual(families['uwsgi_metric_test_hits'], 'counter')
+        self.assertEqual(self.values(samples, 'uwsgi_metric_test_hits'), [10])
+        self.assertEqual(families['uwsgi_metric_core_response_time'], 'histogram')
+        self.assertNotIn('uwsgi_metric_core_response_time_p99', families)
+        self.assertNotIn('uwsgi_metric_rss_size', families)
+        buckets = self.values(samples, 'uwsgi_metric_core_response_time_bucket')
+        self.assertEqual(buckets, sorted(buckets))
+        self.assertEqual(buckets[-1], 10)
+        self.assertEqual(self.values(samples, 'uwsgi_metric_core_response_time_count'), [10])
+        self.assertGreater(self.values(samples, 'uwsgi_metric_core_response_time_sum')[0], 0)
+
+    def test_idle_client(self):
+        self.spawn('--stats', '127.0.0.1:%d' % STATS, '--socket-timeout', '5')
+        # connected without sending the request
+        idle = connect(PROMETHEUS)
+        try:
+            time.sleep(0.2)
+            # the master is still serving its stats
+            start = time.time()
+            data = read_all(STATS)
+            self.assertIn(b'"workers"', data)
+            self.assertLess(time.time() - start, 2)
+        finally:
+            idle.close()
+        families, samples = self.scrape()
+        self.assertEqual(sum(self.values(samples, 'uwsgi_worker_requests_total')), 10)
+
+
+if __name__ == '__main__':
+    unittest.main()
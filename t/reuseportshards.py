@@ -0,0 +1,104 @@
+import unittest
+import time
+import signal
+import threading
+import http.client
+from uwsgitest import UwsgiServerTest, free_port
+
+HTTP = free_port()
+APP = b'''
+import os
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    return [str(os.getpid()).encode()]
+'''
+
+
+class ReusePortShardsTest(UwsgiServerTest):
+
+    def spawn(self, *args):
+        p = self.start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--wsgi-file', self.write_app(APP),
+                               '--disable-logging'] + list(args), ready=HTTP)
+        # wait for all of the workers
+        time.sleep(2)
+        return p
+
+    def request(self):
+        conn = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=5)
+        conn.request('GET', '/')
+        r = conn.getresponse()
+        body = r.read()
+        conn.close()
+        self.assertEqual(r.status, 200)
+        return int(body)
+
+    def test_shards(self):
+        p = self.spawn('--processes', '4', '--reuse-port-shards')
+        try:
+            pids = {}
+            for i in range(200):
+                pid = self.request()
+                pids[pid] = pids.get(pid, 0) + 1
+            self.assertEqual(len(pids), 4)
+            for pid in pids:
+                self.assertGreater(pids[pid], 10)
+        finally:
+            log = self.stop_server(p)
+        self.assertEqual(log.count(b'bound to TCP address 127.0.0.1:%d' % HTTP), 4)
+
+    def test_cbpf_cheaper(self):
+        # only a worker is running, the other shards must not receive connections
+        p = self.spawn('--processes', '4', '--cheaper', '1', '--cheaper-initial', '1', '--reuse-port-cbpf')
+        try:
+            pids = set()
+            for i in range(50):
+                pids.add(self.request())
+            self.assertEqual(len(pids), 1)
+        finally:
+            log = self.stop_server(p)
+        self.assertIn(b'reuseport shards steered to 1/4 workers', log)
+
+    def test_cheaper_forces_cbpf(self):
+        p = self.spawn('--processes', '4', '--cheaper', '1', '--cheaper-initial', '1', '--reuse-port-shards')
+        try:
+            pids = set()
+            for i in range(50):
+                pids.add(self.request())
+            self.assertEqual(len(pids), 1)
+        finally:
+            log = self.stop_server(p)
+        self.assertIn(b'steering the reuseport shards with --reuse-port-cbpf', log)
+
+    def test_cbpf_reload(self):
+        p = self.spawn('--processes', '2', '--reuse-port-cbpf')
+        errors = []
+        done = threading.Event()
+
+        def client():
+            while not done.is_set():
+                try:
+                    self.request()
+                except Exception as e:
+                    errors.append(e)
+        t = threading.Thread(target=client)
+        t.start()
+        try:
+            time.sleep(0.5)
+            # graceful reload, the shards are inherited
+            p.send_signal(signal.SIGHUP)
+            time.sleep(3)
+            done.set()
+            t.join()
+            self.assertEqual(errors, [])
+            pids = set()
+            for i in range(50):
+                pids.add(self.request())
+            self.assertEqual(len(pids), 2)
+        finally:
+            done.set()
+            log = self.stop_server(p)
+        self.assertEqual(log.count(b'inherited INET address 127.0.0.1:%d' % HTTP), 2)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,116 @@
+import unittest
+import os
+import re
+import time
+import threading
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports, read_all
+
+HTTP, BACKEND, STATS, SUBSCRIPTION, DEAD = free_ports(5)
+
+APP = b'''
+def application(e, sr):
+    body = e['wsgi.input'].read() + e['PATH_INFO'].encode()
+    sr('200 OK', [('Content-Length', str(len(body)))])
+    return [body]
+'''
+
+
+class RouterThreadsTest(UwsgiServerTest):
+
+    def setUp(self):
+        self.app = self.write_app(APP)
+
+    def spawn(self, *args):
+        return self.start_server(['--master', '--http', '127.0.0.1:%d' % HTTP, '--http-threads', '4',
+                                  '--http-stats', '127.0.0.1:%d' % STATS, '--processes', '4', '--wsgi-file', self.app] + list(args),
+                                 ready=HTTP)
+
+    def stats(self):
+        return read_all(STATS).decode()
+
+    def hammer(self, host, clients=8, requests=50):
+        errors = []
+
+        def client(n):
+            try:
+                for i in range(requests):
+                    c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+                    body = b'x' * (i * 100)
+                    c.request('POST', '/%d/%d' % (n, i), body, headers={'Host': host})
+                    r = c.getresponse()
+                    if r.status != 200 or r.read() != body + b'/%d/%d' % (n, i):
+                        errors.append((n, i, r.status))
+                    c.close()
+            except Exception as e:
+                errors.append(e)
+        threads = [threading.Thread(target=client, args=(n,)) for n in range(clients)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        return errors
+
+    def test_static_backend(self):
+        self.spawn('--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND)
+        self.assertEqual(self.hammer('localhost'), [])
+        stats = self.stats()
+        self.assertIn('"threads":4', stats)
+        pid = int(re.search(r'"pid":(\d+)', stats).group(1))
+        self.assertEqual(len(os.listdir('/proc/%d/task' % pid)), 4)
+        self.assertIn('"active_sessions":0', stats)
+
+    def test_subscriptions(self):
+        self.spawn('--http-subscription-server', '127.0.0.1:%d' % SUBSCRIPTION, '--socket', '127.0.0.1:%d' % BACKEND,
+                   '--subscribe-to', '127.0.0.1:%d:threads.local' % SUBSCRIPTION)
+        for i in range(50):
+            if 'threads.local' in self.stats():
+                break
+            time.sleep(0.1)
+        self.assertEqual(self.hammer('threads.local'), [])
+        stats = self.stats()
+        # all of the references to the node have been released
+        self.assertIn('"ref":0', stats)
+        self.assertIn('"requests":400', stats)
+
+    def test_dead_backend(self):
+        # the dead node keeps being subscribed again while all of the threads fail against it
+        self.spawn('--http-subscription-server', '127.0.0.1:%d' % SUBSCRIPTION, '--socket', '127.0.0.1:%d' % BACKEND,
+                   '--subscribe-to', '127.0.0.1:%d:threads.local' % SUBSCRIPTION, '--subscribe-freq', '1',
+                   '--subscribe2', 'server=127.0.0.1:%d,key=dead.local,addr=127.0.0.1:%d' % (SUBSCRIPTION, DEAD))
+        for i in range(50):
+            stats = self.stats()
+            if 'threads.local' in stats and 'dead.local' in stats:
+                break
+            time.sleep(0.1)
+        pid = int(re.search(r'"pid":(\d+)', stats).group(1))
+        errors = []
+
+        def client():
+            try:
+                for i in range(100):
+                    c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+                    c.request('GET', '/', headers={'Host': 'dead.local'})
+                    try:
+                        c.getresponse().read()
+                    except (http.client.RemoteDisconnected, ConnectionResetError):
+                        # the router closes the connection once the node is gone
+                        pass
+                    c.close()
+            except Exception as e:
+                errors.append(e)
+        threads = [threading.Thread(target=client) for n in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(errors, [])
+        # the router survived
+        self.assertEqual(self.hammer('threads.local', requests=10), [])
+        stats = self.stats()
+        self.assertEqual(int(re.search(r'"pid":(\d+)', stats).group(1)), pid)
+        self.assertIn('"active_sessions":0', stats)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,137 @@
+import unittest
+import socket
+import threading
+import hashlib
+import re
+import http.client
+from uwsgitest import UwsgiServerTest, free_ports, read_all, wait_ready
+
+ROUTER, FRONTEND, BACKEND, STATS, ROUTER_STATS = free_ports(5)
+
+SIZE = 8 * 1024 * 1024
+
+APP = b'''
+import hashlib
+def application(e, sr):
+    if e['PATH_INFO'] == '/download':
+        body = bytes(range(256)) * %d
+    else:
+        body = hashlib.sha1(e['wsgi.input'].read()).hexdigest().encode()
+    sr('200 OK', [('Content-Length', str(len(body)))])
+    return [body]
+''' % (SIZE // 256)
+
+PAYLOAD = bytes(range(256)) * (SIZE // 256)
+
+
+class EchoBackend(threading.Thread):
+
+    def __init__(self):
+        threading.Thread.__init__(self, daemon=True)
+        self.s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self.s.bind(('127.0.0.1', BACKEND))
+        self.s.listen(10)
+
+    def run(self):
+        while True:
+            try:
+                c, addr = self.s.accept()
+            except OSError:
+                return
+            while True:
+                data = c.recv(65536)
+                if not data:
+                    break
+                c.sendall(data)
+            c.close()
+
+
+class SpliceTest(UwsgiServerTest):
+
+    def spawn(self, *args):
+        return self.start_server(['--master', '--stats', '127.0.0.1:%d' % STATS] + list(args), ready=ROUTER)
+
+    def spliced(self):
+        return int(re.search(r'"spliced":(\d+)', read_all(ROUTER_STATS).decode()).group(1))
+
+    def test_rawrouter(self):
+        backend = EchoBackend()
+        backend.start()
+        self.addCleanup(backend.s.close)
+        self.spawn('--rawrouter', '127.0.0.1:%d' % ROUTER, '--rawrouter-to', '127.0.0.1:%d' % BACKEND,
+                   '--rawrouter-splice', '--rawrouter-stats', '127.0.0.1:%d' % ROUTER_STATS)
+        s = socket.create_connection(('127.0.0.1', ROUTER))
+        s.settimeout(10)
+        received = []
+
+        def reader():
+            while sum(map(len, received)) < SIZE:
+                data = s.recv(65536)
+                if not data:
+                    break
+                received.append(data)
+        t = threading.Thread(target=reader)
+        t.start()
+        s.sendall(PAYLOAD)
+        t.join()
+        s.close()
+        self.assertEqual(hashlib.sha1(b''.join(received)).hexdigest(), hashlib.sha1(PAYLOAD).hexdigest())
+        self.assertEqual(self.spliced(), SIZE * 2)
+
+    def test_http(self):
+        app = self.write_app(APP)
+        self.spawn('--http', '127.0.0.1:%d' % ROUTER, '--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND,
+                   '--http-splice', '--http-stats', '127.0.0.1:%d' % ROUTER_STATS, '--wsgi-file', app)
+        c = http.client.HTTPConnection('127.0.0.1', ROUTER, timeout=10)
+        c.request('GET', '/download')
+        r = c.getresponse()
+        self.assertEqual(r.read(), PAYLOAD)
+        c.close()
+        c = http.client.HTTPConnection('127.0.0.1', ROUTER, timeout=10)
+        c.request('POST', '/upload', PAYLOAD)
+        r = c.getresponse()
+        self.assertEqual(r.read().decode(), hashlib.sha1(PAYLOAD).hexdigest())
+        c.close()
+        # most of the body has been relayed with splice (headers and the first chunk are buffered)
+        self.assertGreater(self.spliced(), SIZE * 2 - 256 * 1024)
+
+    def test_http_keepalive_fallback(self):
+        app = self.write_app(APP)
+        self.spawn('--http', '127.0.0.1:%d' % ROUTER, '--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND,
+                   '--http-splice', '--http-keepalive', '--http-stats', '127.0.0.1:%d' % ROUTER_STATS, '--wsgi-file', app)
+        c = http.client.HTTPConnection('127.0.0.1', ROUTER, timeout=10)
+        for i in range(2):
+            c.request('POST', '/upload', PAYLOAD)
+            r = c.getresponse()
+            self.assertEqual(r.read().decode(), hashlib.sha1(PAYLOAD).hexdigest())
+            c.request('GET', '/download')
+            r = c.getresponse()
+            self.assertEqual(r.read(), PAYLOAD)
+        c.close()
+        # the responses are parsed in keepalive mode, only request bodies can be spliced
+        spliced = self.spliced()
+        self.assertGreater(spliced, 0)
+        self.assertLessEqual(spliced, SIZE * 2)
+
+    def test_fastrouter(self):
+        app = self.write_app(APP)
+        self.spawn('--fastrouter', '127.0.0.1:%d' % ROUTER, '--fastrouter-use-socket', '--socket', '127.0.0.1:%d' % BACKEND,
+                   '--fastrouter-splice', '--fastrouter-stats', '127.0.0.1:%d' % ROUTER_STATS, '--wsgi-file', app,
+                   '--http', '127.0.0.1:%d' % FRONTEND, '--http-to', '127.0.0.1:%d' % ROUTER)
+        wait_ready(FRONTEND)
+        c = http.client.HTTPConnection('127.0.0.1', FRONTEND, timeout=10)
+        c.request('GET', '/download')
+        r = c.getresponse()
+        self.assertEqual(r.read(), PAYLOAD)
+        c.close()
+        c = http.client.HTTPConnection('127.0.0.1', FRONTEND, timeout=10)
+        c.request('POST', '/upload', PAYLOAD)
+        r = c.getresponse()
+        self.assertEqual(r.read().decode(), hashlib.sha1(PAYLOAD).hexdigest())
+        c.close()
+        self.assertGreater(self.spliced(), SIZE * 2 - 256 * 1024)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,106 @@
+# rawrouter throughput benchmark: buffered relaying vs zero-copy splice()
+#
+#   python3 t/splicebench.py
+#
+# environment variables:
+#   SPLICE_BENCH_MB           megabytes transferred in each direction (default: 1024)
+#   SPLICE_BENCH_BUFFER_SIZE  router buffer (and pipe) size (default: page size)
+#   SPLICE_BENCH_RUNS         number of runs per mode, the best one is reported (default: 3)
+import socket
+import os
+import time
+import signal
+import tempfile
+from uwsgitest import start_server, stop_server, connect, free_ports
+
+mb = int(os.environ.get('SPLICE_BENCH_MB', '1024'))
+buffer_size = os.environ.get('SPLICE_BENCH_BUFFER_SIZE')
+runs = int(os.environ.get('SPLICE_BENCH_RUNS', '3'))
+
+ROUTER, BACKEND = free_ports(2)
+
+CHUNK = 1024 * 1024
+total = mb * CHUNK
+
+# a file to send with sendfile() so the backend is not the bottleneck
+payload = tempfile.TemporaryFile()
+payload.write(os.urandom(CHUNK))
+payload.flush()
+
+
+def drain(s):
+    buf = bytearray(CHUNK)
+    received = 0
+    while True:
+        n = s.recv_into(buf)
+        if not n:
+            break
+        received += n
+    return received
+
+
+def backend():
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(('127.0.0.1', BACKEND))
+    s.listen(10)
+    while True:
+        c, addr = s.accept()
+        mode = c.recv(1)
+        # download: send the payload, upload: discard everything
+        if mode == b'd':
+            for i in range(mb):
+                c.sendfile(payload, 0, CHUNK)
+            c.shutdown(socket.SHUT_WR)
+        else:
+            drain(c)
+        c.close()
+
+
+def download():
+    s = connect(ROUTER)
+    s.sendall(b'd')
+    t = time.time()
+    received = drain(s)
+    elapsed = time.time() - t
+    s.close()
+    assert received == total
+    return elapsed
+
+
+def upload():
+    s = connect(ROUTER)
+    s.sendall(b'u')
+    t = time.time()
+    for i in range(mb):
+        s.sendfile(payload, 0, CHUNK)
+    s.shutdown(socket.SHUT_WR)
+    # wait for the backend to close the connection
+    s.recv(1)
+    elapsed = time.time() - t
+    s.close()
+    return elapsed
+
+
+backend_pid = os.fork()
+if backend_pid == 0:
+    backend()
+    os._exit(0)
+
+try:
+    for mode in ('buffered', 'splice'):
+        args = ['--master', '--rawrouter', '127.0.0.1:%d' % ROUTER, '--rawrouter-to', '127.0.0.1:%d' % BACKEND]
+        if buffer_size:
+            args += ['--rawrouter-buffer-size', buffer_size]
+        if mode == 'splice':
+            args.append('--rawrouter-splice')
+        p = start_server(args, ready=ROUTER)
+        try:
+            for name, func in (('download', download), ('upload', upload)):
+                best = min(func() for i in range(runs))
+                print('mode: %-8s direction: %-8s MB/sec: %d' % (mode, name, mb / best))
+        finally:
+            stop_server(p)
+finally:
+    os.kill(backend_pid, signal.SIGKILL)
+    os.waitpid(backend_pid, 0)
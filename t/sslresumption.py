@@ -0,0 +1,134 @@
+import unittest
+import subprocess
+import ssl
+import os
+import re
+import time
+import tempfile
+import shutil
+from uwsgitest import UwsgiServerTest, connect, read_all, free_ports
+
+HTTPS, BACKEND, STATS = free_ports(3)
+
+APP = b'''
+def application(e, sr):
+    sr('200 OK', [('Content-Length', '2')])
+    return [b'ok']
+'''
+
+
+class SSLResumptionTest(UwsgiServerTest):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.dir = tempfile.mkdtemp()
+        cls.crt = os.path.join(cls.dir, 'resumption.crt')
+        cls.key = os.path.join(cls.dir, 'resumption.key')
+        try:
+            subprocess.check_call(['openssl', 'req', '-x509', '-newkey', 'rsa:2048', '-nodes', '-subj', '/CN=localhost',
+                                   '-keyout', cls.key, '-out', cls.crt, '-days', '1'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        except (OSError, subprocess.CalledProcessError):
+            shutil.rmtree(cls.dir)
+            raise unittest.SkipTest('openssl is required')
+        cls.app = os.path.join(cls.dir, 'app.py')
+        with open(cls.app, 'wb') as f:
+            f.write(APP)
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.dir)
+
+    def spawn(self, *args):
+        # the ssl options must precede the https sockets
+        return self.start_server(['--master'] + list(args) + ['--https', '127.0.0.1:%d,%s,%s' % (HTTPS, self.crt, self.key),
+                                  '--http-to', '127.0.0.1:%d' % BACKEND, '--socket', '127.0.0.1:%d' % BACKEND, '--wsgi-file', self.app,
+                                  '--http-stats', '127.0.0.1:%d' % STATS], ready=HTTPS)
+
+    def context(self, tls12=False):
+        ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+        ctx.check_hostname = False
+        ctx.verify_mode = ssl.CERT_NONE
+        if tls12:
+            ctx.maximum_version = ssl.TLSVersion.TLSv1_2
+        return ctx
+
+    def get(self, ctx, session=None):
+        s = ctx.wrap_socket(connect(HTTPS), session=session)
+        s.sendall(b'GET / HTTP/1.0\r\nHost: localhost\r\n\r\n')
+        data = b''
+        while True:
+            chunk = s.recv(4096)
+            if not chunk:
+                break
+            data += chunk
+        self.assertTrue(data.endswith(b'\r\n\r\nok'))
+        # TLS 1.3 tickets are received after the handshake
+        reused, session = s.session_reused, s.session
+        s.close()
+        return reused, session
+
+    def test_shared_tickets(self):
+        self.spawn('--ssl-ticket-keys-rotation', '60', '--http-processes', '4')
+        ctx = self.context()
+        reused, session = self.get(ctx)
+        self.assertFalse(reused)
+        # every router process accepts the tickets
+        for i in range(20):
+            reused, _ = self.get(ctx, session)
+            self.assertTrue(reused)
+
+    def test_counters(self):
+        self.spawn('--ssl-ticket-keys-rotation', '60')
+        ctx = self.context()
+        reused, session = self.get(ctx)
+        for i in range(5):
+            self.get(ctx, session)
+        stats = read_all(STATS).decode()
+        self.assertEqual(int(re.search(r'"ssl_handshakes":(\d+)', stats).group(1)), 6)
+        self.assertEqual(int(re.search(r'"ssl_resumed":(\d+)', stats).group(1)), 5)
+        self.assertEqual(int(re.search(r'"ssl_ticket_keys_rotations":(\d+)', stats).group(1)), 1)
+
+    def test_secret_survives_restart(self):
+        p = self.spawn('--ssl-ticket-keys-rotation', '60', '--ssl-ticket-keys-secret', 'foobar')
+        ctx = self.context()
+        reused, session = self.get(ctx)
+        self.stop_server(p)
+        p = self.spawn('--ssl-ticket-keys-rotation', '60', '--ssl-ticket-keys-secret', 'foobar')
+        reused, _ = self.get(ctx, session)
+        self.assertTrue(reused)
+        self.stop_server(p)
+        self.spawn('--ssl-ticket-keys-rotation', '60', '--ssl-ticket-keys-secret', 'another')
+        reused, _ = self.get(ctx, session)
+        self.assertFalse(reused)
+
+    def wait_epoch(self, rotation, epoch):
+        while time.time() < epoch * rotation + 0.2:
+            time.sleep(0.05)
+
+    def test_grace(self):
+        self.spawn('--ssl-ticket-keys-rotation', '2', '--ssl-ticket-keys-grace', '2')
+        ctx = self.context()
+        reused, session = self.get(ctx)
+        epoch = int(time.time()) // 2
+        # the previous key is still accepted (and the ticket renewed)
+        self.wait_epoch(2, epoch + 1)
+        reused, _ = self.get(ctx, session)
+        self.assertTrue(reused)
+        # out of the grace window
+        self.wait_epoch(2, epoch + 2)
+        reused, _ = self.get(ctx, session)
+        self.assertFalse(reused)
+
+    def test_sessions_cache(self):
+        self.spawn('--cache2', 'name=sslsessions,items=100,blocksize=4096,shards=4', '--ssl-sessions-use-cache=sslsessions',
+                   '--http-processes', '4')
+        ctx = self.context(tls12=True)
+        reused, session = self.get(ctx)
+        self.assertFalse(reused)
+        for i in range(20):
+            reused, _ = self.get(ctx, session)
+            self.assertTrue(reused)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,176 @@
+import unittest
+import struct
+import time
+import tempfile
+import http.client
+from uwsgitest import UwsgiServerTest, connect, wait_ready, free_ports
+
+HTTP, BINARY = free_ports(2)
+
+APP = b'''
+import uwsgi
+
+def application(e, sr):
+    uwsgi.metric_inc('test.hits', 3)
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    return [b'ok']
+'''
+
+
+def varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7f) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+
+
+class Subscriber(object):
+
+    def __init__(self, address):
+        self.s = connect(address, timeout=10)
+        self.buf = b''
+        self.values = {}
+        kind, payload = self.packet()
+        assert kind == b'S'
+        count, pos = varint(payload, 0)
+        self.names = []
+        for i in range(count):
+            size, pos = varint(payload, pos)
+            self.names.append(payload[pos:pos + size].decode())
+            pos += size
+        self.ids = dict((name, i) for i, name in enumerate(self.names))
+
+    def read(self, size):
+        while len(self.buf) < size:
+            chunk = self.s.recv(65536)
+            if not chunk:
+                raise Exception('connection closed')
+            self.buf += chunk
+        data, self.buf = self.buf[:size], self.buf[size:]
+        return data
+
+    def packet(self):
+        kind, size = struct.unpack('<cI', self.read(5))
+        return kind, self.read(size)
+
+    # apply a snapshot/delta returning the names of the changed values
+    def update(self):
+        kind, payload = self.packet()
+        ts, count = struct.unpack('<QI', payload[:12])
+        pos = 12
+        current = 0
+        changed = []
+        for i in range(count):
+            gap, pos = varint(payload, pos)
+            zigzag, pos = varint(payload, pos)
+            current += gap
+            delta = (zigzag >> 1) ^ -(zigzag & 1)
+            self.values[current] = self.values.get(current, 0) + delta
+            changed.append(self.names[current])
+            current += 1
+        return kind, changed
+
+    def get(self, name):
+        return self.values.get(self.ids[name], 0)
+
+    def close(self):
+        self.s.close()
+
+
+class StatsBinaryTest(UwsgiServerTest):
+
+    def setUp(self):
+        self.app = self.write_app(APP)
+        self.p = self.spawn('127.0.0.1:%d' % BINARY, '--processes', '2', '--threads', '2')
+
+    def spawn(self, binary, *args):
+        return self.start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP,
+                                  '--enable-metrics', '--metric', 'test.hits',
+                                  '--stats-binary', binary, '--wsgi-file', self.app] + list(args), ready=HTTP)
+
+    def requests(self, n):
+        for i in range(n):
+            c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+            c.request('GET', '/')
+            self.assertEqual(c.getresponse().read(), b'ok')
+            c.close()
+
+    def test_snapshot_and_deltas(self):
+        self.requests(5)
+        sub = Subscriber(BINARY)
+        self.assertIn('worker.2.core.1.requests', sub.names)
+        self.assertIn('socket.0.listen_queue', sub.names)
+        self.assertIn('metric.test.hits', sub.names)
+        kind, changed = sub.update()
+        self.assertEqual(kind, b'F')
+        self.assertEqual(len(changed), len(sub.names))
+        self.assertEqual(sub.get('worker.1.requests') + sub.get('worker.2.requests'), 5)
+        self.assertEqual(sub.get('metric.test.hits'), 15)
+
+        # nothing happens: no changes (metrics may still be catching up in the metrics thread)
+        kind, changed = sub.update()
+        self.assertEqual(kind, b'D')
+        self.assertFalse([name for name in changed if not name.startswith('metric.')])
+
+        self.requests(4)
+        total = 0
+        for i in range(5):
+            kind, changed = sub.update()
+            self.assertEqual(kind, b'D')
+            total = sub.get('worker.1.requests') + sub.get('worker.2.requests')
+            if total == 9:
+                break
+        self.assertEqual(total, 9)
+        self.assertEqual(sub.get('metric.test.hits'), 27)
+        cores = sum(sub.get('worker.%d.core.%d.requests' % (w, c)) for w in (1, 2) for c in (0, 1))
+        self.assertEqual(cores, 9)
+        sub.close()
+
+    def test_multiple_subscribers(self):
+        first = Subscriber(BINARY)
+        first.update()
+        self.requests(2)
+        second = Subscriber(BINARY)
+        second.update()
+        first.close()
+        for i in range(5):
+            second.update()
+            if second.get('worker.1.requests') + second.get('worker.2.requests') == 2:
+                break
+        self.assertEqual(second.get('worker.1.requests') + second.get('worker.2.requests'), 2)
+        second.close()
+
+    def test_slow_subscriber(self):
+        self.stop_server(self.p)
+        # a schema bigger than the send buffer of a unix socket
+        path = tempfile.mktemp(suffix='.sock')
+        self.spawn(path, '--processes', '8', '--threads', '64')
+        wait_ready(path)
+        # never reads
+        stuck = connect(path)
+        try:
+            time.sleep(1)
+            start = time.time()
+            sub = Subscriber(path)
+            sub.update()
+            # the other subscribers are not delayed while the stuck one lags behind
+            for i in range(6):
+                kind, changed = sub.update()
+                self.assertEqual(kind, b'D')
+            self.assertLess(time.time() - start, 9)
+            sub.close()
+            # while the stuck one has been dropped
+            stuck.settimeout(10)
+            while stuck.recv(65536):
+                pass
+        finally:
+            stuck.close()
+
+
+if __name__ == '__main__':
+    unittest.main()
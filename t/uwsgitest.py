@@ -0,0 +1,149 @@
+#
+# Shared fixtures for the integration tests spawning their own uWSGI instances.
+#
+# The tests not needing the in-process uwsgi api are plain scripts:
+#
+#   python3 t/http2.py
+#
+# while the ones using it (caches, metrics...) run as pyrun scripts of a dummy instance,
+# whose .ini file adds t/ to the pythonpath:
+#
+#   ./uwsgi --ini t/cachecompress.ini
+
+
+import json
+import os
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import time
+import unittest
+
+
+TESTS_DIR = os.path.dirname(os.path.abspath(__file__))
+UWSGI_BINARY = os.getenv("UWSGI_BINARY", os.path.join(TESTS_DIR, "..", "uwsgi"))
+UWSGI_ADDR = "127.0.0.1"
+
+
+def free_ports(n):
+    # keep all of them bound while asking, so they are all different
+    sockets = []
+    for i in range(n):
+        s = socket.socket()
+        s.bind((UWSGI_ADDR, 0))
+        sockets.append(s)
+    ports = [s.getsockname()[1] for s in sockets]
+    for s in sockets:
+        s.close()
+    return ports
+
+
+def free_port():
+    return free_ports(1)[0]
+
+
+def connect(address, timeout=None):
+    # a tcp port on localhost or the path of a unix socket
+    if isinstance(address, str):
+        s = socket.socket(socket.AF_UNIX)
+        s.settimeout(timeout)
+        s.connect(address)
+        return s
+    return socket.create_connection((UWSGI_ADDR, address), timeout=timeout)
+
+
+def read_all(address):
+    s = connect(address, timeout=10)
+    data = b''
+    while True:
+        chunk = s.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    s.close()
+    return data
+
+
+def wait_ready(address):
+    for i in range(50):
+        try:
+            connect(address).close()
+            return
+        except socket.error:
+            time.sleep(0.1)
+    raise RuntimeError("uwsgi test server is not available")
+
+
+def start_server(args, ready=None, stderr=subprocess.DEVNULL):
+    server = subprocess.Popen(
+        [UWSGI_BINARY] + args,
+        stdin=subprocess.DEVNULL,
+        stdout=subprocess.DEVNULL,
+        stderr=stderr,
+    )
+    if ready is not None:
+        wait_ready(ready)
+    return server
+
+
+def stop_server(server):
+    if server.poll() is None:
+        server.send_signal(signal.SIGINT)
+        try:
+            server.wait(30)
+        except subprocess.TimeoutExpired:
+            server.kill()
+            server.wait()
+
+
+def write_app(code, suffix=".py"):
+    app = tempfile.NamedTemporaryFile(suffix=suffix)
+    app.write(code)
+    app.flush()
+    return app
+
+
+class UwsgiServerTest(unittest.TestCase):
+
+    def problems(self):
+        if hasattr(self._outcome, "errors"):
+            # Python 3.4 - 3.10  (These two methods have no side effects)
+            result = self.defaultTestResult()
+            self._feedErrorsToResult(result, self._outcome.errors)
+        else:
+            # Python 3.11+ (the whole run)
+            result = self._outcome.result
+        return len(result.errors + result.failures)
+
+    def write_app(self, code, suffix=".py"):
+        app = write_app(code, suffix)
+        self.addCleanup(app.close)
+        return app.name
+
+    def start_server(self, args, ready=None):
+        # the log is shown only if the test fails
+        log = tempfile.TemporaryFile()
+        server = start_server(args, stderr=log)
+        server.log = log
+        server.problems = self.problems()
+        self.addCleanup(self.stop_server, server)
+        if ready is not None:
+            wait_ready(ready)
+        return server
+
+    # returns the log of the instance
+    def stop_server(self, server):
+        if server.log.closed:
+            return b""
+        stop_server(server)
+        server.log.seek(0)
+        log = server.log.read()
+        server.log.close()
+        if self.problems() > server.problems:
+            sys.stderr.write(log.decode(errors="replace"))
+        return log
+
+    def stats(self, address):
+        return json.loads(read_all(address).decode())
@@ -0,0 +1,99 @@
+# request vars lookup benchmark: per-request index vs linear scan of the vars
+#
+# every request runs a setprocname route whose template references all of its headers
+# (plus some missing vars) over and over, the cost of a lookup is the difference with the
+# same requests without the route divided by the number of lookups.
+#
+#   python3 t/varsbench.py
+#
+# environment variables:
+#   VARS_BENCH_HEADERS   comma separated list of extra headers counts (default: 0,20,60)
+#   VARS_BENCH_LOOKUPS   lookups in each request, in routes of 1000 (default: 20000)
+#   VARS_BENCH_REQUESTS  requests in each run (default: 500)
+#   VARS_BENCH_RUNS      number of runs, the best one is reported (default: 3)
+import os
+import time
+from uwsgitest import start_server, stop_server, write_app, connect, free_port
+
+HTTP = free_port()
+
+headers_counts = [int(x) for x in os.environ.get('VARS_BENCH_HEADERS', '0,20,60').split(',') if x]
+lookups = int(os.environ.get('VARS_BENCH_LOOKUPS', '20000')) // 1000 * 1000
+requests = int(os.environ.get('VARS_BENCH_REQUESTS', '500'))
+runs = int(os.environ.get('VARS_BENCH_RUNS', '3'))
+
+APP = b'''
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'text/plain')])
+    return [b'ok']
+'''
+
+# what a browser behind a couple of proxies sends
+BROWSER = [
+    ('Host', 'www.example.com'),
+    ('User-Agent', 'Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0'),
+    ('Accept', 'text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8'),
+    ('Accept-Language', 'en-US,en;q=0.5'),
+    ('Accept-Encoding', 'gzip, deflate, br, zstd'),
+    ('Referer', 'https://www.example.com/'),
+    ('Cookie', 'sessionid=0123456789abcdef; csrftoken=fedcba9876543210'),
+    ('Upgrade-Insecure-Requests', '1'),
+    ('Sec-Fetch-Dest', 'document'),
+    ('Sec-Fetch-Mode', 'navigate'),
+    ('Sec-Fetch-Site', 'same-origin'),
+    ('Sec-Fetch-User', '?1'),
+    ('Priority', 'u=0, i'),
+    ('X-Forwarded-For', '10.0.0.1, 10.0.0.2'),
+    ('X-Forwarded-Proto', 'https'),
+    ('X-Real-Ip', '10.0.0.1'),
+]
+
+CGI = ['REQUEST_METHOD', 'REQUEST_URI', 'PATH_INFO', 'QUERY_STRING', 'REMOTE_ADDR', 'SERVER_NAME']
+MISSING = ['HTTP_AUTHORIZATION', 'HTTP_X_REQUEST_ID', 'HTTPS']
+
+app = write_app(APP)
+
+
+def request_headers(extra):
+    headers = list(BROWSER)
+    for i in range(extra):
+        headers.append(('X-Custom-Header-%d' % i, 'value%d' % i))
+    return headers
+
+
+def template(headers):
+    keys = CGI + ['HTTP_' + k.upper().replace('-', '_') for k, v in headers] + MISSING
+    return ''.join('${%s}' % keys[i % len(keys)] for i in range(1000))
+
+
+def run(headers):
+    packet = 'GET /?foo=bar HTTP/1.0\r\n' + ''.join('%s: %s\r\n' % (k, v) for k, v in headers) + '\r\n'
+    packet = packet.encode()
+    t = time.time()
+    for i in range(requests):
+        s = connect(HTTP)
+        s.sendall(packet)
+        while s.recv(4096):
+            pass
+        s.close()
+    return time.time() - t
+
+
+def measure(headers, args):
+    p = start_server(['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--wsgi-file', app.name,
+                      '--buffer-size', '32768', '--disable-logging'] + args, ready=HTTP)
+    try:
+        return min(run(headers) for i in range(runs))
+    finally:
+        stop_server(p)
+
+
+for extra in headers_counts:
+    headers = request_headers(extra)
+    base = measure(headers, [])
+    # the process name is not updated when the expanded template is too long
+    route = ['--route-run', 'setprocname:' + template(headers)] * (lookups // 1000)
+    for mode in ('linear', 'index'):
+        elapsed = measure(headers, route + (['--disable-vars-index'] if mode == 'linear' else []))
+        print('mode: %-6s headers: %3d ns/lookup: %.1f' % (mode, len(headers), max(elapsed - base, 0) * 1e9 / (requests * lookups)))
+app.close()
@@ -0,0 +1,84 @@
+import unittest
+import json
+import http.client
+from uwsgitest import UwsgiServerTest, free_port
+
+HTTP = free_port()
+
+APP = b'''
+import json
+
+def application(e, sr):
+    sr('200 OK', [('Content-Type', 'application/json')])
+    return [json.dumps(dict((k, v) for k, v in e.items() if k.startswith('LOOKUP_'))).encode()]
+'''
+
+ROUTES = [
+    'addvar:LOOKUP_FOO=${HTTP_X_FOO}',
+    'addvar:LOOKUP_MISSING=[${HTTP_X_NOPE}]',
+    'addvar:LOOKUP_METHOD=${REQUEST_METHOD}',
+    'addvar:LOOKUP_FIRST=${HTTP_X_H0}',
+    'addvar:LOOKUP_LAST=${HTTP_X_H69}',
+    # same length, same head and tail, they only differ in the middle
+    'addvar:LOOKUP_MIDDLE1=${HTTP_X_AAAA_MIDDLE1_TAIL_END}',
+    'addvar:LOOKUP_MIDDLE2=${HTTP_X_AAAA_MIDDLE2_TAIL_END}',
+    # vars added after the parsing
+    'addvar:APPENDED=appended',
+    'addvar:LOOKUP_APPENDED=${APPENDED}',
+    'addvar:DUP=first',
+    'addvar:DUP=second',
+    'addvar:LOOKUP_DUP=${DUP}',
+    'addvar:LOOKUP_LOOKUP=${LOOKUP_FOO}',
+]
+
+
+class VarsIndexTest(UwsgiServerTest):
+
+    def spawn(self, *args):
+        cmd = ['--master', '--http-socket', '127.0.0.1:%d' % HTTP, '--wsgi-file', self.write_app(APP)]
+        for route in ROUTES:
+            cmd += ['--route-run', route]
+        self.start_server(cmd + list(args), ready=HTTP)
+
+    def get(self, headers):
+        c = http.client.HTTPConnection('127.0.0.1', HTTP, timeout=10)
+        c.request('GET', '/', headers=headers)
+        r = c.getresponse()
+        self.assertEqual(r.status, 200)
+        data = json.loads(r.read().decode())
+        c.close()
+        return data
+
+    def check(self):
+        headers = {'X-Foo': 'foo', 'X-Aaaa-Middle1-Tail-End': 'middle1', 'X-Aaaa-Middle2-Tail-End': 'middle2'}
+        for i in range(70):
+            headers['X-H%d' % i] = 'h%d' % i
+        expected = {
+            'LOOKUP_FOO': 'foo',
+            'LOOKUP_MISSING': '[]',
+            'LOOKUP_METHOD': 'GET',
+            'LOOKUP_FIRST': 'h0',
+            'LOOKUP_LAST': 'h69',
+            'LOOKUP_MIDDLE1': 'middle1',
+            'LOOKUP_MIDDLE2': 'middle2',
+            'LOOKUP_APPENDED': 'appended',
+            'LOOKUP_DUP': 'second',
+            'LOOKUP_LOOKUP': 'foo',
+        }
+        # the index of the previous request must not leak into the next one
+        for i in range(3):
+            self.assertEqual(self.get(headers), expected)
+            self.assertEqual(self.get({}), dict(expected, LOOKUP_FOO='', LOOKUP_FIRST='', LOOKUP_LAST='',
+                                                LOOKUP_MIDDLE1='', LOOKUP_MIDDLE2='', LOOKUP_LOOKUP=''))
+
+    def test_index(self):
+        self.spawn()
+        self.check()
+
+    def test_linear(self):
+        self.spawn('--disable-vars-index')
+        self.check()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,64 @@
+#include "../uwsgi.h"
+
+/*
+	microbenchmark of the embedded hash algorithms
+
+	keys follow a distribution similar to the ones hashed by caches and routers:
+	40% short (8-24 bytes, e.g. session ids and hostnames), 40% medium (24-64 bytes, paths)
+	and 20% long (64-256 bytes, full urls)
+*/
+
+#define BENCH_KEYS 4096
+#define BENCH_ROUNDS 2000
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+int main(int argc, char *argv[]) {
+	static char *keys[BENCH_KEYS];
+	static uint64_t keys_len[BENCH_KEYS];
+	uint64_t total_len = 0;
+	int i, j;
+
+	srand(17);
+	for (i = 0; i < BENCH_KEYS; i++) {
+		int r = rand() % 10;
+		if (r < 4) keys_len[i] = 8 + (rand() % 17);
+		else if (r < 8) keys_len[i] = 24 + (rand() % 41);
+		else keys_len[i] = 64 + (rand() % 193);
+		keys[i] = malloc(keys_len[i]);
+		for (j = 0; j < (int) keys_len[i]; j++) {
+			keys[i][j] = 'a' + (rand() % 26);
+		}
+		total_len += keys_len[i];
+	}
+
+	uwsgi_hash_algo_register_all();
+
+	printf("%llu keys, average length %llu bytes\n", (unsigned long long) BENCH_KEYS, (unsigned long long) (total_len / BENCH_KEYS));
+
+	// rr and random do not look at the key
+	char *algos[] = { "djb33x", "murmur2", "wyhash", "crc32c", NULL };
+	char **algo = algos;
+	while (*algo) {
+		struct uwsgi_hash_algo *uha = uwsgi_hash_algo_get(*algo);
+		if (!uha) goto next;
+		uint32_t sink = 0;
+		uint64_t start = now_ns();
+		for (j = 0; j < BENCH_ROUNDS; j++) {
+			for (i = 0; i < BENCH_KEYS; i++) {
+				sink += uha->func(keys[i], keys_len[i]);
+			}
+		}
+		uint64_t elapsed = now_ns() - start;
+		double hashes = (double) BENCH_KEYS * BENCH_ROUNDS;
+		printf("%-10s %8.2f ns/key %8.2f GB/s (%08x)\n", uha->name, elapsed / hashes, (total_len * (double) BENCH_ROUNDS) / elapsed, sink);
+next:
+		algo++;
+	}
+
+	return 0;
+}
@@ -94,12 +94,43 @@ Suite *check_core_cron(void)
 	return s;
 }
 
+START_TEST(test_uwsgi_hash_algos)
+{
+	uwsgi_hash_algo_register_all();
+
+	struct uwsgi_hash_algo *uha = uwsgi_hash_algo_get("crc32c");
+	ck_assert(uha != NULL);
+	// crc32c("123456789") is 0xe3069283, followed by the fmix32 avalanche
+	ck_assert_msg(uha->func("123456789", 9) == 0xac7081cc, "result: %x", uha->func("123456789", 9));
+
+	uha = uwsgi_hash_algo_get("wyhash");
+	ck_assert(uha != NULL);
+	ck_assert(uha->func("123456789", 9) == uha->func("123456789", 9));
+	ck_assert(uha->func("123456789", 9) != uha->func("123456780", 9));
+	// keys longer than 48 bytes use the 3 lanes loop
+	char *long_key = "0123456789012345678901234567890123456789012345678901234567890123456789";
+	ck_assert(uha->func(long_key, 70) == uha->func(long_key, 70));
+	ck_assert(uha->func(long_key, 70) != uha->func(long_key, 69));
+}
+END_TEST
+
+Suite *check_core_hash(void)
+{
+	Suite *s = suite_create("uwsgi hash");
+	TCase *tc = tcase_create("hash");
+
+	suite_add_tcase(s, tc);
+	tcase_add_test(tc, test_uwsgi_hash_algos);
+	return s;
+}
+
 int main(void)
 {
 	int nf;
 	SRunner *r = srunner_create(check_core_strings());
 	srunner_add_suite(r, check_core_opt_parsing());
 	srunner_add_suite(r, check_core_cron());
+	srunner_add_suite(r, check_core_hash());
 	srunner_run_all(r, CK_NORMAL);
 	nf = srunner_ntests_failed(r);
 	srunner_free(r);
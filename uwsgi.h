@@ -362,15 +362,37 @@ extern int pivot_root(const char *new_root, const char *put_old);
 #define UWSGI_CACHE_FLAG_MUL	1 << 7
 #define UWSGI_CACHE_FLAG_DIV	1 << 8
 #define UWSGI_CACHE_FLAG_FIXEXPIRE	1 << 9
+#define UWSGI_CACHE_FLAG_COMPRESSED	1 << 10
+
+#define UWSGI_CACHE_POLICY_CLOCK	1
+#define UWSGI_CACHE_POLICY_SAMPLED	2
 
 #ifdef UWSGI_SSL
 #include <openssl/conf.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 
-#if OPENSSL_VERSION_NUMBER < 0x10100000L
-#define UWSGI_SSL_SESSION_CACHE
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define UWSGI_SSL_KTLS
 #endif
+#define UWSGI_SSL_KTLS_TX	(1 << 0)
+#define UWSGI_SSL_KTLS_RX	(1 << 1)
+
+#define UWSGI_SSL_TICKET_KEYS	4
+
+struct uwsgi_ssl_ticket_key {
+	uint64_t epoch;
+	unsigned char name[16];
+	unsigned char aes_key[32];
+	unsigned char hmac_key[32];
+};
+
+struct uwsgi_ssl_ticket_keys {
+	// seqlock, odd while a process is storing a new key
+	uint64_t seq;
+	uint64_t rotations;
+	struct uwsgi_ssl_ticket_key keys[UWSGI_SSL_TICKET_KEYS];
+};
 #endif
 
 #include <glob.h>
@@ -812,6 +834,86 @@ struct uwsgi_cache_item {
 	char key[];
 } __attribute__ ((__packed__));
 
+// compact layout: open addressing index, each bucket fills a single cacheline
+#define UWSGI_CACHE_BUCKET_ENTRIES 7
+struct uwsgi_cache_bucket {
+	// 8bit fingerprints of the keys (0 is a free entry)
+	uint8_t tags[UWSGI_CACHE_BUCKET_ENTRIES];
+	// number of keys that overflowed from this bucket to the next ones
+	uint8_t overflow;
+	uint32_t hashes[UWSGI_CACHE_BUCKET_ENTRIES];
+	uint32_t slots[UWSGI_CACHE_BUCKET_ENTRIES];
+};
+
+// slab allocator: memcached-style size classes, pages are assigned to classes on demand
+#define UWSGI_CACHE_SLAB_CLASSES 64
+struct uwsgi_cache_slab_class {
+	uint64_t chunk_size;
+	uint64_t chunks_per_page;
+	// first page with free chunks (page index + 1)
+	uint64_t partial;
+	uint64_t pages;
+	uint64_t chunks;
+};
+
+struct uwsgi_cache_slab_page {
+	// class index + 1 (0 for unassigned pages)
+	uint32_t class;
+	uint32_t used;
+	// chunks are carved lazily from the start of the page
+	uint32_t carved;
+	// first free chunk (chunk index + 1), the next one is stored in the chunk itself
+	uint32_t free;
+	// partial pages list of the class (or free pages list), page index + 1
+	uint32_t prev;
+	uint32_t next;
+};
+
+// it lives in the cache memory area (after the data), so it is persisted in the store too
+struct uwsgi_cache_slabs {
+	uint64_t nclasses;
+	// pages never assigned start from here
+	uint64_t next_page;
+	// released pages (page index + 1)
+	uint64_t free_pages;
+	struct uwsgi_cache_slab_class classes[UWSGI_CACHE_SLAB_CLASSES];
+};
+
+#define UWSGI_CACHE_STORE_MAGIC 0x7553544f52453031ULL
+
+// the last page of a store file, a store is trusted as is only if it has been cleanly synced
+struct uwsgi_cache_store_header {
+	uint64_t magic;
+	// checksum of the cache geometry
+	uint64_t layout;
+	uint64_t generation;
+	// changes not synced yet
+	uint64_t dirty;
+	uint32_t checksum;
+};
+
+#define UWSGI_CACHE_REPLOG_ORIGINS 8
+
+// a ring of modified keys (entry for sequence 'n' is at n % size), the values are read when the changes are sent
+struct uwsgi_cache_replog {
+	// identifies the log (sequence numbers are meaningful only in the same epoch)
+	uint64_t epoch;
+	uint64_t seq;
+	uint64_t size;
+	uint64_t entry_size;
+	// last sequence applied from the other nodes
+	struct {
+		uint64_t epoch;
+		uint64_t seq;
+	} origins[UWSGI_CACHE_REPLOG_ORIGINS];
+};
+
+struct uwsgi_cache_replog_entry {
+	uint64_t seq;
+	uint16_t keylen;
+	char key[];
+};
+
 struct uwsgi_cache {
 	char *name;
 	uint16_t name_len;
@@ -874,6 +976,65 @@ struct uwsgi_cache {
 	int lazy_expire;
 	uint64_t sweep_on_full;
 	int clear_on_full;
+
+	// sharded mode: the cache is split in independent partitions (each one with its own lock)
+	uint64_t shards;
+	struct uwsgi_cache *shard_caches;
+
+	// optimistic (lock-free) reads: a sequence counter for each hashtable slot
+	uint8_t optimistic;
+	uint64_t optimistic_max_size;
+	uint32_t *seqs;
+	uint64_t optimistic_retries;
+
+	// compact layout (replaces hashtable and items chains)
+	uint8_t compact;
+	struct uwsgi_cache_bucket *buckets;
+	uint64_t nbuckets;
+
+	// slab allocator (replaces fixed blocks and bitmap)
+	uint8_t use_slabs;
+	double slab_factor;
+	uint64_t slab_page_size;
+	uint64_t slab_npages;
+	struct uwsgi_cache_slabs *slabs;
+	struct uwsgi_cache_slab_page *slab_pages;
+
+	// eviction policies not requiring the write lock on gets (alternative to purge_lru)
+	uint8_t purge_policy;
+	uint8_t *clock_refs;
+	uint64_t clock_hand;
+	uint32_t *access_ticks;
+	uint32_t policy_tick;
+	uint64_t purge_samples;
+	uint64_t random_state;
+	uint64_t evictions;
+
+	// TinyLFU admission filter
+	uint8_t tinylfu;
+	uint8_t *sketch;
+	uint64_t sketch_width;
+	uint64_t sketch_additions;
+	uint64_t admission_rejected;
+
+	// delta replication (coalesced batches of changes instead of a datagram for each write)
+	uint64_t replog_size;
+	uint64_t replication_freq;
+	struct uwsgi_cache_replog *replog;
+	struct uwsgi_lock_item *replog_lock;
+	// items too big for a replication datagram
+	uint64_t replication_skipped;
+
+	// incremental sync of the store (only the modified pages are flushed)
+	struct uwsgi_cache_store_header *store_header;
+	uint8_t *dirty_pages;
+	uint64_t dirty_npages;
+	uint64_t store_writes;
+
+	// values bigger than compress_threshold are stored gzipped (UWSGI_CACHE_FLAG_COMPRESSED)
+	int compress;
+	uint64_t compress_threshold;
+	uint64_t compressed_items;
 };
 
 struct uwsgi_option {
@@ -1029,6 +1190,9 @@ struct uwsgi_socket {
 	int shared;
 	int from_shared;
 
+	// the worker owning this SO_REUSEPORT shard (0 if not sharded)
+	int shard;
+
 	// used for avoiding vacuum mess
 	ino_t inode;
 
@@ -1408,6 +1572,8 @@ struct wsgi_request {
 
 	//iovec
 	struct iovec *hvec;
+	// open addressing index of the hvec keys (hvec position + 1, 0 for empty slots)
+	uint16_t *var_index;
 
 	uint64_t start_of_request;
 	uint64_t start_of_request_in_sec;
@@ -1499,6 +1665,8 @@ struct wsgi_request {
 	void *sendfile_obj;
 
 	uint16_t var_cnt;
+	// number of hvec items already in var_index
+	uint16_t var_indexed;
 	uint16_t header_cnt;
 
 	int do_not_log;
@@ -1894,6 +2062,8 @@ struct uwsgi_server {
 	uint64_t master_cycles;
 
 	int reuse_port;
+	int reuse_port_shards;
+	int reuse_port_cbpf;
 	int tcp_fast_open;
 	int tcp_fast_open_client;
 
@@ -2518,6 +2688,8 @@ struct uwsgi_server {
 
 	int max_vars;
 	int vec_size;
+	uint32_t var_index_mask;
+	int vars_index_disable;
 
 	// shared area
 	struct uwsgi_string_list *sharedareas_list;
@@ -2705,6 +2877,11 @@ struct uwsgi_server {
 	char *stats;
 	int stats_fd;
 	int stats_http;
+	char *stats_prometheus;
+	int stats_prometheus_fd;
+	char *stats_binary;
+	int stats_binary_fd;
+	int stats_binary_freq;
 	int stats_minified;
 	struct uwsgi_string_list *requested_stats_pushers;
 	struct uwsgi_stats_pusher *stats_pushers;
@@ -2742,6 +2919,7 @@ struct uwsgi_server {
 	int subscriptions_blocked;
 	int subscribe_freq;
 	int subscription_tolerance;
+	int subscription_ewma_decay;
 	int unsubscribe_on_graceful_reload;
 	struct uwsgi_string_list *subscriptions;
 	struct uwsgi_string_list *subscriptions2;
@@ -2758,6 +2936,11 @@ struct uwsgi_server {
 	int ssl_sessions_timeout;
 	struct uwsgi_cache *ssl_sessions_cache;
 	char *ssl_tmp_dir;
+	int ssl_ktls;
+	int ssl_ticket_keys_rotation;
+	int ssl_ticket_keys_grace;
+	char *ssl_ticket_keys_secret;
+	struct uwsgi_ssl_ticket_keys *ssl_ticket_keys;
 #if defined(UWSGI_PCRE) || defined(UWSGI_PCRE2)
 	struct uwsgi_regexp_list *sni_regexp;
 #endif
@@ -2805,6 +2988,9 @@ struct uwsgi_server {
 	char *metrics_dir;
 	int metrics_dir_restore;
 	uint64_t metrics_cnt;
+	struct uwsgi_metric **metrics_table;
+	struct uwsgi_metric *metrics_response_time;
+	uint64_t metrics_slots_stride;
 	struct uwsgi_string_list *additional_metrics;
 	struct uwsgi_string_list *metrics_threshold;
 
@@ -3104,6 +3290,7 @@ struct uwsgi_core {
 
 	char *buffer;
 	struct iovec *hvec;
+	uint16_t *var_index;
 	char *post_buf;
 
 	struct wsgi_request req;
@@ -3412,10 +3599,12 @@ struct uwsgi_cache *uwsgi_cache_by_name(char *);
 struct uwsgi_cache *uwsgi_cache_by_namelen(char *, uint16_t);
 void uwsgi_cache_create_all(void);
 void uwsgi_cache_sync_from_nodes(struct uwsgi_cache *);
+struct uwsgi_buffer *uwsgi_cache_replog_delta(struct uwsgi_cache *, uint64_t, uint64_t, uint64_t *, uint64_t *);
 void uwsgi_cache_setup_nodes(struct uwsgi_cache *);
 int64_t uwsgi_cache_num2(struct uwsgi_cache *, char *, uint16_t);
 
-void uwsgi_cache_sync_all(void);
+void uwsgi_cache_start_store_sync(void);
+void uwsgi_cache_flush_stores(void);
 void uwsgi_cache_start_sweepers(void);
 void uwsgi_cache_start_sync_servers(void);
 
@@ -3844,6 +4033,10 @@ struct uwsgi_subscribe_node {
 
 	char vassal[0xff];
 	uint16_t vassal_len;
+
+	// peak EWMA of the response time (in microseconds) measured by the routers
+	double ewma;
+	uint64_t ewma_updated;
 };
 
 struct uwsgi_subscribe_slot {
@@ -3879,6 +4072,7 @@ void create_msg_pipe(int *, int);
 struct uwsgi_subscribe_slot *uwsgi_get_subscribe_slot(struct uwsgi_subscribe_slot **, char *, uint16_t);
 struct uwsgi_subscribe_node *uwsgi_get_subscribe_node_by_name(struct uwsgi_subscribe_slot **, char *, uint16_t, char *, uint16_t);
 struct uwsgi_subscribe_node *uwsgi_get_subscribe_node(struct uwsgi_subscribe_slot **, char *, uint16_t, struct uwsgi_subscription_client *);
+void uwsgi_subscription_node_latency(struct uwsgi_subscribe_node *, uint64_t);
 int uwsgi_remove_subscribe_node(struct uwsgi_subscribe_slot **, struct uwsgi_subscribe_node *);
 struct uwsgi_subscribe_node *uwsgi_add_subscribe_node(struct uwsgi_subscribe_slot **, struct uwsgi_subscribe_req *);
 
@@ -3923,6 +4117,7 @@ struct uwsgi_logger *uwsgi_get_logger_from_id(char *);
 
 char *uwsgi_getsockname(int);
 char *uwsgi_get_var(struct wsgi_request *, char *, uint16_t, uint16_t *);
+void uwsgi_vars_index(struct wsgi_request *);
 
 struct uwsgi_gateway_socket *uwsgi_new_gateway_socket(char *, char *);
 struct uwsgi_gateway_socket *uwsgi_new_gateway_socket_from_fd(int, char *);
@@ -4196,6 +4391,9 @@ void uwsgi_stats_pusher_loop(struct uwsgi_thread *);
 
 void uwsgi_stats_pusher_setup(void);
 void uwsgi_send_stats(int, struct uwsgi_stats *(*func) (void));
+void uwsgi_send_prometheus(int);
+void uwsgi_stats_prometheus_start(void);
+void uwsgi_stats_binary_start(void);
 struct uwsgi_stats *uwsgi_master_generate_stats(void);
 struct uwsgi_stats_pusher * uwsgi_register_stats_pusher(char *, void (*)(struct uwsgi_stats_pusher_instance *, time_t, char *, size_t));
 
@@ -4246,6 +4444,8 @@ void uwsgi_setup_emperor();
 #ifdef UWSGI_SSL
 void uwsgi_ssl_init(void);
 SSL_CTX *uwsgi_ssl_new_server_context(char *, char *, char *, char *, char *);
+int uwsgi_ssl_ktls(SSL *);
+uint64_t uwsgi_ssl_ticket_keys_rotations(void);
 char *uwsgi_rsa_sign(char *, char *, size_t, unsigned int *);
 char *uwsgi_sanitize_cert_filename(char *, char *, uint16_t);
 void uwsgi_opt_scd(char *, char *, void *);
@@ -4388,6 +4588,9 @@ void uwsgi_setup_mules_and_farms(void);
 
 void uwsgi_setup_workers(void);
 void uwsgi_map_sockets(void);
+void uwsgi_setup_shard_sockets(void);
+void uwsgi_inherit_shard_socket(struct uwsgi_socket *);
+void uwsgi_steer_shard_sockets(void);
 
 void uwsgi_set_cpu_affinity(void);
 
@@ -4413,6 +4616,7 @@ int uwsgi_buffer_u24be(struct uwsgi_buffer *, uint32_t);
 int uwsgi_buffer_u64be(struct uwsgi_buffer *, uint64_t);
 int uwsgi_buffer_f64be(struct uwsgi_buffer *, double);
 int uwsgi_buffer_num64(struct uwsgi_buffer *, int64_t);
+int uwsgi_buffer_varint(struct uwsgi_buffer *, uint64_t);
 int uwsgi_buffer_append_keyval(struct uwsgi_buffer *, char *, uint16_t, char *, uint16_t);
 int uwsgi_buffer_append_keyval32(struct uwsgi_buffer *, char *, uint32_t, char *, uint32_t);
 int uwsgi_buffer_append_keynum(struct uwsgi_buffer *, char *, uint16_t, int64_t);
@@ -4783,14 +4987,36 @@ struct uwsgi_cache_magic_context {
 	uint16_t status_len;
 	char *cache;
 	uint16_t cache_len;
+	// number of items of batched commands
+	uint64_t items;
+};
+
+// an item of batched (mget/mset/mdel) cache operations
+struct uwsgi_cache_mitem {
+	char *key;
+	uint16_t keylen;
+	char *value;
+	uint64_t vallen;
+	uint64_t expires;
+	// 0 on success, -1 on error (or missing item)
+	int status;
 };
 
 char *uwsgi_cache_magic_get(char *, uint16_t, uint64_t *, uint64_t *, char *);
+char *uwsgi_cache_magic_get_encoded(char *, uint16_t, uint64_t *, uint64_t *, int *, char *);
 int uwsgi_cache_magic_set(char *, uint16_t, char *, uint64_t, uint64_t, uint64_t, char *);
 int uwsgi_cache_magic_del(char *, uint16_t, char *);
 int uwsgi_cache_magic_exists(char *, uint16_t, char *);
 int uwsgi_cache_magic_clear(char *);
 void uwsgi_cache_magic_context_hook(char *, uint16_t, char *, uint16_t, void *);
+int uwsgi_cache_magic_mget(struct uwsgi_cache_mitem *, uint64_t, char *);
+int uwsgi_cache_magic_mset(struct uwsgi_cache_mitem *, uint64_t, uint64_t, char *);
+int uwsgi_cache_magic_mdel(struct uwsgi_cache_mitem *, uint64_t, char *);
+int uwsgi_cache_mget(struct uwsgi_cache *, struct uwsgi_cache_mitem *, uint64_t);
+int uwsgi_cache_mset(struct uwsgi_cache *, struct uwsgi_cache_mitem *, uint64_t, uint64_t);
+int uwsgi_cache_mdel(struct uwsgi_cache *, struct uwsgi_cache_mitem *, uint64_t);
+int uwsgi_cache_mitems_pack(struct uwsgi_buffer *, struct uwsgi_cache_mitem *, uint64_t, int);
+int uwsgi_cache_mitems_unpack(char *, uint64_t, struct uwsgi_cache_mitem *, uint64_t, int);
 
 char *uwsgi_legion_scrolls(char *, uint64_t *);
 int uwsgi_emperor_vassal_start(struct uwsgi_instance *);
@@ -4803,6 +5029,7 @@ char *uwsgi_deflate(z_stream *, char *, size_t, size_t *);
 void uwsgi_crc32(uint32_t *, char *, size_t);
 struct uwsgi_buffer *uwsgi_gzip(char *, size_t);
 struct uwsgi_buffer *uwsgi_zlib_decompress(char *, size_t);
+struct uwsgi_buffer *uwsgi_gunzip(char *, size_t);
 int uwsgi_gzip_fix(z_stream *, uint32_t, struct uwsgi_buffer *, size_t);
 char *uwsgi_gzip_chunk(z_stream *, uint32_t *, char *, size_t, size_t *);
 int uwsgi_gzip_prepare(z_stream *, char *, size_t, uint32_t *);
@@ -4872,6 +5099,12 @@ struct uwsgi_cache_item *uwsgi_cache_keys(struct uwsgi_cache *, uint64_t *, stru
 void uwsgi_cache_rlock(struct uwsgi_cache *);
 void uwsgi_cache_rwunlock(struct uwsgi_cache *);
 char *uwsgi_cache_item_key(struct uwsgi_cache_item *);
+struct uwsgi_cache *uwsgi_cache_shard(struct uwsgi_cache *, char *, uint16_t);
+struct uwsgi_cache *uwsgi_cache_shard_n(struct uwsgi_cache *, uint64_t);
+uint64_t uwsgi_cache_nshards(struct uwsgi_cache *);
+int uwsgi_cache_get_optimistic(struct uwsgi_cache *, char *, uint16_t, char **, uint64_t *, uint64_t *);
+char *uwsgi_cache_get_copy(struct uwsgi_cache *, char *, uint16_t, uint64_t *, uint64_t *, int *);
+struct uwsgi_buffer *uwsgi_cache_precompress(struct uwsgi_cache *, char *, uint64_t, uint64_t);
 
 char *uwsgi_binsh(void);
 int uwsgi_file_executable(char *);
@@ -4933,6 +5166,19 @@ enum {
 	UWSGI_METRIC_GAUGE,
 	UWSGI_METRIC_ABSOLUTE,
 	UWSGI_METRIC_ALIAS,
+	UWSGI_METRIC_HISTOGRAM,
+};
+
+// log-linear buckets: values below 2^UWSGI_HISTOGRAM_SUB_BITS are exact, then every power of two
+// is split in 2^UWSGI_HISTOGRAM_SUB_BITS buckets (~3% precision) up to 2^36 (about 19 hours in microseconds)
+#define UWSGI_HISTOGRAM_SUB_BITS 5
+#define UWSGI_HISTOGRAM_BUCKETS 1024
+
+struct uwsgi_histogram {
+	uint64_t count;
+	uint64_t sum;
+	uint64_t max;
+	uint64_t buckets[UWSGI_HISTOGRAM_BUCKETS];
 };
 
 struct uwsgi_metric_child;
@@ -5007,6 +5253,15 @@ struct uwsgi_metric {
 
 	// allow to reset metrics after each push
 	uint8_t reset_after_push;
+
+	// position in uwsgi.metrics_table (used as handle by the language bindings)
+	uint64_t id;
+	// per-worker increments (NULL for collected metrics), uwsgi.metrics_slots_stride values apart
+	int64_t *slots;
+
+	// histograms have an area per worker in shared memory (merged by the metrics thread)
+	struct uwsgi_histogram *histogram;
+	struct uwsgi_histogram *histogram_merged;
 };
 
 struct uwsgi_metric_child {
@@ -5027,6 +5282,19 @@ int64_t uwsgi_metric_getn(char *, size_t, char *, size_t);
 int uwsgi_metric_set_max(char *, char *, int64_t);
 int uwsgi_metric_set_min(char *, char *, int64_t);
 
+struct uwsgi_metric *uwsgi_metric_handle(char *, char *);
+struct uwsgi_metric *uwsgi_metric_by_id(uint64_t);
+int uwsgi_metric_handle_inc(struct uwsgi_metric *, int64_t);
+int uwsgi_metric_handle_dec(struct uwsgi_metric *, int64_t);
+int uwsgi_metric_handle_set(struct uwsgi_metric *, int64_t);
+int64_t uwsgi_metric_handle_get(struct uwsgi_metric *);
+int uwsgi_metric_handle_observe(struct uwsgi_metric *, uint64_t);
+int uwsgi_metric_observe(char *, char *, uint64_t);
+void uwsgi_histogram_add(struct uwsgi_histogram *, uint64_t);
+uint64_t uwsgi_histogram_percentile(struct uwsgi_histogram *, uint64_t);
+uint64_t uwsgi_histogram_bucket_max(uint64_t);
+void uwsgi_metric_histogram_merge(struct uwsgi_metric *, struct uwsgi_histogram *);
+
 struct uwsgi_metric_collector *uwsgi_register_metric_collector(char *, int64_t (*)(struct uwsgi_metric *));
 struct uwsgi_metric *uwsgi_register_metric(char *, char *, uint8_t, char *, void *, uint32_t, void *);
 